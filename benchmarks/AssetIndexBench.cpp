@@ -0,0 +1,64 @@
+/**
+ * AssetIndexBench.cpp
+ *
+ * Parsing an asset index the size of a current release (~4k objects):
+ * the JSON parse alone, and MojangAPI::parseAssetIndex, which also
+ * converts it to AssetObjects.
+ */
+
+#include "core/downloader/MojangAPI.hpp"
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using konami::core::downloader::MojangAPI;
+
+namespace {
+
+/**
+ * Object names shaped like minecraft/sounds/... and minecraft/lang/...
+ */
+const std::string& assetIndexJson() {
+    static const std::string text = [] {
+        std::mt19937 rng(5);
+        const char* folders[] = {"sounds/block", "sounds/mob", "sounds/ambient", "lang", "textures/entity", "music/game"};
+        const char* extensions[] = {".ogg", ".ogg", ".ogg", ".json", ".png", ".ogg"};
+
+        nlohmann::json objects = nlohmann::json::object();
+        for (int i = 0; i < 4000; ++i) {
+            int folder = static_cast<int>(rng() % 6);
+            std::string hash(40, '0');
+            for (auto& c : hash) c = "0123456789abcdef"[rng() % 16];
+            std::string name = std::string("minecraft/") + folders[folder] + "/asset" + std::to_string(i) + extensions[folder];
+            objects[name] = {{"hash", hash}, {"size", rng() % 200000}};
+        }
+        return nlohmann::json{{"objects", objects}}.dump();
+    }();
+    return text;
+}
+
+void BM_AssetIndex_Parse(benchmark::State& state) {
+    const auto& text = assetIndexJson();
+    for (auto _ : state) {
+        auto json = nlohmann::json::parse(text);
+        benchmark::DoNotOptimize(json);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_AssetIndex_Parse)->Unit(benchmark::kMillisecond);
+
+void BM_MojangAPI_ParseAssetIndex(benchmark::State& state) {
+    const auto& text = assetIndexJson();
+    for (auto _ : state) {
+        auto assets = MojangAPI::parseAssetIndex(text);
+        benchmark::DoNotOptimize(assets.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_MojangAPI_ParseAssetIndex)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,380 @@
+#pragma once
+
+/**
+ * AssetServer.hpp
+ *
+ * In-process stand-in for the game's resources CDN, for load and failure
+ * testing of DownloadManager without touching the network. Serves
+ * registered objects over HTTP/1.1 keep-alive connections and injects
+ * faults per request: latency, a per-connection bandwidth cap, connection
+ * resets, 5xx responses, truncated bodies and corrupted bodies (which fail
+ * the client's hash check).
+ *
+ * Faults are chosen from the seed, the path and how many times that path
+ * has been requested, so a given seed fails the same attempts every run.
+ */
+
+#include <asio.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace konami::bench {
+
+/**
+ * AssetServer - Multi-threaded asio server with fault injection
+ */
+class AssetServer {
+public:
+    /**
+     * What to do to requests; rates are per request, in [0, 1]
+     */
+    struct Faults {
+        std::chrono::milliseconds latency{0};   // Before every response
+        size_t bandwidth{0};                    // Bytes/s per connection, 0 = unlimited
+        double resetRate{0};                    // Reset the connection instead of answering
+        double serverErrorRate{0};              // Answer 503
+        double truncateRate{0};                 // Close halfway through the body
+        double corruptRate{0};                  // Flip one byte of the body
+        uint64_t seed{1};
+    };
+
+    /**
+     * Counters since start
+     */
+    struct Stats {
+        size_t connections{0};
+        size_t requests{0};
+        size_t bytesSent{0};
+        size_t resets{0};
+        size_t serverErrors{0};
+        size_t truncated{0};
+        size_t corrupted{0};
+        size_t notFound{0};
+    };
+
+    /**
+     * Constructor - listens on an ephemeral 127.0.0.1 port; call start()
+     * once every object has been added
+     * @param faults Faults to inject
+     * @param threads I/O threads
+     */
+    explicit AssetServer(Faults faults, size_t threads = 2)
+        : m_faults(faults)
+        , m_threadCount(std::max<size_t>(threads, 1))
+        , m_acceptor(m_io, asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0)) {}
+
+    ~AssetServer() {
+        stop();
+    }
+
+    AssetServer(const AssetServer&) = delete;
+    AssetServer& operator=(const AssetServer&) = delete;
+
+    /**
+     * Register an object (before start())
+     * @param path Request path, e.g. "/ab/ab12..."
+     * @param body Object contents
+     */
+    void add(const std::string& path, std::string body) {
+        m_objects[path].body = std::move(body);
+    }
+
+    /**
+     * Start accepting connections
+     */
+    void start() {
+        accept();
+        for (size_t i = 0; i < m_threadCount; ++i) {
+            m_threads.emplace_back([this] { m_io.run(); });
+        }
+    }
+
+    /**
+     * Stop serving and join the I/O threads
+     */
+    void stop() {
+        if (m_stopped.exchange(true)) {
+            return;
+        }
+        m_io.stop();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    uint16_t port() const {
+        return m_acceptor.local_endpoint().port();
+    }
+
+    /**
+     * Build a URL on this server
+     * @param path Request path
+     * @return Absolute URL
+     */
+    std::string url(const std::string& path) const {
+        return "http://127.0.0.1:" + std::to_string(port()) + path;
+    }
+
+    /**
+     * Number of requests received for one object
+     */
+    size_t requestCount(const std::string& path) const {
+        auto it = m_objects.find(path);
+        return it != m_objects.end() ? it->second.requests.load() : 0;
+    }
+
+    Stats stats() const {
+        Stats stats;
+        stats.connections = m_connections;
+        stats.requests = m_requests;
+        stats.bytesSent = m_bytesSent;
+        stats.resets = m_resets;
+        stats.serverErrors = m_serverErrors;
+        stats.truncated = m_truncated;
+        stats.corrupted = m_corrupted;
+        stats.notFound = m_notFound;
+        return stats;
+    }
+
+private:
+    enum class Fault { None, Reset, ServerError, Truncate, Corrupt };
+
+    struct Object {
+        std::string body;
+        std::atomic<size_t> requests{0};
+    };
+
+    /**
+     * Pick the fault for the n-th request of a path
+     */
+    Fault decide(const std::string& path, size_t attempt) const {
+        uint64_t x = m_faults.seed ^ (attempt * 0x9e3779b97f4a7c15ull);
+        for (unsigned char c : path) {
+            x = (x ^ c) * 0x100000001b3ull;
+        }
+        // splitmix64 finaliser
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27; x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        double u = static_cast<double>(x >> 11) / static_cast<double>(1ull << 53);
+
+        if ((u -= m_faults.resetRate) < 0) return Fault::Reset;
+        if ((u -= m_faults.serverErrorRate) < 0) return Fault::ServerError;
+        if ((u -= m_faults.truncateRate) < 0) return Fault::Truncate;
+        if ((u -= m_faults.corruptRate) < 0) return Fault::Corrupt;
+        return Fault::None;
+    }
+
+    /**
+     * One keep-alive connection
+     */
+    class Session : public std::enable_shared_from_this<Session> {
+    public:
+        Session(asio::ip::tcp::socket socket, AssetServer& server)
+            : m_socket(std::move(socket)), m_server(server), m_timer(m_socket.get_executor()) {}
+
+        void start() {
+            asio::error_code ec;
+            m_socket.set_option(asio::ip::tcp::no_delay(true), ec);
+            readRequest();
+        }
+
+    private:
+        void readRequest() {
+            auto self = shared_from_this();
+            asio::async_read_until(m_socket, m_buffer, "\r\n\r\n",
+                [this, self](asio::error_code ec, size_t headerSize) {
+                    if (ec) return;
+
+                    std::string head(asio::buffers_begin(m_buffer.data()),
+                                     asio::buffers_begin(m_buffer.data()) + headerSize);
+                    m_buffer.consume(headerSize);
+                    ++m_server.m_requests;
+
+                    // GET only: no request bodies to skip
+                    size_t start = head.find(' ');
+                    size_t end = head.find_first_of(" ?", start + 1);
+                    std::string path = start == std::string::npos ? "" : head.substr(start + 1, end - start - 1);
+
+                    auto it = m_server.m_objects.find(path);
+                    if (it == m_server.m_objects.end()) {
+                        ++m_server.m_notFound;
+                        m_object = nullptr;
+                        m_fault = Fault::None;
+                    } else {
+                        m_object = &it->second;
+                        m_fault = m_server.decide(path, it->second.requests.fetch_add(1));
+                    }
+                    delayResponse();
+                });
+        }
+
+        void delayResponse() {
+            if (m_server.m_faults.latency.count() <= 0) {
+                respond();
+                return;
+            }
+            auto self = shared_from_this();
+            m_timer.expires_after(m_server.m_faults.latency);
+            m_timer.async_wait([this, self](asio::error_code ec) {
+                if (!ec) respond();
+            });
+        }
+
+        void respond() {
+            if (!m_object) {
+                sendSmall(404, "Not Found");
+                return;
+            }
+
+            switch (m_fault) {
+            case Fault::Reset: {
+                ++m_server.m_resets;
+                asio::error_code ec;
+                m_socket.set_option(asio::socket_base::linger(true, 0), ec);
+                m_socket.close(ec);
+                return;
+            }
+            case Fault::ServerError:
+                ++m_server.m_serverErrors;
+                sendSmall(503, "Service Unavailable");
+                return;
+            case Fault::Corrupt:
+                ++m_server.m_corrupted;
+                m_corruptCopy = m_object->body;
+                if (!m_corruptCopy.empty()) {
+                    m_corruptCopy[m_corruptCopy.size() / 2] ^= 0x5a;
+                }
+                break;
+            case Fault::Truncate:
+                ++m_server.m_truncated;
+                break;
+            case Fault::None:
+                break;
+            }
+
+            const std::string& body = m_fault == Fault::Corrupt ? m_corruptCopy : m_object->body;
+            m_header = "HTTP/1.1 200 OK\r\n"
+                       "Content-Type: application/octet-stream\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: keep-alive\r\n\r\n";
+            m_body = body.data();
+            m_bodyEnd = m_fault == Fault::Truncate ? body.size() / 2 : body.size();
+            sendBody();
+        }
+
+        void sendSmall(int status, const char* reason) {
+            m_header = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n"
+                       "Content-Type: text/plain\r\n"
+                       "Content-Length: " + std::to_string(std::char_traits<char>::length(reason)) + "\r\n"
+                       "Connection: keep-alive\r\n\r\n" + reason;
+            auto self = shared_from_this();
+            asio::async_write(m_socket, asio::buffer(m_header),
+                [this, self](asio::error_code ec, size_t written) {
+                    m_server.m_bytesSent += written;
+                    if (!ec) readRequest();
+                });
+        }
+
+        void sendBody() {
+            auto self = shared_from_this();
+            size_t bandwidth = m_server.m_faults.bandwidth;
+            if (bandwidth == 0) {
+                std::array<asio::const_buffer, 2> buffers{asio::buffer(m_header), asio::buffer(m_body, m_bodyEnd)};
+                asio::async_write(m_socket, buffers, [this, self](asio::error_code ec, size_t written) {
+                    m_server.m_bytesSent += written;
+                    if (!ec) finish();
+                });
+                return;
+            }
+
+            asio::async_write(m_socket, asio::buffer(m_header), [this, self](asio::error_code ec, size_t written) {
+                m_server.m_bytesSent += written;
+                if (!ec) sendChunk(0);
+            });
+        }
+
+        /**
+         * Bandwidth-capped body: one slice per tick
+         */
+        void sendChunk(size_t offset) {
+            static constexpr auto kTick = std::chrono::milliseconds(20);
+            size_t slice = std::max<size_t>(m_server.m_faults.bandwidth * kTick.count() / 1000, 1);
+            size_t count = std::min(slice, m_bodyEnd - offset);
+
+            auto self = shared_from_this();
+            asio::async_write(m_socket, asio::buffer(m_body + offset, count),
+                [this, self, offset, count](asio::error_code ec, size_t written) {
+                    m_server.m_bytesSent += written;
+                    if (ec) return;
+                    if (offset + count >= m_bodyEnd) {
+                        finish();
+                        return;
+                    }
+                    m_timer.expires_after(kTick);
+                    m_timer.async_wait([this, self, next = offset + count](asio::error_code ec) {
+                        if (!ec) sendChunk(next);
+                    });
+                });
+        }
+
+        void finish() {
+            if (m_fault == Fault::Truncate) {
+                asio::error_code ec;
+                m_socket.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+                m_socket.close(ec);
+                return;
+            }
+            readRequest();
+        }
+
+        asio::ip::tcp::socket m_socket;
+        AssetServer& m_server;
+        asio::steady_timer m_timer;
+        asio::streambuf m_buffer;
+
+        Object* m_object{nullptr};
+        Fault m_fault{Fault::None};
+        std::string m_header;
+        std::string m_corruptCopy;
+        const char* m_body{nullptr};
+        size_t m_bodyEnd{0};
+    };
+
+    void accept() {
+        m_acceptor.async_accept([this](asio::error_code ec, asio::ip::tcp::socket socket) {
+            if (ec) return;
+            ++m_connections;
+            std::make_shared<Session>(std::move(socket), *this)->start();
+            accept();
+        });
+    }
+
+private:
+    Faults m_faults;
+    size_t m_threadCount;
+    asio::io_context m_io;
+    asio::ip::tcp::acceptor m_acceptor;
+    std::unordered_map<std::string, Object> m_objects;  // Read-only once started
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_stopped{false};
+
+    std::atomic<size_t> m_connections{0};
+    std::atomic<size_t> m_requests{0};
+    std::atomic<size_t> m_bytesSent{0};
+    std::atomic<size_t> m_resets{0};
+    std::atomic<size_t> m_serverErrors{0};
+    std::atomic<size_t> m_truncated{0};
+    std::atomic<size_t> m_corrupted{0};
+    std::atomic<size_t> m_notFound{0};
+};
+
+} // namespace konami::bench
@@ -0,0 +1,100 @@
+/**
+ * AuthBench.cpp
+ *
+ * Microsoft login latency against a local mock of the OAuth, Xbox Live,
+ * XSTS and Minecraft services, with a per-response delay standing in for
+ * the round trip. MicrosoftAuth's refresh (profile and entitlements
+ * fetched together once the Minecraft token exists) is compared with the
+ * same requests issued one after another.
+ */
+
+#include "LocalHttpServer.hpp"
+#include "core/auth/MicrosoftAuth.hpp"
+#include "utils/HttpClient.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+using konami::bench::LocalHttpServer;
+using konami::core::auth::MicrosoftAuth;
+using konami::utils::HttpClient;
+using konami::utils::HttpOptions;
+
+namespace {
+
+class AuthFixture : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State& state) override {
+        server = std::make_unique<LocalHttpServer>();
+        server->setLatency(std::chrono::milliseconds(state.range(0)));
+
+        const std::string xbox = R"({"Token":"xbl","NotAfter":"2099-01-01T00:00:00Z","DisplayClaims":{"xui":[{"uhs":"1234"}]}})";
+        server->route("/token", R"({"access_token":"ms","refresh_token":"next","token_type":"bearer","expires_in":3600})");
+        server->route("/xbl", xbox);
+        server->route("/xsts", xbox);
+        server->route("/mc", R"({"access_token":"mc","expires_in":86400})");
+        server->route("/profile", R"({"id":"069a79f444e94726a5befca90e38aaf5","name":"Notch","skins":[)"
+                                  R"({"state":"ACTIVE","variant":"CLASSIC","url":")" + server->url("/skin.png") + "\"}]}");
+        server->route("/entitlements", R"({"items":[{"name":"product_minecraft"},{"name":"game_minecraft"}]})");
+        server->route("/skin.png", std::string(4096, 'p'), 200, "image/png");
+
+        endpoints.token = server->url("/token");
+        endpoints.xboxAuth = server->url("/xbl");
+        endpoints.xsts = server->url("/xsts");
+        endpoints.minecraftAuth = server->url("/mc");
+        endpoints.profile = server->url("/profile");
+        endpoints.ownership = server->url("/entitlements");
+    }
+
+    void TearDown(benchmark::State&) override {
+        server.reset();
+    }
+
+    std::unique_ptr<LocalHttpServer> server;
+    MicrosoftAuth::Endpoints endpoints;
+};
+
+BENCHMARK_DEFINE_F(AuthFixture, Refresh_Pipelined)(benchmark::State& state) {
+    MicrosoftAuth auth(endpoints);
+    for (auto _ : state) {
+        auto result = auth.refreshAuthentication("refresh").get();
+        if (!result || !result->ownsGame || result->skinTexture.empty()) {
+            state.SkipWithError(("Refresh failed: " + auth.getLastError()).c_str());
+            return;
+        }
+        benchmark::DoNotOptimize(result->accessToken.data());
+    }
+}
+BENCHMARK_REGISTER_F(AuthFixture, Refresh_Pipelined)
+    ->Arg(0)->Arg(20)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * The same seven requests in the order the chain used to issue them
+ */
+BENCHMARK_DEFINE_F(AuthFixture, Refresh_Serial)(benchmark::State& state) {
+    auto& http = HttpClient::instance();
+    HttpOptions form;
+    form.headers["Content-Type"] = "application/x-www-form-urlencoded";
+    HttpOptions bearer;
+    bearer.headers["Authorization"] = "Bearer mc";
+
+    for (auto _ : state) {
+        bool ok = http.post(endpoints.token, "grant_type=refresh_token&refresh_token=refresh", form).isOk() &&
+                  http.postJson(endpoints.xboxAuth, "{}").isOk() &&
+                  http.postJson(endpoints.xsts, "{}").isOk() &&
+                  http.postJson(endpoints.minecraftAuth, "{}").isOk() &&
+                  http.get(endpoints.ownership, bearer).isOk() &&
+                  http.get(endpoints.profile, bearer).isOk() &&
+                  http.get(server->url("/skin.png")).isOk();
+        if (!ok) {
+            state.SkipWithError("Mock request failed");
+            return;
+        }
+    }
+}
+BENCHMARK_REGISTER_F(AuthFixture, Refresh_Serial)
+    ->Arg(0)->Arg(20)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace
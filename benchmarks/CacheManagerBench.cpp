@@ -0,0 +1,114 @@
+/**
+ * CacheManagerBench.cpp
+ *
+ * Download cache bookkeeping with 10k and 100k indexed entries: lookups,
+ * adding a file while the cache has room, and adding one that forces the
+ * least recently used entry out.
+ */
+
+#include "core/downloader/CacheManager.hpp"
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using konami::core::downloader::CacheManager;
+
+namespace {
+
+constexpr size_t kEntrySize = 1024;
+
+std::string hashFor(uint64_t n) {
+    char hash[41];
+    std::snprintf(hash, sizeof(hash), "%040llx", static_cast<unsigned long long>(n * 0x9e3779b97f4a7c15ull));
+    return hash;
+}
+
+/**
+ * Cache directory whose index lists `entries` objects, plus a 1 KiB file to add
+ */
+struct Fixture {
+    fs::path root;
+    fs::path cache;
+    fs::path source;
+    std::vector<std::string> hashes;
+
+    explicit Fixture(size_t entries) {
+        root = fs::temp_directory_path() / "konami_cache_bench";
+        fs::remove_all(root);
+        cache = root / "cache";
+        fs::create_directories(cache);
+
+        nlohmann::json index = nlohmann::json::object();
+        for (size_t i = 0; i < entries; ++i) {
+            hashes.push_back(hashFor(i));
+            index[hashes.back()] = {{"originalPath", "assets/objects/" + hashes.back()},
+                                    {"size", kEntrySize}, {"compressed", false}, {"accessCount", 1}};
+        }
+        std::ofstream(cache / "index.json") << index.dump();
+
+        source = root / "source.bin";
+        std::ofstream(source, std::ios::binary) << std::string(kEntrySize, 'x');
+    }
+
+    ~Fixture() {
+        std::error_code ec;
+        fs::remove_all(root, ec);
+    }
+};
+
+void BM_CacheManager_Has(benchmark::State& state) {
+    Fixture fixture(static_cast<size_t>(state.range(0)));
+    CacheManager cache;
+    cache.initialize(fixture.cache.string());
+
+    std::mt19937 rng(7);
+    size_t hits = 0;
+    for (auto _ : state) {
+        // Half hits, half misses
+        uint64_t n = rng() % (fixture.hashes.size() * 2);
+        hits += cache.has(n < fixture.hashes.size() ? fixture.hashes[n] : hashFor(n));
+    }
+    benchmark::DoNotOptimize(hits);
+}
+BENCHMARK(BM_CacheManager_Has)->Arg(10'000)->Arg(100'000);
+
+void BM_CacheManager_Add(benchmark::State& state) {
+    Fixture fixture(static_cast<size_t>(state.range(0)));
+    CacheManager cache;
+    cache.initialize(fixture.cache.string());
+
+    uint64_t next = fixture.hashes.size();
+    for (auto _ : state) {
+        std::string hash = hashFor(next++);
+        cache.add(fixture.source.string(), hash);
+
+        state.PauseTiming();
+        cache.remove(hash);
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_CacheManager_Add)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+void BM_CacheManager_AddEvicting(benchmark::State& state) {
+    Fixture fixture(static_cast<size_t>(state.range(0)));
+    CacheManager cache;
+    cache.initialize(fixture.cache.string(), fixture.hashes.size() * kEntrySize);
+
+    // Full cache: every add evicts the least recently used entry
+    uint64_t next = fixture.hashes.size();
+    for (auto _ : state) {
+        cache.add(fixture.source.string(), hashFor(next++));
+    }
+    state.counters["entries"] = static_cast<double>(cache.getEntryCount());
+}
+BENCHMARK(BM_CacheManager_AddEvicting)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,188 @@
+/**
+ * CodecBench.cpp
+ *
+ * Base64 and hex throughput: the vector kernels against the scalar
+ * reference and the stream / bit-accumulator code they replaced. The
+ * fixtures first check that every path produces the same bytes on random
+ * input and fail the run otherwise.
+ */
+
+#include "utils/Codec.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using konami::utils::Codec;
+
+namespace {
+
+std::string randomBytes(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::string data(size, '\0');
+    for (auto& c : data) c = static_cast<char>(rng());
+    return data;
+}
+
+/**
+ * The previous StringUtils encoder: one push_back per character
+ */
+std::string accumulatorBase64(const std::string& data) {
+    static const char chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    int val = 0, valb = -6;
+    for (unsigned char c : data) {
+        val = (val << 8) + c;
+        valb += 8;
+        while (valb >= 0) {
+            result.push_back(chars[(val >> valb) & 0x3F]);
+            valb -= 6;
+        }
+    }
+    if (valb > -6) result.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
+    while (result.size() % 4) result.push_back('=');
+    return result;
+}
+
+/**
+ * The previous HashUtils formatting
+ */
+std::string streamHex(const std::string& data) {
+    std::ostringstream oss;
+    for (unsigned char b : data) oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(b);
+    return oss.str();
+}
+
+/**
+ * Compare the vector and scalar paths on random lengths and alphabets
+ * @return Empty on success, otherwise what differed
+ */
+std::string crossCheck() {
+    std::mt19937 rng(87);
+    for (int i = 0; i < 2000; ++i) {
+        std::string data = randomBytes(rng() % 300, rng());
+        auto alphabet = (i & 1) ? Codec::Base64Alphabet::UrlSafe : Codec::Base64Alphabet::Standard;
+        bool padding = (i & 2) != 0;
+
+        std::string encoded(Codec::base64EncodedSize(data.size(), padding), '\0');
+        std::string reference = encoded;
+        Codec::base64Encode(data.data(), data.size(), encoded.data(), alphabet, padding);
+        Codec::Scalar::base64Encode(data.data(), data.size(), reference.data(), alphabet, padding);
+        if (encoded != reference) return "base64 encode mismatch";
+        if (alphabet == Codec::Base64Alphabet::Standard && padding && encoded != accumulatorBase64(data)) {
+            return "base64 differs from the previous encoder";
+        }
+        if (Codec::base64Decode(encoded, alphabet) != data) return "base64 round trip failed";
+
+        std::string hex = Codec::hexEncode(data);
+        if (hex != streamHex(data)) return "hex encode mismatch";
+        if (Codec::hexDecode(hex) != data) return "hex round trip failed";
+    }
+    return {};
+}
+
+class CodecFixture : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State& state) override {
+        std::string error = crossCheck();
+        if (!error.empty()) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+        data = randomBytes(static_cast<size_t>(state.range(0)), 1);
+        base64 = Codec::base64Encode(data);
+        hex = Codec::hexEncode(data);
+        buffer.resize(Codec::base64EncodedSize(data.size()) + Codec::hexEncodedSize(data.size()));
+    }
+
+    std::string data;
+    std::string base64;
+    std::string hex;
+    std::vector<char> buffer;
+};
+
+#define CODEC_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(CodecFixture, name)->Arg(32)->Arg(1024)->Arg(1 << 20)
+
+BENCHMARK_DEFINE_F(CodecFixture, Base64Encode_Simd)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Codec::base64Encode(data.data(), data.size(), buffer.data()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(Base64Encode_Simd);
+
+BENCHMARK_DEFINE_F(CodecFixture, Base64Encode_Scalar)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Codec::Scalar::base64Encode(
+            data.data(), data.size(), buffer.data(), Codec::Base64Alphabet::Standard, true));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(Base64Encode_Scalar);
+
+BENCHMARK_DEFINE_F(CodecFixture, Base64Encode_Previous)(benchmark::State& state) {
+    for (auto _ : state) benchmark::DoNotOptimize(accumulatorBase64(data));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(Base64Encode_Previous);
+
+BENCHMARK_DEFINE_F(CodecFixture, Base64Decode_Simd)(benchmark::State& state) {
+    auto* out = reinterpret_cast<uint8_t*>(buffer.data());
+    for (auto _ : state) benchmark::DoNotOptimize(Codec::base64Decode(base64, out));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(Base64Decode_Simd);
+
+BENCHMARK_DEFINE_F(CodecFixture, Base64Decode_Scalar)(benchmark::State& state) {
+    auto* out = reinterpret_cast<uint8_t*>(buffer.data());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Codec::Scalar::base64Decode(base64, out, Codec::Base64Alphabet::Standard));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(Base64Decode_Scalar);
+
+BENCHMARK_DEFINE_F(CodecFixture, HexEncode_Simd)(benchmark::State& state) {
+    for (auto _ : state) {
+        Codec::hexEncode(data.data(), data.size(), buffer.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(HexEncode_Simd);
+
+BENCHMARK_DEFINE_F(CodecFixture, HexEncode_Scalar)(benchmark::State& state) {
+    for (auto _ : state) {
+        Codec::Scalar::hexEncode(data.data(), data.size(), buffer.data(), false);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(HexEncode_Scalar);
+
+BENCHMARK_DEFINE_F(CodecFixture, HexEncode_Previous)(benchmark::State& state) {
+    for (auto _ : state) benchmark::DoNotOptimize(streamHex(data));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(HexEncode_Previous);
+
+BENCHMARK_DEFINE_F(CodecFixture, HexDecode_Simd)(benchmark::State& state) {
+    auto* out = reinterpret_cast<uint8_t*>(buffer.data());
+    for (auto _ : state) benchmark::DoNotOptimize(Codec::hexDecode(hex, out));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(HexDecode_Simd);
+
+BENCHMARK_DEFINE_F(CodecFixture, HexDecode_Scalar)(benchmark::State& state) {
+    auto* out = reinterpret_cast<uint8_t*>(buffer.data());
+    for (auto _ : state) benchmark::DoNotOptimize(Codec::Scalar::hexDecode(hex, out));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+CODEC_BENCHMARK(HexDecode_Scalar);
+
+} // namespace
@@ -0,0 +1,52 @@
+/**
+ * ConfigBench.cpp
+ *
+ * Config reads: by dot-notation string, through a pre-compiled ConfigKey,
+ * for a missing key, and from several threads at once.
+ */
+
+#include "core/Config.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+using konami::core::Config;
+using konami::core::ConfigKey;
+
+namespace {
+
+void ensureDefaults() {
+    static const bool ready = [] {
+        Config::instance().setDefaults();
+        return true;
+    }();
+    (void)ready;
+}
+
+void BM_Config_GetString(benchmark::State& state) {
+    ensureDefaults();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Config::instance().get<int>("downloads.maxConcurrent", 4));
+    }
+}
+BENCHMARK(BM_Config_GetString)->Threads(1)->Threads(4);
+
+void BM_Config_GetKey(benchmark::State& state) {
+    ensureDefaults();
+    static const ConfigKey<int> kMaxConcurrent{"downloads.maxConcurrent", 4};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kMaxConcurrent.get());
+    }
+}
+BENCHMARK(BM_Config_GetKey)->Threads(1)->Threads(4);
+
+void BM_Config_GetMissing(benchmark::State& state) {
+    ensureDefaults();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Config::instance().get<std::string>("plugins.unknown.setting", "fallback"));
+    }
+}
+BENCHMARK(BM_Config_GetMissing);
+
+} // namespace
@@ -0,0 +1,104 @@
+/**
+ * DirectoryWalkerBench.cpp
+ *
+ * Size of an instance-shaped tree (many small files across nested
+ * folders): DirectoryWalker at one and all threads against a serial
+ * std::filesystem::recursive_directory_iterator.
+ */
+
+#include "utils/DirectoryWalker.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+using konami::utils::DirectoryWalker;
+
+namespace {
+
+/**
+ * Worlds with region folders plus per-mod config folders, built once per process
+ */
+struct Fixture {
+    fs::path root;
+
+    Fixture() {
+        root = fs::temp_directory_path() / "konami_walker_bench";
+        fs::remove_all(root);
+
+        std::string payload(1024, 'x');
+        auto fill = [&](const fs::path& dir, int files) {
+            fs::create_directories(dir);
+            for (int file = 0; file < files; ++file) {
+                std::ofstream(dir / ("f" + std::to_string(file) + ".dat"), std::ios::binary)
+                    .write(payload.data(), static_cast<std::streamsize>(file % 8 + 1) * 128);
+            }
+        };
+        for (int world = 0; world < 8; ++world) {
+            fs::path save = root / "saves" / ("world" + std::to_string(world));
+            fill(save / "region", 200);
+            fill(save / "data", 50);
+            for (int dim = 0; dim < 4; ++dim) fill(save / ("DIM" + std::to_string(dim)) / "region", 100);
+        }
+        for (int mod = 0; mod < 100; ++mod) {
+            fill(root / "config" / ("mod" + std::to_string(mod)), 10);
+        }
+    }
+
+    ~Fixture() {
+        std::error_code ec;
+        fs::remove_all(root, ec);
+    }
+};
+
+Fixture& fixture() {
+    static Fixture instance;
+    return instance;
+}
+
+void BM_DirectoryWalker_Size(benchmark::State& state) {
+    auto& f = fixture();
+    DirectoryWalker::Options options;
+    options.threads = static_cast<unsigned>(state.range(0));
+    uint64_t files = 0;
+    for (auto _ : state) {
+        auto result = DirectoryWalker::walk(f.root, options);
+        files = result.files;
+        benchmark::DoNotOptimize(result.totalBytes);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * files));
+}
+BENCHMARK(BM_DirectoryWalker_Size)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_DirectoryWalker_Subtrees(benchmark::State& state) {
+    auto& f = fixture();
+    DirectoryWalker::Options options;
+    options.subtreeDepth = 2;
+    for (auto _ : state) {
+        auto result = DirectoryWalker::walk(f.root, options);
+        benchmark::DoNotOptimize(result.subtrees.data());
+    }
+}
+BENCHMARK(BM_DirectoryWalker_Subtrees)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_RecursiveIterator_Size(benchmark::State& state) {
+    auto& f = fixture();
+    uint64_t files = 0;
+    for (auto _ : state) {
+        uint64_t bytes = 0;
+        files = 0;
+        for (const auto& entry : fs::recursive_directory_iterator(f.root)) {
+            if (entry.is_regular_file()) {
+                bytes += entry.file_size();
+                ++files;
+            }
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * files));
+}
+BENCHMARK(BM_RecursiveIterator_Size)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
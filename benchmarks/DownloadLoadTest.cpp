@@ -0,0 +1,305 @@
+/**
+ * DownloadLoadTest.cpp
+ *
+ * Load test for DownloadManager against an in-process AssetServer. Replays
+ * the shape of a real asset index - a few thousand objects, mostly a few KiB
+ * with a long tail up to several MiB - through the real download, retry,
+ * checksum and cache path, with optional latency, bandwidth caps and
+ * injected failures, and reports throughput, completion-time percentiles,
+ * retries and failures.
+ *
+ * Example:
+ *   konami_download_loadtest --objects 4000 --concurrency 16 --latency 20 \
+ *       --reset-rate 0.01 --error-rate 0.02 --truncate-rate 0.01 --corrupt-rate 0.01
+ */
+
+#include "AssetServer.hpp"
+
+#include "core/Config.hpp"
+#include "core/downloader/DownloadManager.hpp"
+#include "utils/FileUtils.hpp"
+#include "utils/HashUtils.hpp"
+
+#include <CLI/CLI.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using konami::bench::AssetServer;
+using konami::core::Config;
+using konami::core::downloader::DownloadManager;
+using konami::core::downloader::DownloadTask;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Object {
+    std::string hash;
+    std::string path;       // Server path, "/ab/ab12..."
+    size_t size{0};
+    Clock::time_point enqueued;
+    Clock::time_point completed;
+    bool success{false};
+};
+
+/**
+ * Object sizes shaped like the vanilla asset index: median ~8 KiB,
+ * log-normal tail clipped to [64 B, 8 MiB]
+ */
+std::vector<size_t> generateSizes(size_t count, std::mt19937_64& rng) {
+    std::lognormal_distribution<double> distribution(std::log(8192.0), 1.6);
+    std::vector<size_t> sizes(count);
+    for (auto& size : sizes) {
+        size = static_cast<size_t>(std::clamp(distribution(rng), 64.0, 8.0 * 1024 * 1024));
+    }
+    return sizes;
+}
+
+std::string generateBody(size_t size, std::mt19937_64& rng) {
+    std::string body(size, '\0');
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word = rng();
+        std::memcpy(body.data() + i, &word, 8);
+    }
+    for (; i < size; ++i) {
+        body[i] = static_cast<char>(rng());
+    }
+    return body;
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+    return values[std::min(index, values.size() - 1)];
+}
+
+std::string formatBytes(double bytes) {
+    char buffer[32];
+    if (bytes >= 1024.0 * 1024.0) {
+        std::snprintf(buffer, sizeof(buffer), "%.1f MiB", bytes / (1024.0 * 1024.0));
+    } else if (bytes >= 1024.0) {
+        std::snprintf(buffer, sizeof(buffer), "%.1f KiB", bytes / 1024.0);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.0f B", bytes);
+    }
+    return buffer;
+}
+
+/**
+ * Point HOME/APPDATA at a scratch directory so config, cache and downloads
+ * never touch the user's launcher data
+ */
+fs::path isolateDataDirectory(const std::string& requested) {
+    fs::path root = requested.empty()
+        ? fs::temp_directory_path() / ("konami-loadtest-" + std::to_string(Clock::now().time_since_epoch().count()))
+        : fs::path(requested);
+    fs::remove_all(root);
+    fs::create_directories(root);
+#ifdef _WIN32
+    _putenv_s("APPDATA", root.string().c_str());
+#else
+    setenv("HOME", root.c_str(), 1);
+#endif
+    return root;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CLI::App app{"DownloadManager load test against a local fault-injecting asset server"};
+
+    size_t objectCount = 4000;
+    int concurrency = 10;
+    int retryCount = 3;
+    int retryDelay = 100;
+    int timeout = 30000;
+    size_t serverThreads = 2;
+    uint64_t seed = 1;
+    std::string dataDirectory;
+    std::string jsonOutput;
+    bool keep = false;
+    AssetServer::Faults faults;
+    int latencyMs = 0;
+
+    app.add_option("-n,--objects", objectCount, "Number of objects in the synthetic index");
+    app.add_option("-c,--concurrency", concurrency, "downloads.maxConcurrent");
+    app.add_option("--retries", retryCount, "downloads.retryCount");
+    app.add_option("--retry-delay", retryDelay, "downloads.retryDelay in ms (multiplied by the attempt)");
+    app.add_option("--timeout", timeout, "downloads.timeout in ms");
+    app.add_option("--server-threads", serverThreads, "Asset server I/O threads");
+    app.add_option("--latency", latencyMs, "Server latency before every response, in ms");
+    app.add_option("--bandwidth", faults.bandwidth, "Per-connection bandwidth cap in bytes/s (0 = unlimited)");
+    app.add_option("--reset-rate", faults.resetRate, "Fraction of requests answered with a connection reset");
+    app.add_option("--error-rate", faults.serverErrorRate, "Fraction of requests answered with 503");
+    app.add_option("--truncate-rate", faults.truncateRate, "Fraction of responses cut off halfway");
+    app.add_option("--corrupt-rate", faults.corruptRate, "Fraction of responses with a corrupted body");
+    app.add_option("--seed", seed, "Seed for object sizes, contents and fault choice");
+    app.add_option("--data-dir", dataDirectory, "Scratch directory (default: a new temp directory)");
+    app.add_option("--json", jsonOutput, "Also write the results to this JSON file");
+    app.add_flag("--keep", keep, "Keep the scratch directory afterwards");
+
+    CLI11_PARSE(app, argc, argv);
+
+    faults.latency = std::chrono::milliseconds(latencyMs);
+    faults.seed = seed;
+
+    fs::path root = isolateDataDirectory(dataDirectory);
+    fs::path objectsDir = root / "objects";
+
+    // Synthetic index
+    std::mt19937_64 rng(seed);
+    auto sizes = generateSizes(objectCount, rng);
+    std::vector<Object> objects(objectCount);
+    AssetServer server(faults, serverThreads);
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < objectCount; ++i) {
+        std::string body = generateBody(sizes[i], rng);
+        objects[i].hash = konami::utils::HashUtils::sha1String(body);
+        objects[i].path = "/" + objects[i].hash.substr(0, 2) + "/" + objects[i].hash;
+        objects[i].size = body.size();
+        totalBytes += body.size();
+        server.add(objects[i].path, std::move(body));
+    }
+    server.start();
+
+    Config::instance().set("downloads.maxConcurrent", concurrency);
+    Config::instance().set("downloads.retryCount", retryCount);
+    Config::instance().set("downloads.retryDelay", retryDelay);
+    Config::instance().set("downloads.timeout", timeout);
+
+    DownloadManager manager;
+    manager.initialize();
+
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t completed = 0;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < objectCount; ++i) {
+        auto& object = objects[i];
+        DownloadTask task(server.url(object.path),
+                          (objectsDir / object.hash.substr(0, 2) / object.hash).string(),
+                          object.hash);
+        task.expectedSize = object.size;
+
+        object.enqueued = Clock::now();
+        manager.addDownload(task, 0, nullptr,
+            [&, i](const std::string&, bool success, const std::string&) {
+                std::lock_guard<std::mutex> lock(mutex);
+                objects[i].completed = Clock::now();
+                objects[i].success = success;
+                if (++completed == objectCount) done.notify_all();
+            });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return completed == objectCount; });
+    }
+    manager.waitForAll();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    manager.shutdown();
+    server.stop();
+
+    // Results
+    std::vector<double> completionMs;
+    std::vector<double> objectSizes;
+    size_t failed = 0;
+    size_t retriedObjects = 0;
+    size_t retries = 0;
+    size_t maxRequests = 0;
+    size_t deliveredBytes = 0;
+    for (const auto& object : objects) {
+        completionMs.push_back(std::chrono::duration<double, std::milli>(object.completed - object.enqueued).count());
+        objectSizes.push_back(static_cast<double>(object.size));
+        if (object.success) {
+            deliveredBytes += object.size;
+        } else {
+            ++failed;
+        }
+        size_t requests = server.requestCount(object.path);
+        if (requests > 1) {
+            ++retriedObjects;
+            retries += requests - 1;
+        }
+        maxRequests = std::max(maxRequests, requests);
+    }
+    auto stats = server.stats();
+
+    std::printf("objects       %zu (%s, median %s, max %s)\n", objectCount,
+                formatBytes(static_cast<double>(totalBytes)).c_str(),
+                formatBytes(percentile(objectSizes, 0.5)).c_str(),
+                formatBytes(percentile(objectSizes, 1.0)).c_str());
+    std::printf("settings      concurrency %d, retries %d, retry delay %d ms, latency %d ms, bandwidth %s\n",
+                concurrency, retryCount, retryDelay, latencyMs,
+                faults.bandwidth ? (formatBytes(static_cast<double>(faults.bandwidth)) + "/s").c_str() : "unlimited");
+    std::printf("wall time     %.2f s\n", seconds);
+    std::printf("throughput    %s/s, %.0f objects/s\n",
+                formatBytes(static_cast<double>(deliveredBytes) / seconds).c_str(),
+                static_cast<double>(objectCount - failed) / seconds);
+    std::printf("completion    p50 %.0f ms, p90 %.0f ms, p99 %.0f ms, max %.0f ms (since enqueue)\n",
+                percentile(completionMs, 0.5), percentile(completionMs, 0.9),
+                percentile(completionMs, 0.99), percentile(completionMs, 1.0));
+    std::printf("requests      %zu over %zu connections, %s sent\n", stats.requests, stats.connections,
+                formatBytes(static_cast<double>(stats.bytesSent)).c_str());
+    std::printf("retries       %zu (%zu objects retried, at most %zu requests for one object)\n",
+                retries, retriedObjects, maxRequests);
+    std::printf("faults        %zu resets, %zu 5xx, %zu truncated, %zu corrupted\n",
+                stats.resets, stats.serverErrors, stats.truncated, stats.corrupted);
+    std::printf("failed        %zu\n", failed);
+
+    if (!jsonOutput.empty()) {
+        nlohmann::json result = {
+            {"objects", objectCount},
+            {"totalBytes", totalBytes},
+            {"concurrency", concurrency},
+            {"latencyMs", latencyMs},
+            {"bandwidth", faults.bandwidth},
+            {"seed", seed},
+            {"seconds", seconds},
+            {"bytesPerSecond", static_cast<double>(deliveredBytes) / seconds},
+            {"completionMs", {
+                {"p50", percentile(completionMs, 0.5)},
+                {"p90", percentile(completionMs, 0.9)},
+                {"p99", percentile(completionMs, 0.99)},
+                {"max", percentile(completionMs, 1.0)},
+            }},
+            {"requests", stats.requests},
+            {"connections", stats.connections},
+            {"retries", retries},
+            {"retriedObjects", retriedObjects},
+            {"faults", {
+                {"resets", stats.resets},
+                {"serverErrors", stats.serverErrors},
+                {"truncated", stats.truncated},
+                {"corrupted", stats.corrupted},
+            }},
+            {"failed", failed},
+        };
+        if (!konami::utils::FileUtils::writeFileAtomic(jsonOutput, result.dump(2))) {
+            std::fprintf(stderr, "Failed to write %s\n", jsonOutput.c_str());
+        }
+    }
+
+    if (!keep && dataDirectory.empty()) {
+        std::error_code ec;
+        fs::remove_all(root, ec);
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+/**
+ * EventBusBench.cpp
+ *
+ * EventBus::emit cost by subscriber count, for an event nobody listens to,
+ * and with the progress-style payload the downloader emits.
+ */
+
+#include "core/EventBus.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using konami::core::EventBus;
+
+namespace {
+
+void BM_EventBus_Emit(benchmark::State& state) {
+    auto& bus = EventBus::instance();
+    bus.clear();
+
+    size_t received = 0;
+    std::vector<konami::core::SubscriptionPtr> subscriptions;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        subscriptions.push_back(bus.subscribe("bench.event", [&received](const auto&) { ++received; }));
+    }
+
+    for (auto _ : state) {
+        bus.emit("bench.event");
+    }
+    benchmark::DoNotOptimize(received);
+    bus.clear();
+}
+BENCHMARK(BM_EventBus_Emit)->Arg(0)->Arg(1)->Arg(8)->Arg(64);
+
+void BM_EventBus_EmitWithPayload(benchmark::State& state) {
+    auto& bus = EventBus::instance();
+    bus.clear();
+
+    double last = 0;
+    auto subscription = bus.subscribe("download.progress", [&last](const auto& data) {
+        last = data.value("progress", 0.0);
+    });
+
+    const std::string file = "assets/objects/ab/ab34cd56ef7890123456789abcdef0123456789a";
+    for (auto _ : state) {
+        bus.emit("download.progress", {{"file", file}, {"downloaded", 524288}, {"total", 1048576}, {"progress", 0.5}});
+    }
+    benchmark::DoNotOptimize(last);
+    bus.clear();
+}
+BENCHMARK(BM_EventBus_EmitWithPayload);
+
+} // namespace
@@ -0,0 +1,142 @@
+/**
+ * FileCopyBench.cpp
+ *
+ * Copy throughput: FileCopier against std::filesystem::copy_file / copy
+ * (the previous behaviour) and a plain stream copy, for one large file
+ * and for an instance-shaped tree of many small files.
+ */
+
+#include "utils/FileCopier.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+using konami::utils::FileCopier;
+
+namespace {
+
+constexpr size_t kLargeFileSize = 64 * 1024 * 1024;
+
+/**
+ * One large random file plus a tree of small configs and medium blobs,
+ * built once per process
+ */
+struct Fixture {
+    fs::path root;
+    fs::path largeFile;
+    fs::path tree;
+    uint64_t treeBytes{0};
+
+    Fixture() {
+        root = fs::temp_directory_path() / "konami_copy_bench";
+        fs::remove_all(root);
+        tree = root / "tree";
+        largeFile = root / "large.bin";
+        fs::create_directories(root);
+
+        std::mt19937 rng(7);
+        std::string blob(kLargeFileSize, '\0');
+        for (auto& c : blob) c = static_cast<char>(rng());
+        std::ofstream(largeFile, std::ios::binary).write(blob.data(), static_cast<std::streamsize>(blob.size()));
+
+        for (int mod = 0; mod < 40; ++mod) {
+            fs::path config = tree / "config" / ("mod" + std::to_string(mod));
+            fs::create_directories(config);
+            for (int file = 0; file < 25; ++file) {
+                std::ofstream out(config / ("options" + std::to_string(file) + ".toml"));
+                for (int line = 0; line < 40; ++line) out << "key_" << line << " = " << rng() % 1000 << "\n";
+            }
+        }
+        fs::create_directories(tree / "mods");
+        for (int jar = 0; jar < 32; ++jar) {
+            std::ofstream(tree / "mods" / ("mod" + std::to_string(jar) + ".jar"), std::ios::binary)
+                .write(blob.data() + jar * 512 * 1024, 512 * 1024);
+        }
+        for (const auto& entry : fs::recursive_directory_iterator(tree)) {
+            if (entry.is_regular_file()) treeBytes += entry.file_size();
+        }
+    }
+
+    ~Fixture() {
+        std::error_code ec;
+        fs::remove_all(root, ec);
+    }
+};
+
+Fixture& fixture() {
+    static Fixture instance;
+    return instance;
+}
+
+void BM_FileCopier_CopyFile(benchmark::State& state) {
+    auto& f = fixture();
+    fs::path out = f.root / "copy.bin";
+    for (auto _ : state) {
+        std::string error;
+        if (!FileCopier::copyFile(f.largeFile, out, true, true, &error)) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kLargeFileSize));
+}
+BENCHMARK(BM_FileCopier_CopyFile)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_StdCopyFile(benchmark::State& state) {
+    auto& f = fixture();
+    fs::path out = f.root / "copy_std.bin";
+    for (auto _ : state) {
+        fs::copy_file(f.largeFile, out, fs::copy_options::overwrite_existing);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kLargeFileSize));
+}
+BENCHMARK(BM_StdCopyFile)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_StreamCopyFile(benchmark::State& state) {
+    auto& f = fixture();
+    fs::path out = f.root / "copy_stream.bin";
+    for (auto _ : state) {
+        std::ifstream in(f.largeFile, std::ios::binary);
+        std::ofstream(out, std::ios::binary) << in.rdbuf();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kLargeFileSize));
+}
+BENCHMARK(BM_StreamCopyFile)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_FileCopier_CopyDirectory(benchmark::State& state) {
+    auto& f = fixture();
+    fs::path out = f.root / "tree_copy";
+    FileCopier::Options options;
+    options.threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        fs::remove_all(out);
+        state.ResumeTiming();
+        auto result = FileCopier::copyDirectory(f.tree, out, options);
+        if (!result.ok()) {
+            state.SkipWithError(result.firstError.c_str());
+            return;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * f.treeBytes));
+}
+BENCHMARK(BM_FileCopier_CopyDirectory)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_StdCopyRecursive(benchmark::State& state) {
+    auto& f = fixture();
+    fs::path out = f.root / "tree_copy_std";
+    for (auto _ : state) {
+        state.PauseTiming();
+        fs::remove_all(out);
+        state.ResumeTiming();
+        fs::copy(f.tree, out, fs::copy_options::recursive);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * f.treeBytes));
+}
+BENCHMARK(BM_StdCopyRecursive)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
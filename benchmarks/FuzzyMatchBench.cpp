@@ -0,0 +1,102 @@
+/**
+ * FuzzyMatchBench.cpp
+ *
+ * Suggestion lookup over a large list of version ids and mod names: the
+ * previous full-matrix Levenshtein against the bounded Myers distance and
+ * the batched FuzzyMatcher.
+ */
+
+#include "utils/StringUtils.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using konami::utils::FuzzyMatcher;
+
+namespace {
+
+/**
+ * The matcher this replaced: one (m+1)x(n+1) matrix per candidate
+ */
+int matrixDistance(const std::string& s1, const std::string& s2) {
+    size_t m = s1.size(), n = s2.size();
+    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1));
+    for (size_t i = 0; i <= m; ++i) dp[i][0] = static_cast<int>(i);
+    for (size_t j = 0; j <= n; ++j) dp[0][j] = static_cast<int>(j);
+    for (size_t i = 1; i <= m; ++i) {
+        for (size_t j = 1; j <= n; ++j) {
+            int cost = (s1[i-1] == s2[j-1]) ? 0 : 1;
+            dp[i][j] = std::min({dp[i-1][j]+1, dp[i][j-1]+1, dp[i-1][j-1]+cost});
+        }
+    }
+    return dp[m][n];
+}
+
+/**
+ * 30k names shaped like manifest ids and mod slugs
+ */
+const std::vector<std::string>& candidates() {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> result;
+        std::mt19937 rng(3);
+        const char* words[] = {"fabric", "api", "sodium", "iris", "create", "forge", "lithium",
+                               "journey", "map", "tweaks", "core", "lib", "extra", "utilities"};
+        for (int i = 0; i < 15000; ++i) {
+            result.push_back(std::string(words[rng() % 14]) + "-" + words[rng() % 14] + "-" + std::to_string(rng() % 100));
+            result.push_back("1." + std::to_string(rng() % 21) + "." + std::to_string(rng() % 6) +
+                             (rng() % 3 == 0 ? "-pre" + std::to_string(rng() % 5) : ""));
+        }
+        return result;
+    }();
+    return names;
+}
+
+void BM_MatrixLevenshtein_Scan(benchmark::State& state) {
+    const auto& names = candidates();
+    const std::string query = "sodium-extra-12";
+    for (auto _ : state) {
+        int best = 4;
+        for (const auto& name : names) best = std::min(best, matrixDistance(query, name));
+        benchmark::DoNotOptimize(best);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * names.size()));
+}
+BENCHMARK(BM_MatrixLevenshtein_Scan)->Unit(benchmark::kMillisecond);
+
+void BM_BoundedLevenshtein_Scan(benchmark::State& state) {
+    const auto& names = candidates();
+    const std::string query = "sodium-extra-12";
+    for (auto _ : state) {
+        int best = 4;
+        for (const auto& name : names) best = std::min(best, konami::utils::levenshteinDistance(query, name, 3));
+        benchmark::DoNotOptimize(best);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * names.size()));
+}
+BENCHMARK(BM_BoundedLevenshtein_Scan)->Unit(benchmark::kMillisecond);
+
+void BM_FuzzyMatcher_Matches(benchmark::State& state) {
+    const auto& names = candidates();
+    for (auto _ : state) {
+        auto matches = FuzzyMatcher("sodium-extra-12").matches(names, 3, 10);
+        benchmark::DoNotOptimize(matches.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * names.size()));
+}
+BENCHMARK(BM_FuzzyMatcher_Matches)->Unit(benchmark::kMillisecond);
+
+void BM_FuzzyMatcher_DistancesUnbounded(benchmark::State& state) {
+    const auto& names = candidates();
+    FuzzyMatcher matcher("1.20.4-pre1");
+    for (auto _ : state) {
+        auto scores = matcher.distances(names);
+        benchmark::DoNotOptimize(scores.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * names.size()));
+}
+BENCHMARK(BM_FuzzyMatcher_DistancesUnbounded)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,60 @@
+/**
+ * HashUtilsBench.cpp
+ *
+ * SHA-1 and SHA-256 throughput for in-memory buffers (metadata, small
+ * assets) and for a file the size of a typical library jar.
+ */
+
+#include "utils/HashUtils.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+using konami::utils::HashUtils;
+
+namespace {
+
+std::string randomBytes(size_t size) {
+    std::mt19937 rng(11);
+    std::string data(size, '\0');
+    for (auto& c : data) c = static_cast<char>(rng());
+    return data;
+}
+
+void BM_HashUtils_Sha1String(benchmark::State& state) {
+    std::string data = randomBytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HashUtils::sha1String(data));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashUtils_Sha1String)->Arg(4 << 10)->Arg(1 << 20);
+
+void BM_HashUtils_Sha256String(benchmark::State& state) {
+    std::string data = randomBytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HashUtils::sha256String(data));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashUtils_Sha256String)->Arg(4 << 10)->Arg(1 << 20);
+
+void BM_HashUtils_Sha1File(benchmark::State& state) {
+    constexpr size_t kSize = 8 << 20;
+    auto path = fs::temp_directory_path() / "konami_hash_bench.bin";
+    std::ofstream(path, std::ios::binary) << randomBytes(kSize);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HashUtils::sha1File(path.string()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kSize));
+    fs::remove(path);
+}
+BENCHMARK(BM_HashUtils_Sha1File)->Unit(benchmark::kMillisecond);
+
+} // namespace
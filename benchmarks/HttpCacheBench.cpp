@@ -0,0 +1,101 @@
+/**
+ * HttpCacheBench.cpp
+ *
+ * HttpCache under HttpClient against a local origin: fresh hits and 304
+ * revalidations compared with full fetches. The RFC 9111 behaviour checks
+ * live in tests/HttpCacheTests.cpp.
+ */
+
+#include "LocalHttpServer.hpp"
+#include "utils/HttpCache.hpp"
+#include "utils/HttpClient.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+using konami::bench::LocalHttpServer;
+using konami::utils::HttpCache;
+using konami::utils::HttpClient;
+
+namespace {
+
+constexpr int kRequestsPerIteration = 1000;
+const std::string kPlainBody(4096, 'k');
+
+LocalHttpServer& origin() {
+    static LocalHttpServer instance;
+    static const bool routed = [] {
+        instance.handle("/bench", [](const std::string&) {
+            return LocalHttpServer::response(200, kPlainBody, {{"Cache-Control", "max-age=3600"}});
+        });
+        instance.handle("/bench-etag", [](const std::string& head) {
+            if (!LocalHttpServer::requestHeader(head, "if-none-match").empty()) {
+                return LocalHttpServer::response(304, "", {{"ETag", "\"b1\""}});
+            }
+            return LocalHttpServer::response(200, kPlainBody, {{"Cache-Control", "no-cache"}, {"ETag", "\"b1\""}});
+        });
+        return true;
+    }();
+    (void)routed;
+    return instance;
+}
+
+/**
+ * Attach a cache to the shared HttpClient for one scope
+ */
+class CacheScope {
+public:
+    explicit CacheScope(std::shared_ptr<HttpCache> cache) : m_cache(std::move(cache)) {
+        HttpClient::instance().setCache(m_cache);
+    }
+    ~CacheScope() { HttpClient::instance().setCache(nullptr); }
+
+private:
+    std::shared_ptr<HttpCache> m_cache;
+};
+
+/**
+ * Sequential GETs of one 4 KiB resource
+ * @param path Origin route
+ * @param cached Attach a memory cache
+ */
+void runSequentialGets(benchmark::State& state, const std::string& path, bool cached) {
+    const std::string url = origin().url(path);
+    std::unique_ptr<CacheScope> scope;
+    if (cached) {
+        scope = std::make_unique<CacheScope>(std::make_shared<HttpCache>());
+    }
+    auto& client = HttpClient::instance();
+
+    for (auto _ : state) {
+        for (int i = 0; i < kRequestsPerIteration; ++i) {
+            auto response = client.get(url);
+            if (!response.isSuccess()) {
+                state.SkipWithError(response.error.empty() ? "request failed" : response.error.c_str());
+                return;
+            }
+            benchmark::DoNotOptimize(response.body.data());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kRequestsPerIteration);
+}
+
+void BM_HttpCache_Uncached(benchmark::State& state) {
+    runSequentialGets(state, "/bench", false);
+}
+BENCHMARK(BM_HttpCache_Uncached)->Unit(benchmark::kMillisecond);
+
+void BM_HttpCache_FreshHits(benchmark::State& state) {
+    runSequentialGets(state, "/bench", true);
+}
+BENCHMARK(BM_HttpCache_FreshHits)->Unit(benchmark::kMillisecond);
+
+void BM_HttpCache_Revalidations(benchmark::State& state) {
+    runSequentialGets(state, "/bench-etag", true);
+}
+BENCHMARK(BM_HttpCache_Revalidations)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,71 @@
+/**
+ * HttpClientBench.cpp
+ *
+ * Sequential small GETs against a local keep-alive server: pooled
+ * HttpClient versus a fresh curl easy handle per request.
+ */
+
+#include "LocalHttpServer.hpp"
+#include "utils/HttpClient.hpp"
+
+#include <benchmark/benchmark.h>
+#include <curl/curl.h>
+
+using konami::bench::LocalHttpServer;
+using konami::utils::HttpClient;
+
+namespace {
+
+constexpr int kRequestsPerIteration = 1000;
+
+size_t discardBody(void*, size_t size, size_t nmemb, void*) {
+    return size * nmemb;
+}
+
+LocalHttpServer& server() {
+    static LocalHttpServer instance("{\"status\":\"ok\"}");
+    return instance;
+}
+
+void BM_HttpClient_SequentialGets(benchmark::State& state) {
+    const std::string url = server().url("/small");
+    auto& client = HttpClient::instance();
+
+    for (auto _ : state) {
+        for (int i = 0; i < kRequestsPerIteration; ++i) {
+            auto response = client.get(url);
+            if (!response.isSuccess()) {
+                state.SkipWithError(response.error.c_str());
+                return;
+            }
+            benchmark::DoNotOptimize(response.body.data());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kRequestsPerIteration);
+}
+BENCHMARK(BM_HttpClient_SequentialGets)->Unit(benchmark::kMillisecond);
+
+void BM_FreshCurlHandle_SequentialGets(benchmark::State& state) {
+    const std::string url = server().url("/small");
+
+    for (auto _ : state) {
+        for (int i = 0; i < kRequestsPerIteration; ++i) {
+            CURL* curl = curl_easy_init();
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discardBody);
+            CURLcode res = curl_easy_perform(curl);
+            curl_easy_cleanup(curl);
+            if (res != CURLE_OK) {
+                state.SkipWithError(curl_easy_strerror(res));
+                return;
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kRequestsPerIteration);
+}
+BENCHMARK(BM_FreshCurlHandle_SequentialGets)->Unit(benchmark::kMillisecond);
+
+} // namespace
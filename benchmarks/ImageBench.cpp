@@ -0,0 +1,97 @@
+/**
+ * ImageBench.cpp
+ *
+ * Getting a mod icon ready for display: decoding the downloaded PNG at
+ * full size (what handing the file to slint::Image does on the UI thread),
+ * decoding and downscaling to a 48 px thumbnail (ImageLoader's worker
+ * path), and reading that thumbnail back from the disk cache.
+ */
+
+#include "utils/Thumbnail.hpp"
+
+#include <benchmark/benchmark.h>
+#include <stb_image.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using konami::utils::Thumbnail;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * Smooth gradient with a soft round mask, like a typical mod icon
+ */
+std::string iconPng(int size) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            uint8_t* p = &pixels[(static_cast<size_t>(y) * size + x) * 4];
+            double dx = x - size / 2.0, dy = y - size / 2.0;
+            double edge = std::clamp(size / 2.0 - std::sqrt(dx * dx + dy * dy), 0.0, 1.0);
+            p[0] = static_cast<uint8_t>(x * 255 / size);
+            p[1] = static_cast<uint8_t>(y * 255 / size);
+            p[2] = static_cast<uint8_t>((x ^ y) & 0xff);
+            p[3] = static_cast<uint8_t>(edge * 255);
+        }
+    }
+
+    std::string png;
+    stbi_write_png_to_func(
+        [](void* context, void* data, int length) {
+            static_cast<std::string*>(context)->append(static_cast<const char*>(data), static_cast<size_t>(length));
+        },
+        &png, size, size, 4, pixels.data(), size * 4);
+    return png;
+}
+
+void BM_DecodeFullSize(benchmark::State& state) {
+    std::string png = iconPng(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        int width = 0, height = 0, channels = 0;
+        stbi_uc* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(png.data()),
+                                                static_cast<int>(png.size()), &width, &height, &channels, 4);
+        benchmark::DoNotOptimize(pixels);
+        stbi_image_free(pixels);
+    }
+    state.counters["bytes kept"] = static_cast<double>(state.range(0) * state.range(0) * 4);
+}
+BENCHMARK(BM_DecodeFullSize)->Arg(128)->Arg(512)->Unit(benchmark::kMicrosecond);
+
+void BM_DecodeThumbnail(benchmark::State& state) {
+    std::string png = iconPng(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto thumbnail = Thumbnail::decode(png, 48, 48);
+        benchmark::DoNotOptimize(thumbnail->pixels.data());
+    }
+    state.counters["bytes kept"] = 48.0 * 48.0 * 4.0;
+}
+BENCHMARK(BM_DecodeThumbnail)->Arg(128)->Arg(512)->Unit(benchmark::kMicrosecond);
+
+void BM_ThumbnailFromDisk(benchmark::State& state) {
+    auto path = fs::temp_directory_path() / "konami-bench-icon.thumb";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << Thumbnail::decode(iconPng(512), 48, 48)->serialize();
+    }
+
+    for (auto _ : state) {
+        std::ifstream file(path, std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto thumbnail = Thumbnail::deserialize(data);
+        benchmark::DoNotOptimize(thumbnail->pixels.data());
+    }
+    fs::remove(path);
+}
+BENCHMARK(BM_ThumbnailFromDisk)->Unit(benchmark::kMicrosecond);
+
+} // namespace
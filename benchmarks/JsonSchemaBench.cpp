@@ -0,0 +1,177 @@
+/**
+ * JsonSchemaBench.cpp
+ *
+ * Validating a large version JSON (a modded instance pulls in several
+ * hundred libraries): compiling the schema on every call against a schema
+ * compiled once, the JsonUtils cached path, full error collection, and
+ * deepMerge of a loader profile onto its parent.
+ */
+
+#include "utils/JsonSchema.hpp"
+#include "utils/JsonUtils.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+
+using konami::utils::JsonSchema;
+using konami::utils::JsonUtils;
+using json = nlohmann::json;
+
+namespace {
+
+/**
+ * Same shape as the schema MojangAPI checks fetched version JSONs against
+ */
+const json& versionSchema() {
+    static const json schema = json::parse(R"({
+        "type": "object",
+        "required": ["id"],
+        "properties": {
+            "id": {"type": "string", "minLength": 1},
+            "type": {"type": "string"},
+            "mainClass": {"type": "string"},
+            "javaVersion": {
+                "type": "object",
+                "properties": {"component": {"type": "string"}, "majorVersion": {"type": "integer", "minimum": 1}}
+            },
+            "assetIndex": {"$ref": "#/$defs/download", "required": ["id", "url"]},
+            "downloads": {"type": "object", "additionalProperties": {"$ref": "#/$defs/download"}},
+            "libraries": {"type": "array", "items": {"$ref": "#/$defs/library"}}
+        },
+        "$defs": {
+            "download": {
+                "type": "object",
+                "properties": {
+                    "id": {"type": "string"},
+                    "url": {"type": "string"},
+                    "sha1": {"type": "string", "pattern": "^[0-9a-fA-F]{40}$"},
+                    "size": {"type": "integer", "minimum": 0},
+                    "totalSize": {"type": "integer", "minimum": 0}
+                }
+            },
+            "library": {
+                "type": "object",
+                "required": ["name"],
+                "properties": {
+                    "name": {"type": "string", "pattern": "^[^:]+:[^:]+:[^:]+"},
+                    "downloads": {
+                        "type": "object",
+                        "properties": {
+                            "artifact": {"$ref": "#/$defs/download"},
+                            "classifiers": {"type": "object", "additionalProperties": {"$ref": "#/$defs/download"}}
+                        }
+                    },
+                    "natives": {"type": "object", "additionalProperties": {"type": "string"}},
+                    "rules": {
+                        "type": "array",
+                        "items": {
+                            "type": "object",
+                            "properties": {"os": {"type": "object", "properties": {"name": {"type": "string"}}}}
+                        }
+                    }
+                }
+            }
+        }
+    })");
+    return schema;
+}
+
+std::string sha1(std::mt19937& rng) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hash(40, '0');
+    for (auto& c : hash) c = digits[rng() % 16];
+    return hash;
+}
+
+json download(std::mt19937& rng, const std::string& path) {
+    return {{"path", path}, {"url", "https://libraries.minecraft.net/" + path},
+            {"sha1", sha1(rng)}, {"size", static_cast<int>(rng() % 5000000)}};
+}
+
+json versionJson(size_t libraries) {
+    std::mt19937 rng(88);
+    json version = {
+        {"id", "1.20.4-forge-49.0.30"},
+        {"type", "release"},
+        {"mainClass", "cpw.mods.bootstraplauncher.BootstrapLauncher"},
+        {"javaVersion", {{"component", "java-runtime-gamma"}, {"majorVersion", 17}}},
+        {"assetIndex", {{"id", "12"}, {"url", "https://piston-meta.mojang.com/12.json"},
+                        {"sha1", sha1(rng)}, {"size", 445000}, {"totalSize", 600000000}}},
+        {"downloads", {{"client", download(rng, "client.jar")}, {"server", download(rng, "server.jar")}}},
+        {"libraries", json::array()},
+    };
+    for (size_t i = 0; i < libraries; ++i) {
+        std::string name = "org.example.group" + std::to_string(i % 37) + ":artifact" + std::to_string(i) + ":1." +
+                           std::to_string(i % 9);
+        json library = {{"name", name},
+                        {"downloads", {{"artifact", download(rng, "lib/" + std::to_string(i) + ".jar")}}}};
+        if (i % 5 == 0) {
+            library["natives"] = {{"linux", "natives-linux"}, {"windows", "natives-windows"}, {"osx", "natives-macos"}};
+            library["downloads"]["classifiers"] = {{"natives-linux", download(rng, "n/" + std::to_string(i))},
+                                                   {"natives-windows", download(rng, "w/" + std::to_string(i))}};
+            library["rules"] = json::array({{{"action", "allow"}}, {{"action", "disallow"}, {"os", {{"name", "osx"}}}}});
+        }
+        version["libraries"].push_back(std::move(library));
+    }
+    return version;
+}
+
+class VersionFixture : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State& state) override {
+        document = versionJson(static_cast<size_t>(state.range(0)));
+        std::string error;
+        compiled = JsonSchema::compile(versionSchema(), &error);
+        if (!compiled) {
+            state.SkipWithError(error.c_str());
+        } else if (!compiled->validate(document) || !compiled->errors(document).empty()) {
+            state.SkipWithError("Generated version JSON does not validate");
+        }
+    }
+
+    json document;
+    std::optional<JsonSchema> compiled;
+};
+
+BENCHMARK_DEFINE_F(VersionFixture, CompileEveryCall)(benchmark::State& state) {
+    for (auto _ : state) {
+        auto schema = JsonSchema::compile(versionSchema());
+        benchmark::DoNotOptimize(schema->validate(document));
+    }
+}
+BENCHMARK_REGISTER_F(VersionFixture, CompileEveryCall)->Arg(50)->Arg(400)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(VersionFixture, Compiled)(benchmark::State& state) {
+    for (auto _ : state) benchmark::DoNotOptimize(compiled->validate(document));
+}
+BENCHMARK_REGISTER_F(VersionFixture, Compiled)->Arg(50)->Arg(400)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(VersionFixture, CompiledAllErrors)(benchmark::State& state) {
+    for (auto _ : state) benchmark::DoNotOptimize(compiled->errors(document));
+}
+BENCHMARK_REGISTER_F(VersionFixture, CompiledAllErrors)->Arg(50)->Arg(400)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(VersionFixture, JsonUtilsCached)(benchmark::State& state) {
+    for (auto _ : state) benchmark::DoNotOptimize(JsonUtils::validateSchema(document, versionSchema()));
+}
+BENCHMARK_REGISTER_F(VersionFixture, JsonUtilsCached)->Arg(50)->Arg(400)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(VersionFixture, Parse)(benchmark::State& state) {
+    std::string text = document.dump();
+    for (auto _ : state) benchmark::DoNotOptimize(json::parse(text));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK_REGISTER_F(VersionFixture, Parse)->Arg(50)->Arg(400)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(VersionFixture, DeepMerge)(benchmark::State& state) {
+    json loader = {{"id", "fabric-loader-0.15.6-1.20.4"},
+                   {"mainClass", "net.fabricmc.loader.impl.launch.knot.KnotClient"},
+                   {"javaVersion", {{"majorVersion", 21}}},
+                   {"arguments", {{"jvm", json::array({"-DFabricMcEmu= net.minecraft.client.main.Main "})}}}};
+    for (auto _ : state) benchmark::DoNotOptimize(JsonUtils::deepMerge(document, loader));
+}
+BENCHMARK_REGISTER_F(VersionFixture, DeepMerge)->Arg(400)->Unit(benchmark::kMicrosecond);
+
+} // namespace
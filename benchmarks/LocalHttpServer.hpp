@@ -0,0 +1,315 @@
+#pragma once
+
+/**
+ * LocalHttpServer.hpp
+ *
+ * Minimal in-process HTTP/1.1 server for benchmarks.
+ * Listens on an ephemeral 127.0.0.1 port and answers every request with a
+ * fixed body over keep-alive connections, so client-side costs (handle
+ * setup, connection reuse) dominate the measurement. Per-path routes,
+ * request handlers and an artificial response latency let it stand in for
+ * remote services.
+ */
+
+#include <asio.hpp>
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace konami::bench {
+
+/**
+ * LocalHttpServer - Single-threaded asio server serving a fixed response
+ */
+class LocalHttpServer {
+public:
+    /**
+     * Builds the full raw response (status line, headers and body) for a
+     * request, given its head (request line and headers)
+     */
+    using Handler = std::function<std::string(const std::string& head)>;
+
+    /**
+     * Constructor - starts listening immediately
+     * @param body Response body for every request
+     */
+    explicit LocalHttpServer(std::string body = "ok")
+        : m_acceptor(m_io, asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0)) {
+
+        m_response = makeResponse(200, "text/plain", body);
+
+        accept();
+        m_thread = std::thread([this] { m_io.run(); });
+    }
+
+    /**
+     * Destructor - stops the server
+     */
+    ~LocalHttpServer() {
+        stop();
+    }
+
+    LocalHttpServer(const LocalHttpServer&) = delete;
+    LocalHttpServer& operator=(const LocalHttpServer&) = delete;
+
+    /**
+     * Stop serving and join the I/O thread
+     */
+    void stop() {
+        if (m_stopped.exchange(true)) {
+            return;
+        }
+        m_io.stop();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    /**
+     * Get listening port
+     * @return Port number
+     */
+    uint16_t port() const {
+        return m_acceptor.local_endpoint().port();
+    }
+
+    /**
+     * Build a URL on this server
+     * @param path Request path
+     * @return Absolute URL
+     */
+    std::string url(const std::string& path = "/") const {
+        return "http://127.0.0.1:" + std::to_string(port()) + path;
+    }
+
+    /**
+     * Get number of accepted connections
+     * @return Connection count
+     */
+    size_t connectionCount() const {
+        return m_connections.load();
+    }
+
+    /**
+     * Serve a different response for one path (any method)
+     *
+     * Routes are not locked: set them all before sending requests.
+     * @param path Request path, without query string
+     * @param body Response body
+     * @param status Status code
+     * @param contentType Content-Type header
+     */
+    void route(const std::string& path, const std::string& body, int status = 200,
+               const std::string& contentType = "application/json") {
+        m_routes[path] = makeResponse(status, contentType, body);
+    }
+
+    /**
+     * Answer one path (any method) from a handler, for responses that
+     * depend on the request or change over time
+     *
+     * Handlers run on the server thread; set them before sending requests.
+     * @param path Request path, without query string
+     * @param handler Response builder
+     */
+    void handle(const std::string& path, Handler handler) {
+        m_handlers[path] = std::move(handler);
+    }
+
+    /**
+     * Build a raw response for a handler
+     * @param status Status code
+     * @param body Response body (sent as is; pass encoded bytes with Content-Encoding)
+     * @param headers Extra headers, e.g. {{"Cache-Control", "max-age=60"}}
+     * @return Status line, headers and body
+     */
+    static std::string response(int status, const std::string& body,
+                                const std::vector<std::pair<std::string, std::string>>& headers = {}) {
+        std::string raw = "HTTP/1.1 " + std::to_string(status) + (status < 400 ? " OK" : " Error") + "\r\n";
+        for (const auto& [name, value] : headers) {
+            raw += name + ": " + value + "\r\n";
+        }
+        raw += "Content-Length: " + std::to_string(body.size()) + "\r\n"
+               "Connection: keep-alive\r\n"
+               "\r\n" + body;
+        return raw;
+    }
+
+    /**
+     * Value of a request header
+     * @param head Request head
+     * @param name Header name, lower case
+     * @return Trimmed value, empty if absent
+     */
+    static std::string requestHeader(const std::string& head, const std::string& name) {
+        for (size_t pos = head.find("\r\n"); pos != std::string::npos; pos = head.find("\r\n", pos + 2)) {
+            size_t i = 0;
+            while (i < name.size() && pos + 2 + i < head.size() &&
+                   std::tolower(static_cast<unsigned char>(head[pos + 2 + i])) == name[i]) {
+                ++i;
+            }
+            if (i == name.size() && pos + 2 + i < head.size() && head[pos + 2 + i] == ':') {
+                size_t start = head.find_first_not_of(' ', pos + 3 + i);
+                size_t end = head.find("\r\n", pos + 2);
+                return start < end ? head.substr(start, end - start) : std::string();
+            }
+        }
+        return {};
+    }
+
+    /**
+     * Delay every response, modelling a round trip to a remote host
+     *
+     * Delays run on timers, so concurrent requests overlap as they would
+     * against a real server. Set before sending requests.
+     * @param latency Delay between reading a request and answering it
+     */
+    void setLatency(std::chrono::milliseconds latency) {
+        m_latency = latency;
+    }
+
+private:
+    static std::shared_ptr<const std::string> makeResponse(int status, const std::string& contentType,
+                                                           const std::string& body) {
+        return std::make_shared<const std::string>(
+            "HTTP/1.1 " + std::to_string(status) + (status < 400 ? " OK" : " Error") + "\r\n"
+            "Content-Type: " + contentType + "\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "Connection: keep-alive\r\n"
+            "\r\n" + body
+        );
+    }
+
+    /**
+     * Response for a request line's path
+     */
+    std::shared_ptr<const std::string> responseFor(const std::string& head) const {
+        size_t start = head.find(' ');
+        if (start != std::string::npos && (!m_routes.empty() || !m_handlers.empty())) {
+            size_t end = head.find_first_of(" ?", start + 1);
+            std::string path = head.substr(start + 1, end - start - 1);
+            if (auto handler = m_handlers.find(path); handler != m_handlers.end()) {
+                return std::make_shared<const std::string>(handler->second(head));
+            }
+            auto it = m_routes.find(path);
+            if (it != m_routes.end()) return it->second;
+        }
+        return m_response;
+    }
+
+    /**
+     * One keep-alive connection: read request head (+ body), write response, repeat
+     */
+    class Session : public std::enable_shared_from_this<Session> {
+    public:
+        Session(asio::ip::tcp::socket socket, const LocalHttpServer& server)
+            : m_socket(std::move(socket)), m_server(server), m_timer(m_socket.get_executor()) {}
+
+        void start() {
+            asio::error_code ec;
+            m_socket.set_option(asio::ip::tcp::no_delay(true), ec);
+            readRequest();
+        }
+
+    private:
+        void readRequest() {
+            auto self = shared_from_this();
+            asio::async_read_until(m_socket, m_buffer, "\r\n\r\n",
+                [this, self](asio::error_code ec, size_t headerSize) {
+                    if (ec) return;
+
+                    std::string head(asio::buffers_begin(m_buffer.data()),
+                                     asio::buffers_begin(m_buffer.data()) + headerSize);
+                    m_buffer.consume(headerSize);
+
+                    m_response = m_server.responseFor(head);
+                    size_t contentLength = parseContentLength(head);
+                    if (m_buffer.size() >= contentLength) {
+                        m_buffer.consume(contentLength);
+                        delayResponse();
+                        return;
+                    }
+
+                    asio::async_read(m_socket, m_buffer,
+                        asio::transfer_exactly(contentLength - m_buffer.size()),
+                        [this, self, contentLength](asio::error_code ec, size_t) {
+                            if (ec) return;
+                            m_buffer.consume(contentLength);
+                            delayResponse();
+                        });
+                });
+        }
+
+        void delayResponse() {
+            if (m_server.m_latency.count() <= 0) {
+                writeResponse();
+                return;
+            }
+            auto self = shared_from_this();
+            m_timer.expires_after(m_server.m_latency);
+            m_timer.async_wait([this, self](asio::error_code ec) {
+                if (!ec) writeResponse();
+            });
+        }
+
+        void writeResponse() {
+            auto self = shared_from_this();
+            asio::async_write(m_socket, asio::buffer(*m_response),
+                [this, self](asio::error_code ec, size_t) {
+                    if (!ec) readRequest();
+                });
+        }
+
+        static size_t parseContentLength(const std::string& head) {
+            for (size_t pos = head.find("\r\n"); pos != std::string::npos; pos = head.find("\r\n", pos + 2)) {
+                static const char kHeader[] = "content-length:";
+                size_t i = 0;
+                while (kHeader[i] && pos + 2 + i < head.size() &&
+                       std::tolower(static_cast<unsigned char>(head[pos + 2 + i])) == kHeader[i]) {
+                    ++i;
+                }
+                if (!kHeader[i]) {
+                    return static_cast<size_t>(std::strtoull(head.c_str() + pos + 2 + i, nullptr, 10));
+                }
+            }
+            return 0;
+        }
+
+        asio::ip::tcp::socket m_socket;
+        const LocalHttpServer& m_server;
+        asio::steady_timer m_timer;
+        asio::streambuf m_buffer;
+        std::shared_ptr<const std::string> m_response;
+    };
+
+    void accept() {
+        m_acceptor.async_accept([this](asio::error_code ec, asio::ip::tcp::socket socket) {
+            if (ec) return;
+            ++m_connections;
+            std::make_shared<Session>(std::move(socket), *this)->start();
+            accept();
+        });
+    }
+
+private:
+    asio::io_context m_io;
+    asio::ip::tcp::acceptor m_acceptor;
+    std::shared_ptr<const std::string> m_response;
+    std::map<std::string, std::shared_ptr<const std::string>> m_routes;
+    std::map<std::string, Handler> m_handlers;
+    std::chrono::milliseconds m_latency{0};
+    std::thread m_thread;
+    std::atomic<bool> m_stopped{false};
+    std::atomic<size_t> m_connections{0};
+};
+
+} // namespace konami::bench
@@ -0,0 +1,73 @@
+/**
+ * ModScanBench.cpp
+ *
+ * ModManager::scanInstalledMods over a mods folder of synthetic Fabric
+ * jars (fabric.mod.json plus class-file filler), as on opening the mods
+ * page of a large modpack.
+ */
+
+#include "core/mods/ModManager.hpp"
+#include "utils/ZipArchive.hpp"
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using konami::mods::ModManager;
+using konami::utils::ZipWriter;
+
+namespace {
+
+/**
+ * Mods folder with `count` jars, built once per count
+ */
+fs::path modsFolder(int count) {
+    fs::path root = fs::temp_directory_path() / ("konami_modscan_bench_" + std::to_string(count));
+    fs::path mods = root / "mods";
+    if (fs::exists(mods)) return mods;
+
+    fs::path staging = root / "staging";
+    fs::create_directories(staging);
+    fs::create_directories(mods);
+
+    std::mt19937 rng(9);
+    std::string filler(48 * 1024, '\0');
+    for (int i = 0; i < count; ++i) {
+        std::string id = "mod" + std::to_string(i);
+        nlohmann::json manifest = {
+            {"schemaVersion", 1}, {"id", id}, {"version", "1.0." + std::to_string(i)},
+            {"name", "Mod " + std::to_string(i)}, {"description", "Synthetic mod for benchmarking"},
+            {"authors", {"Konami Team"}}, {"depends", {{"fabricloader", ">=0.15.0"}, {"minecraft", "~1.20.4"}}}
+        };
+        std::ofstream(staging / "fabric.mod.json") << manifest.dump(2);
+        for (auto& c : filler) c = static_cast<char>(rng() % 64);
+        std::ofstream(staging / "Main.class", std::ios::binary) << filler;
+
+        ZipWriter::write(mods / (id + ".jar"),
+                         {{staging / "fabric.mod.json", "fabric.mod.json"},
+                          {staging / "Main.class", "com/example/" + id + "/Main.class"}},
+                         ZipWriter::Options{});
+    }
+    fs::remove_all(staging);
+    return mods;
+}
+
+void BM_ModManager_ScanInstalled(benchmark::State& state) {
+    ModManager manager;
+    manager.setModsDirectory(modsFolder(static_cast<int>(state.range(0))));
+
+    for (auto _ : state) {
+        auto mods = manager.scanInstalledMods();
+        benchmark::DoNotOptimize(mods.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ModManager_ScanInstalled)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
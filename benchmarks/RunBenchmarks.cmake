@@ -0,0 +1,86 @@
+# Konami Client - Benchmark History
+#
+# Runs konami_benchmarks with JSON output and keeps every run, so results
+# can be compared over time. Each run is written to
+#   <RESULTS_DIR>/<UTC timestamp>-<git revision>.json
+# with the revision recorded in the benchmark context. When a previous run
+# exists and Google Benchmark's compare.py is available (it needs Python
+# with scipy), the two runs are compared.
+#
+# Usage:
+#   cmake -DBENCHMARK_EXECUTABLE=<path> -DRESULTS_DIR=<dir>
+#         [-DSOURCE_DIR=<repo>] [-DCOMPARE_SCRIPT=<compare.py>]
+#         [-DFILTER=<regex>] [-DREPETITIONS=3] -P RunBenchmarks.cmake
+# or build the konami_benchmarks_json target.
+
+cmake_minimum_required(VERSION 3.19)
+
+if(NOT BENCHMARK_EXECUTABLE OR NOT RESULTS_DIR)
+    message(FATAL_ERROR "BENCHMARK_EXECUTABLE and RESULTS_DIR are required")
+endif()
+if(NOT REPETITIONS)
+    set(REPETITIONS 3)
+endif()
+
+file(MAKE_DIRECTORY "${RESULTS_DIR}")
+
+set(revision "unknown")
+find_package(Git QUIET)
+if(GIT_FOUND AND SOURCE_DIR)
+    execute_process(
+        COMMAND "${GIT_EXECUTABLE}" rev-parse --short HEAD
+        WORKING_DIRECTORY "${SOURCE_DIR}"
+        OUTPUT_VARIABLE revision
+        OUTPUT_STRIP_TRAILING_WHITESPACE
+        ERROR_QUIET
+    )
+    execute_process(
+        COMMAND "${GIT_EXECUTABLE}" status --porcelain --untracked-files=no
+        WORKING_DIRECTORY "${SOURCE_DIR}"
+        OUTPUT_VARIABLE dirty
+        ERROR_QUIET
+    )
+    if(dirty)
+        string(APPEND revision "-dirty")
+    endif()
+endif()
+
+# Previous run, if any (names sort by time)
+file(GLOB previous_runs "${RESULTS_DIR}/*.json")
+list(SORT previous_runs)
+list(POP_BACK previous_runs previous)
+
+string(TIMESTAMP timestamp "%Y%m%dT%H%M%SZ" UTC)
+set(output "${RESULTS_DIR}/${timestamp}-${revision}.json")
+
+set(args
+    --benchmark_out=${output}
+    --benchmark_out_format=json
+    --benchmark_repetitions=${REPETITIONS}
+    --benchmark_report_aggregates_only=true
+    --benchmark_context=git_revision=${revision}
+)
+if(FILTER)
+    list(APPEND args --benchmark_filter=${FILTER})
+endif()
+
+execute_process(COMMAND "${BENCHMARK_EXECUTABLE}" ${args} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    file(REMOVE "${output}")
+    message(FATAL_ERROR "konami_benchmarks failed (${result})")
+endif()
+message(STATUS "Results written to ${output}")
+
+if(previous AND COMPARE_SCRIPT AND EXISTS "${COMPARE_SCRIPT}")
+    find_package(Python3 QUIET COMPONENTS Interpreter)
+    if(Python3_FOUND)
+        message(STATUS "Comparing with ${previous}")
+        execute_process(
+            COMMAND "${Python3_EXECUTABLE}" "${COMPARE_SCRIPT}" benchmarks "${previous}" "${output}"
+            RESULT_VARIABLE compare_result
+        )
+        if(NOT compare_result EQUAL 0)
+            message(WARNING "compare.py failed; is scipy installed?")
+        endif()
+    endif()
+endif()
@@ -0,0 +1,139 @@
+# Konami Client - Startup Benchmark
+#
+# Launches the client repeatedly with --exit-after-first-frame and
+# --trace-startup, and reports the median time of each startup span.
+#
+#   cold: every run gets a fresh, empty data directory (no config, caches
+#         or thumbnails), like a first launch after install
+#   warm: all runs share one data directory that a discarded run has
+#         already populated
+#
+# The OS file cache is not dropped, so "cold" is cold for the launcher's
+# own state, not for the disk. Needs a display (or a headless Slint backend).
+#
+# Usage:
+#   cmake -DKONAMI_EXECUTABLE=<path> [-DRUNS=5] [-DOUTPUT_DIR=<dir>] -P StartupBench.cmake
+# or build the konami_startup_bench target.
+
+cmake_minimum_required(VERSION 3.19)
+
+if(NOT KONAMI_EXECUTABLE)
+    message(FATAL_ERROR "KONAMI_EXECUTABLE is required")
+endif()
+if(NOT RUNS)
+    set(RUNS 5)
+endif()
+if(NOT OUTPUT_DIR)
+    set(OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/startup-bench")
+endif()
+
+file(REMOVE_RECURSE "${OUTPUT_DIR}")
+file(MAKE_DIRECTORY "${OUTPUT_DIR}")
+
+# Run the client once with HOME/APPDATA pointed at data_dir and append the
+# span durations (in microseconds) of its trace to bench_<mode>_<span>
+function(run_client mode data_dir trace_file)
+    file(MAKE_DIRECTORY "${data_dir}")
+    set(ENV{HOME} "${data_dir}")
+    set(ENV{APPDATA} "${data_dir}")
+
+    execute_process(
+        COMMAND "${KONAMI_EXECUTABLE}" --exit-after-first-frame --trace-startup "${trace_file}"
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+        ERROR_QUIET
+        TIMEOUT 120
+    )
+    if(NOT result EQUAL 0 OR NOT EXISTS "${trace_file}")
+        message(FATAL_ERROR "Client run failed (${result}); see ${data_dir}")
+    endif()
+
+    file(READ "${trace_file}" trace)
+    string(JSON count LENGTH "${trace}" traceEvents)
+    math(EXPR last "${count} - 1")
+    foreach(i RANGE ${last})
+        string(JSON phase GET "${trace}" traceEvents ${i} ph)
+        string(JSON name GET "${trace}" traceEvents ${i} name)
+        if(phase STREQUAL "X")
+            string(JSON value GET "${trace}" traceEvents ${i} dur)
+        elseif(phase STREQUAL "i")
+            string(JSON value GET "${trace}" traceEvents ${i} ts)
+        else()
+            continue()
+        endif()
+
+        set(key "bench_${mode}_${name}")
+        set(${key} ${${key}} ${value} PARENT_SCOPE)
+        set(bench_spans ${bench_spans} ${name})
+    endforeach()
+    list(REMOVE_DUPLICATES bench_spans)
+    set(bench_spans ${bench_spans} PARENT_SCOPE)
+endfunction()
+
+# Median, min and max of a list of microsecond values, in milliseconds
+function(summarize values out_var)
+    list(SORT values COMPARE NATURAL)
+    list(LENGTH values n)
+    math(EXPR middle "${n} / 2")
+    list(GET values ${middle} median)
+    list(GET values 0 low)
+    list(GET values -1 high)
+    foreach(var median low high)
+        math(EXPR whole "${${var}} / 1000")
+        math(EXPR frac "(${${var}} % 1000) / 100")
+        set(${var} "${whole}.${frac}")
+    endforeach()
+    set(${out_var} "${median};${low};${high}" PARENT_SCOPE)
+endfunction()
+
+set(bench_spans "")
+
+foreach(run RANGE 1 ${RUNS})
+    message(STATUS "cold run ${run}/${RUNS}")
+    run_client(cold "${OUTPUT_DIR}/cold-${run}" "${OUTPUT_DIR}/cold-${run}.json")
+endforeach()
+
+message(STATUS "warm-up run")
+run_client(discard "${OUTPUT_DIR}/warm" "${OUTPUT_DIR}/warm-0.json")
+foreach(run RANGE 1 ${RUNS})
+    message(STATUS "warm run ${run}/${RUNS}")
+    run_client(warm "${OUTPUT_DIR}/warm" "${OUTPUT_DIR}/warm-${run}.json")
+endforeach()
+
+list(SORT bench_spans)
+set(csv "mode,span,median_ms,min_ms,max_ms\n")
+message("")
+message("span                              cold (ms)    warm (ms)")
+foreach(span ${bench_spans})
+    set(line "${span}")
+    string(LENGTH "${line}" length)
+    while(length LESS 34)
+        string(APPEND line " ")
+        math(EXPR length "${length} + 1")
+    endwhile()
+
+    foreach(mode cold warm)
+        set(values ${bench_${mode}_${span}})
+        if(values)
+            summarize("${values}" stats)
+            list(GET stats 0 median)
+            list(GET stats 1 low)
+            list(GET stats 2 high)
+            string(APPEND csv "${mode},${span},${median},${low},${high}\n")
+            string(APPEND line "${median}")
+            string(LENGTH "${median}" width)
+            while(width LESS 13)
+                string(APPEND line " ")
+                math(EXPR width "${width} + 1")
+            endwhile()
+        else()
+            string(APPEND line "-            ")
+        endif()
+    endforeach()
+    message("${line}")
+endforeach()
+
+file(WRITE "${OUTPUT_DIR}/startup-bench.csv" "${csv}")
+message("")
+message("ui.firstFrame is the time from main() to the first rendered frame.")
+message("Traces and ${OUTPUT_DIR}/startup-bench.csv hold the full results.")
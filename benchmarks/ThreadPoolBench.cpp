@@ -0,0 +1,96 @@
+/**
+ * ThreadPoolBench.cpp
+ *
+ * ThreadPool overhead: a single submit/get round trip, throughput of a
+ * batch of tiny tasks, how quickly idle workers pick up the rest of an
+ * uneven batch while one worker is stuck on a long task, and fork-join
+ * where tasks submit their own subtasks.
+ */
+
+#include "core/ThreadPool.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+using konami::core::ThreadPool;
+
+namespace {
+
+/**
+ * Busy-wait so short tasks are not dominated by sleep granularity
+ */
+void spin(std::chrono::microseconds duration) {
+    auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+void BM_ThreadPool_SubmitRoundTrip(benchmark::State& state) {
+    ThreadPool pool(4);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool.submit([] { return 1; }).get());
+    }
+}
+BENCHMARK(BM_ThreadPool_SubmitRoundTrip)->UseRealTime();
+
+void BM_ThreadPool_SubmitBatch(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::vector<std::future<void>> futures;
+    futures.reserve(1000);
+    for (auto _ : state) {
+        futures.clear();
+        for (int i = 0; i < 1000; ++i) {
+            futures.push_back(pool.submit([] {}));
+        }
+        for (auto& future : futures) future.get();
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_ThreadPool_SubmitBatch)->Arg(1)->Arg(4)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+void BM_ThreadPool_UnevenBatch(benchmark::State& state) {
+    // One 2 ms task followed by 200 x 20 us: the other workers should
+    // drain the short tasks while the first is busy (~1 ms on 4 workers)
+    ThreadPool pool(4);
+    std::vector<std::future<void>> futures;
+    for (auto _ : state) {
+        futures.clear();
+        futures.push_back(pool.submit([] { spin(std::chrono::microseconds(2000)); }));
+        for (int i = 0; i < 200; ++i) {
+            futures.push_back(pool.submit([] { spin(std::chrono::microseconds(20)); }));
+        }
+        for (auto& future : futures) future.get();
+    }
+}
+BENCHMARK(BM_ThreadPool_UnevenBatch)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+void BM_ThreadPool_ForkJoin(benchmark::State& state) {
+    // 16 parents each fan out 16 children from inside the pool; parents
+    // do not block on children, so this cannot deadlock the pool
+    ThreadPool pool(4);
+    std::atomic<int> remaining{0};
+    for (auto _ : state) {
+        remaining = 16 * 16;
+        for (int parent = 0; parent < 16; ++parent) {
+            pool.submit([&pool, &remaining] {
+                for (int child = 0; child < 16; ++child) {
+                    pool.submit([&remaining] {
+                        if (remaining.fetch_sub(1) == 1) remaining.notify_one();
+                    });
+                }
+            });
+        }
+        for (int left = remaining.load(); left != 0; left = remaining.load()) {
+            remaining.wait(left);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 16 * 17);
+}
+BENCHMARK(BM_ThreadPool_ForkJoin)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,107 @@
+/**
+ * TokenStorageBench.cpp
+ *
+ * Storing and reading tokens in file-backed TokenStorage with a handful of
+ * accounts, against the previous scheme: read the key file, re-encrypt the
+ * whole token map and rewrite the file on every store.
+ */
+
+#include "core/auth/Encryption.hpp"
+#include "core/auth/TokenStorage.hpp"
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+using konami::core::auth::Encryption;
+using konami::core::auth::TokenStorage;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kAccounts = 8;
+
+std::string token(int i) {
+    return std::string(900, static_cast<char>('a' + i % 26));
+}
+
+class StorageFixture : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State&) override {
+        directory = fs::temp_directory_path() / "konami-token-bench";
+        fs::remove_all(directory);
+        storage = std::make_unique<TokenStorage>();
+        storage->initialize(directory.string());
+        for (int i = 0; i < kAccounts; ++i) {
+            storage->storeToken("account-" + std::to_string(i), token(i));
+        }
+        storage->flush();
+    }
+
+    void TearDown(benchmark::State&) override {
+        storage.reset();
+        fs::remove_all(directory);
+    }
+
+    fs::path directory;
+    std::unique_ptr<TokenStorage> storage;
+};
+
+BENCHMARK_DEFINE_F(StorageFixture, Store)(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage->storeToken("account-" + std::to_string(i % kAccounts), token(i)));
+        ++i;
+    }
+}
+BENCHMARK_REGISTER_F(StorageFixture, Store)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(StorageFixture, Get)(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage->getToken("account-" + std::to_string(i++ % kAccounts)));
+    }
+}
+BENCHMARK_REGISTER_F(StorageFixture, Get)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(StorageFixture, Flush)(benchmark::State& state) {
+    for (auto _ : state) {
+        storage->storeToken("account-0", token(0));
+        storage->flush();
+    }
+}
+BENCHMARK_REGISTER_F(StorageFixture, Flush)->Unit(benchmark::kMicrosecond);
+
+/**
+ * The previous storeInFile: key from disk, whole map re-encrypted and written
+ */
+BENCHMARK_DEFINE_F(StorageFixture, Store_Previous)(benchmark::State& state) {
+    std::unordered_map<std::string, std::string> tokens;
+    for (int i = 0; i < kAccounts; ++i) tokens["account-" + std::to_string(i)] = token(i);
+    auto keyPath = directory / ".key";
+    auto filePath = directory / "previous.enc";
+
+    int i = 0;
+    for (auto _ : state) {
+        tokens["account-" + std::to_string(i % kAccounts)] = token(i);
+        ++i;
+
+        nlohmann::json data;
+        for (const auto& [key, value] : tokens) data[key] = value;
+
+        std::ifstream keyFile(keyPath, std::ios::binary);
+        std::string key((std::istreambuf_iterator<char>(keyFile)), std::istreambuf_iterator<char>());
+        std::string encrypted = Encryption::encrypt(data.dump(), key);
+
+        std::ofstream file(filePath, std::ios::binary);
+        file.write(encrypted.data(), static_cast<std::streamsize>(encrypted.size()));
+    }
+}
+BENCHMARK_REGISTER_F(StorageFixture, Store_Previous)->Unit(benchmark::kMicrosecond);
+
+} // namespace
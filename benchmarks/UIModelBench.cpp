@@ -0,0 +1,221 @@
+/**
+ * UIModelBench.cpp
+ *
+ * UI-thread time for one refresh of the installed mods list (1,000 mods):
+ * replacing the model, as UIBridge used to, against diffing it by mod id.
+ *
+ * Slint is not part of this target, so RepeaterModel stands in for
+ * VectorModel plus the ListView repeater behind it: every row the repeater
+ * is told about gets its item instantiated (text laid out at the row
+ * width), a reset re-instantiates all of them, and an update re-lays out
+ * that one row. Each iteration is one frame's worth of refresh work:
+ * converting the mods to rows and handing them to the model.
+ */
+
+#include "ui/bridge/KeyedDiff.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using konami::ui::applyKeyedEdits;
+using konami::ui::diffKeyed;
+
+namespace {
+
+constexpr size_t kMods = 1000;
+
+struct Mod {
+    std::string id;
+    std::string name;
+    std::string author;
+    std::string description;
+    std::string version;
+    int downloads = 0;
+    bool isEnabled = true;
+};
+
+/**
+ * Same shape as the generated ModInfo
+ */
+struct ModRow {
+    std::string id;
+    std::string name;
+    std::string author;
+    std::string description;
+    std::string version;
+    int downloads = 0;
+    bool isEnabled = true;
+
+    bool operator==(const ModRow&) const = default;
+};
+
+ModRow toRow(const Mod& mod) {
+    return {mod.id, mod.name, mod.author, mod.description, mod.version, mod.downloads, mod.isEnabled};
+}
+
+/**
+ * Instantiated row item: line breaks of the wrapped description
+ */
+struct RowItem {
+    std::vector<uint16_t> lineBreaks;
+    float height = 0.0f;
+};
+
+RowItem instantiate(const ModRow& row) {
+    constexpr float kWidth = 420.0f;
+    RowItem item;
+    float x = 0.0f;
+    size_t lastSpace = 0;
+    for (size_t i = 0; i < row.description.size(); ++i) {
+        char c = row.description[i];
+        x += (c == 'i' || c == 'l' || c == ' ') ? 3.5f : 7.25f;
+        if (c == ' ') lastSpace = i;
+        if (x > kWidth) {
+            item.lineBreaks.push_back(static_cast<uint16_t>(lastSpace));
+            x = 0.0f;
+        }
+    }
+    item.height = 48.0f + 18.0f * static_cast<float>(item.lineBreaks.size());
+    return item;
+}
+
+class RepeaterModel {
+public:
+    void reset(std::vector<ModRow> rows) {
+        m_rows = std::move(rows);
+        m_items.clear();
+        m_items.reserve(m_rows.size());
+        for (const auto& row : m_rows) m_items.push_back(instantiate(row));
+        m_instantiated += m_rows.size();
+    }
+
+    void erase(size_t row) {
+        m_rows.erase(m_rows.begin() + static_cast<std::ptrdiff_t>(row));
+        m_items.erase(m_items.begin() + static_cast<std::ptrdiff_t>(row));
+    }
+
+    void insert(size_t row, const ModRow& value) {
+        m_rows.insert(m_rows.begin() + static_cast<std::ptrdiff_t>(row), value);
+        m_items.insert(m_items.begin() + static_cast<std::ptrdiff_t>(row), instantiate(value));
+        ++m_instantiated;
+    }
+
+    void set_row_data(size_t row, const ModRow& value) {
+        m_rows[row] = value;
+        m_items[row] = instantiate(value);
+        ++m_instantiated;
+    }
+
+    size_t instantiated() const { return m_instantiated; }
+
+private:
+    std::vector<ModRow> m_rows;
+    std::vector<RowItem> m_items;
+    size_t m_instantiated = 0;
+};
+
+std::vector<Mod> installedMods() {
+    std::mt19937 rng(92);
+    std::vector<Mod> mods;
+    mods.reserve(kMods);
+    for (size_t i = 0; i < kMods; ++i) {
+        Mod mod;
+        mod.id = "mod-" + std::to_string(i);
+        mod.name = "Example Mod " + std::to_string(i);
+        mod.author = "author" + std::to_string(rng() % 200);
+        for (size_t words = 20 + rng() % 40; words > 0; --words) {
+            mod.description += std::string(2 + rng() % 8, static_cast<char>('a' + rng() % 26)) + ' ';
+        }
+        mod.version = "1." + std::to_string(rng() % 20) + "." + std::to_string(rng() % 10);
+        mod.downloads = static_cast<int>(rng() % 5000000);
+        mods.push_back(std::move(mod));
+    }
+    return mods;
+}
+
+/**
+ * A typical refresh: a few mods toggled, one updated, one removed, one added
+ */
+void mutate(std::vector<Mod>& mods, size_t round) {
+    for (size_t i = 0; i < 5; ++i) {
+        auto& mod = mods[(round * 37 + i * 191) % mods.size()];
+        mod.isEnabled = !mod.isEnabled;
+    }
+    mods[(round * 53) % mods.size()].version = "2." + std::to_string(round);
+    Mod added = mods[(round * 71) % mods.size()];
+    mods.erase(mods.begin() + static_cast<std::ptrdiff_t>((round * 71) % mods.size()));
+    added.id = "mod-new-" + std::to_string(round);
+    mods.insert(mods.begin() + static_cast<std::ptrdiff_t>((round * 29) % mods.size()), std::move(added));
+}
+
+std::vector<ModRow> toRows(const std::vector<Mod>& mods) {
+    std::vector<ModRow> rows;
+    rows.reserve(mods.size());
+    for (const auto& mod : mods) rows.push_back(toRow(mod));
+    return rows;
+}
+
+void BM_Refresh_Replace(benchmark::State& state) {
+    auto mods = installedMods();
+    RepeaterModel model;
+    model.reset(toRows(mods));
+    size_t round = 0;
+    size_t before = model.instantiated();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        mutate(mods, ++round);
+        state.ResumeTiming();
+
+        model.reset(toRows(mods));
+    }
+    state.counters["rows/refresh"] = static_cast<double>(model.instantiated() - before) /
+                                     static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_Refresh_Replace)->Unit(benchmark::kMicrosecond);
+
+void BM_Refresh_Keyed(benchmark::State& state) {
+    auto mods = installedMods();
+    RepeaterModel model;
+    std::vector<ModRow> current = toRows(mods);
+    model.reset(current);
+    size_t round = 0;
+    size_t before = model.instantiated();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        mutate(mods, ++round);
+        state.ResumeTiming();
+
+        auto rows = toRows(mods);
+        auto edits = diffKeyed(current, rows, [](const ModRow& row) { return std::string_view(row.id); });
+        applyKeyedEdits(model, edits, rows);
+        current = std::move(rows);
+    }
+    state.counters["rows/refresh"] = static_cast<double>(model.instantiated() - before) /
+                                     static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_Refresh_Keyed)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Refresh with nothing changed: the common case when a page is revisited
+ */
+void BM_Refresh_KeyedUnchanged(benchmark::State& state) {
+    auto rows = toRows(installedMods());
+    RepeaterModel model;
+    model.reset(rows);
+    for (auto _ : state) {
+        auto next = rows;
+        auto edits = diffKeyed(rows, next, [](const ModRow& row) { return std::string_view(row.id); });
+        applyKeyedEdits(model, edits, next);
+        benchmark::DoNotOptimize(edits.data());
+    }
+}
+BENCHMARK(BM_Refresh_KeyedUnchanged)->Unit(benchmark::kMicrosecond);
+
+} // namespace
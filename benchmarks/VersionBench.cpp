@@ -0,0 +1,94 @@
+/**
+ * VersionBench.cpp
+ *
+ * Sorting a loader/mod version list: the previous split-and-parseInt
+ * comparator against Version keys parsed once, plus range matching.
+ */
+
+#include "utils/Version.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using konami::utils::Version;
+using konami::utils::VersionRange;
+
+namespace {
+
+/**
+ * The comparator this replaced: split on '.', stoi each part, every call
+ */
+int splitCompare(const std::string& v1, const std::string& v2) {
+    auto split = [](const std::string& s) {
+        std::vector<std::string> parts;
+        std::stringstream stream(s);
+        for (std::string part; std::getline(stream, part, '.'); ) parts.push_back(part);
+        return parts;
+    };
+    auto parse = [](const std::string& s) {
+        try { return std::stoi(s); } catch (...) { return 0; }
+    };
+    auto parts1 = split(v1);
+    auto parts2 = split(v2);
+    size_t max = std::max(parts1.size(), parts2.size());
+    for (size_t i = 0; i < max; ++i) {
+        int p1 = i < parts1.size() ? parse(parts1[i]) : 0;
+        int p2 = i < parts2.size() ? parse(parts2[i]) : 0;
+        if (p1 != p2) return p1 < p2 ? -1 : 1;
+    }
+    return 0;
+}
+
+const std::vector<std::string>& versions() {
+    static const std::vector<std::string> list = [] {
+        std::vector<std::string> result;
+        std::mt19937 rng(11);
+        const char* suffixes[] = {"", "", "", "-pre1", "-rc2", "-beta.3", "+mc1.20.4"};
+        for (int i = 0; i < 20000; ++i) {
+            result.push_back(std::to_string(rng() % 3) + "." + std::to_string(rng() % 40) + "." +
+                             std::to_string(rng() % 30) + suffixes[rng() % 7]);
+        }
+        return result;
+    }();
+    return list;
+}
+
+void BM_SplitCompare_Sort(benchmark::State& state) {
+    for (auto _ : state) {
+        auto list = versions();
+        std::sort(list.begin(), list.end(),
+            [](const std::string& a, const std::string& b) { return splitCompare(a, b) < 0; });
+        benchmark::DoNotOptimize(list.data());
+    }
+}
+BENCHMARK(BM_SplitCompare_Sort)->Unit(benchmark::kMillisecond);
+
+void BM_VersionKey_Sort(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<Version> list;
+        list.reserve(versions().size());
+        for (const auto& text : versions()) list.emplace_back(text);
+        std::sort(list.begin(), list.end());
+        benchmark::DoNotOptimize(list.data());
+    }
+}
+BENCHMARK(BM_VersionKey_Sort)->Unit(benchmark::kMillisecond);
+
+void BM_VersionRange_Contains(benchmark::State& state) {
+    auto range = *VersionRange::parse(">=1.2.0 <2.0.0 || ^0.30");
+    std::vector<Version> list(versions().begin(), versions().end());
+    for (auto _ : state) {
+        size_t matched = 0;
+        for (const auto& version : list) matched += range.contains(version);
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * list.size()));
+}
+BENCHMARK(BM_VersionRange_Contains);
+
+} // namespace
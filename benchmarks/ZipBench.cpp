@@ -0,0 +1,170 @@
+/**
+ * ZipBench.cpp
+ *
+ * Extraction and creation of a synthetic modpack-sized tree: ZipReader /
+ * ZipWriter against the system unzip and zip commands. Also measures the
+ * mod-scan pattern of opening a jar and reading one metadata entry.
+ */
+
+#include "utils/ZipArchive.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+using konami::utils::ZipReader;
+using konami::utils::ZipWriter;
+
+namespace {
+
+/**
+ * Source tree (text configs, random "already compressed" blobs) and its archive,
+ * built once per process
+ */
+struct Fixture {
+    fs::path root;
+    fs::path tree;
+    fs::path archive;
+
+    Fixture() {
+        root = fs::temp_directory_path() / "konami_zip_bench";
+        fs::remove_all(root);
+        tree = root / "tree";
+        archive = root / "tree.zip";
+
+        std::mt19937 rng(42);
+        for (int dir = 0; dir < 20; ++dir) {
+            fs::path config = tree / "config" / ("mod" + std::to_string(dir));
+            fs::create_directories(config);
+            for (int file = 0; file < 50; ++file) {
+                std::ofstream out(config / ("settings" + std::to_string(file) + ".toml"));
+                for (int line = 0; line < 200; ++line) {
+                    out << "option_" << line << " = " << (rng() % 1000) << "\n";
+                }
+            }
+        }
+
+        fs::create_directories(tree / "mods");
+        std::string blob(2 * 1024 * 1024, '\0');
+        for (int jar = 0; jar < 16; ++jar) {
+            for (auto& c : blob) c = static_cast<char>(rng());
+            std::ofstream(tree / "mods" / ("mod" + std::to_string(jar) + ".bin"), std::ios::binary)
+                .write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        }
+
+        ZipWriter::write(archive, ZipWriter::collect(tree), ZipWriter::Options{});
+    }
+
+    ~Fixture() {
+        std::error_code ec;
+        fs::remove_all(root, ec);
+    }
+};
+
+Fixture& fixture() {
+    static Fixture instance;
+    return instance;
+}
+
+bool hasCommand(const char* name) {
+    return std::system((std::string("command -v ") + name + " >/dev/null 2>&1").c_str()) == 0;
+}
+
+void BM_ZipReader_ExtractAll(benchmark::State& state) {
+    auto& f = fixture();
+    fs::path out = f.root / "out_reader";
+    for (auto _ : state) {
+        fs::remove_all(out);
+        ZipReader reader;
+        if (!reader.open(f.archive) || !reader.extractAll(out, static_cast<unsigned>(state.range(0)))) {
+            state.SkipWithError(reader.error().c_str());
+            return;
+        }
+    }
+}
+BENCHMARK(BM_ZipReader_ExtractAll)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_UnzipCli_Extract(benchmark::State& state) {
+    if (!hasCommand("unzip")) {
+        state.SkipWithError("unzip not installed");
+        return;
+    }
+    auto& f = fixture();
+    fs::path out = f.root / "out_cli";
+    std::string command = "unzip -qq -o '" + f.archive.string() + "' -d '" + out.string() + "'";
+    for (auto _ : state) {
+        fs::remove_all(out);
+        if (std::system(command.c_str()) != 0) {
+            state.SkipWithError("unzip failed");
+            return;
+        }
+    }
+}
+BENCHMARK(BM_UnzipCli_Extract)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_ZipReader_OpenFindRead(benchmark::State& state) {
+    auto& f = fixture();
+    for (auto _ : state) {
+        ZipReader reader;
+        if (!reader.open(f.archive)) {
+            state.SkipWithError(reader.error().c_str());
+            return;
+        }
+        const auto* entry = reader.find("config/mod7/settings42.toml");
+        auto content = entry ? reader.read(*entry) : std::nullopt;
+        benchmark::DoNotOptimize(content);
+    }
+}
+BENCHMARK(BM_ZipReader_OpenFindRead)->Unit(benchmark::kMicrosecond);
+
+void BM_ZipReader_FindAll(benchmark::State& state) {
+    auto& f = fixture();
+    ZipReader reader;
+    reader.open(f.archive);
+    for (auto _ : state) {
+        for (const auto& entry : reader.entries()) {
+            benchmark::DoNotOptimize(reader.find(entry.name));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * reader.entries().size()));
+}
+BENCHMARK(BM_ZipReader_FindAll);
+
+void BM_ZipWriter_Create(benchmark::State& state) {
+    auto& f = fixture();
+    fs::path out = f.root / "written.zip";
+    ZipWriter::Options options;
+    options.threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        std::string error;
+        if (!ZipWriter::write(out, ZipWriter::collect(f.tree), options, &error)) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+    }
+}
+BENCHMARK(BM_ZipWriter_Create)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_ZipCli_Create(benchmark::State& state) {
+    if (!hasCommand("zip")) {
+        state.SkipWithError("zip not installed");
+        return;
+    }
+    auto& f = fixture();
+    fs::path out = f.root / "cli.zip";
+    std::string command = "cd '" + f.tree.string() + "' && zip -qr '" + out.string() + "' .";
+    for (auto _ : state) {
+        fs::remove(out);
+        if (std::system(command.c_str()) != 0) {
+            state.SkipWithError("zip failed");
+            return;
+        }
+    }
+}
+BENCHMARK(BM_ZipCli_Create)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
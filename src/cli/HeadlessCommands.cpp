@@ -0,0 +1,508 @@
+/**
+ * HeadlessCommands.cpp
+ *
+ * Headless provisioning commands: argument registration, progress output
+ * and the install / prefetch / verify / gc-cache / import-pack drivers.
+ */
+
+#include "HeadlessCommands.hpp"
+#include "../core/Config.hpp"
+#include "../core/Logger.hpp"
+#include "../core/downloader/CacheManager.hpp"
+#include "../core/downloader/DownloadManager.hpp"
+#include "../core/downloader/MojangAPI.hpp"
+#include "../core/launcher/GameLauncher.hpp"
+#include "../core/profile/ProfileManager.hpp"
+#include "../utils/PathUtils.hpp"
+#include "../utils/StringUtils.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace konami::cli {
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+const char* stageName(launcher::LaunchState state) {
+    switch (state) {
+        case launcher::LaunchState::Preparing:            return "preparing";
+        case launcher::LaunchState::DownloadingClient:    return "client";
+        case launcher::LaunchState::DownloadingLibraries: return "libraries";
+        case launcher::LaunchState::DownloadingAssets:    return "assets";
+        case launcher::LaunchState::InstallingLoader:     return "loader";
+        case launcher::LaunchState::Finished:             return "finished";
+        default:                                          return "idle";
+    }
+}
+
+} // namespace
+
+/**
+ * Writes command events to stdout, either as JSON lines or as plain text.
+ * Progress is rate-limited per target and stage so large installs stay
+ * readable; stage changes and completion are always written.
+ */
+class ProgressWriter {
+public:
+    explicit ProgressWriter(bool jsonLines) : m_json(jsonLines) {}
+
+    void start(const std::string& command, const std::string& target) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_targets[target] = Target{Clock::now(), "", Clock::time_point{}};
+        write({{"event", "start"}, {"command", command}, {"target", target}});
+    }
+
+    void progress(const std::string& command, const std::string& target, const launcher::LaunchProgress& progress) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& state = m_targets[target];
+        std::string stage = stageName(progress.state);
+        auto now = Clock::now();
+        bool complete = progress.totalFiles > 0 && progress.downloadedFiles >= progress.totalFiles;
+        if (stage == state.stage && !complete && now - state.lastProgress < kProgressInterval) {
+            return;
+        }
+        state.stage = stage;
+        state.lastProgress = now;
+
+        write({
+            {"event", "progress"},
+            {"command", command},
+            {"target", target},
+            {"stage", stage},
+            {"message", progress.message},
+            {"progress", progress.progress},
+            {"files", progress.downloadedFiles},
+            {"totalFiles", progress.totalFiles},
+            {"bytes", progress.downloadedBytes},
+            {"totalBytes", progress.totalBytes},
+        });
+    }
+
+    void done(const std::string& command, const std::string& target, bool ok, json details = json::object()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        json event = {{"event", "done"}, {"command", command}, {"target", target}, {"ok", ok}};
+        if (auto it = m_targets.find(target); it != m_targets.end()) {
+            event["seconds"] = std::chrono::duration<double>(Clock::now() - it->second.started).count();
+            m_targets.erase(it);
+        }
+        event.update(details);
+        write(event);
+    }
+
+    void result(const std::string& command, bool ok, json details = json::object()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        json event = {{"event", "result"}, {"command", command}, {"ok", ok}};
+        event.update(details);
+        write(event);
+    }
+
+private:
+    static constexpr auto kProgressInterval = std::chrono::milliseconds(250);
+
+    struct Target {
+        Clock::time_point started;
+        std::string stage;
+        Clock::time_point lastProgress;
+    };
+
+    void write(const json& event) {
+        if (m_json) {
+            std::fputs((event.dump() + "\n").c_str(), stdout);
+        } else {
+            std::fputs((formatText(event) + "\n").c_str(), stdout);
+        }
+        std::fflush(stdout);
+    }
+
+    static std::string formatText(const json& event) {
+        std::string type = event.value("event", "");
+        std::string line = "[" + event.value("command", "");
+        if (event.contains("target")) {
+            line += " " + event["target"].get<std::string>();
+        }
+        line += "] ";
+
+        if (type == "start") {
+            return line + "started";
+        }
+        if (type == "progress") {
+            line += event.value("message", "");
+            int total = event.value("totalFiles", 0);
+            if (total > 0) {
+                char buffer[64];
+                std::snprintf(buffer, sizeof(buffer), " %d/%d (%.0f%%)",
+                              event.value("files", 0), total, event.value("progress", 0.0) * 100.0);
+                line += buffer;
+            }
+            return line;
+        }
+
+        line += event.value("ok", false) ? "ok" : "FAILED";
+        for (const auto& [key, value] : event.items()) {
+            if (key == "event" || key == "command" || key == "target" || key == "ok") continue;
+            line += " " + key + "=" + (value.is_string() ? value.get<std::string>() : value.dump());
+        }
+        return line;
+    }
+
+    bool m_json;
+    std::mutex m_mutex;
+    std::map<std::string, Target> m_targets;
+};
+
+HeadlessCommands::HeadlessCommands(CLI::App& app) {
+    auto addTuning = [this](CLI::App* command) {
+        command->add_option("-j,--concurrency", m_concurrency,
+                            "Parallel downloads (default: downloads.maxConcurrent)")
+            ->check(CLI::PositiveNumber);
+        command->add_option("--bandwidth", m_bandwidth,
+                            "Download limit in bytes/s, e.g. 5MB (default: downloads.bandwidthLimit)")
+            ->transform(CLI::AsSizeValue(false));
+    };
+    auto addFormat = [this](CLI::App* command) {
+        command->add_option("--format", m_format, "Progress output: json (one object per line) or text")
+            ->check(CLI::IsMember({"json", "text"}));
+    };
+
+    m_install = app.add_subcommand("install", "Download a version's client, libraries and assets");
+    m_install->add_option("versions", m_versions, "Version ids, or latest / latest-snapshot")->required();
+    addTuning(m_install);
+    addFormat(m_install);
+
+    m_prefetch = app.add_subcommand("prefetch", "Install every version used by the given profiles");
+    m_prefetch->add_option("--profiles", m_profiles, "all, or a comma-separated list of profile ids or names");
+    addTuning(m_prefetch);
+    addFormat(m_prefetch);
+
+    m_verify = app.add_subcommand("verify", "Check installed files against their hashes");
+    m_verify->add_option("versions", m_versions, "Versions to check (default: every installed version)");
+    m_verify->add_flag("--repair", m_repair, "Re-download missing or corrupt files");
+    addTuning(m_verify);
+    addFormat(m_verify);
+
+    m_gcCache = app.add_subcommand("gc-cache", "Drop stale download cache entries and orphaned files");
+    m_gcCache->add_option("--max-size", m_maxCacheSize, "Evict least recently used entries down to this size, e.g. 2GB")
+        ->transform(CLI::AsSizeValue(false));
+    m_gcCache->add_flag("--clear", m_clearCache, "Remove every cache entry");
+    addFormat(m_gcCache);
+
+    m_importPack = app.add_subcommand("import-pack", "Create a profile from a Modrinth .mrpack and download its files");
+    m_importPack->add_option("pack", m_packPath, "Path to the .mrpack file")->required()->check(CLI::ExistingFile);
+    m_importPack->add_flag("--no-install", m_skipInstall, "Do not install the pack's Minecraft version");
+    addTuning(m_importPack);
+    addFormat(m_importPack);
+}
+
+HeadlessCommands::~HeadlessCommands() {
+    // Stop the launcher before the download engine it queues work on
+    m_launcher.reset();
+    if (m_downloads) {
+        m_downloads->shutdown();
+    }
+}
+
+bool HeadlessCommands::selected() const {
+    return m_install->parsed() || m_prefetch->parsed() || m_verify->parsed() ||
+           m_gcCache->parsed() || m_importPack->parsed();
+}
+
+int HeadlessCommands::run() {
+    m_output = std::make_unique<ProgressWriter>(m_format == "json");
+
+    try {
+        if (m_install->parsed()) return install();
+        if (m_prefetch->parsed()) return prefetch();
+        if (m_verify->parsed()) return verify();
+        if (m_gcCache->parsed()) return gcCache();
+        if (m_importPack->parsed()) return importPack();
+    } catch (const std::exception& e) {
+        core::Logger::instance().critical("Headless command failed: {}", e.what());
+        m_output->result("error", false, {{"error", e.what()}});
+    }
+    return 1;
+}
+
+bool HeadlessCommands::startEngines() {
+    // In-memory only: headless runs do not auto-save the configuration
+    auto& config = core::Config::instance();
+    if (m_concurrency > 0) {
+        config.set("downloads.maxConcurrent", m_concurrency);
+    }
+    if (m_bandwidth > 0) {
+        config.set("downloads.bandwidthLimit", m_bandwidth);
+    }
+
+    m_downloads = std::make_shared<core::downloader::DownloadManager>();
+    m_downloads->initialize();
+
+    m_launcher = std::make_unique<launcher::GameLauncher>();
+    if (!m_launcher->initialize(utils::PathUtils::getLauncherPath())) {
+        core::Logger::instance().error("Failed to initialize the game launcher");
+        return false;
+    }
+    m_launcher->setDownloadManager(m_downloads);
+    return true;
+}
+
+std::string HeadlessCommands::resolveVersion(const std::string& version) {
+    if (version != "latest" && version != "latest-snapshot") {
+        return version;
+    }
+
+    core::downloader::MojangAPI api;
+    auto latest = (version == "latest" ? api.getLatestRelease() : api.getLatestSnapshot()).get();
+    return latest ? latest->id : "";
+}
+
+size_t HeadlessCommands::installVersions(const std::vector<std::string>& versions) {
+    size_t failed = 0;
+    for (const auto& requested : versions) {
+        std::string version = resolveVersion(requested);
+        if (version.empty()) {
+            m_output->done("install", requested, false, {{"error", "could not resolve version"}});
+            ++failed;
+            continue;
+        }
+
+        m_output->start("install", version);
+        bool ok = m_launcher->installVersion(version, [this, version](const launcher::LaunchProgress& progress) {
+            m_output->progress("install", version, progress);
+        }).get();
+        m_output->done("install", version, ok);
+        if (!ok) ++failed;
+    }
+    return failed;
+}
+
+int HeadlessCommands::install() {
+    if (!startEngines()) return 1;
+
+    size_t failed = installVersions(m_versions);
+    m_output->result("install", failed == 0, {{"versions", m_versions.size()}, {"failed", failed}});
+    return failed == 0 ? 0 : 1;
+}
+
+int HeadlessCommands::prefetch() {
+    profile::ProfileManager profiles;
+    profiles.initialize(utils::PathUtils::getProfilesPath());
+
+    std::vector<profile::Profile> selectedProfiles;
+    std::vector<std::string> unknown;
+    if (m_profiles == "all") {
+        selectedProfiles = profiles.getAllProfiles();
+    } else {
+        for (const auto& token : utils::StringUtils::split(m_profiles, ',')) {
+            std::string key = utils::StringUtils::trim(token);
+            if (key.empty()) continue;
+            auto profile = profiles.getProfile(key);
+            if (!profile) {
+                profile = profiles.getProfileByName(key);
+            }
+            if (profile) {
+                selectedProfiles.push_back(*profile);
+            } else {
+                core::Logger::instance().warn("Unknown profile: {}", key);
+                unknown.push_back(key);
+            }
+        }
+    }
+
+    // Each game version once, in profile order
+    std::vector<std::string> versions;
+    std::set<std::string> seen;
+    size_t loaders = 0;
+    for (const auto& profile : selectedProfiles) {
+        if (!profile.gameVersion.empty() && seen.insert(profile.gameVersion).second) {
+            versions.push_back(profile.gameVersion);
+        }
+        if (!profile.loader.type.empty() && profile.loader.type != "vanilla") {
+            core::Logger::instance().warn("Profile {} uses {} {}; mod loaders are not prefetched",
+                                          profile.name, profile.loader.type, profile.loader.version);
+            ++loaders;
+        }
+    }
+
+    if (!startEngines()) return 1;
+
+    size_t failed = installVersions(versions);
+    bool ok = failed == 0 && unknown.empty();
+    m_output->result("prefetch", ok, {
+        {"profiles", selectedProfiles.size()},
+        {"versions", versions.size()},
+        {"failed", failed},
+        {"unknownProfiles", unknown},
+        {"loadersSkipped", loaders},
+    });
+    return ok ? 0 : 1;
+}
+
+int HeadlessCommands::verify() {
+    if (!startEngines()) return 1;
+
+    std::vector<std::string> versions = m_versions;
+    if (versions.empty()) {
+        for (const auto& installed : m_launcher->getInstalledVersions()) {
+            versions.push_back(installed.id);
+        }
+    }
+
+    size_t failed = 0;
+    for (const auto& version : versions) {
+        m_output->start("verify", version);
+        if (!m_launcher->isVersionInstalled(version)) {
+            m_output->done("verify", version, false, {{"error", "not installed"}});
+            ++failed;
+            continue;
+        }
+
+        launcher::LaunchProgress last;
+        auto report = [this, &last, version](const launcher::LaunchProgress& progress) {
+            last = progress;
+            m_output->progress("verify", version, progress);
+        };
+
+        bool ok = m_launcher->verifyAssets(version, report).get();
+        json details = {{"files", last.totalFiles}, {"bad", last.totalFiles - last.downloadedFiles}};
+        if (!ok && m_repair) {
+            ok = m_launcher->repairAssets(version, report).get();
+            details["repaired"] = ok;
+        }
+        m_output->done("verify", version, ok, details);
+        if (!ok) ++failed;
+    }
+
+    m_output->result("verify", failed == 0, {{"versions", versions.size()}, {"failed", failed}});
+    return failed == 0 ? 0 : 1;
+}
+
+int HeadlessCommands::gcCache() {
+    std::string cachePath = utils::PathUtils::getCachePath().string();
+    m_output->start("gc-cache", cachePath);
+
+    core::downloader::CacheManager cache;
+    cache.initialize(cachePath);
+    size_t entriesBefore = cache.getEntryCount();
+    size_t bytesBefore = cache.getCurrentSize();
+
+    if (m_clearCache) {
+        cache.clear();
+    } else {
+        cache.runMaintenance();
+        if (m_maxCacheSize > 0) {
+            cache.setMaxSize(m_maxCacheSize);
+        }
+    }
+
+    json details = {
+        {"entriesBefore", entriesBefore},
+        {"entriesAfter", cache.getEntryCount()},
+        {"bytesBefore", bytesBefore},
+        {"bytesAfter", cache.getCurrentSize()},
+    };
+    cache.shutdown();
+
+    m_output->done("gc-cache", cachePath, true, details);
+    m_output->result("gc-cache", true, details);
+    return 0;
+}
+
+int HeadlessCommands::importPack() {
+    if (!startEngines()) return 1;
+
+    profile::ProfileManager profiles;
+    profiles.initialize(utils::PathUtils::getProfilesPath());
+
+    m_output->start("import-pack", m_packPath);
+    std::vector<profile::ModpackFile> files;
+    auto imported = profiles.importModpack(m_packPath, &files);
+    if (!imported) {
+        m_output->done("import-pack", m_packPath, false, {{"error", "not a valid Modrinth pack"}});
+        m_output->result("import-pack", false);
+        return 1;
+    }
+
+    // Pack files go straight into the profile's game directory
+    struct Batch {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t completed = 0;
+        size_t failed = 0;
+        int64_t bytes = 0;
+    };
+    auto batch = std::make_shared<Batch>();
+
+    std::filesystem::path gameDirectory(imported->gameDirectory);
+    int64_t totalBytes = 0;
+    for (const auto& file : files) {
+        totalBytes += file.size;
+
+        core::downloader::DownloadTask task(file.url, (gameDirectory / file.path).string(), file.sha1);
+        task.expectedSize = static_cast<size_t>(std::max<int64_t>(file.size, 0));
+        m_downloads->addDownload(task, 0, nullptr,
+            [batch, size = file.size, path = file.path](const std::string&, bool success, const std::string& error) {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                ++batch->completed;
+                if (success) {
+                    batch->bytes += size;
+                } else {
+                    ++batch->failed;
+                    core::Logger::instance().warn("Pack file failed: {} ({})", path, error);
+                }
+                batch->done.notify_all();
+            });
+    }
+
+    while (!files.empty()) {
+        launcher::LaunchProgress progress;
+        progress.state = launcher::LaunchState::DownloadingLibraries;
+        progress.message = "Downloading pack files";
+        progress.totalFiles = static_cast<int>(files.size());
+        progress.totalBytes = totalBytes;
+        bool finished = false;
+        {
+            std::unique_lock<std::mutex> lock(batch->mutex);
+            batch->done.wait_for(lock, std::chrono::milliseconds(100),
+                                 [&] { return batch->completed == files.size(); });
+            finished = batch->completed == files.size();
+            progress.downloadedFiles = static_cast<int>(batch->completed);
+            progress.downloadedBytes = batch->bytes;
+        }
+        progress.progress = static_cast<double>(progress.downloadedFiles) / static_cast<double>(files.size());
+        m_output->progress("import-pack", m_packPath, progress);
+        if (finished) break;
+    }
+
+    bool ok = batch->failed == 0;
+    if (ok && !m_skipInstall) {
+        ok = installVersions({imported->gameVersion}) == 0;
+    }
+    if (!imported->loader.type.empty() && imported->loader.type != "vanilla") {
+        core::Logger::instance().warn("Pack uses {} {}; install the loader from the launcher",
+                                      imported->loader.type, imported->loader.version);
+    }
+
+    json details = {
+        {"profile", imported->id},
+        {"name", imported->name},
+        {"gameVersion", imported->gameVersion},
+        {"loader", imported->loader.type},
+        {"loaderVersion", imported->loader.version},
+        {"files", files.size()},
+        {"failedFiles", batch->failed},
+    };
+    m_output->done("import-pack", m_packPath, ok, details);
+    m_output->result("import-pack", ok, details);
+    return ok ? 0 : 1;
+}
+
+} // namespace konami::cli
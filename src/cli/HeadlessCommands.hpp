@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * HeadlessCommands.hpp
+ *
+ * Subcommands that run the launcher's engines without the UI, for
+ * provisioning machines: installing versions, prefetching every profile,
+ * verifying installs, collecting the download cache and importing packs.
+ * Progress is written to stdout as one JSON object per line (or as plain
+ * text); logs go to stderr.
+ */
+
+#include <CLI/CLI.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace konami::core::downloader { class DownloadManager; }
+namespace konami::launcher { class GameLauncher; }
+
+namespace konami::cli {
+
+class ProgressWriter;
+
+/**
+ * HeadlessCommands - install, prefetch, verify, gc-cache and import-pack
+ *
+ * Register on the top-level CLI::App before parsing; after parsing, run()
+ * executes the selected subcommand. Logger, directories and configuration
+ * must be initialised by then.
+ */
+class HeadlessCommands {
+public:
+    /**
+     * Constructor - registers the subcommands
+     * @param app Top-level application parser
+     */
+    explicit HeadlessCommands(CLI::App& app);
+    ~HeadlessCommands();
+
+    HeadlessCommands(const HeadlessCommands&) = delete;
+    HeadlessCommands& operator=(const HeadlessCommands&) = delete;
+
+    /**
+     * Check whether a headless subcommand was given
+     * @return true if run() should be called instead of starting the UI
+     */
+    bool selected() const;
+
+    /**
+     * Run the selected subcommand
+     * @return Process exit code (0 on success)
+     */
+    int run();
+
+private:
+    int install();
+    int prefetch();
+    int verify();
+    int gcCache();
+    int importPack();
+
+    /**
+     * Start the download engine with the tuning flags applied, and a game
+     * launcher on top of it
+     * @return false if the engines could not be started
+     */
+    bool startEngines();
+
+    /**
+     * Install versions one after another, reporting each
+     * @param versions Version ids ("latest" and "latest-snapshot" resolved)
+     * @return Number of versions that failed
+     */
+    size_t installVersions(const std::vector<std::string>& versions);
+
+    /**
+     * Resolve "latest" / "latest-snapshot" through the version manifest
+     */
+    std::string resolveVersion(const std::string& version);
+
+private:
+    CLI::App* m_install{nullptr};
+    CLI::App* m_prefetch{nullptr};
+    CLI::App* m_verify{nullptr};
+    CLI::App* m_gcCache{nullptr};
+    CLI::App* m_importPack{nullptr};
+
+    // Shared tuning and output flags
+    int m_concurrency{0};           // 0 = downloads.maxConcurrent
+    size_t m_bandwidth{0};          // Bytes/s, 0 = downloads.bandwidthLimit
+    std::string m_format{"json"};
+
+    // Per-command arguments
+    std::vector<std::string> m_versions;
+    std::string m_profiles{"all"};
+    bool m_repair{false};
+    size_t m_maxCacheSize{0};
+    bool m_clearCache{false};
+    std::string m_packPath;
+    bool m_skipInstall{false};
+
+    std::unique_ptr<ProgressWriter> m_output;
+    std::shared_ptr<core::downloader::DownloadManager> m_downloads;
+    std::unique_ptr<launcher::GameLauncher> m_launcher;
+};
+
+} // namespace konami::cli
@@ -14,8 +14,9 @@
 #include "profile/ProfileManager.hpp"
 #include "skin/SkinEngine.hpp"
 #include "../utils/PathUtils.hpp"
+#include "../utils/HttpClient.hpp"
+#include "../utils/HttpCache.hpp"
 
-#include <thread>
 #include <chrono>
 
 namespace konami::core {
@@ -40,60 +41,35 @@ bool Application::initialize() {
     setState(AppState::Initializing);
     Logger::instance().info("Initializing application...");
     
-    auto startTime = std::chrono::high_resolution_clock::now();
+    auto startTime = std::chrono::steady_clock::now();
     
-    // Initialize subsystems in order
-    if (!initializeAuth()) {
-        Logger::instance().error("Failed to initialize authentication");
-        setState(AppState::Error);
-        return false;
-    }
-    
-    if (!initializeDownloader()) {
-        Logger::instance().error("Failed to initialize downloader");
-        setState(AppState::Error);
-        return false;
-    }
-    
-    if (!initializeVersionManager()) {
-        Logger::instance().error("Failed to initialize version manager");
-        setState(AppState::Error);
-        return false;
-    }
+    // Subsystem DAG: independent nodes initialise concurrently, deferred
+    // ones wait for initializeDeferred()
+    using Stage = InitGraph::Stage;
+    m_initGraph = std::make_unique<InitGraph>();
+    m_initGraph->add("auth", {}, [this] { return initializeAuth(); });
+    m_initGraph->add("downloader", {}, [this] { return initializeDownloader(); });
+    m_initGraph->add("versions", {"downloader"}, [this] { return initializeVersionManager(); });
+    m_initGraph->add("profiles", {}, [this] { return initializeProfileManager(); });
+    m_initGraph->add("themes", {}, [this] { return initializeThemeManager(); });
+    m_initGraph->add("plugins", {"themes", "profiles"}, [this] { return initializePluginManager(); });
+    m_initGraph->add("mods", {"profiles", "downloader"}, [this] { return initializeModManager(); },
+                     Stage::Deferred, false);
+    m_initGraph->add("skins", {"auth"}, [this] { return initializeSkinManager(); },
+                     Stage::Deferred, false);
     
-    if (!initializeProfileManager()) {
-        Logger::instance().error("Failed to initialize profile manager");
-        setState(AppState::Error);
-        return false;
-    }
-    
-    if (!initializeModManager()) {
-        Logger::instance().error("Failed to initialize mod manager");
-        setState(AppState::Error);
-        return false;
-    }
-    
-    if (!initializeSkinManager()) {
-        Logger::instance().error("Failed to initialize skin manager");
-        setState(AppState::Error);
-        return false;
-    }
+    bool ok = m_initGraph->run(Stage::Startup, ThreadPool::global());
     
-    if (!initializeThemeManager()) {
-        Logger::instance().error("Failed to initialize theme manager");
-        setState(AppState::Error);
-        return false;
-    }
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    reportInitTimings(Stage::Startup, duration);
     
-    if (!initializePluginManager()) {
-        Logger::instance().error("Failed to initialize plugin manager");
+    if (!ok) {
+        Logger::instance().error("Failed to initialize application");
         setState(AppState::Error);
         return false;
     }
     
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-    
     Logger::instance().info("Application initialized in {}ms", duration.count());
     
     setState(AppState::Ready);
@@ -102,6 +78,41 @@ bool Application::initialize() {
     return true;
 }
 
+void Application::initializeDeferred() {
+    if (!m_initGraph || m_deferredInit.joinable()) {
+        return;
+    }
+    
+    // Own thread: run() blocks on the pool it schedules onto
+    m_deferredInit = std::thread([this] {
+        StartupTrace::instance().setThreadName("deferred-init");
+        auto span = StartupTrace::instance().span("app.initializeDeferred", "init");
+        auto startTime = std::chrono::steady_clock::now();
+        bool ok = m_initGraph->run(InitGraph::Stage::Deferred, ThreadPool::global());
+        reportInitTimings(InitGraph::Stage::Deferred, std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime));
+        
+        EventBus::instance().emit("app.deferredInitialized", {{"success", ok}});
+    });
+}
+
+std::vector<InitGraph::Timing> Application::getInitTimings() const {
+    return m_initGraph ? m_initGraph->timings() : std::vector<InitGraph::Timing>{};
+}
+
+void Application::reportInitTimings(InitGraph::Stage stage, std::chrono::milliseconds elapsed) const {
+    auto& logger = Logger::instance();
+    const char* label = stage == InitGraph::Stage::Startup ? "Startup" : "Deferred";
+    
+    for (const auto& timing : m_initGraph->timings()) {
+        if (timing.stage != stage) continue;
+        StartupTrace::instance().record("init." + timing.name, "init", timing.start, timing.duration, timing.thread);
+        logger.debug("{} init: {} took {:.1f}ms{}", label, timing.name,
+                     timing.duration.count() / 1000.0, timing.ok ? "" : " (failed)");
+    }
+    logger.info("{} initialization finished in {}ms", label, elapsed.count());
+}
+
 void Application::shutdown() {
     if (m_state == AppState::ShuttingDown || m_state == AppState::Uninitialized) {
         return;
@@ -110,10 +121,16 @@ void Application::shutdown() {
     setState(AppState::ShuttingDown);
     Logger::instance().info("Shutting down application...");
     
+    // Let deferred initialization finish before tearing subsystems down
+    if (m_deferredInit.joinable()) {
+        m_deferredInit.join();
+    }
+    
     // Stop any running game
     stopGame();
     
-    // Save configuration
+    // Save configuration (stops auto-save and compacts the journal)
+    Config::instance().disableAutoSave();
     Config::instance().save(
         (utils::PathUtils::getAppDataPath() / "KonamiClient" / "config.json").string()
     );
@@ -121,13 +138,23 @@ void Application::shutdown() {
     // Shutdown subsystems in reverse order
     m_pluginManager.reset();
     m_themeManager.reset();
-    m_skinManager.reset();
-    m_modManager.reset();
+    {
+        std::lock_guard<std::mutex> lock(m_deferredMutex);
+        m_skinManager.reset();
+        m_modManager.reset();
+    }
     m_profileManager.reset();
     m_versionManager.reset();
     m_downloadManager.reset();
     m_authManager.reset();
     
+    if (auto cache = utils::HttpClient::instance().cache()) {
+        auto stats = cache->stats();
+        Logger::instance().info("HTTP cache: {} hits, {} revalidated, {} misses, {} stale served",
+                                stats.hits, stats.revalidated, stats.misses, stats.staleServed);
+        utils::HttpClient::instance().setCache(nullptr);
+    }
+    
     EventBus::instance().emit("app.shutdown", {});
     Logger::instance().info("Application shutdown complete");
     
@@ -209,6 +236,11 @@ bool Application::initializeDownloader() {
     try {
         m_downloadManager = std::make_shared<downloader::DownloadManager>();
         m_downloadManager->initialize();
+        
+        // Metadata requests revalidate against the shared response cache
+        utils::HttpClient::instance().setCache(
+            std::make_shared<utils::HttpCache>(utils::PathUtils::getCachePath() / "http")
+        );
         return true;
     } catch (const std::exception& e) {
         Logger::instance().error("Downloader initialization error: {}", e.what());
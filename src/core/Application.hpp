@@ -7,12 +7,16 @@
  * Coordinates all subsystems including auth, downloads, mods, and game launching.
  */
 
+#include "InitGraph.hpp"
+#include "StartupTrace.hpp"
+
 #include <memory>
 #include <atomic>
 #include <string>
 #include <functional>
 #include <vector>
 #include <mutex>
+#include <thread>
 
 // Forward declarations in correct namespaces
 namespace konami::core::auth { class AuthManager; }
@@ -66,11 +70,27 @@ public:
     Application& operator=(Application&&) = delete;
     
     /**
-     * Initialize all application subsystems
+     * Initialize the subsystems needed for the first frame
+     *
+     * Independent subsystems initialise concurrently on the global
+     * ThreadPool; the call returns once all of them have finished.
      * @return true if initialization successful
      */
     bool initialize();
     
+    /**
+     * Start initializing non-critical subsystems (mods, skins) in the
+     * background. Call once the first frame is on screen; emits
+     * "app.deferredInitialized" when done.
+     */
+    void initializeDeferred();
+    
+    /**
+     * Get per-subsystem initialization timings
+     * @return Timings of finished subsystems, in completion order
+     */
+    std::vector<InitGraph::Timing> getInitTimings() const;
+    
     /**
      * Shutdown the application gracefully
      */
@@ -104,7 +124,10 @@ public:
      * Get mod manager instance
      * @return Shared pointer to ModManager
      */
-    std::shared_ptr<::konami::mods::ModManager> getModManager() const { return m_modManager; }
+    std::shared_ptr<::konami::mods::ModManager> getModManager() const {
+        std::lock_guard<std::mutex> lock(m_deferredMutex);
+        return m_modManager;
+    }
     
     /**
      * Get profile manager instance
@@ -122,7 +145,10 @@ public:
      * Get skin manager instance
      * @return Shared pointer to SkinManager
      */
-    std::shared_ptr<::konami::skin::SkinManager> getSkinManager() const { return m_skinManager; }
+    std::shared_ptr<::konami::skin::SkinManager> getSkinManager() const {
+        std::lock_guard<std::mutex> lock(m_deferredMutex);
+        return m_skinManager;
+    }
     
     /**
      * Get theme manager instance
@@ -173,6 +199,13 @@ private:
      */
     void setState(AppState state);
     
+    /**
+     * Log timings of one initialization stage and add them to the startup trace
+     * @param stage Stage that just finished
+     * @param elapsed Wall time of the stage
+     */
+    void reportInitTimings(InitGraph::Stage stage, std::chrono::milliseconds elapsed) const;
+    
     /**
      * Initialize authentication subsystem
      * @return true if successful
@@ -229,6 +262,13 @@ private:
     std::vector<std::function<void(AppState)>> m_stateCallbacks;
     std::mutex m_callbackMutex;
     
+    // Subsystem initialization order and timings
+    std::unique_ptr<InitGraph> m_initGraph;
+    std::thread m_deferredInit;
+    
+    // Guards managers that are created after startup (mods, skins)
+    mutable std::mutex m_deferredMutex;
+    
     // Subsystem managers
     std::shared_ptr<auth::AuthManager> m_authManager;
     std::shared_ptr<downloader::DownloadManager> m_downloadManager;
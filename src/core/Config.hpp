@@ -5,6 +5,12 @@
  * 
  * Configuration management using JSON.
  * Provides type-safe access to configuration values with defaults.
+ * 
+ * Reads never take a lock: the configuration is published as an
+ * immutable snapshot behind an atomic shared pointer, and writers
+ * build and publish a new snapshot under the writer mutex. Each reading
+ * thread caches the snapshot it last saw and only reloads the shared
+ * pointer when the published revision changes.
  */
 
 #include <nlohmann/json.hpp>
@@ -13,16 +19,54 @@
 #include <mutex>
 #include <fstream>
 #include <filesystem>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <algorithm>
+
+#include "../utils/FileUtils.hpp"
 
 namespace konami::core {
 
 using json = nlohmann::json;
 
+/**
+ * Immutable configuration snapshot
+ * 
+ * Holds the full configuration tree plus the nodes resolved for every
+ * registered ConfigKey, so typed reads are a single index into `resolved`.
+ */
+struct ConfigSnapshot {
+    json root;
+    std::vector<const json*> resolved;
+    uint64_t revision{0};
+};
+
+using ConfigSnapshotPtr = std::shared_ptr<const ConfigSnapshot>;
+
+/**
+ * Configuration change callback
+ * @param key Dot-notation key that changed
+ * @param value New value (null if the key was removed)
+ */
+using ConfigChangeCallback = std::function<void(const std::string& key, const json& value)>;
+
+template<typename T>
+class ConfigKey;
+
 /**
  * Configuration manager - Thread-safe singleton
  * 
  * Manages application settings with:
  * - Type-safe getters with defaults
+ * - Lock-free snapshot reads and pre-compiled keys
+ * - Change subscriptions
  * - JSON persistence
  * - Hot-reload support
  */
@@ -39,67 +83,183 @@ public:
     
     /**
      * Load configuration from file
+     * 
+     * Replays the change journal next to the file, if one exists and was
+     * written against the same base contents.
+     * 
      * @param path Path to config file
      * @return true if loaded successfully
      */
     bool load(const std::string& path) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
         
         try {
             if (!std::filesystem::exists(path)) {
                 return false;
             }
             
-            std::ifstream file(path);
+            std::ifstream file(path, std::ios::binary);
             if (!file.is_open()) {
                 return false;
             }
             
-            m_config = json::parse(file);
+            std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            m_config = json::parse(content);
             m_configPath = path;
-            return true;
+            m_baseDigest = digest(content);
+            m_journalEntries = replayJournal(journalPath(path), m_baseDigest, m_config);
             
         } catch (const json::exception& e) {
             return false;
         }
+        
+        m_savedGeneration = m_changeGeneration;
+        ConfigSnapshotPtr loaded = publishLocked(lock);
+        
+        if (!lock.owns_lock()) {
+            lock.lock();
+        }
+        m_persisted = loaded;
+        return true;
     }
     
     /**
      * Save configuration to file
+     * 
+     * Always rewrites the whole file (write to temp, fsync, rename) and
+     * discards the change journal.
+     * 
      * @param path Path to config file (uses loaded path if empty)
      * @return true if saved successfully
      */
     bool save(const std::string& path = "") {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard<std::mutex> ioLock(m_saveMutex);
         
-        std::string savePath = path.empty() ? m_configPath : path;
-        if (savePath.empty()) {
-            return false;
+        ConfigSnapshotPtr snap;
+        uint64_t generation = 0;
+        std::string savePath;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            savePath = path.empty() ? m_configPath : path;
+            if (savePath.empty()) {
+                return false;
+            }
+            if (m_configPath.empty()) {
+                m_configPath = savePath;
+            }
+            snap = snapshot();
+            generation = m_changeGeneration;
         }
         
-        try {
-            std::filesystem::create_directories(
-                std::filesystem::path(savePath).parent_path()
-            );
-            
-            std::ofstream file(savePath);
-            if (!file.is_open()) {
+        return writeFull(savePath, snap, generation);
+    }
+    
+    /**
+     * Write pending changes now
+     * 
+     * With the journal enabled, appends a JSON patch against the last
+     * persisted state instead of rewriting the file, compacting once the
+     * journal grows past its limit.
+     * 
+     * @return true if nothing was pending or the write succeeded
+     */
+    bool flush() {
+        std::lock_guard<std::mutex> ioLock(m_saveMutex);
+        
+        ConfigSnapshotPtr snap;
+        ConfigSnapshotPtr persisted;
+        uint64_t generation = 0;
+        std::string savePath;
+        std::string baseDigest;
+        bool useJournal = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_changeGeneration == m_savedGeneration) {
+                return true;
+            }
+            if (m_configPath.empty()) {
                 return false;
             }
-            
-            file << m_config.dump(4);
-            return true;
-            
-        } catch (const std::exception& e) {
-            return false;
+            snap = snapshot();
+            persisted = m_persisted;
+            generation = m_changeGeneration;
+            savePath = m_configPath;
+            baseDigest = m_baseDigest;
+            useJournal = m_journalEnabled && persisted && m_journalEntries < kMaxJournalEntries;
         }
+        
+        if (!useJournal) {
+            return writeFull(savePath, snap, generation);
+        }
+        
+        json patch = json::diff(persisted->root, snap->root);
+        if (!patch.empty()) {
+            json entry = {{"base", baseDigest}, {"patch", std::move(patch)}};
+            if (!utils::FileUtils::appendFileDurable(journalPath(savePath), entry.dump() + "\n")) {
+                return writeFull(savePath, snap, generation);
+            }
+        }
+        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_persisted = snap;
+        m_savedGeneration = generation;
+        ++m_journalEntries;
+        return true;
+    }
+    
+    /**
+     * Start debounced background saving
+     * 
+     * Changes are written once no further change has happened for
+     * `delay`, and at the latest after 10x `delay` under a steady stream
+     * of changes.
+     * 
+     * @param delay Quiet period before writing
+     * @param useJournal Append JSON patches instead of rewriting the file
+     */
+    void enableAutoSave(std::chrono::milliseconds delay = std::chrono::milliseconds(1500),
+                        bool useJournal = false) {
+        disableAutoSave();
+        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_saveDelay = delay;
+        m_journalEnabled = useJournal;
+        m_stopAutoSave = false;
+        m_savePending = m_changeGeneration != m_savedGeneration;
+        m_pendingSince = m_lastChange = std::chrono::steady_clock::now();
+        m_saveThread = std::thread([this] { autoSaveLoop(); });
+    }
+    
+    /**
+     * Stop background saving and write any pending changes
+     */
+    void disableAutoSave() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_saveThread.joinable()) {
+                return;
+            }
+            m_stopAutoSave = true;
+        }
+        m_saveCondition.notify_all();
+        m_saveThread.join();
+        flush();
+    }
+    
+    /**
+     * Check for changes not yet written to disk
+     * @return true if there are unsaved changes
+     */
+    bool isDirty() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_changeGeneration != m_savedGeneration;
     }
     
     /**
      * Set default configuration values
      */
     void setDefaults() {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
         
         m_config = {
             {"version", "1.0.0"},
@@ -156,22 +316,29 @@ public:
                 {"cacheSize", 1024}
             }}
         };
+        
+        markDirtyLocked();
+        publishLocked(lock);
     }
     
     /**
      * Get configuration value with dot notation
+     * 
+     * Lock-free, but converts the key on every call. Prefer a
+     * ConfigKey on hot paths.
+     * 
      * @param key Key path (e.g., "theme.current")
      * @param defaultValue Default value if key not found
      * @return Configuration value
      */
     template<typename T>
     T get(const std::string& key, const T& defaultValue = T{}) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        const ConfigSnapshot& snap = currentSnapshot();
         
         try {
             json::json_pointer ptr = toJsonPointer(key);
-            if (m_config.contains(ptr)) {
-                return m_config.at(ptr).get<T>();
+            if (snap.root.contains(ptr)) {
+                return snap.root.at(ptr).get<T>();
             }
         } catch (const json::exception&) {
             // Fall through to default
@@ -180,6 +347,14 @@ public:
         return defaultValue;
     }
     
+    /**
+     * Get configuration value through a pre-compiled key
+     * @param key Compiled key
+     * @return Configuration value, or the key's default
+     */
+    template<typename T>
+    T get(const ConfigKey<T>& key) const;
+    
     /**
      * Set configuration value with dot notation
      * @param key Key path (e.g., "theme.current")
@@ -187,27 +362,41 @@ public:
      */
     template<typename T>
     void set(const std::string& key, const T& value) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
         
         try {
             json::json_pointer ptr = toJsonPointer(key);
+            if (m_config.contains(ptr) && m_config.at(ptr) == json(value)) {
+                return;
+            }
             m_config[ptr] = value;
         } catch (const json::exception& e) {
-            // Log error
+            return;
         }
+        
+        markDirtyLocked();
+        publishLocked(lock);
     }
     
+    /**
+     * Set configuration value through a pre-compiled key
+     * @param key Compiled key
+     * @param value Value to set
+     */
+    template<typename T>
+    void set(const ConfigKey<T>& key, const T& value);
+    
     /**
      * Check if key exists
      * @param key Key path
      * @return true if key exists
      */
     bool has(const std::string& key) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        const ConfigSnapshot& snap = currentSnapshot();
         
         try {
             json::json_pointer ptr = toJsonPointer(key);
-            return m_config.contains(ptr);
+            return snap.root.contains(ptr);
         } catch (const json::exception&) {
             return false;
         }
@@ -218,7 +407,7 @@ public:
      * @param key Key path
      */
     void remove(const std::string& key) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
         
         try {
             json::json_pointer ptr = toJsonPointer(key);
@@ -237,7 +426,11 @@ public:
             }
         } catch (const json::exception&) {
             // Key doesn't exist or invalid path
+            return;
         }
+        
+        markDirtyLocked();
+        publishLocked(lock);
     }
     
     /**
@@ -245,8 +438,23 @@ public:
      * @return JSON configuration object
      */
     json getAll() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_config;
+        return snapshot()->root;
+    }
+    
+    /**
+     * Get the current immutable snapshot
+     * 
+     * The snapshot stays valid for as long as the caller holds it, even
+     * if the configuration is changed concurrently.
+     * 
+     * @return Current snapshot
+     */
+    ConfigSnapshotPtr snapshot() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return m_snapshot.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+#endif
     }
     
     /**
@@ -254,19 +462,66 @@ public:
      * @param other JSON object to merge
      */
     void merge(const json& other) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
         m_config.merge_patch(other);
+        markDirtyLocked();
+        publishLocked(lock);
     }
-
-private:
-    Config() {
-        setDefaults();
+    
+    /**
+     * Subscribe to changes of a key or subtree
+     * 
+     * The callback runs on the writing thread after the new snapshot has
+     * been published, and only when the value at `key` actually changed.
+     * Callbacks are serialized and never see an older revision after a
+     * newer one; when writers race, a superseded value may be skipped.
+     * 
+     * @param key Key path (e.g., "downloads.maxConcurrent" or "downloads")
+     * @param callback Change callback
+     * @return Subscription id for unsubscribe()
+     */
+    uint64_t subscribe(const std::string& key, ConfigChangeCallback callback) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        uint64_t id = ++m_nextListenerId;
+        m_listeners.push_back({id, key, toJsonPointer(key), std::move(callback)});
+        return id;
     }
     
-    ~Config() = default;
+    /**
+     * Remove a change subscription
+     * @param id Subscription id returned by subscribe()
+     */
+    void unsubscribe(uint64_t id) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::erase_if(m_listeners, [id](const Listener& listener) {
+                return listener.id == id;
+            });
+        }
+        
+        std::lock_guard<std::recursive_mutex> dispatch(m_dispatchMutex);
+        m_deliveredRevisions.erase(id);
+    }
     
-    Config(const Config&) = delete;
-    Config& operator=(const Config&) = delete;
+    /**
+     * Register a compiled key and resolve it in the published snapshot
+     * @param pointer JSON pointer of the key
+     * @return Slot index into ConfigSnapshot::resolved
+     */
+    size_t registerKey(const json::json_pointer& pointer) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        for (size_t i = 0; i < m_keyPointers.size(); ++i) {
+            if (m_keyPointers[i] == pointer) {
+                return i;
+            }
+        }
+        
+        m_keyPointers.push_back(pointer);
+        publishLocked(lock, false);
+        return m_keyPointers.size() - 1;
+    }
     
     /**
      * Convert dot notation to JSON pointer
@@ -286,9 +541,372 @@ private:
     }
 
 private:
+    Config() {
+        setDefaults();
+    }
+    
+    ~Config() {
+        disableAutoSave();
+    }
+    
+    Config(const Config&) = delete;
+    Config& operator=(const Config&) = delete;
+    
+    static constexpr size_t kMaxJournalEntries = 64;
+    
+    /**
+     * Record a mutation and wake the auto-save thread
+     */
+    void markDirtyLocked() {
+        ++m_changeGeneration;
+        auto now = std::chrono::steady_clock::now();
+        if (!m_savePending) {
+            m_pendingSince = now;
+        }
+        m_lastChange = now;
+        m_savePending = true;
+        m_saveCondition.notify_all();
+    }
+    
+    /**
+     * Auto-save thread: wait for changes, debounce, then flush
+     */
+    void autoSaveLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        while (true) {
+            m_saveCondition.wait(lock, [this] { return m_stopAutoSave || m_savePending; });
+            if (m_stopAutoSave) {
+                return;
+            }
+            
+            // Wait for a quiet period, bounded so constant changes still get saved
+            while (!m_stopAutoSave) {
+                auto deadline = std::min(m_lastChange + m_saveDelay, m_pendingSince + m_saveDelay * 10);
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
+                m_saveCondition.wait_until(lock, deadline);
+            }
+            if (m_stopAutoSave) {
+                return;
+            }
+            
+            m_savePending = false;
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+    
+    /**
+     * Rewrite the config file atomically and drop the journal
+     * @param path Target path
+     * @param snap Snapshot to write
+     * @param generation Change generation captured with the snapshot
+     * @return true if written
+     */
+    bool writeFull(const std::string& path, const ConfigSnapshotPtr& snap, uint64_t generation) {
+        try {
+            std::string content = snap->root.dump(4);
+            if (!utils::FileUtils::writeFileAtomic(path, content)) {
+                return false;
+            }
+            
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (path != m_configPath) {
+                return true;
+            }
+            
+            std::error_code ec;
+            std::filesystem::remove(journalPath(path), ec);
+            m_baseDigest = digest(content);
+            m_journalEntries = 0;
+            m_persisted = snap;
+            m_savedGeneration = generation;
+            return true;
+            
+        } catch (const std::exception& e) {
+            return false;
+        }
+    }
+    
+    /**
+     * Apply journal entries written against the given base
+     * @param path Journal path
+     * @param baseDigest Digest of the loaded base file
+     * @param target Configuration to patch
+     * @return Number of entries applied
+     */
+    static size_t replayJournal(const std::string& path, const std::string& baseDigest, json& target) {
+        std::ifstream journal(path);
+        if (!journal.is_open()) {
+            return 0;
+        }
+        
+        size_t applied = 0;
+        std::string line;
+        while (std::getline(journal, line)) {
+            try {
+                json entry = json::parse(line);
+                if (entry.value("base", "") != baseDigest) {
+                    // Stale journal from before the last full save
+                    break;
+                }
+                target = target.patch(entry.at("patch"));
+                ++applied;
+            } catch (const json::exception&) {
+                // Torn trailing write - stop replaying
+                break;
+            }
+        }
+        return applied;
+    }
+    
+    static std::string journalPath(const std::string& configPath) {
+        return configPath + ".journal";
+    }
+    
+    /**
+     * Stable FNV-1a digest identifying a base file for its journal
+     */
+    static std::string digest(const std::string& content) {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : content) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return std::to_string(content.size()) + "-" + std::to_string(hash);
+    }
+    
+    /**
+     * Publish m_config as a new snapshot and notify listeners
+     * 
+     * Must be called with m_mutex held through `lock`; the lock is
+     * released before listeners are invoked.
+     * 
+     * @param lock Held writer lock
+     * @param notify Whether to run change listeners
+     * @return The published snapshot
+     */
+    ConfigSnapshotPtr publishLocked(std::unique_lock<std::mutex>& lock, bool notify = true) {
+        auto next = std::make_shared<ConfigSnapshot>();
+        next->root = m_config;
+        next->resolved.reserve(m_keyPointers.size());
+        for (const auto& pointer : m_keyPointers) {
+            next->resolved.push_back(
+                next->root.contains(pointer) ? &next->root.at(pointer) : nullptr
+            );
+        }
+        
+        ConfigSnapshotPtr previous = snapshot();
+        next->revision = previous ? previous->revision + 1 : 1;
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+        m_snapshot.store(next, std::memory_order_release);
+#else
+        std::atomic_store_explicit(&m_snapshot, ConfigSnapshotPtr(next), std::memory_order_release);
+#endif
+        m_revision.store(next->revision, std::memory_order_release);
+        
+        if (!notify || !previous || m_listeners.empty()) {
+            return next;
+        }
+        
+        // Collect changed keys while still holding the lock, call outside it
+        std::vector<std::pair<const Listener*, json>> changed;
+        std::vector<Listener> listeners = m_listeners;
+        for (const auto& listener : listeners) {
+            const json* before = previous->root.contains(listener.pointer)
+                ? &previous->root.at(listener.pointer) : nullptr;
+            const json* after = next->root.contains(listener.pointer)
+                ? &next->root.at(listener.pointer) : nullptr;
+                
+            if ((before == nullptr) != (after == nullptr) ||
+                (before && after && *before != *after)) {
+                changed.emplace_back(&listener, after ? *after : json(nullptr));
+            }
+        }
+        
+        lock.unlock();
+        
+        // Dispatch is serialized, and taken only after the writer lock is
+        // released so callbacks may write. A concurrent writer can publish
+        // a newer revision and dispatch it first; the older one is then
+        // skipped for every listener that already saw the newer value.
+        std::lock_guard<std::recursive_mutex> dispatch(m_dispatchMutex);
+        for (const auto& [listener, value] : changed) {
+            uint64_t& delivered = m_deliveredRevisions[listener->id];
+            if (delivered > next->revision) {
+                continue;
+            }
+            delivered = next->revision;
+            try {
+                listener->callback(listener->key, value);
+            } catch (const std::exception&) {
+                // Listener errors must not break writers
+            }
+        }
+        
+        return next;
+    }
+
+private:
+    /**
+     * Snapshot for reads that finish within the calling function
+     * 
+     * Returns this thread's cached snapshot while its revision matches
+     * the published one, so a read is a single atomic load of the
+     * revision instead of a shared_ptr copy with two refcount updates.
+     * The cache keeps at most one superseded snapshot alive per thread
+     * until that thread reads again.
+     * 
+     * @return Snapshot valid until this thread's next read
+     */
+    const ConfigSnapshot& currentSnapshot() const {
+        struct Cached {
+            const Config* owner{nullptr};
+            uint64_t revision{0};
+            ConfigSnapshotPtr snapshot;
+        };
+        static thread_local Cached cached;
+        
+        uint64_t revision = m_revision.load(std::memory_order_acquire);
+        if (cached.owner != this || cached.revision != revision || !cached.snapshot) {
+            cached.snapshot = snapshot();
+            cached.owner = this;
+            cached.revision = cached.snapshot->revision;
+        }
+        return *cached.snapshot;
+    }
+    
+    struct Listener {
+        uint64_t id;
+        std::string key;
+        json::json_pointer pointer;
+        ConfigChangeCallback callback;
+    };
+    
     mutable std::mutex m_mutex;
     json m_config;
     std::string m_configPath;
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<ConfigSnapshotPtr> m_snapshot;
+#else
+    ConfigSnapshotPtr m_snapshot;
+#endif
+    std::atomic<uint64_t> m_revision{0};
+    
+    std::vector<json::json_pointer> m_keyPointers;
+    std::vector<Listener> m_listeners;
+    uint64_t m_nextListenerId{0};
+    
+    // Listener dispatch; recursive so a callback may write (guards m_deliveredRevisions)
+    std::recursive_mutex m_dispatchMutex;
+    std::unordered_map<uint64_t, uint64_t> m_deliveredRevisions;   // Listener id -> last revision
+    
+    // Persistence state (guarded by m_mutex; file writes serialized by m_saveMutex)
+    std::mutex m_saveMutex;
+    ConfigSnapshotPtr m_persisted;
+    std::string m_baseDigest;
+    size_t m_journalEntries{0};
+    bool m_journalEnabled{false};
+    uint64_t m_changeGeneration{0};
+    uint64_t m_savedGeneration{0};
+    
+    // Debounced auto-save
+    std::thread m_saveThread;
+    std::condition_variable m_saveCondition;
+    std::chrono::milliseconds m_saveDelay{1500};
+    std::chrono::steady_clock::time_point m_lastChange;
+    std::chrono::steady_clock::time_point m_pendingSince;
+    bool m_savePending{false};
+    bool m_stopAutoSave{false};
+};
+
+/**
+ * Pre-compiled, typed configuration key
+ * 
+ * Parses the dot-notation path once and registers it with Config, which
+ * resolves the node in every published snapshot. Reads through the key
+ * are one atomic revision load plus an index, with no lock, refcount
+ * update or string building.
+ * 
+ * Usage:
+ *   static const ConfigKey<int> kRetryCount{"downloads.retryCount", 3};
+ *   int retries = kRetryCount.get();
+ */
+template<typename T>
+class ConfigKey {
+public:
+    /**
+     * Constructor
+     * @param key Dot-notation key path
+     * @param defaultValue Value returned when the key is missing or mistyped
+     */
+    ConfigKey(std::string key, T defaultValue = T{})
+        : m_key(std::move(key))
+        , m_pointer(Config::toJsonPointer(m_key))
+        , m_default(std::move(defaultValue))
+        , m_slot(Config::instance().registerKey(m_pointer)) {}
+        
+    const std::string& key() const { return m_key; }
+    const json::json_pointer& pointer() const { return m_pointer; }
+    const T& defaultValue() const { return m_default; }
+    size_t slot() const { return m_slot; }
+    
+    /**
+     * Read the current value
+     * @return Configuration value or default
+     */
+    T get() const { return Config::instance().get(*this); }
+    
+    /**
+     * Write a new value
+     * @param value Value to set
+     */
+    void set(const T& value) const { Config::instance().set(*this, value); }
+
+private:
+    std::string m_key;
+    json::json_pointer m_pointer;
+    T m_default;
+    size_t m_slot;
 };
 
+template<typename T>
+T Config::get(const ConfigKey<T>& key) const {
+    const ConfigSnapshot& snap = currentSnapshot();
+    
+    const json* node = key.slot() < snap.resolved.size()
+        ? snap.resolved[key.slot()] : nullptr;
+    if (node) {
+        try {
+            return node->get<T>();
+        } catch (const json::exception&) {
+            // Fall through to default
+        }
+    }
+    
+    return key.defaultValue();
+}
+
+template<typename T>
+void Config::set(const ConfigKey<T>& key, const T& value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    try {
+        if (m_config.contains(key.pointer()) && m_config.at(key.pointer()) == json(value)) {
+            return;
+        }
+        m_config[key.pointer()] = value;
+    } catch (const json::exception&) {
+        return;
+    }
+    
+    markDirtyLocked();
+    publishLocked(lock);
+}
+
 } // namespace konami::core
@@ -17,6 +17,8 @@
 #include <memory>
 #include <atomic>
 
+#include "Profiler.hpp"
+
 namespace konami::core {
 
 using json = nlohmann::json;
@@ -70,7 +72,7 @@ public:
      * @return Subscription handle for unsubscribing
      */
     SubscriptionPtr subscribe(const std::string& event, EventCallback callback) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard lock(m_mutex);
         
         uint64_t id = m_nextId++;
         auto subscription = std::make_shared<Subscription>(id, event);
@@ -89,7 +91,7 @@ public:
         
         subscription->cancel();
         
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard lock(m_mutex);
         
         auto& subscribers = m_subscribers[subscription->getEvent()];
         subscribers.erase(
@@ -107,10 +109,13 @@ public:
      * @param data Event data
      */
     void emit(const std::string& event, const json& data = json::object()) {
+        KONAMI_ZONE_NAMED("EventBus::emit");
+        KONAMI_ZONE_TEXT(event);
+        
         std::vector<EventCallback> callbacks;
         
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
+            std::lock_guard lock(m_mutex);
             
             auto it = m_subscribers.find(event);
             if (it != m_subscribers.end()) {
@@ -162,7 +167,7 @@ public:
         };
         
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
+            std::lock_guard lock(m_mutex);
             m_subscribers[event].push_back({subscription->getId(), std::move(wrappedCallback), subscription});
         }
         
@@ -175,7 +180,7 @@ public:
      * @return true if has subscribers
      */
     bool hasSubscribers(const std::string& event) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard lock(m_mutex);
         auto it = m_subscribers.find(event);
         return it != m_subscribers.end() && !it->second.empty();
     }
@@ -186,7 +191,7 @@ public:
      * @return Number of subscribers
      */
     size_t getSubscriberCount(const std::string& event) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard lock(m_mutex);
         auto it = m_subscribers.find(event);
         return it != m_subscribers.end() ? it->second.size() : 0;
     }
@@ -196,7 +201,7 @@ public:
      * @param event Event name
      */
     void clearEvent(const std::string& event) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard lock(m_mutex);
         m_subscribers.erase(event);
     }
     
@@ -204,7 +209,7 @@ public:
      * Clear all subscribers
      */
     void clear() {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::lock_guard lock(m_mutex);
         m_subscribers.clear();
     }
 
@@ -222,7 +227,7 @@ private:
         SubscriptionPtr subscription;
     };
     
-    mutable std::mutex m_mutex;
+    mutable KONAMI_LOCKABLE(std::mutex, m_mutex);
     std::unordered_map<std::string, std::vector<SubscriberEntry>> m_subscribers;
     std::atomic<uint64_t> m_nextId{0};
 };
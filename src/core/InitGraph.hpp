@@ -0,0 +1,229 @@
+#pragma once
+
+/**
+ * InitGraph.hpp
+ *
+ * Dependency-ordered, concurrent subsystem initialisation.
+ * Used by Application to bring up managers in parallel at startup and to
+ * defer non-critical ones until after the first frame.
+ */
+
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace konami::core {
+
+/**
+ * InitGraph - Subsystem initialisation DAG
+ *
+ * Each node is an init function with the names of the nodes it depends
+ * on. run() starts every node whose dependencies have finished on the
+ * pool, so independent subsystems initialise concurrently, and returns
+ * once the stage is done. A failed node skips everything that depends on
+ * it; the stage fails only if a critical node failed or was skipped.
+ *
+ * Nodes belong to a stage. Deferred nodes may depend on startup nodes
+ * (which are finished by then) but not the other way round. run() blocks
+ * on the pool, so it must not be called from one of the pool's threads.
+ *
+ * Per-node timings are kept for logging and tracing.
+ */
+class InitGraph {
+public:
+    enum class Stage {
+        Startup,    // Before the window is shown
+        Deferred    // After the first frame
+    };
+
+    /**
+     * Timing of one finished node
+     */
+    struct Timing {
+        std::string name;
+        Stage stage;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::microseconds duration{0};
+        std::thread::id thread;
+        bool ok{false};
+    };
+
+    /**
+     * Add a node
+     * @param name Unique node name
+     * @param dependencies Nodes that must finish first
+     * @param init Init function; returns false (or throws) on failure
+     * @param stage Stage the node runs in
+     * @param critical Whether failure fails the stage
+     */
+    void add(std::string name, std::vector<std::string> dependencies, std::function<bool()> init,
+             Stage stage = Stage::Startup, bool critical = true) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_order.push_back(name);
+        m_nodes[name] = Node{std::move(dependencies), std::move(init), stage, critical, NodeState::Pending};
+    }
+
+    /**
+     * Run every node of a stage, blocking until they have finished
+     * @param stage Stage to run
+     * @param pool Pool to run init functions on
+     * @return false if a critical node failed, was skipped or could not be ordered
+     */
+    bool run(Stage stage, ThreadPool& pool) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        validate(stage);
+        size_t running = 0;
+
+        while (true) {
+            bool changed = false;
+            for (const auto& name : m_order) {
+                auto& node = m_nodes[name];
+                if (node.stage != stage || node.state != NodeState::Pending) continue;
+
+                NodeState dependencies = dependencyState(node);
+                if (dependencies == NodeState::Failed) {
+                    Logger::instance().warn("Skipping {}: a dependency failed", name);
+                    node.state = NodeState::Failed;
+                    changed = true;
+                } else if (dependencies == NodeState::Done) {
+                    node.state = NodeState::Running;
+                    changed = true;
+                    if (start(name, node, pool)) ++running;
+                }
+            }
+
+            if (changed) continue;
+            if (running == 0) break;
+
+            // Wait for a running node to finish
+            size_t finished = m_finished;
+            m_condition.wait(lock, [&] { return m_finished != finished; });
+            running -= m_finished - finished;
+        }
+
+        bool ok = true;
+        for (const auto& name : m_order) {
+            auto& node = m_nodes[name];
+            if (node.stage != stage) continue;
+            if (node.state == NodeState::Pending) {
+                Logger::instance().error("Cannot initialise {}: dependency cycle", name);
+                node.state = NodeState::Failed;
+            }
+            if (node.critical && node.state != NodeState::Done) ok = false;
+        }
+        return ok;
+    }
+
+    /**
+     * Check whether a node finished successfully
+     */
+    bool succeeded(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_nodes.find(name);
+        return it != m_nodes.end() && it->second.state == NodeState::Done;
+    }
+
+    /**
+     * Timings of finished nodes, in completion order
+     */
+    std::vector<Timing> timings() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_timings;
+    }
+
+private:
+    enum class NodeState { Pending, Running, Done, Failed };
+
+    struct Node {
+        std::vector<std::string> dependencies;
+        std::function<bool()> init;
+        Stage stage;
+        bool critical;
+        NodeState state;
+    };
+
+    /**
+     * Fail nodes with unknown dependencies or dependencies in a later stage
+     */
+    void validate(Stage stage) {
+        for (const auto& name : m_order) {
+            auto& node = m_nodes[name];
+            if (node.stage != stage || node.state != NodeState::Pending) continue;
+
+            for (const auto& dependency : node.dependencies) {
+                auto it = m_nodes.find(dependency);
+                if (it == m_nodes.end() || it->second.stage > node.stage) {
+                    Logger::instance().error("Cannot initialise {}: invalid dependency {}", name, dependency);
+                    node.state = NodeState::Failed;
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * Done if every dependency is done, Failed if one failed, else Pending
+     */
+    NodeState dependencyState(const Node& node) const {
+        NodeState state = NodeState::Done;
+        for (const auto& dependency : node.dependencies) {
+            NodeState other = m_nodes.at(dependency).state;
+            if (other == NodeState::Failed) return NodeState::Failed;
+            if (other != NodeState::Done) state = NodeState::Pending;
+        }
+        return state;
+    }
+
+    /**
+     * Submit a node to the pool (called with m_mutex held)
+     * @return false if the pool refused it; the node is marked failed
+     */
+    bool start(const std::string& name, Node& node, ThreadPool& pool) {
+        auto task = [this, name, init = node.init, stage = node.stage] {
+            Timing timing{name, stage, std::chrono::steady_clock::now(), {}, std::this_thread::get_id(), false};
+            try {
+                timing.ok = init();
+            } catch (const std::exception& e) {
+                Logger::instance().error("{} initialisation error: {}", name, e.what());
+            }
+            timing.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - timing.start);
+            if (!timing.ok) {
+                Logger::instance().error("Failed to initialise {}", name);
+            }
+
+            // Notify under the lock: run() may return and the graph go away
+            // as soon as it can see the count
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_nodes[name].state = timing.ok ? NodeState::Done : NodeState::Failed;
+            m_timings.push_back(std::move(timing));
+            ++m_finished;
+            m_condition.notify_all();
+        };
+        try {
+            pool.submit(std::move(task));
+            return true;
+        } catch (const std::exception& e) {
+            Logger::instance().error("Cannot initialise {}: {}", name, e.what());
+            node.state = NodeState::Failed;
+            return false;
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::unordered_map<std::string, Node> m_nodes;
+    std::vector<std::string> m_order;   // Insertion order, for deterministic start order
+    std::vector<Timing> m_timings;
+    size_t m_finished{0};
+};
+
+} // namespace konami::core
@@ -54,14 +54,22 @@ public:
      * Initialize the logger
      * @param level Minimum log level
      * @param logDir Log file directory (optional)
+     * @param consoleToStderr Write console output to stderr, keeping stdout
+     *        free for machine-readable output (headless commands)
      */
     void initialize(LogLevel level = LogLevel::Info, 
-                   const std::string& logDir = "") {
+                   const std::string& logDir = "",
+                   bool consoleToStderr = false) {
         try {
             std::vector<spdlog::sink_ptr> sinks;
             
             // Console sink with colors
-            auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+            spdlog::sink_ptr consoleSink;
+            if (consoleToStderr) {
+                consoleSink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+            } else {
+                consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+            }
             consoleSink->set_level(toSpdlogLevel(level));
             consoleSink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%t] %v");
             sinks.push_back(consoleSink);
@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * Profiler.hpp
+ *
+ * Thin macro layer over the Tracy profiler. With KONAMI_ENABLE_TRACY off
+ * every macro compiles to nothing (or to the plain mutex type), so
+ * instrumented code costs nothing in normal builds.
+ *
+ *   KONAMI_ZONE()                       Zone named after the enclosing function
+ *   KONAMI_ZONE_NAMED("name")           Zone with an explicit name
+ *   KONAMI_ZONE_TEXT(str)               Attach a std::string to the current zone
+ *   KONAMI_PLOT("name", value)          Plot a numeric value over time
+ *   KONAMI_FRAME_MARK()                 End of a UI frame
+ *   KONAMI_THREAD_NAME("name")          Name the calling thread
+ *   KONAMI_LOCKABLE(std::mutex, m_x)    Mutex member whose waits and holds are traced
+ *
+ * A KONAMI_LOCKABLE mutex works with CTAD lock guards (std::lock_guard
+ * lock(m_x)) and must be waited on through LockableConditionVariable.
+ */
+
+#include <condition_variable>
+#include <mutex>
+
+#ifdef KONAMI_ENABLE_TRACY
+
+#include <tracy/Tracy.hpp>
+
+#define KONAMI_ZONE()                   ZoneScoped
+#define KONAMI_ZONE_NAMED(name)         ZoneScopedN(name)
+#define KONAMI_ZONE_TEXT(text)          ZoneText((text).data(), (text).size())
+#define KONAMI_PLOT(name, value)        TracyPlot(name, value)
+#define KONAMI_FRAME_MARK()             FrameMark
+#define KONAMI_THREAD_NAME(name)        tracy::SetThreadName(name)
+#define KONAMI_LOCKABLE(type, name)     TracyLockable(type, name)
+
+namespace konami::core {
+using LockableConditionVariable = std::condition_variable_any;
+} // namespace konami::core
+
+#else
+
+#define KONAMI_ZONE()                   ((void)0)
+#define KONAMI_ZONE_NAMED(name)         ((void)0)
+#define KONAMI_ZONE_TEXT(text)          ((void)0)
+#define KONAMI_PLOT(name, value)        ((void)0)
+#define KONAMI_FRAME_MARK()             ((void)0)
+#define KONAMI_THREAD_NAME(name)        ((void)0)
+#define KONAMI_LOCKABLE(type, name)     type name
+
+namespace konami::core {
+using LockableConditionVariable = std::condition_variable;
+} // namespace konami::core
+
+#endif
@@ -0,0 +1,220 @@
+#pragma once
+
+/**
+ * StartupTrace.hpp
+ *
+ * Always-on timeline of named spans for launcher startup and game launch.
+ * Spans are recorded relative to the start of main() and can be exported
+ * as Chrome trace JSON (chrome://tracing, Perfetto).
+ */
+
+#include "../utils/FileUtils.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace konami::core {
+
+/**
+ * StartupTrace - Process-wide span recorder
+ *
+ * Recording is a mutex-protected push into a bounded vector, cheap enough
+ * to leave on in release builds. Call instance() first thing in main() so
+ * that timestamps start there.
+ *
+ * Usage:
+ *   auto span = StartupTrace::instance().span("config.load");
+ *   ...     // span ends when it goes out of scope, or at span.end()
+ */
+class StartupTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kMaxEvents = 4096;
+
+    /**
+     * Recorded event; a zero duration with instant=true is a point in time
+     */
+    struct Event {
+        std::string name;
+        std::string category;
+        std::chrono::microseconds start{0};     // Since the trace origin
+        std::chrono::microseconds duration{0};
+        int thread{0};
+        bool instant{false};
+    };
+
+    /**
+     * RAII span; records itself when ended or destroyed
+     */
+    class Span {
+    public:
+        Span(StartupTrace* trace, std::string name, std::string category)
+            : m_trace(trace), m_name(std::move(name)), m_category(std::move(category)), m_start(Clock::now()) {}
+
+        Span(Span&& other) noexcept
+            : m_trace(std::exchange(other.m_trace, nullptr))
+            , m_name(std::move(other.m_name))
+            , m_category(std::move(other.m_category))
+            , m_start(other.m_start) {}
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+        Span& operator=(Span&&) = delete;
+
+        ~Span() { end(); }
+
+        /**
+         * End the span now
+         */
+        void end() {
+            if (m_trace) {
+                m_trace->record(m_name, m_category, m_start, Clock::now() - m_start, std::this_thread::get_id());
+                m_trace = nullptr;
+            }
+        }
+
+    private:
+        StartupTrace* m_trace;
+        std::string m_name;
+        std::string m_category;
+        Clock::time_point m_start;
+    };
+
+    /**
+     * Get singleton instance
+     * @return Reference to StartupTrace instance
+     */
+    static StartupTrace& instance() {
+        static StartupTrace instance;
+        return instance;
+    }
+
+    /**
+     * Start a span on the calling thread
+     * @param name Span name, e.g. "config.load"
+     * @param category Trace category, e.g. "startup" or "launch"
+     */
+    Span span(std::string name, std::string category = "startup") {
+        return Span(this, std::move(name), std::move(category));
+    }
+
+    /**
+     * Record a finished span, e.g. one timed elsewhere
+     * @param name Span name
+     * @param category Trace category
+     * @param start When the span started
+     * @param duration How long it took
+     * @param thread Thread it ran on
+     */
+    void record(std::string name, std::string category, Clock::time_point start, Clock::duration duration,
+                std::thread::id thread) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_events.size() >= kMaxEvents) return;
+        m_events.push_back(Event{std::move(name), std::move(category), sinceOrigin(start),
+                                 std::chrono::duration_cast<std::chrono::microseconds>(duration),
+                                 threadIndex(thread), false});
+    }
+
+    /**
+     * Record a point in time on the calling thread
+     * @param name Event name, e.g. "ui.firstFrame"
+     * @param category Trace category
+     */
+    void mark(std::string name, std::string category = "startup") {
+        auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_events.size() >= kMaxEvents) return;
+        m_events.push_back(Event{std::move(name), std::move(category), sinceOrigin(now), {},
+                                 threadIndex(std::this_thread::get_id()), true});
+    }
+
+    /**
+     * Name the calling thread in exported traces
+     */
+    void setThreadName(std::string name) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threadNames[threadIndex(std::this_thread::get_id())] = std::move(name);
+    }
+
+    /**
+     * Time since the trace origin (start of main)
+     */
+    std::chrono::milliseconds elapsed() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_origin);
+    }
+
+    /**
+     * Copy of the recorded events, in recording order
+     */
+    std::vector<Event> events() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_events;
+    }
+
+    /**
+     * Write the trace in Chrome trace event format
+     * @param path Output file
+     * @return true if written
+     */
+    bool exportChromeTrace(const std::filesystem::path& path) const {
+        nlohmann::json events = nlohmann::json::array();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& [thread, name] : m_threadNames) {
+                events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", thread},
+                                  {"args", {{"name", name}}}});
+            }
+            for (const auto& event : m_events) {
+                nlohmann::json entry = {
+                    {"name", event.name}, {"cat", event.category}, {"pid", 1}, {"tid", event.thread},
+                    {"ts", event.start.count()}
+                };
+                if (event.instant) {
+                    entry["ph"] = "i";
+                    entry["s"] = "g";
+                } else {
+                    entry["ph"] = "X";
+                    entry["dur"] = event.duration.count();
+                }
+                events.push_back(std::move(entry));
+            }
+        }
+
+        nlohmann::json trace = {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+        return utils::FileUtils::writeFileAtomic(path, trace.dump());
+    }
+
+private:
+    StartupTrace() : m_origin(Clock::now()) {
+        m_threadNames[threadIndex(std::this_thread::get_id())] = "main";
+    }
+
+    std::chrono::microseconds sinceOrigin(Clock::time_point time) const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time - m_origin);
+    }
+
+    /**
+     * Small stable id for a thread (called with m_mutex held)
+     */
+    int threadIndex(std::thread::id thread) {
+        auto [it, inserted] = m_threads.try_emplace(thread, static_cast<int>(m_threads.size()) + 1);
+        return it->second;
+    }
+
+    const Clock::time_point m_origin;
+    mutable std::mutex m_mutex;
+    std::vector<Event> m_events;
+    std::unordered_map<std::thread::id, int> m_threads;
+    std::unordered_map<int, std::string> m_threadNames;
+};
+
+} // namespace konami::core
@@ -17,6 +17,8 @@
 #include <atomic>
 #include <stdexcept>
 
+#include "Profiler.hpp"
+
 namespace konami::core {
 
 /**
@@ -56,7 +58,7 @@ public:
      */
     ~ThreadPool() {
         {
-            std::unique_lock<std::mutex> lock(m_queueMutex);
+            std::unique_lock lock(m_queueMutex);
             m_stop = true;
         }
         
@@ -94,13 +96,14 @@ public:
         std::future<ReturnType> result = task->get_future();
         
         {
-            std::unique_lock<std::mutex> lock(m_queueMutex);
+            std::unique_lock lock(m_queueMutex);
             
             if (m_stop) {
                 throw std::runtime_error("Cannot submit to stopped ThreadPool");
             }
             
             m_tasks.emplace([task]() { (*task)(); });
+            KONAMI_PLOT("ThreadPool queue", static_cast<int64_t>(m_tasks.size() + m_priorityTasks.size()));
         }
         
         m_condition.notify_one();
@@ -127,13 +130,14 @@ public:
         std::future<ReturnType> result = task->get_future();
         
         {
-            std::unique_lock<std::mutex> lock(m_queueMutex);
+            std::unique_lock lock(m_queueMutex);
             
             if (m_stop) {
                 throw std::runtime_error("Cannot submit to stopped ThreadPool");
             }
             
             m_priorityTasks.emplace(priority, [task]() { (*task)(); });
+            KONAMI_PLOT("ThreadPool queue", static_cast<int64_t>(m_tasks.size() + m_priorityTasks.size()));
         }
         
         m_condition.notify_one();
@@ -153,7 +157,7 @@ public:
      * @return Queue size
      */
     size_t pendingTasks() const {
-        std::unique_lock<std::mutex> lock(m_queueMutex);
+        std::unique_lock lock(m_queueMutex);
         return m_tasks.size() + m_priorityTasks.size();
     }
     
@@ -177,7 +181,7 @@ public:
      * Wait for all tasks to complete
      */
     void waitAll() {
-        std::unique_lock<std::mutex> lock(m_queueMutex);
+        std::unique_lock lock(m_queueMutex);
         m_idleCondition.wait(lock, [this] {
             return m_tasks.empty() && m_priorityTasks.empty() && m_activeJobs == 0;
         });
@@ -197,11 +201,13 @@ private:
      * Worker thread loop
      */
     void workerLoop() {
+        KONAMI_THREAD_NAME("ThreadPool worker");
+        
         while (true) {
             std::function<void()> task;
             
             {
-                std::unique_lock<std::mutex> lock(m_queueMutex);
+                std::unique_lock lock(m_queueMutex);
                 
                 m_condition.wait(lock, [this] {
                     return m_stop || !m_tasks.empty() || !m_priorityTasks.empty();
@@ -224,6 +230,7 @@ private:
             if (task) {
                 ++m_activeJobs;
                 try {
+                    KONAMI_ZONE_NAMED("ThreadPool::task");
                     task();
                 } catch (...) {
                     // Log error but continue
@@ -232,7 +239,7 @@ private:
                 
                 // Check idle state under the lock to avoid race conditions
                 {
-                    std::lock_guard<std::mutex> lock(m_queueMutex);
+                    std::lock_guard lock(m_queueMutex);
                     if (m_tasks.empty() && m_priorityTasks.empty() && m_activeJobs == 0) {
                         m_idleCondition.notify_all();
                     }
@@ -258,9 +265,9 @@ private:
     std::queue<std::function<void()>> m_tasks;
     std::priority_queue<PriorityTask> m_priorityTasks;
     
-    mutable std::mutex m_queueMutex;
-    std::condition_variable m_condition;
-    std::condition_variable m_idleCondition;
+    mutable KONAMI_LOCKABLE(std::mutex, m_queueMutex);
+    LockableConditionVariable m_condition;
+    LockableConditionVariable m_idleCondition;
     
     std::atomic<bool> m_stop;
     std::atomic<size_t> m_activeJobs;
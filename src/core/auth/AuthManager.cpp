@@ -12,9 +12,40 @@
 
 #include <algorithm>
 #include <fstream>
+#include <random>
 
 namespace konami::core::auth {
 
+namespace {
+
+const ConfigKey<bool> kRefreshAllAccounts{"auth.refreshAllAccounts", false};
+
+// Scheduled refreshes start this long before expiry, minus up to kRefreshJitter
+constexpr auto kRefreshLead = std::chrono::minutes(10);
+constexpr auto kRefreshJitter = std::chrono::minutes(5);
+
+// Failed refreshes back off exponentially between these bounds
+constexpr auto kRetryBase = std::chrono::seconds(30);
+constexpr auto kRetryMax = std::chrono::minutes(30);
+
+/**
+ * Uniformly random duration in [0, max]
+ */
+std::chrono::seconds randomDuration(std::chrono::seconds max) {
+    thread_local std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<std::chrono::seconds::rep> dist(0, max.count());
+    return std::chrono::seconds(dist(gen));
+}
+
+/**
+ * Secure storage key for an account's Minecraft access token
+ */
+std::string accessTokenKey(const std::string& uuid) {
+    return uuid + ":minecraft";
+}
+
+} // namespace
+
 AuthManager::AuthManager()
     : m_microsoftAuth(std::make_unique<MicrosoftAuth>())
     , m_tokenStorage(std::make_unique<TokenStorage>()) {
@@ -51,6 +82,12 @@ void AuthManager::initialize() {
         }
     }
     
+    // Start the refresh scheduler
+    m_refreshAllAccounts = kRefreshAllAccounts.get();
+    m_stopRefresh = false;
+    m_refreshPool = std::make_unique<ThreadPool>(2);
+    m_refreshThread = std::thread(&AuthManager::refreshLoop, this);
+    
     m_initialized = true;
     Logger::instance().info("AuthManager initialized with {} accounts", m_accounts.size());
 }
@@ -60,6 +97,19 @@ void AuthManager::shutdown() {
     
     Logger::instance().info("Shutting down AuthManager");
     
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRefresh = true;
+    }
+    m_refreshCondition.notify_all();
+    if (m_refreshThread.joinable()) {
+        m_refreshThread.join();
+    }
+    
+    // Waits for refreshes already on the wire; queued ones return at once
+    m_refreshPool.reset();
+    m_refreshing.clear();
+    
     saveAccounts();
     
     // Save active account to config
@@ -69,9 +119,9 @@ void AuthManager::shutdown() {
 }
 
 std::future<std::optional<models::Account>> AuthManager::addMicrosoftAccount(
-    MicrosoftAuth::DeviceCodeCallback onDeviceCode,
-    MicrosoftAuth::AuthProgressCallback onProgress,
-    MicrosoftAuth::AuthCompleteCallback onComplete
+    DeviceCodeCallback onDeviceCode,
+    AuthProgressCallback onProgress,
+    AuthCompleteCallback onComplete
 ) {
     return std::async(std::launch::async, [this, onDeviceCode, onProgress, onComplete]()
         -> std::optional<models::Account> {
@@ -105,6 +155,7 @@ std::future<std::optional<models::Account>> AuthManager::addMicrosoftAccount(
             account.refreshToken = oauthToken->refreshToken;
             m_tokenStorage->storeToken(account.uuid, oauthToken->refreshToken);
         }
+        m_tokenStorage->storeToken(accessTokenKey(account.uuid), account.accessToken);
         
         // Add to accounts
         {
@@ -129,6 +180,7 @@ std::future<std::optional<models::Account>> AuthManager::addMicrosoftAccount(
                 m_activeAccountUuid = account.uuid;
             }
         }
+        m_refreshCondition.notify_all();
         
         saveAccounts();
         notifyAccountChange();
@@ -147,27 +199,33 @@ std::future<std::optional<models::Account>> AuthManager::addMicrosoftAccount(
 }
 
 bool AuthManager::removeAccount(const std::string& uuid) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    auto it = std::find_if(m_accounts.begin(), m_accounts.end(),
-        [&uuid](const models::Account& acc) {
-            return acc.uuid == uuid;
-        });
-    
-    if (it == m_accounts.end()) {
-        return false;
+    std::string username;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        auto it = std::find_if(m_accounts.begin(), m_accounts.end(),
+            [&uuid](const models::Account& acc) {
+                return acc.uuid == uuid;
+            });
+        
+        if (it == m_accounts.end()) {
+            return false;
+        }
+        
+        username = it->username;
+        m_accounts.erase(it);
+        m_refreshSchedule.erase(uuid);
+        
+        // Update active account if necessary
+        if (m_activeAccountUuid == uuid) {
+            m_activeAccountUuid = m_accounts.empty() ? "" : m_accounts.front().uuid;
+        }
     }
+    m_refreshCondition.notify_all();
     
-    std::string username = it->username;
-    m_accounts.erase(it);
-    
-    // Remove stored token
+    // Remove stored tokens
     m_tokenStorage->removeToken(uuid);
-    
-    // Update active account if necessary
-    if (m_activeAccountUuid == uuid) {
-        m_activeAccountUuid = m_accounts.empty() ? "" : m_accounts.front().uuid;
-    }
+    m_tokenStorage->removeToken(accessTokenKey(uuid));
     
     saveAccounts();
     notifyAccountChange();
@@ -222,27 +280,33 @@ std::optional<models::Account> AuthManager::getActiveAccount() const {
 }
 
 bool AuthManager::setActiveAccount(const std::string& uuid) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    auto it = std::find_if(m_accounts.begin(), m_accounts.end(),
-        [&uuid](const models::Account& acc) {
-            return acc.uuid == uuid;
-        });
-    
-    if (it == m_accounts.end()) {
-        return false;
+    std::string username;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        auto it = std::find_if(m_accounts.begin(), m_accounts.end(),
+            [&uuid](const models::Account& acc) {
+                return acc.uuid == uuid;
+            });
+        
+        if (it == m_accounts.end()) {
+            return false;
+        }
+        
+        m_activeAccountUuid = uuid;
+        username = it->username;
     }
     
-    m_activeAccountUuid = uuid;
-    
+    // The new account may be due for a refresh the scheduler wasn't tracking
+    m_refreshCondition.notify_all();
     notifyAccountChange();
     
     EventBus::instance().emit("auth.accountSwitched", {
         {"uuid", uuid},
-        {"username", it->username}
+        {"username", username}
     });
     
-    Logger::instance().info("Switched to account: {}", it->username);
+    Logger::instance().info("Switched to account: {}", username);
     
     return true;
 }
@@ -252,82 +316,31 @@ bool AuthManager::isAuthenticated() const {
     return account.has_value() && !account->accessToken.empty();
 }
 
-std::future<bool> AuthManager::refreshActiveAccount(
-    MicrosoftAuth::AuthProgressCallback onProgress
+std::shared_future<bool> AuthManager::refreshActiveAccount(
+    AuthProgressCallback onProgress
 ) {
-    return std::async(std::launch::async, [this, onProgress]() -> bool {
-        auto account = getActiveAccount();
-        
-        if (!account) {
-            Logger::instance().warn("No active account to refresh");
-            return false;
-        }
-        
-        // Get refresh token from secure storage
-        auto refreshToken = m_tokenStorage->getToken(account->uuid);
-        if (!refreshToken) {
-            refreshToken = account->refreshToken;
-        }
-        
-        if (!refreshToken || refreshToken->empty()) {
-            Logger::instance().warn("No refresh token available");
-            return false;
-        }
-        
-        auto authFuture = m_microsoftAuth->refreshAuthentication(*refreshToken, onProgress);
-        auto result = authFuture.get();
-        
-        if (!result) {
-            Logger::instance().error("Failed to refresh token: {}", m_microsoftAuth->getLastError());
-            return false;
-        }
-        
-        // Update account
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            
-            auto it = std::find_if(m_accounts.begin(), m_accounts.end(),
-                [&account](const models::Account& acc) {
-                    return acc.uuid == account->uuid;
-                });
-            
-            if (it != m_accounts.end()) {
-                it->accessToken = result->accessToken;
-                it->tokenExpiry = result->expiryTime;
-                
-                // Update stored refresh token
-                auto oauthToken = m_microsoftAuth->getOAuthToken();
-                if (oauthToken) {
-                    it->refreshToken = oauthToken->refreshToken;
-                    m_tokenStorage->storeToken(it->uuid, oauthToken->refreshToken);
-                }
-            }
-        }
-        
-        saveAccounts();
-        notifyAccountChange();
-        
-        Logger::instance().info("Refreshed token for account: {}", account->username);
-        
-        return true;
-    });
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (m_activeAccountUuid.empty() || !m_refreshPool) {
+        Logger::instance().warn("No active account to refresh");
+        std::promise<bool> result;
+        result.set_value(false);
+        return result.get_future().share();
+    }
+    
+    return startRefreshLocked(m_activeAccountUuid, std::move(onProgress));
 }
 
 bool AuthManager::restoreSession() {
-    if (m_accounts.empty()) {
-        return false;
-    }
-    
     auto account = getActiveAccount();
     if (!account) {
         return false;
     }
     
-    // Check if token needs refresh
+    // Don't hold up startup on the token chain; the scheduler picks it up
     if (needsRefresh(*account)) {
-        Logger::instance().info("Token needs refresh, refreshing...");
-        auto future = refreshActiveAccount(nullptr);
-        return future.get();
+        Logger::instance().info("Token for {} needs refresh, refreshing in the background", account->username);
+        m_refreshCondition.notify_all();
     }
     
     return true;
@@ -335,12 +348,27 @@ bool AuthManager::restoreSession() {
 
 std::optional<std::string> AuthManager::getAccessToken() const {
     auto account = getActiveAccount();
-    if (account && !account->accessToken.empty()) {
+    if (!account) {
+        return std::nullopt;
+    }
+    
+    if (!account->accessToken.empty() && !account->isExpired()) {
         return account->accessToken;
     }
+    
+    m_refreshCondition.notify_all();
     return std::nullopt;
 }
 
+void AuthManager::setRefreshAllAccounts(bool allAccounts) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_refreshAllAccounts = allAccounts;
+    }
+    kRefreshAllAccounts.set(allAccounts);
+    m_refreshCondition.notify_all();
+}
+
 void AuthManager::onAccountChange(AccountChangeCallback callback) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_changeCallbacks.push_back(std::move(callback));
@@ -366,13 +394,21 @@ void AuthManager::loadAccounts() {
             account.uuid = accJson["uuid"].get<std::string>();
             account.username = accJson["username"].get<std::string>();
             account.type = static_cast<models::AccountType>(accJson["type"].get<int>());
-            account.accessToken = accJson.value("accessToken", "");
+            account.tokenExpiry = std::chrono::system_clock::time_point(
+                std::chrono::seconds(accJson.value("tokenExpiry", int64_t{0})));
             
-            // Load refresh token from secure storage
+            // Load tokens from secure storage; an expired access token is
+            // left for the scheduler to replace
             auto refreshToken = m_tokenStorage->getToken(account.uuid);
             if (refreshToken) {
                 account.refreshToken = *refreshToken;
             }
+            if (!account.isExpired()) {
+                auto accessToken = m_tokenStorage->getToken(accessTokenKey(account.uuid));
+                if (accessToken) {
+                    account.accessToken = *accessToken;
+                }
+            }
             
             m_accounts.push_back(account);
         }
@@ -389,12 +425,14 @@ void AuthManager::saveAccounts() {
         nlohmann::json json;
         json["accounts"] = nlohmann::json::array();
         
-        for (const auto& account : m_accounts) {
+        for (const auto& account : getAccounts()) {
             nlohmann::json accJson;
             accJson["uuid"] = account.uuid;
             accJson["username"] = account.username;
             accJson["type"] = static_cast<int>(account.type);
             // Don't save tokens to file - use secure storage
+            accJson["tokenExpiry"] = std::chrono::duration_cast<std::chrono::seconds>(
+                account.tokenExpiry.time_since_epoch()).count();
             
             json["accounts"].push_back(accJson);
         }
@@ -411,7 +449,13 @@ void AuthManager::saveAccounts() {
 void AuthManager::notifyAccountChange() {
     auto account = getActiveAccount();
     
-    for (const auto& callback : m_changeCallbacks) {
+    std::vector<AccountChangeCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        callbacks = m_changeCallbacks;
+    }
+    
+    for (const auto& callback : callbacks) {
         try {
             callback(account);
         } catch (const std::exception& e) {
@@ -432,4 +476,156 @@ bool AuthManager::needsRefresh(const models::Account& account) const {
     return now >= (account.tokenExpiry - buffer);
 }
 
+void AuthManager::refreshLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    while (!m_stopRefresh) {
+        auto now = std::chrono::system_clock::now();
+        auto next = std::chrono::system_clock::time_point::max();
+        
+        for (const auto& account : m_accounts) {
+            if (account.type != models::AccountType::Microsoft) continue;
+            if (!m_refreshAllAccounts && account.uuid != m_activeAccountUuid) continue;
+            if (m_refreshing.contains(account.uuid)) continue;
+            
+            auto due = refreshDueLocked(account);
+            if (due <= now) {
+                Logger::instance().debug("Scheduled token refresh for {}", account.username);
+                startRefreshLocked(account.uuid, nullptr);
+            } else {
+                next = std::min(next, due);
+            }
+        }
+        
+        // Woken early by completed refreshes and account changes.
+        // system_clock so a suspended machine wakes up due, not late.
+        if (next == std::chrono::system_clock::time_point::max()) {
+            m_refreshCondition.wait(lock);
+        } else {
+            m_refreshCondition.wait_until(lock, next);
+        }
+    }
+}
+
+std::chrono::system_clock::time_point AuthManager::refreshDueLocked(const models::Account& account) {
+    auto& schedule = m_refreshSchedule[account.uuid];
+    
+    // Jitter once per token so the due time doesn't move on every wakeup
+    if (schedule.due == std::chrono::system_clock::time_point{} || schedule.expiry != account.tokenExpiry) {
+        schedule.expiry = account.tokenExpiry;
+        schedule.failures = 0;
+        
+        if (account.accessToken.empty() || account.tokenExpiry == std::chrono::system_clock::time_point{}) {
+            schedule.due = std::chrono::system_clock::now();
+        } else {
+            schedule.due = account.tokenExpiry - kRefreshLead - randomDuration(kRefreshJitter);
+        }
+    }
+    
+    return schedule.due;
+}
+
+std::shared_future<bool> AuthManager::startRefreshLocked(const std::string& uuid, AuthProgressCallback onProgress) {
+    auto it = m_refreshing.find(uuid);
+    if (it != m_refreshing.end()) {
+        return it->second;
+    }
+    
+    auto future = m_refreshPool->submit([this, uuid, onProgress]() {
+        return refreshAccount(uuid, onProgress);
+    }).share();
+    
+    m_refreshing.emplace(uuid, future);
+    return future;
+}
+
+bool AuthManager::refreshAccount(const std::string& uuid, AuthProgressCallback onProgress) {
+    bool success = false;
+    std::string username;
+    
+    auto account = getAccount(uuid);
+    if (account && !m_stopRefresh) {
+        username = account->username;
+        
+        // Get refresh token from secure storage
+        auto refreshToken = m_tokenStorage->getToken(uuid);
+        if (!refreshToken) {
+            refreshToken = account->refreshToken;
+        }
+        
+        if (!refreshToken || refreshToken->empty()) {
+            Logger::instance().warn("No refresh token available for {}", username);
+        } else {
+            // A MicrosoftAuth per refresh: it keeps per-flow state, and
+            // other accounts (or an interactive sign-in) run alongside
+            MicrosoftAuth auth;
+            auto result = auth.refreshAuthentication(*refreshToken, onProgress).get();
+            
+            if (!result) {
+                Logger::instance().error("Failed to refresh token for {}: {}", username, auth.getLastError());
+            } else {
+                auto oauthToken = auth.getOAuthToken();
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    
+                    auto it = std::find_if(m_accounts.begin(), m_accounts.end(),
+                        [&uuid](const models::Account& acc) {
+                            return acc.uuid == uuid;
+                        });
+                    
+                    if (it != m_accounts.end()) {
+                        it->accessToken = result->accessToken;
+                        it->tokenExpiry = result->expiryTime;
+                        if (oauthToken) {
+                            it->refreshToken = oauthToken->refreshToken;
+                        }
+                        success = true;
+                    }
+                }
+                
+                if (success) {
+                    if (oauthToken) {
+                        m_tokenStorage->storeToken(uuid, oauthToken->refreshToken);
+                    }
+                    m_tokenStorage->storeToken(accessTokenKey(uuid), result->accessToken);
+                }
+            }
+        }
+    }
+    
+    bool active = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_refreshing.erase(uuid);
+        
+        auto it = std::find_if(m_accounts.begin(), m_accounts.end(),
+            [&uuid](const models::Account& acc) {
+                return acc.uuid == uuid;
+            });
+        
+        if (it != m_accounts.end() && !success) {
+            auto& schedule = m_refreshSchedule[uuid];
+            schedule.expiry = it->tokenExpiry;
+            schedule.failures++;
+            
+            auto delay = std::min<std::chrono::seconds>(
+                kRetryBase * (1 << std::min(schedule.failures - 1, 6)), kRetryMax);
+            schedule.due = std::chrono::system_clock::now() + delay / 2 + randomDuration(delay / 2);
+        }
+        
+        active = uuid == m_activeAccountUuid;
+    }
+    m_refreshCondition.notify_all();
+    
+    if (success) {
+        saveAccounts();
+        if (active) {
+            notifyAccountChange();
+        }
+        Logger::instance().info("Refreshed token for account: {}", username);
+    }
+    
+    return success;
+}
+
 } // namespace konami::core::auth
@@ -9,13 +9,18 @@
 
 #include "MicrosoftAuth.hpp"
 #include "TokenStorage.hpp"
+#include "../ThreadPool.hpp"
 #include "../../models/Account.hpp"
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <optional>
 #include <mutex>
+#include <condition_variable>
 #include <functional>
+#include <thread>
+#include <unordered_map>
 
 namespace konami::core::auth {
 
@@ -32,6 +37,13 @@ using AccountChangeCallback = std::function<void(const std::optional<models::Acc
  * - Secure token storage
  * - Auto token refresh
  * - Account switching
+ * 
+ * Tokens are refreshed by a background scheduler ahead of expiry (with
+ * per-account jitter so several accounts don't hit Xbox Live together),
+ * so the token handed to the launcher is already fresh and nothing on the
+ * startup or launch path waits on the Microsoft -> Xbox Live -> XSTS ->
+ * Minecraft chain. The steps of one chain depend on each other; separate
+ * accounts refresh concurrently, each with its own MicrosoftAuth.
  */
 class AuthManager {
 public:
@@ -67,9 +79,9 @@ public:
      * @return Future for the new account
      */
     std::future<std::optional<models::Account>> addMicrosoftAccount(
-        MicrosoftAuth::DeviceCodeCallback onDeviceCode,
-        MicrosoftAuth::AuthProgressCallback onProgress = nullptr,
-        MicrosoftAuth::AuthCompleteCallback onComplete = nullptr
+        DeviceCodeCallback onDeviceCode,
+        AuthProgressCallback onProgress = nullptr,
+        AuthCompleteCallback onComplete = nullptr
     );
     
     /**
@@ -113,25 +125,40 @@ public:
     
     /**
      * Refresh active account token
-     * @param onProgress Progress callback
+     * 
+     * Joins a refresh already running for the account instead of starting
+     * a second one.
+     * @param onProgress Progress callback (ignored when joining)
      * @return true if refresh successful
      */
-    std::future<bool> refreshActiveAccount(
-        MicrosoftAuth::AuthProgressCallback onProgress = nullptr
+    std::shared_future<bool> refreshActiveAccount(
+        AuthProgressCallback onProgress = nullptr
     );
     
     /**
      * Restore previous session
-     * @return true if session restored
+     * 
+     * Does not wait for the network: a stale token is handed to the
+     * refresh scheduler, which brings it up to date in the background.
+     * @return true if there is an active account to restore
      */
     bool restoreSession();
     
     /**
      * Get access token for active account
-     * @return Access token if available
+     * 
+     * Never blocks. An expired token is not returned; the scheduler is
+     * woken to refresh it instead.
+     * @return Access token if a valid one is cached
      */
     std::optional<std::string> getAccessToken() const;
     
+    /**
+     * Choose which accounts the scheduler keeps fresh
+     * @param allAccounts true for every Microsoft account, false for the active one only
+     */
+    void setRefreshAllAccounts(bool allAccounts);
+    
     /**
      * Register account change callback
      * @param callback Callback function
@@ -165,8 +192,45 @@ private:
      * @return true if needs refresh
      */
     bool needsRefresh(const models::Account& account) const;
+    
+    /**
+     * Scheduler thread: sleeps until the earliest refresh is due
+     */
+    void refreshLoop();
+    
+    /**
+     * Time at which an account's token should be refreshed (m_mutex held)
+     * @param account Account to schedule
+     * @return Due time, jittered once per token
+     */
+    std::chrono::system_clock::time_point refreshDueLocked(const models::Account& account);
+    
+    /**
+     * Start a refresh on the pool unless one is running (m_mutex held)
+     * @param uuid Account UUID
+     * @param onProgress Progress callback
+     * @return Future for the running refresh
+     */
+    std::shared_future<bool> startRefreshLocked(const std::string& uuid, AuthProgressCallback onProgress);
+    
+    /**
+     * Run the token chain for one account and store the result
+     * @param uuid Account UUID
+     * @param onProgress Progress callback
+     * @return true if refresh successful
+     */
+    bool refreshAccount(const std::string& uuid, AuthProgressCallback onProgress);
 
 private:
+    /**
+     * Refresh bookkeeping for one account
+     */
+    struct RefreshSchedule {
+        std::chrono::system_clock::time_point expiry;   // token the due time was computed for
+        std::chrono::system_clock::time_point due;
+        int failures{0};
+    };
+    
     std::unique_ptr<MicrosoftAuth> m_microsoftAuth;
     std::unique_ptr<TokenStorage> m_tokenStorage;
     
@@ -176,6 +240,15 @@ private:
     std::vector<AccountChangeCallback> m_changeCallbacks;
     mutable std::mutex m_mutex;
     
+    // Refresh scheduler, guarded by m_mutex
+    std::unique_ptr<ThreadPool> m_refreshPool;
+    std::thread m_refreshThread;
+    mutable std::condition_variable m_refreshCondition;
+    std::unordered_map<std::string, RefreshSchedule> m_refreshSchedule;
+    std::unordered_map<std::string, std::shared_future<bool>> m_refreshing;
+    bool m_refreshAllAccounts{false};
+    std::atomic<bool> m_stopRefresh{false};
+    
     bool m_initialized{false};
 };
 
@@ -6,19 +6,97 @@
 
 #include "Encryption.hpp"
 #include "../Logger.hpp"
+#include "../../utils/Codec.hpp"
 
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 #include <openssl/err.h>
-#include <openssl/bio.h>
-#include <openssl/buffer.h>
 
 #include <stdexcept>
 #include <cstring>
 #include <memory>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace konami::core::auth {
 
+// -- SecureBuffer --
+
+SecureBuffer::SecureBuffer(size_t size) : m_size(size) {
+    if (size == 0) return;
+    
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    size_t page = info.dwPageSize;
+    m_capacity = (size + page - 1) / page * page;
+    
+    void* pages = VirtualAlloc(nullptr, m_capacity, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!pages) throw std::bad_alloc();
+    m_locked = VirtualLock(pages, m_capacity) != 0;
+#else
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    m_capacity = (size + page - 1) / page * page;
+    
+    void* pages = mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED) throw std::bad_alloc();
+    m_locked = mlock(pages, m_capacity) == 0;
+#ifdef MADV_DONTDUMP
+    madvise(pages, m_capacity, MADV_DONTDUMP);
+#endif
+#endif
+    
+    m_data = static_cast<unsigned char*>(pages);
+}
+
+SecureBuffer::~SecureBuffer() {
+    release();
+}
+
+SecureBuffer::SecureBuffer(SecureBuffer&& other) noexcept
+    : m_data(other.m_data), m_size(other.m_size), m_capacity(other.m_capacity), m_locked(other.m_locked) {
+    other.m_data = nullptr;
+    other.m_size = other.m_capacity = 0;
+    other.m_locked = false;
+}
+
+SecureBuffer& SecureBuffer::operator=(SecureBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        m_locked = other.m_locked;
+        other.m_data = nullptr;
+        other.m_size = other.m_capacity = 0;
+        other.m_locked = false;
+    }
+    return *this;
+}
+
+void SecureBuffer::release() {
+    if (!m_data) return;
+    
+    // OPENSSL_cleanse is not elided by the optimiser like a plain memset
+    OPENSSL_cleanse(m_data, m_capacity);
+#ifdef _WIN32
+    if (m_locked) VirtualUnlock(m_data, m_capacity);
+    VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+    if (m_locked) munlock(m_data, m_capacity);
+    munmap(m_data, m_capacity);
+#endif
+    m_data = nullptr;
+}
+
+// -- Encryption --
+
 // RAII wrapper for EVP_CIPHER_CTX
 struct CipherContextDeleter {
     void operator()(EVP_CIPHER_CTX* ctx) const {
@@ -32,7 +110,18 @@ std::string Encryption::encrypt(const std::string& plaintext, const std::string&
         Logger::instance().error("Invalid key size: {} (expected {})", key.size(), KEY_SIZE);
         return "";
     }
-    
+    return encryptWithKey(plaintext, reinterpret_cast<const unsigned char*>(key.data()), {});
+}
+
+std::string Encryption::encrypt(const std::string& plaintext, const SecureBuffer& key, std::string_view aad) {
+    if (key.size() != KEY_SIZE) {
+        Logger::instance().error("Invalid key size: {} (expected {})", key.size(), KEY_SIZE);
+        return "";
+    }
+    return encryptWithKey(plaintext, key.data(), aad);
+}
+
+std::string Encryption::encryptWithKey(const std::string& plaintext, const unsigned char* key, std::string_view aad) {
     try {
         // Generate random IV
         auto iv = generateIV();
@@ -44,15 +133,19 @@ std::string Encryption::encrypt(const std::string& plaintext, const std::string&
         }
         
         // Initialize encryption
-        if (EVP_EncryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr,
-                              reinterpret_cast<const unsigned char*>(key.data()),
-                              iv.data()) != 1) {
+        if (EVP_EncryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, key, iv.data()) != 1) {
             throw std::runtime_error("Failed to initialize encryption");
         }
         
+        int len = 0;
+        if (!aad.empty() &&
+            EVP_EncryptUpdate(ctx.get(), nullptr, &len, reinterpret_cast<const unsigned char*>(aad.data()),
+                              static_cast<int>(aad.size())) != 1) {
+            throw std::runtime_error("Failed to add associated data");
+        }
+        
         // Encrypt
         std::vector<uint8_t> ciphertext(plaintext.size() + EVP_MAX_BLOCK_LENGTH);
-        int len = 0;
         int ciphertextLen = 0;
         
         if (EVP_EncryptUpdate(ctx.get(), ciphertext.data(), &len,
@@ -94,7 +187,20 @@ std::optional<std::string> Encryption::decrypt(const std::string& ciphertext, co
         Logger::instance().error("Invalid key size");
         return std::nullopt;
     }
-    
+    return decryptWithKey(ciphertext, reinterpret_cast<const unsigned char*>(key.data()), {});
+}
+
+std::optional<std::string> Encryption::decrypt(const std::string& ciphertext, const SecureBuffer& key,
+                                               std::string_view aad) {
+    if (key.size() != KEY_SIZE) {
+        Logger::instance().error("Invalid key size");
+        return std::nullopt;
+    }
+    return decryptWithKey(ciphertext, key.data(), aad);
+}
+
+std::optional<std::string> Encryption::decryptWithKey(const std::string& ciphertext, const unsigned char* key,
+                                                      std::string_view aad) {
     if (ciphertext.size() < IV_SIZE + TAG_SIZE) {
         Logger::instance().error("Invalid ciphertext size");
         return std::nullopt;
@@ -114,15 +220,19 @@ std::optional<std::string> Encryption::decrypt(const std::string& ciphertext, co
         }
         
         // Initialize decryption
-        if (EVP_DecryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr,
-                              reinterpret_cast<const unsigned char*>(key.data()),
-                              iv) != 1) {
+        if (EVP_DecryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, key, iv) != 1) {
             throw std::runtime_error("Failed to initialize decryption");
         }
         
+        int len = 0;
+        if (!aad.empty() &&
+            EVP_DecryptUpdate(ctx.get(), nullptr, &len, reinterpret_cast<const unsigned char*>(aad.data()),
+                              static_cast<int>(aad.size())) != 1) {
+            throw std::runtime_error("Failed to add associated data");
+        }
+        
         // Decrypt
         std::vector<uint8_t> plaintext(encryptedLen + EVP_MAX_BLOCK_LENGTH);
-        int len = 0;
         int plaintextLen = 0;
         
         if (EVP_DecryptUpdate(ctx.get(), plaintext.data(), &len,
@@ -140,12 +250,15 @@ std::optional<std::string> Encryption::decrypt(const std::string& ciphertext, co
         // Finalize and verify tag
         if (EVP_DecryptFinal_ex(ctx.get(), plaintext.data() + len, &len) != 1) {
             // Authentication failed
+            OPENSSL_cleanse(plaintext.data(), plaintext.size());
             Logger::instance().warn("Authentication tag verification failed");
             return std::nullopt;
         }
         plaintextLen += len;
         
-        return std::string(reinterpret_cast<char*>(plaintext.data()), plaintextLen);
+        std::string result(reinterpret_cast<char*>(plaintext.data()), plaintextLen);
+        OPENSSL_cleanse(plaintext.data(), plaintext.size());
+        return result;
         
     } catch (const std::exception& e) {
         Logger::instance().error("Decryption error: {}", e.what());
@@ -158,6 +271,14 @@ std::string Encryption::generateKey() {
     return std::string(reinterpret_cast<char*>(bytes.data()), bytes.size());
 }
 
+SecureBuffer Encryption::generateSecureKey() {
+    SecureBuffer key(KEY_SIZE);
+    if (RAND_bytes(key.data(), static_cast<int>(key.size())) != 1) {
+        throw std::runtime_error("Failed to generate random bytes");
+    }
+    return key;
+}
+
 std::vector<uint8_t> Encryption::generateIV() {
     return randomBytes(IV_SIZE);
 }
@@ -212,84 +333,19 @@ std::string Encryption::sha256Hex(const std::string& data) {
 }
 
 std::string Encryption::base64Encode(const std::string& data) {
-    BIO* bio = BIO_new(BIO_s_mem());
-    BIO* b64 = BIO_new(BIO_f_base64());
-    bio = BIO_push(b64, bio);
-    
-    BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL);
-    BIO_write(bio, data.data(), static_cast<int>(data.size()));
-    BIO_flush(bio);
-    
-    BUF_MEM* bufferPtr;
-    BIO_get_mem_ptr(bio, &bufferPtr);
-    
-    std::string result(bufferPtr->data, bufferPtr->length);
-    
-    BIO_free_all(bio);
-    
-    return result;
+    return utils::Codec::base64Encode(data);
 }
 
 std::optional<std::string> Encryption::base64Decode(const std::string& encoded) {
-    BIO* bio = BIO_new_mem_buf(encoded.data(), static_cast<int>(encoded.size()));
-    BIO* b64 = BIO_new(BIO_f_base64());
-    bio = BIO_push(b64, bio);
-    
-    BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL);
-    
-    std::vector<uint8_t> buffer(encoded.size());
-    int len = BIO_read(bio, buffer.data(), static_cast<int>(buffer.size()));
-    
-    BIO_free_all(bio);
-    
-    if (len < 0) {
-        return std::nullopt;
-    }
-    
-    return std::string(reinterpret_cast<char*>(buffer.data()), len);
+    return utils::Codec::base64Decode(encoded);
 }
 
 std::string Encryption::hexEncode(const std::string& data) {
-    static const char hexChars[] = "0123456789abcdef";
-    
-    std::string result;
-    result.reserve(data.size() * 2);
-    
-    for (unsigned char c : data) {
-        result.push_back(hexChars[c >> 4]);
-        result.push_back(hexChars[c & 0x0f]);
-    }
-    
-    return result;
+    return utils::Codec::hexEncode(data);
 }
 
 std::optional<std::string> Encryption::hexDecode(const std::string& hex) {
-    if (hex.size() % 2 != 0) {
-        return std::nullopt;
-    }
-    
-    std::string result;
-    result.reserve(hex.size() / 2);
-    
-    for (size_t i = 0; i < hex.size(); i += 2) {
-        char high = hex[i];
-        char low = hex[i + 1];
-        
-        int highVal = (high >= 'a') ? (high - 'a' + 10) :
-                     (high >= 'A') ? (high - 'A' + 10) :
-                     (high - '0');
-        int lowVal = (low >= 'a') ? (low - 'a' + 10) :
-                    (low >= 'A') ? (low - 'A' + 10) :
-                    (low - '0');
-        
-        if (highVal < 0 || highVal > 15 || lowVal < 0 || lowVal > 15) {
-            return std::nullopt;
-        }
-        
-        result.push_back(static_cast<char>((highVal << 4) | lowVal));
-    }
-    
-    return result;
+    return utils::Codec::hexDecode(hex);
 }
 
 std::vector<uint8_t> Encryption::randomBytes(size_t length) {
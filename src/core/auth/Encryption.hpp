@@ -7,12 +7,58 @@
  */
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace konami::core::auth {
 
+/**
+ * SecureBuffer - Fixed-size buffer for key material
+ * 
+ * Backed by its own pages, which are locked in RAM (mlock / VirtualLock)
+ * so they never reach swap, excluded from core dumps where supported,
+ * and wiped before they are released.
+ */
+class SecureBuffer {
+public:
+    /**
+     * Constructor
+     * @param size Buffer size in bytes (zero-filled)
+     */
+    explicit SecureBuffer(size_t size);
+    
+    /**
+     * Destructor - wipes, unlocks and releases the pages
+     */
+    ~SecureBuffer();
+    
+    SecureBuffer(const SecureBuffer&) = delete;
+    SecureBuffer& operator=(const SecureBuffer&) = delete;
+    SecureBuffer(SecureBuffer&& other) noexcept;
+    SecureBuffer& operator=(SecureBuffer&& other) noexcept;
+    
+    unsigned char* data() { return m_data; }
+    const unsigned char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    
+    /**
+     * Check if the pages are locked in memory
+     * @return false if locking was refused (e.g. RLIMIT_MEMLOCK)
+     */
+    bool locked() const { return m_locked; }
+
+private:
+    void release();
+    
+    unsigned char* m_data{nullptr};
+    size_t m_size{0};
+    size_t m_capacity{0};
+    bool m_locked{false};
+};
+
 /**
  * Encryption - AES-256-GCM encryption utilities
  */
@@ -39,12 +85,37 @@ public:
      */
     static std::optional<std::string> decrypt(const std::string& ciphertext, const std::string& key);
     
+    /**
+     * Encrypt data using AES-256-GCM with a key held in locked memory
+     * @param plaintext Data to encrypt
+     * @param key Encryption key (32 bytes)
+     * @param aad Additional data bound to the ciphertext but not stored in it
+     * @return Encrypted data (IV + ciphertext + tag) or empty on error
+     */
+    static std::string encrypt(const std::string& plaintext, const SecureBuffer& key, std::string_view aad = {});
+    
+    /**
+     * Decrypt data using AES-256-GCM with a key held in locked memory
+     * @param ciphertext Encrypted data (IV + ciphertext + tag)
+     * @param key Encryption key (32 bytes)
+     * @param aad Additional data given to encrypt()
+     * @return Decrypted data or nullopt on error or tampering
+     */
+    static std::optional<std::string> decrypt(const std::string& ciphertext, const SecureBuffer& key,
+                                              std::string_view aad = {});
+    
     /**
      * Generate a random encryption key
      * @return 32-byte random key
      */
     static std::string generateKey();
     
+    /**
+     * Generate a random encryption key directly in locked memory
+     * @return 32-byte random key
+     */
+    static SecureBuffer generateSecureKey();
+    
     /**
      * Generate a random IV
      * @return 12-byte random IV
@@ -114,6 +185,10 @@ public:
     static std::optional<std::string> hexDecode(const std::string& hex);
 
 private:
+    static std::string encryptWithKey(const std::string& plaintext, const unsigned char* key, std::string_view aad);
+    static std::optional<std::string> decryptWithKey(const std::string& ciphertext, const unsigned char* key,
+                                                     std::string_view aad);
+    
     /**
      * Generate random bytes
      * @param length Number of bytes
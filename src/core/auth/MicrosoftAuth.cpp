@@ -6,17 +6,47 @@
 
 #include "MicrosoftAuth.hpp"
 #include "../Logger.hpp"
+#include "../../utils/HttpClient.hpp"
 
-#include <cpr/cpr.h>
 #include <nlohmann/json.hpp>
-#include <thread>
+#include <algorithm>
 #include <chrono>
+#include <map>
 
 namespace konami::core::auth {
 
 using json = nlohmann::json;
 
-MicrosoftAuth::MicrosoftAuth() = default;
+namespace {
+
+utils::HttpResponse postForm(const std::string& url, const std::map<std::string, std::string>& fields) {
+    utils::HttpOptions options;
+    options.headers["Content-Type"] = "application/x-www-form-urlencoded";
+    return utils::HttpClient::instance().post(url, utils::HttpClient::buildQueryString(fields), options);
+}
+
+utils::HttpResponse postJson(const std::string& url, const json& body) {
+    utils::HttpOptions options;
+    options.headers["Accept"] = "application/json";
+    return utils::HttpClient::instance().postJson(url, body.dump(), options);
+}
+
+/**
+ * "HTTP <status>", or the transport error if no response arrived
+ */
+std::string failureReason(const utils::HttpResponse& response) {
+    if (response.statusCode == 0) {
+        return response.error.empty() ? "no response" : response.error;
+    }
+    return "HTTP " + std::to_string(response.statusCode);
+}
+
+} // namespace
+
+MicrosoftAuth::MicrosoftAuth() : MicrosoftAuth(Endpoints{}) {}
+
+MicrosoftAuth::MicrosoftAuth(Endpoints endpoints) : m_endpoints(std::move(endpoints)) {}
+
 MicrosoftAuth::~MicrosoftAuth() {
     cancelAuthentication();
 }
@@ -89,10 +119,10 @@ std::future<std::optional<MinecraftAuthResult>> MicrosoftAuth::authenticateDevic
                 return std::nullopt;
             }
             
-            // Step 6: Verify ownership
+            // Step 6: Verify ownership (fetched alongside the profile)
             if (onProgress) onProgress("Verifying game ownership...", 0.9f);
             
-            if (!verifyGameOwnership(mcResult->accessToken)) {
+            if (!mcResult->ownsGame) {
                 m_lastError = "User does not own Minecraft";
                 if (onComplete) onComplete(false, m_lastError);
                 m_authenticating = false;
@@ -175,26 +205,31 @@ std::future<std::optional<MinecraftAuthResult>> MicrosoftAuth::refreshAuthentica
 }
 
 void MicrosoftAuth::cancelAuthentication() {
-    m_cancelled = true;
+    {
+        std::lock_guard<std::mutex> lock(m_cancelMutex);
+        m_cancelled = true;
+    }
+    m_cancelCondition.notify_all();
+}
+
+bool MicrosoftAuth::waitUntil(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(m_cancelMutex);
+    return !m_cancelCondition.wait_until(lock, deadline, [this] { return m_cancelled.load(); });
 }
 
 std::optional<DeviceCode> MicrosoftAuth::requestDeviceCode() {
     try {
-        cpr::Response response = cpr::Post(
-            cpr::Url{MICROSOFT_DEVICE_CODE_URL},
-            cpr::Payload{
-                {"client_id", CLIENT_ID},
-                {"scope", SCOPE}
-            },
-            cpr::Header{{"Content-Type", "application/x-www-form-urlencoded"}}
-        );
+        auto response = postForm(m_endpoints.deviceCode, {
+            {"client_id", CLIENT_ID},
+            {"scope", SCOPE}
+        });
         
-        if (response.status_code != 200) {
-            m_lastError = "Failed to get device code: HTTP " + std::to_string(response.status_code);
+        if (!response.isOk()) {
+            m_lastError = "Failed to get device code: " + failureReason(response);
             return std::nullopt;
         }
         
-        auto jsonResponse = json::parse(response.text);
+        auto jsonResponse = json::parse(response.body);
         
         DeviceCode code;
         code.deviceCode = jsonResponse["device_code"].get<std::string>();
@@ -218,29 +253,29 @@ std::optional<OAuthToken> MicrosoftAuth::pollForToken(
 ) {
     auto startTime = std::chrono::steady_clock::now();
     auto expiryTime = startTime + std::chrono::seconds(deviceCode.expiresIn);
+    auto interval = std::chrono::seconds(std::max(deviceCode.interval, 1));
     
-    while (std::chrono::steady_clock::now() < expiryTime) {
-        if (m_cancelled) {
+    // Polls fire on a fixed cadence from the start, so request latency
+    // doesn't stretch the interval; cancellation wakes the wait at once
+    auto nextPoll = startTime + interval;
+    
+    while (nextPoll < expiryTime) {
+        if (!waitUntil(nextPoll)) {
             m_lastError = "Authentication cancelled";
             return std::nullopt;
         }
-        
-        std::this_thread::sleep_for(std::chrono::seconds(deviceCode.interval));
+        nextPoll += interval;
         
         try {
-            cpr::Response response = cpr::Post(
-                cpr::Url{MICROSOFT_TOKEN_URL},
-                cpr::Payload{
-                    {"client_id", CLIENT_ID},
-                    {"grant_type", "urn:ietf:params:oauth:grant-type:device_code"},
-                    {"device_code", deviceCode.deviceCode}
-                },
-                cpr::Header{{"Content-Type", "application/x-www-form-urlencoded"}}
-            );
-            
-            auto jsonResponse = json::parse(response.text);
-            
-            if (response.status_code == 200) {
+            auto response = postForm(m_endpoints.token, {
+                {"client_id", CLIENT_ID},
+                {"grant_type", "urn:ietf:params:oauth:grant-type:device_code"},
+                {"device_code", deviceCode.deviceCode}
+            });
+            
+            auto jsonResponse = json::parse(response.body);
+            
+            if (response.isOk()) {
                 OAuthToken token;
                 token.accessToken = jsonResponse["access_token"].get<std::string>();
                 token.refreshToken = jsonResponse["refresh_token"].get<std::string>();
@@ -263,6 +298,13 @@ std::optional<OAuthToken> MicrosoftAuth::pollForToken(
                 continue;
             }
             
+            if (error == "slow_down") {
+                // RFC 8628 3.5: back off by 5 seconds for this and later polls
+                interval += std::chrono::seconds(5);
+                nextPoll += std::chrono::seconds(5);
+                continue;
+            }
+            
             if (error == "authorization_declined") {
                 m_lastError = "User declined authorization";
                 return std::nullopt;
@@ -299,21 +341,14 @@ std::optional<XboxToken> MicrosoftAuth::authenticateXboxLive(const OAuthToken& o
             {"TokenType", "JWT"}
         };
         
-        cpr::Response response = cpr::Post(
-            cpr::Url{XBOX_AUTH_URL},
-            cpr::Body{requestBody.dump()},
-            cpr::Header{
-                {"Content-Type", "application/json"},
-                {"Accept", "application/json"}
-            }
-        );
+        auto response = postJson(m_endpoints.xboxAuth, requestBody);
         
-        if (response.status_code != 200) {
-            m_lastError = "Xbox Live auth failed: HTTP " + std::to_string(response.status_code);
+        if (!response.isOk()) {
+            m_lastError = "Xbox Live auth failed: " + failureReason(response);
             return std::nullopt;
         }
         
-        auto jsonResponse = json::parse(response.text);
+        auto jsonResponse = json::parse(response.body);
         
         XboxToken token;
         token.token = jsonResponse["Token"].get<std::string>();
@@ -343,17 +378,10 @@ std::optional<XboxToken> MicrosoftAuth::getXSTSToken(const XboxToken& xboxToken)
             {"TokenType", "JWT"}
         };
         
-        cpr::Response response = cpr::Post(
-            cpr::Url{XBOX_XSTS_URL},
-            cpr::Body{requestBody.dump()},
-            cpr::Header{
-                {"Content-Type", "application/json"},
-                {"Accept", "application/json"}
-            }
-        );
+        auto response = postJson(m_endpoints.xsts, requestBody);
         
-        if (response.status_code == 401) {
-            auto jsonResponse = json::parse(response.text);
+        if (response.statusCode == 401) {
+            auto jsonResponse = json::parse(response.body);
             uint64_t xerr = jsonResponse.value("XErr", 0ULL);
             
             if (xerr == 2148916233) {
@@ -366,12 +394,12 @@ std::optional<XboxToken> MicrosoftAuth::getXSTSToken(const XboxToken& xboxToken)
             return std::nullopt;
         }
         
-        if (response.status_code != 200) {
-            m_lastError = "XSTS auth failed: HTTP " + std::to_string(response.status_code);
+        if (!response.isOk()) {
+            m_lastError = "XSTS auth failed: " + failureReason(response);
             return std::nullopt;
         }
         
-        auto jsonResponse = json::parse(response.text);
+        auto jsonResponse = json::parse(response.body);
         
         XboxToken token;
         token.token = jsonResponse["Token"].get<std::string>();
@@ -392,33 +420,21 @@ std::optional<MinecraftAuthResult> MicrosoftAuth::authenticateMinecraft(const Xb
             {"identityToken", "XBL3.0 x=" + xstsToken.userHash + ";" + xstsToken.token}
         };
         
-        cpr::Response response = cpr::Post(
-            cpr::Url{MINECRAFT_AUTH_URL},
-            cpr::Body{requestBody.dump()},
-            cpr::Header{
-                {"Content-Type", "application/json"},
-                {"Accept", "application/json"}
-            }
-        );
+        auto response = postJson(m_endpoints.minecraftAuth, requestBody);
         
-        if (response.status_code != 200) {
-            m_lastError = "Minecraft auth failed: HTTP " + std::to_string(response.status_code);
+        if (!response.isOk()) {
+            m_lastError = "Minecraft auth failed: " + failureReason(response);
             return std::nullopt;
         }
         
-        auto jsonResponse = json::parse(response.text);
+        auto jsonResponse = json::parse(response.body);
         
         MinecraftAuthResult result;
         result.accessToken = jsonResponse["access_token"].get<std::string>();
         result.expiryTime = std::chrono::system_clock::now() + 
                            std::chrono::seconds(jsonResponse["expires_in"].get<int>());
         
-        // Get profile info
-        auto profile = getMinecraftProfile(result.accessToken);
-        if (profile) {
-            result.uuid = profile->first;
-            result.username = profile->second;
-        }
+        fetchAccountDetails(result);
         
         return result;
         
@@ -428,87 +444,85 @@ std::optional<MinecraftAuthResult> MicrosoftAuth::authenticateMinecraft(const Xb
     }
 }
 
-bool MicrosoftAuth::verifyGameOwnership(const std::string& accessToken) {
-    try {
-        cpr::Response response = cpr::Get(
-            cpr::Url{MINECRAFT_OWNERSHIP_URL},
-            cpr::Header{
-                {"Authorization", "Bearer " + accessToken},
-                {"Accept", "application/json"}
-            }
-        );
-        
-        if (response.status_code != 200) {
-            return false;
-        }
-        
-        auto jsonResponse = json::parse(response.text);
-        auto items = jsonResponse["items"];
-        
-        // Check for game ownership entitlements
-        for (const auto& item : items) {
-            std::string name = item.value("name", "");
-            if (name == "product_minecraft" || name == "game_minecraft") {
-                return true;
+void MicrosoftAuth::fetchAccountDetails(MinecraftAuthResult& result) {
+    auto& http = utils::HttpClient::instance();
+    
+    utils::HttpOptions options;
+    options.headers["Authorization"] = "Bearer " + result.accessToken;
+    options.headers["Accept"] = "application/json";
+    
+    // Both only need the Minecraft token, so they go out together
+    auto responses = http.getAll({m_endpoints.profile, m_endpoints.ownership}, options);
+    const auto& profile = responses[0];
+    const auto& ownership = responses[1];
+    
+    if (ownership.isOk()) {
+        try {
+            auto jsonResponse = json::parse(ownership.body);
+            
+            // Check for game ownership entitlements
+            for (const auto& item : jsonResponse.value("items", json::array())) {
+                std::string name = item.value("name", "");
+                if (name == "product_minecraft" || name == "game_minecraft") {
+                    result.ownsGame = true;
+                    break;
+                }
             }
+        } catch (const std::exception& e) {
+            Logger::instance().warn("Ownership verification error: {}", e.what());
         }
-        
-        return false;
-        
-    } catch (const std::exception& e) {
-        Logger::instance().warn("Ownership verification error: {}", e.what());
-        return false;
+    } else {
+        Logger::instance().warn("Ownership verification failed: {}", failureReason(ownership));
     }
-}
-
-std::optional<std::pair<std::string, std::string>> MicrosoftAuth::getMinecraftProfile(
-    const std::string& accessToken
-) {
+    
+    if (!profile.isOk()) {
+        Logger::instance().warn("Profile fetch failed: {}", failureReason(profile));
+        return;
+    }
+    
     try {
-        cpr::Response response = cpr::Get(
-            cpr::Url{MINECRAFT_PROFILE_URL},
-            cpr::Header{
-                {"Authorization", "Bearer " + accessToken},
-                {"Accept", "application/json"}
+        auto jsonResponse = json::parse(profile.body);
+        result.uuid = jsonResponse["id"].get<std::string>();
+        result.username = jsonResponse["name"].get<std::string>();
+        
+        for (const auto& skin : jsonResponse.value("skins", json::array())) {
+            if (skin.value("state", "") == "ACTIVE") {
+                result.skinUrl = skin.value("url", "");
+                result.skinVariant = skin.value("variant", "CLASSIC");
+                break;
             }
-        );
-        
-        if (response.status_code != 200) {
-            return std::nullopt;
         }
-        
-        auto jsonResponse = json::parse(response.text);
-        
-        return std::make_pair(
-            jsonResponse["id"].get<std::string>(),
-            jsonResponse["name"].get<std::string>()
-        );
-        
     } catch (const std::exception& e) {
         Logger::instance().warn("Profile fetch error: {}", e.what());
-        return std::nullopt;
+        return;
+    }
+    
+    // Skin URLs are content-addressed, so this is usually a cache hit
+    if (!result.skinUrl.empty()) {
+        auto skin = http.get(result.skinUrl);
+        if (skin.isOk()) {
+            result.skinTexture = std::move(skin.body);
+        } else {
+            Logger::instance().warn("Skin fetch failed: {}", failureReason(skin));
+        }
     }
 }
 
 std::optional<OAuthToken> MicrosoftAuth::refreshOAuthToken(const std::string& refreshToken) {
     try {
-        cpr::Response response = cpr::Post(
-            cpr::Url{MICROSOFT_TOKEN_URL},
-            cpr::Payload{
-                {"client_id", CLIENT_ID},
-                {"grant_type", "refresh_token"},
-                {"refresh_token", refreshToken},
-                {"scope", SCOPE}
-            },
-            cpr::Header{{"Content-Type", "application/x-www-form-urlencoded"}}
-        );
-        
-        if (response.status_code != 200) {
-            m_lastError = "Token refresh failed: HTTP " + std::to_string(response.status_code);
+        auto response = postForm(m_endpoints.token, {
+            {"client_id", CLIENT_ID},
+            {"grant_type", "refresh_token"},
+            {"refresh_token", refreshToken},
+            {"scope", SCOPE}
+        });
+        
+        if (!response.isOk()) {
+            m_lastError = "Token refresh failed: " + failureReason(response);
             return std::nullopt;
         }
         
-        auto jsonResponse = json::parse(response.text);
+        auto jsonResponse = json::parse(response.body);
         
         OAuthToken token;
         token.accessToken = jsonResponse["access_token"].get<std::string>();
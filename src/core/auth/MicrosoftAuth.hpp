@@ -13,6 +13,8 @@
 #include <chrono>
 #include <future>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 namespace konami::core::auth {
 
@@ -55,6 +57,12 @@ struct MinecraftAuthResult {
     std::string username;
     std::chrono::system_clock::time_point expiryTime;
     bool hasGamePass{false};
+    bool ownsGame{false};
+    
+    // Active skin from the profile; texture is the PNG, empty if none or not fetched
+    std::string skinUrl;
+    std::string skinVariant;
+    std::string skinTexture;
 };
 
 /**
@@ -86,7 +94,13 @@ using AuthCompleteCallback = std::function<void(bool success, const std::string&
  * 4. Exchange for Xbox Live token
  * 5. Get XSTS token
  * 6. Authenticate with Minecraft
- * 7. Verify game ownership
+ * 7. Fetch profile and entitlements together, then the skin texture
+ * 
+ * Steps 3-6 each need the previous token and run in order; step 7 only
+ * needs the Minecraft token, so its requests go out concurrently. All
+ * requests use the shared HttpClient pool and its shared TLS sessions;
+ * step 7 runs in a pooled multi handle, which has its own connections,
+ * so it reuses the connections of the previous login rather than step 6's.
  */
 class MicrosoftAuth {
 public:
@@ -117,10 +131,29 @@ public:
     static constexpr const char* SCOPE = "XboxLive.signin offline_access";
     
     /**
-     * Constructor
+     * Service URLs (overridable for testing against a local mock)
+     */
+    struct Endpoints {
+        std::string deviceCode{MICROSOFT_DEVICE_CODE_URL};
+        std::string token{MICROSOFT_TOKEN_URL};
+        std::string xboxAuth{XBOX_AUTH_URL};
+        std::string xsts{XBOX_XSTS_URL};
+        std::string minecraftAuth{MINECRAFT_AUTH_URL};
+        std::string profile{MINECRAFT_PROFILE_URL};
+        std::string ownership{MINECRAFT_OWNERSHIP_URL};
+    };
+    
+    /**
+     * Constructor - uses the live services
      */
     MicrosoftAuth();
     
+    /**
+     * Constructor
+     * @param endpoints Service URLs
+     */
+    explicit MicrosoftAuth(Endpoints endpoints);
+    
     /**
      * Destructor
      */
@@ -208,25 +241,22 @@ private:
     /**
      * Authenticate with Minecraft using XSTS token
      * @param xstsToken XSTS token
-     * @return Minecraft auth result
+     * @return Minecraft auth result with profile, ownership and skin filled in
      */
     std::optional<MinecraftAuthResult> authenticateMinecraft(const XboxToken& xstsToken);
     
     /**
-     * Verify game ownership
-     * @param accessToken Minecraft access token
-     * @return true if user owns Minecraft
+     * Fetch profile and entitlements concurrently, then the skin texture
+     * @param result Auth result holding the access token; filled in place
      */
-    bool verifyGameOwnership(const std::string& accessToken);
+    void fetchAccountDetails(MinecraftAuthResult& result);
     
     /**
-     * Get Minecraft profile
-     * @param accessToken Minecraft access token
-     * @return Profile info (uuid, username)
+     * Wait until a deadline or cancellation
+     * @param deadline Time to wake at
+     * @return false if cancelled
      */
-    std::optional<std::pair<std::string, std::string>> getMinecraftProfile(
-        const std::string& accessToken
-    );
+    bool waitUntil(std::chrono::steady_clock::time_point deadline);
     
     /**
      * Refresh OAuth token
@@ -236,8 +266,12 @@ private:
     std::optional<OAuthToken> refreshOAuthToken(const std::string& refreshToken);
 
 private:
+    Endpoints m_endpoints;
+    
     std::atomic<bool> m_authenticating{false};
     std::atomic<bool> m_cancelled{false};
+    std::mutex m_cancelMutex;
+    std::condition_variable m_cancelCondition;
     std::string m_lastError;
     std::optional<OAuthToken> m_oauthToken;
 };
@@ -7,10 +7,10 @@
 #include "TokenStorage.hpp"
 #include "Encryption.hpp"
 #include "../Logger.hpp"
+#include "../../utils/FileUtils.hpp"
 
 #include <nlohmann/json.hpp>
 #include <fstream>
-#include <random>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -22,14 +22,81 @@
 // libsecret would be used here for Linux
 #endif
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
 namespace konami::core::auth {
 
 using json = nlohmann::json;
 
+namespace {
+
+// Flush once stores have been quiet this long, but never defer past kFlushMaxDelay
+constexpr auto kFlushDelay = std::chrono::milliseconds(250);
+constexpr auto kFlushMaxDelay = std::chrono::seconds(2);
+
+constexpr int kFileVersion = 2;
+
+/**
+ * Create the key file and write the key to it
+ * 
+ * The file is created exclusively and owner-only before any key bytes are
+ * written, so no other user can ever open it. On Windows it inherits the
+ * per-user ACL of the storage directory and is opened without sharing.
+ * 
+ * @param path Key file path, which must not exist yet
+ * @param key Key bytes
+ * @return true if the whole key reached the disk
+ */
+bool createKeyFile(const std::filesystem::path& path, const SecureBuffer& key) {
+#ifdef _WIN32
+    HANDLE h = CreateFileW(path.wstring().c_str(), GENERIC_WRITE, 0, nullptr,
+                           CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) return false;
+    DWORD written = 0;
+    bool ok = WriteFile(h, key.data(), static_cast<DWORD>(key.size()), &written, nullptr)
+              && written == key.size()
+              && FlushFileBuffers(h);
+    CloseHandle(h);
+    if (!ok) DeleteFileW(path.wstring().c_str());
+    return ok;
+#else
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) return false;
+    size_t offset = 0;
+    while (offset < key.size()) {
+        ssize_t n = write(fd, key.data() + offset, key.size() - offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            close(fd); unlink(path.c_str());
+            return false;
+        }
+        offset += static_cast<size_t>(n);
+    }
+    if (fsync(fd) != 0) { close(fd); unlink(path.c_str()); return false; }
+    close(fd);
+    return true;
+#endif
+}
+
+} // namespace
+
 TokenStorage::TokenStorage() = default;
 TokenStorage::~TokenStorage() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlush = true;
+    }
+    m_flushCondition.notify_all();
+    if (m_flushThread.joinable()) {
+        m_flushThread.join();
+    }
+    
     if (m_initialized && !m_useKeychain) {
-        saveToFile();
+        flush();
     }
 }
 
@@ -47,6 +114,9 @@ bool TokenStorage::initialize(const std::string& storagePath) {
         
         // Load existing tokens
         loadFromFile();
+        
+        m_stopFlush = false;
+        m_flushThread = std::thread(&TokenStorage::flushLoop, this);
     }
     
     m_initialized = true;
@@ -108,11 +178,28 @@ void TokenStorage::clearAll() {
     if (m_useKeychain) {
         // Clear from keychain - would need to iterate stored keys
     } else {
-        m_tokens.clear();
-        saveToFile();
+        m_records.clear();
+        scheduleFlush();
     }
 }
 
+void TokenStorage::flush() {
+    // Held across snapshot and write so an older snapshot never lands last
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+    
+    std::unordered_map<std::string, std::string> records;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_flushPending) {
+            return;
+        }
+        m_flushPending = false;
+        records = m_records;
+    }
+    
+    writeRecords(records);
+}
+
 bool TokenStorage::isKeychainAvailable() {
 #ifdef _WIN32
     return true; // Windows Credential Manager
@@ -123,43 +210,62 @@ bool TokenStorage::isKeychainAvailable() {
 #endif
 }
 
-std::string TokenStorage::encrypt(const std::string& plaintext) const {
-    return Encryption::encrypt(plaintext, getEncryptionKey());
+std::string TokenStorage::encrypt(const std::string& plaintext, std::string_view recordKey) const {
+    const SecureBuffer* key = encryptionKey();
+    return key ? Encryption::encrypt(plaintext, *key, recordKey) : std::string();
 }
 
-std::optional<std::string> TokenStorage::decrypt(const std::string& ciphertext) const {
-    return Encryption::decrypt(ciphertext, getEncryptionKey());
+std::optional<std::string> TokenStorage::decrypt(const std::string& ciphertext, std::string_view recordKey) const {
+    const SecureBuffer* key = encryptionKey();
+    if (!key) return std::nullopt;
+    return Encryption::decrypt(ciphertext, *key, recordKey);
 }
 
-std::string TokenStorage::getEncryptionKey() const {
+const SecureBuffer* TokenStorage::encryptionKey() const {
     // In production, this should be derived from a master key stored securely
     // or use platform-specific key derivation
+    if (m_key) {
+        return m_key.get();
+    }
     
     auto keyPath = m_storagePath / ".key";
     
-    if (std::filesystem::exists(keyPath)) {
-        std::ifstream file(keyPath, std::ios::binary);
-        std::string key((std::istreambuf_iterator<char>(file)),
-                        std::istreambuf_iterator<char>());
-        return key;
+    try {
+        // Unbuffered streams, so the key never sits in a stream buffer
+        if (std::filesystem::exists(keyPath)) {
+            auto key = std::make_unique<SecureBuffer>(Encryption::KEY_SIZE);
+            
+            std::ifstream file;
+            file.rdbuf()->pubsetbuf(nullptr, 0);
+            file.open(keyPath, std::ios::binary);
+            file.read(reinterpret_cast<char*>(key->data()), static_cast<std::streamsize>(key->size()));
+            
+            if (file.gcount() != static_cast<std::streamsize>(key->size())) {
+                Logger::instance().error("Token encryption key is truncated: {}", keyPath.string());
+                return nullptr;
+            }
+            m_key = std::move(key);
+        } else {
+            // Generate new key
+            auto key = std::make_unique<SecureBuffer>(Encryption::generateSecureKey());
+            
+            std::filesystem::create_directories(m_storagePath);
+            if (!createKeyFile(keyPath, *key)) {
+                Logger::instance().error("Failed to create token encryption key: {}", keyPath.string());
+                return nullptr;
+            }
+            
+            m_key = std::move(key);
+        }
+    } catch (const std::exception& e) {
+        Logger::instance().error("Failed to load token encryption key: {}", e.what());
+        return nullptr;
     }
     
-    // Generate new key
-    std::string key(32, '\0');
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 255);
-    
-    for (auto& c : key) {
-        c = static_cast<char>(dis(gen));
+    if (!m_key->locked()) {
+        Logger::instance().warn("Token encryption key could not be locked in memory");
     }
-    
-    // Save key
-    std::filesystem::create_directories(m_storagePath);
-    std::ofstream file(keyPath, std::ios::binary);
-    file.write(key.data(), key.size());
-    
-    return key;
+    return m_key.get();
 }
 
 bool TokenStorage::storeInKeychain(const std::string& key, const std::string& token) {
@@ -283,29 +389,37 @@ bool TokenStorage::removeFromKeychain(const std::string& key) {
 }
 
 bool TokenStorage::storeInFile(const std::string& key, const std::string& token) {
-    // Store plaintext in memory; saveToFile() handles encryption of the whole storage
-    m_tokens[key] = token;
-    saveToFile();
+    // Only this record is re-encrypted; the record name is bound as
+    // associated data so ciphertexts can't be swapped between entries
+    std::string record = encrypt(token, key);
+    if (record.empty()) {
+        return false;
+    }
+    
+    m_records[key] = std::move(record);
+    scheduleFlush();
     return true;
 }
 
 std::optional<std::string> TokenStorage::getFromFile(const std::string& key) const {
-    // Tokens are stored as plaintext in memory; loadFromFile() handles decryption
-    auto it = m_tokens.find(key);
-    if (it != m_tokens.end()) {
-        return it->second;
+    auto it = m_records.find(key);
+    if (it == m_records.end()) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    
+    auto token = decrypt(it->second, key);
+    if (!token) {
+        Logger::instance().warn("Failed to decrypt stored token: {}", key);
+    }
+    return token;
 }
 
 bool TokenStorage::removeFromFile(const std::string& key) {
-    auto it = m_tokens.find(key);
-    if (it != m_tokens.end()) {
-        m_tokens.erase(it);
-        saveToFile();
-        return true;
+    if (m_records.erase(key) == 0) {
+        return false;
     }
-    return false;
+    scheduleFlush();
+    return true;
 }
 
 void TokenStorage::loadFromFile() {
@@ -320,40 +434,94 @@ void TokenStorage::loadFromFile() {
         std::string content((std::istreambuf_iterator<char>(file)),
                            std::istreambuf_iterator<char>());
         
-        auto decrypted = decrypt(content);
+        auto jsonData = json::parse(content, nullptr, false);
+        if (!jsonData.is_discarded() && jsonData.is_object() && jsonData.contains("records")) {
+            for (const auto& [key, value] : jsonData["records"].items()) {
+                auto record = Encryption::base64Decode(value.get<std::string>());
+                if (record) {
+                    m_records[key] = std::move(*record);
+                }
+            }
+            return;
+        }
+        
+        // Version 1 file: one ciphertext over the whole map; rewrite per record
+        auto decrypted = decrypt(content, {});
         if (!decrypted) {
             Logger::instance().warn("Failed to decrypt token storage");
             return;
         }
         
-        auto jsonData = json::parse(*decrypted);
-        for (const auto& [key, value] : jsonData.items()) {
-            // Tokens are stored as plaintext inside the encrypted file
-            m_tokens[key] = value.get<std::string>();
+        auto legacy = json::parse(*decrypted);
+        for (const auto& [key, value] : legacy.items()) {
+            std::string record = encrypt(value.get<std::string>(), key);
+            if (!record.empty()) {
+                m_records[key] = std::move(record);
+            }
         }
+        scheduleFlush();
         
     } catch (const std::exception& e) {
         Logger::instance().error("Failed to load tokens: {}", e.what());
     }
 }
 
-void TokenStorage::saveToFile() const {
+bool TokenStorage::writeRecords(const std::unordered_map<std::string, std::string>& records) const {
     auto filePath = m_storagePath / "tokens.enc";
     
     try {
         json jsonData;
-        for (const auto& [key, value] : m_tokens) {
-            jsonData[key] = value;
+        jsonData["version"] = kFileVersion;
+        jsonData["records"] = json::object();
+        for (const auto& [key, record] : records) {
+            jsonData["records"][key] = Encryption::base64Encode(record);
         }
         
-        std::string encrypted = encrypt(jsonData.dump());
-        
-        std::filesystem::create_directories(m_storagePath);
-        std::ofstream file(filePath, std::ios::binary);
-        file.write(encrypted.data(), encrypted.size());
+        // Temp file, fsync, rename: a crash leaves the old or the new tokens, never a torn file
+        if (!utils::FileUtils::writeFileAtomic(filePath, jsonData.dump())) {
+            throw std::runtime_error("write failed");
+        }
+        return true;
         
     } catch (const std::exception& e) {
         Logger::instance().error("Failed to save tokens: {}", e.what());
+        return false;
+    }
+}
+
+void TokenStorage::scheduleFlush() {
+    auto now = std::chrono::steady_clock::now();
+    if (!m_flushPending) {
+        m_pendingSince = now;
+    }
+    m_lastChange = now;
+    m_flushPending = true;
+    m_flushCondition.notify_all();
+}
+
+void TokenStorage::flushLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    while (true) {
+        m_flushCondition.wait(lock, [this] { return m_stopFlush || m_flushPending; });
+        
+        // Debounce: wait for a quiet period, bounded from the first change
+        while (!m_stopFlush) {
+            auto deadline = std::min(m_lastChange + kFlushDelay, m_pendingSince + kFlushMaxDelay);
+            if (std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+            m_flushCondition.wait_until(lock, deadline);
+        }
+        
+        // The destructor writes whatever is still pending
+        if (m_stopFlush) {
+            return;
+        }
+        
+        lock.unlock();
+        flush();
+        lock.lock();
     }
 }
 
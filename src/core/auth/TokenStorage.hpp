@@ -8,13 +8,20 @@
  */
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <filesystem>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <memory>
 #include <unordered_map>
 
 namespace konami::core::auth {
 
+class SecureBuffer;
+
 /**
  * TokenStorage - Secure credential storage
  * 
@@ -22,6 +29,12 @@ namespace konami::core::auth {
  * - AES-256-GCM encryption
  * - Platform keychain integration (Windows Credential Manager, macOS Keychain, Linux Secret Service)
  * - Fallback to encrypted file storage
+ * 
+ * In file storage every token is its own AES-GCM record, bound to its key
+ * as associated data, and only ciphertext is kept in memory. The file key
+ * is read once into locked memory. Changes are flushed to disk by a
+ * background writer once stores go quiet, so a burst of updates costs
+ * one write and an update never re-encrypts the other records.
  */
 class TokenStorage {
 public:
@@ -76,6 +89,11 @@ public:
      */
     void clearAll();
     
+    /**
+     * Write pending changes to disk now instead of after the debounce
+     */
+    void flush();
+    
     /**
      * Check if platform keychain is available
      * @return true if keychain available
@@ -84,24 +102,26 @@ public:
 
 private:
     /**
-     * Encrypt data using AES-256-GCM
+     * Encrypt one record using AES-256-GCM
      * @param plaintext Data to encrypt
-     * @return Encrypted data (IV + ciphertext + tag)
+     * @param recordKey Record name, bound as associated data
+     * @return Encrypted data (IV + ciphertext + tag), empty on error
      */
-    std::string encrypt(const std::string& plaintext) const;
+    std::string encrypt(const std::string& plaintext, std::string_view recordKey) const;
     
     /**
-     * Decrypt data using AES-256-GCM
+     * Decrypt one record using AES-256-GCM
      * @param ciphertext Encrypted data
+     * @param recordKey Record name it was encrypted under
      * @return Decrypted data
      */
-    std::optional<std::string> decrypt(const std::string& ciphertext) const;
+    std::optional<std::string> decrypt(const std::string& ciphertext, std::string_view recordKey) const;
     
     /**
-     * Get or generate encryption key
-     * @return Encryption key
+     * Get or generate the encryption key, cached in locked memory (m_mutex held)
+     * @return Encryption key, or nullptr if the key file is unusable
      */
-    std::string getEncryptionKey() const;
+    const SecureBuffer* encryptionKey() const;
     
     /**
      * Store using platform keychain
@@ -153,17 +173,39 @@ private:
     void loadFromFile();
     
     /**
-     * Save tokens to storage file
+     * Write records to the storage file (atomically replaced)
+     * @param records Encrypted records
+     * @return true if written
+     */
+    bool writeRecords(const std::unordered_map<std::string, std::string>& records) const;
+    
+    /**
+     * Mark records dirty and wake the writer (m_mutex held)
+     */
+    void scheduleFlush();
+    
+    /**
+     * Writer thread: flushes once changes have been quiet for a while
      */
-    void saveToFile() const;
+    void flushLoop();
 
 private:
     std::filesystem::path m_storagePath;
     mutable std::mutex m_mutex;
-    std::unordered_map<std::string, std::string> m_tokens;
+    std::unordered_map<std::string, std::string> m_records;   // key -> IV + ciphertext + tag
+    mutable std::unique_ptr<SecureBuffer> m_key;
     bool m_useKeychain{false};
     bool m_initialized{false};
     
+    // Debounced writer, guarded by m_mutex; m_writeMutex orders file writes
+    std::mutex m_writeMutex;
+    std::thread m_flushThread;
+    std::condition_variable m_flushCondition;
+    std::chrono::steady_clock::time_point m_lastChange;
+    std::chrono::steady_clock::time_point m_pendingSince;
+    bool m_flushPending{false};
+    bool m_stopFlush{false};
+    
     // Service name for keychain
     static constexpr const char* SERVICE_NAME = "KonamiClient";
 };
@@ -6,6 +6,8 @@
 
 #include "CacheManager.hpp"
 #include "../Logger.hpp"
+#include "../../utils/DirectoryWalker.hpp"
+#include "../../utils/FileCopier.hpp"
 
 #include <nlohmann/json.hpp>
 #include <lz4.h>
@@ -22,7 +24,7 @@ CacheManager::~CacheManager() {
 }
 
 void CacheManager::initialize(const std::string& cachePath, size_t maxSize) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
 
     m_cachePath = cachePath;
     m_maxSize = maxSize;
@@ -38,13 +40,14 @@ void CacheManager::initialize(const std::string& cachePath, size_t maxSize) {
 void CacheManager::shutdown() {
     if (!m_initialized) return;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
     saveIndex();
     m_initialized = false;
 }
 
 bool CacheManager::add(const std::string& filePath, const std::string& hash) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    KONAMI_ZONE_NAMED("CacheManager::add");
+    std::lock_guard lock(m_mutex);
 
     if (!m_initialized) return false;
     if (hash.empty()) return false;
@@ -74,6 +77,7 @@ bool CacheManager::add(const std::string& filePath, const std::string& hash) {
 
         m_entries[hash] = entry;
         m_currentSize += fileSize;
+        KONAMI_PLOT("Cache size", static_cast<int64_t>(m_currentSize));
 
         saveIndex();
         return true;
@@ -84,12 +88,12 @@ bool CacheManager::add(const std::string& filePath, const std::string& hash) {
 }
 
 bool CacheManager::has(const std::string& hash) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
     return m_entries.find(hash) != m_entries.end();
 }
 
 std::optional<std::string> CacheManager::get(const std::string& hash) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
 
     auto it = m_entries.find(hash);
     if (it == m_entries.end()) {
@@ -112,23 +116,23 @@ std::optional<std::string> CacheManager::get(const std::string& hash) {
 }
 
 bool CacheManager::copyTo(const std::string& hash, const std::string& destination) {
+    KONAMI_ZONE_NAMED("CacheManager::copyTo");
     auto cached = get(hash);
     if (!cached) return false;
 
-    try {
-        std::filesystem::create_directories(
-            std::filesystem::path(destination).parent_path());
-        std::filesystem::copy_file(*cached, destination,
-            std::filesystem::copy_options::overwrite_existing);
-        return true;
-    } catch (const std::exception& e) {
-        Logger::instance().error("Cache copyTo error: {}", e.what());
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(destination).parent_path(), ec);
+
+    std::string error;
+    if (!utils::FileCopier::copyFile(*cached, destination, true, true, &error)) {
+        Logger::instance().error("Cache copyTo error: {}", error);
         return false;
     }
+    return true;
 }
 
 bool CacheManager::remove(const std::string& hash) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
 
     auto it = m_entries.find(hash);
     if (it == m_entries.end()) return false;
@@ -143,7 +147,7 @@ bool CacheManager::remove(const std::string& hash) {
 }
 
 void CacheManager::clear() {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
 
     std::error_code ec;
     std::filesystem::remove_all(m_cachePath, ec);
@@ -158,7 +162,7 @@ void CacheManager::clear() {
 }
 
 void CacheManager::setMaxSize(size_t maxSize) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
     m_maxSize = maxSize;
 
     if (m_currentSize > m_maxSize) {
@@ -167,28 +171,63 @@ void CacheManager::setMaxSize(size_t maxSize) {
 }
 
 size_t CacheManager::getEntryCount() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
     return m_entries.size();
 }
 
 void CacheManager::runMaintenance() {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    KONAMI_ZONE_NAMED("CacheManager::runMaintenance");
+    // One parallel walk of the cache directory instead of a stat per index entry
+    std::unordered_map<std::string, std::pair<std::filesystem::path, size_t>> onDisk;
+    {
+        std::mutex walkMutex;
+        utils::DirectoryWalker::Options options;
+        options.filter = [](const utils::DirectoryWalker::Entry& entry) {
+            return !(entry.depth == 1 && entry.name == "index.json");
+        };
+        utils::DirectoryWalker::walk(m_cachePath, options, [&](const utils::DirectoryWalker::Entry& entry) {
+            if (entry.type != utils::DirectoryWalker::Type::File) return;
+            std::lock_guard<std::mutex> lock(walkMutex);
+            onDisk[std::string(entry.name)] = {entry.fullPath(), static_cast<size_t>(entry.size)};
+        });
+    }
+
+    std::lock_guard lock(m_mutex);
 
-    // Remove entries whose files no longer exist
+    // Remove entries whose files no longer exist and resync sizes with the disk
+    size_t missing = 0;
     for (auto it = m_entries.begin(); it != m_entries.end(); ) {
-        auto path = getCachePath(it->first);
-        if (!std::filesystem::exists(path)) {
+        auto file = onDisk.find(it->first);
+        if (file == onDisk.end() || file->second.first != getCachePath(it->first)) {
             m_currentSize -= it->second.size;
             it = m_entries.erase(it);
+            ++missing;
         } else {
+            m_currentSize = m_currentSize - it->second.size + file->second.second;
+            it->second.size = file->second.second;
             ++it;
         }
     }
 
+    // Delete files the index does not know about
+    size_t orphans = 0;
+    for (const auto& [hash, file] : onDisk) {
+        if (m_entries.count(hash) == 0) {
+            std::error_code ec;
+            if (std::filesystem::remove(file.first, ec)) ++orphans;
+        }
+    }
+
+    if (missing > 0 || orphans > 0) {
+        Logger::instance().info("Cache maintenance: dropped {} missing entries, removed {} orphaned files",
+                                missing, orphans);
+    }
+
     saveIndex();
 }
 
 void CacheManager::loadIndex() {
+    KONAMI_ZONE_NAMED("CacheManager::loadIndex");
     auto indexPath = m_cachePath / "index.json";
     if (!std::filesystem::exists(indexPath)) return;
 
@@ -214,6 +253,7 @@ void CacheManager::loadIndex() {
 }
 
 void CacheManager::saveIndex() const {
+    KONAMI_ZONE_NAMED("CacheManager::saveIndex");
     auto indexPath = m_cachePath / "index.json";
 
     try {
@@ -243,6 +283,7 @@ std::filesystem::path CacheManager::getCachePath(const std::string& hash) const
 }
 
 bool CacheManager::compressFile(const std::string& input, const std::string& output) const {
+    KONAMI_ZONE_NAMED("CacheManager::compressFile");
     try {
         std::ifstream in(input, std::ios::binary);
         std::string data((std::istreambuf_iterator<char>(in)),
@@ -270,6 +311,7 @@ bool CacheManager::compressFile(const std::string& input, const std::string& out
 }
 
 bool CacheManager::decompressFile(const std::string& input, const std::string& output) const {
+    KONAMI_ZONE_NAMED("CacheManager::decompressFile");
     try {
         std::ifstream in(input, std::ios::binary);
 
@@ -297,6 +339,7 @@ bool CacheManager::decompressFile(const std::string& input, const std::string& o
 }
 
 void CacheManager::evict(size_t requiredSpace) {
+    KONAMI_ZONE_NAMED("CacheManager::evict");
     while (m_currentSize + requiredSpace > m_maxSize && !m_entries.empty()) {
         auto lru = getLRUEntry();
         if (lru.empty()) break;
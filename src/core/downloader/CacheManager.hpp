@@ -14,6 +14,8 @@
 #include <optional>
 #include <chrono>
 
+#include "../Profiler.hpp"
+
 namespace konami::core::downloader {
 
 /**
@@ -193,7 +195,7 @@ private:
 private:
     std::filesystem::path m_cachePath;
     std::unordered_map<std::string, CacheEntry> m_entries;
-    mutable std::mutex m_mutex;
+    mutable KONAMI_LOCKABLE(std::mutex, m_mutex);
     
     size_t m_maxSize{0};
     size_t m_currentSize{0};
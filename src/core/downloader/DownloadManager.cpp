@@ -7,6 +7,7 @@
 #include "DownloadManager.hpp"
 #include "../Logger.hpp"
 #include "../Config.hpp"
+#include "../Profiler.hpp"
 #include "../../utils/HashUtils.hpp"
 #include "../../utils/PathUtils.hpp"
 
@@ -16,6 +17,16 @@
 
 namespace konami::core::downloader {
 
+namespace {
+
+const ConfigKey<int> kMaxConcurrent{"downloads.maxConcurrent", 10};
+const ConfigKey<size_t> kBandwidthLimit{"downloads.bandwidthLimit", 0};
+const ConfigKey<int> kRetryCount{"downloads.retryCount", 3};
+const ConfigKey<int> kRetryDelay{"downloads.retryDelay", 1000};
+const ConfigKey<int> kTimeout{"downloads.timeout", 30000};
+
+} // namespace
+
 DownloadManager::DownloadManager()
     : m_cacheManager(std::make_unique<CacheManager>()) {
 }
@@ -30,9 +41,14 @@ void DownloadManager::initialize() {
     Logger::instance().info("Initializing DownloadManager");
     
     // Load configuration
-    auto& config = Config::instance();
-    m_maxConcurrent = config.get<int>("downloads.maxConcurrent", 10);
-    m_bandwidthLimit = config.get<size_t>("downloads.bandwidthLimit", 0);
+    m_maxConcurrent = kMaxConcurrent.get();
+    m_bandwidthLimit = kBandwidthLimit.get();
+    
+    // Pick up bandwidth changes made elsewhere (settings page, CLI)
+    m_configSubscription = Config::instance().subscribe(kBandwidthLimit.key(),
+        [this](const std::string&, const json&) {
+            m_bandwidthLimit = kBandwidthLimit.get();
+        });
     
     // Initialize cache
     auto cachePath = utils::PathUtils::getCachePath();
@@ -52,6 +68,8 @@ void DownloadManager::shutdown() {
     
     Logger::instance().info("Shutting down DownloadManager");
     
+    Config::instance().unsubscribe(m_configSubscription);
+    
     cancelAll();
     
     m_running = false;
@@ -67,6 +85,7 @@ std::string DownloadManager::addDownload(
     DownloadProgressCallback progressCallback,
     DownloadCompleteCallback completeCallback
 ) {
+    KONAMI_ZONE();
     std::string taskId = generateTaskId();
     
     QueuedDownload queued;
@@ -76,29 +95,41 @@ std::string DownloadManager::addDownload(
     queued.progressCallback = std::move(progressCallback);
     queued.completeCallback = std::move(completeCallback);
     
+    // Every path out of here reports completion exactly once, so callers
+    // waiting on a batch of callbacks never stall
+    if (!m_initialized || !m_threadPool) {
+        Logger::instance().error("DownloadManager not initialized; dropping {}", task.url);
+        if (queued.completeCallback) {
+            queued.completeCallback(taskId, false, "Download manager not initialized");
+        }
+        return taskId;
+    }
+    
     // Check cache first
     if (!task.sha1.empty() && m_cacheManager->has(task.sha1)) {
         Logger::instance().debug("Using cached file for: {}", task.url);
         
         // Copy from cache
         if (m_cacheManager->copyTo(task.sha1, task.destination)) {
-            if (completeCallback) {
-                completeCallback(taskId, true, "");
+            if (queued.completeCallback) {
+                queued.completeCallback(taskId, true, "");
             }
             return taskId;
         }
     }
     
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push(queued);
+        std::lock_guard lock(m_mutex);
+        queued.sequence = m_nextSequence++;
+        m_queue.push(std::move(queued));
         m_taskProgress[taskId] = 0.0f;
         ++m_totalTasks;
     }
     
-    // Submit to thread pool
-    m_threadPool->submit([this, queued]() mutable {
-        processDownload(std::move(queued));
+    // Each pool job runs whichever download is on top of the queue when a
+    // worker frees up, so priority decides the order downloads start in
+    m_threadPool->submit([this]() {
+        processDownload();
     });
     
     m_condition.notify_one();
@@ -125,7 +156,7 @@ std::vector<std::string> DownloadManager::addDownloads(
 }
 
 bool DownloadManager::cancelDownload(const std::string& taskId) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
     
     auto it = m_activeTasks.find(taskId);
     if (it != m_activeTasks.end()) {
@@ -138,23 +169,38 @@ bool DownloadManager::cancelDownload(const std::string& taskId) {
 }
 
 void DownloadManager::cancelAll() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    // Cancel all active tasks
-    for (auto& [id, task] : m_activeTasks) {
-        task.task.cancelled = true;
+    std::vector<QueuedDownload> dropped;
+    {
+        std::lock_guard lock(m_mutex);
+        
+        // Cancel all active tasks
+        for (auto& [id, task] : m_activeTasks) {
+            task.task.cancelled = true;
+        }
+        m_activeTasks.clear();
+        
+        // Clear queue; the pool jobs submitted for these find it empty
+        dropped.reserve(m_queue.size());
+        while (!m_queue.empty()) {
+            dropped.push_back(m_queue.top());
+            m_queue.pop();
+        }
+        
+        m_totalTasks = 0;
+        m_completedTasks = 0;
+        m_totalBytes = 0;
+        m_downloadedBytes = 0;
     }
-    m_activeTasks.clear();
     
-    // Clear queue
-    while (!m_queue.empty()) {
-        m_queue.pop();
+    // Queued downloads never started, but their callers still wait for them
+    for (const auto& queued : dropped) {
+        if (queued.completeCallback) {
+            queued.completeCallback(queued.task.id, false, "Cancelled");
+        }
     }
     
-    m_totalTasks = 0;
-    m_completedTasks = 0;
-    m_totalBytes = 0;
-    m_downloadedBytes = 0;
+    std::lock_guard lock(m_mutex);
+    m_completionCondition.notify_all();
 }
 
 void DownloadManager::pauseAll() {
@@ -169,14 +215,14 @@ void DownloadManager::resumeAll() {
 }
 
 void DownloadManager::waitForAll() {
-    std::unique_lock<std::mutex> lock(m_mutex);
+    std::unique_lock lock(m_mutex);
     m_completionCondition.wait(lock, [this] {
         return m_queue.empty() && m_activeTasks.empty();
     });
 }
 
 float DownloadManager::getProgress(const std::string& taskId) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
     
     auto it = m_taskProgress.find(taskId);
     if (it != m_taskProgress.end()) {
@@ -197,12 +243,12 @@ float DownloadManager::getOverallProgress() const {
 }
 
 size_t DownloadManager::getPendingCount() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
     return m_queue.size();
 }
 
 size_t DownloadManager::getActiveCount() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard lock(m_mutex);
     return m_activeTasks.size();
 }
 
@@ -212,38 +258,61 @@ size_t DownloadManager::getCurrentSpeed() const {
 
 void DownloadManager::setMaxConcurrent(size_t max) {
     m_maxConcurrent = max;
-    Config::instance().set("downloads.maxConcurrent", static_cast<int>(max));
+    kMaxConcurrent.set(static_cast<int>(max));
 }
 
 void DownloadManager::setBandwidthLimit(size_t limit) {
     m_bandwidthLimit = limit;
-    Config::instance().set("downloads.bandwidthLimit", limit);
+    kBandwidthLimit.set(limit);
 }
 
 void DownloadManager::setOverallProgressCallback(OverallProgressCallback callback) {
     m_overallProgressCallback = std::move(callback);
 }
 
-void DownloadManager::processDownload(QueuedDownload queued) {
-    if (!m_running || queued.task.cancelled) {
-        return;
-    }
+void DownloadManager::processDownload() {
+    KONAMI_ZONE();
     
     // Wait if paused
     while (m_paused && m_running) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     
+    QueuedDownload queued;
+    bool cancelled = false;
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_activeTasks[queued.task.id] = queued;
+        std::lock_guard lock(m_mutex);
+        
+        // cancelAll() already reported whatever this job was submitted for
+        if (m_queue.empty()) {
+            return;
+        }
+        queued = m_queue.top();
+        m_queue.pop();
+        
+        if (m_running && !queued.task.cancelled) {
+            m_activeTasks[queued.task.id] = queued;
+            KONAMI_PLOT("Downloads active", static_cast<int64_t>(m_activeTasks.size()));
+            KONAMI_PLOT("Downloads pending", static_cast<int64_t>(m_queue.size()));
+        } else {
+            cancelled = true;
+        }
+    }
+    
+    // Cancelled or shut down before starting: still report it
+    if (cancelled) {
+        if (queued.completeCallback) {
+            queued.completeCallback(queued.task.id, false, "Cancelled");
+        }
+        std::lock_guard lock(m_mutex);
+        m_completionCondition.notify_all();
+        return;
     }
     
     bool success = executeDownload(queued.task, queued.progressCallback);
     
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_activeTasks.erase(queued.task.id);
+        std::lock_guard lock(m_mutex);
         m_taskProgress[queued.task.id] = success ? 1.0f : -1.0f;
         ++m_completedTasks;
     }
@@ -266,8 +335,12 @@ void DownloadManager::processDownload(QueuedDownload queued) {
         );
     }
     
-    // Notify completion if all done
-    if (m_completedTasks >= m_totalTasks) {
+    // Leave the active set only after the callbacks, so waitForAll()
+    // returns once every callback has run
+    {
+        std::lock_guard lock(m_mutex);
+        m_activeTasks.erase(queued.task.id);
+        KONAMI_PLOT("Downloads active", static_cast<int64_t>(m_activeTasks.size()));
         m_completionCondition.notify_all();
     }
 }
@@ -276,16 +349,19 @@ bool DownloadManager::executeDownload(
     DownloadTask& task,
     const DownloadProgressCallback& progressCallback
 ) {
-    auto& config = Config::instance();
-    int retryCount = config.get<int>("downloads.retryCount", 3);
-    int retryDelay = config.get<int>("downloads.retryDelay", 1000);
-    int timeout = config.get<int>("downloads.timeout", 30000);
+    KONAMI_ZONE();
+    KONAMI_ZONE_TEXT(task.url);
+    
+    int retryCount = kRetryCount.get();
+    int retryDelay = kRetryDelay.get();
+    int timeout = kTimeout.get();
     
     for (int attempt = 0; attempt <= retryCount; ++attempt) {
         if (task.cancelled) {
             return false;
         }
         
+        task.retryAttempts = attempt;
         if (attempt > 0) {
             Logger::instance().debug("Retry {} for {}", attempt, task.url);
             std::this_thread::sleep_for(std::chrono::milliseconds(retryDelay * attempt));
@@ -328,7 +404,7 @@ bool DownloadManager::executeDownload(
                     
                     // Update task progress
                     {
-                        std::lock_guard<std::mutex> lock(m_mutex);
+                        std::lock_guard lock(m_mutex);
                         m_taskProgress[task.id] = downloadTotal > 0 
                             ? static_cast<float>(downloadNow) / static_cast<float>(downloadTotal)
                             : 0.0f;
@@ -374,6 +450,7 @@ bool DownloadManager::executeDownload(
             }
             
             m_downloadedBytes += std::filesystem::file_size(task.destination);
+            KONAMI_PLOT("Download speed", static_cast<int64_t>(m_currentSpeed.load()));
             
             Logger::instance().debug("Downloaded: {}", task.destination);
             return true;
@@ -389,6 +466,8 @@ bool DownloadManager::executeDownload(
 }
 
 bool DownloadManager::verifyChecksum(const DownloadTask& task) {
+    KONAMI_ZONE();
+    
     if (task.sha1.empty()) {
         return true;
     }
@@ -10,6 +10,7 @@
 #include "DownloadTask.hpp"
 #include "CacheManager.hpp"
 #include "../ThreadPool.hpp"
+#include "../Profiler.hpp"
 
 #include <vector>
 #include <queue>
@@ -57,11 +58,13 @@ using OverallProgressCallback = std::function<void(
 struct QueuedDownload {
     DownloadTask task;
     int priority{0};
+    uint64_t sequence{0};   // Submission order, first-in first-out within a priority
     DownloadProgressCallback progressCallback;
     DownloadCompleteCallback completeCallback;
     
     bool operator<(const QueuedDownload& other) const {
-        return priority < other.priority;
+        if (priority != other.priority) return priority < other.priority;
+        return sequence > other.sequence;
     }
 };
 
@@ -222,10 +225,9 @@ private:
     void workerLoop();
     
     /**
-     * Process a download task
-     * @param queued Queued download
+     * Take the highest-priority queued download and run it
      */
-    void processDownload(QueuedDownload queued);
+    void processDownload();
     
     /**
      * Execute download with retry
@@ -259,9 +261,9 @@ private:
     std::unordered_map<std::string, QueuedDownload> m_activeTasks;
     std::unordered_map<std::string, float> m_taskProgress;
     
-    mutable std::mutex m_mutex;
-    std::condition_variable m_condition;
-    std::condition_variable m_completionCondition;
+    mutable KONAMI_LOCKABLE(std::mutex, m_mutex);
+    LockableConditionVariable m_condition;
+    LockableConditionVariable m_completionCondition;
     
     std::atomic<bool> m_running{false};
     std::atomic<bool> m_paused{false};
@@ -277,6 +279,8 @@ private:
     OverallProgressCallback m_overallProgressCallback;
     
     std::atomic<uint64_t> m_nextTaskId{0};
+    uint64_t m_nextSequence{0};
+    uint64_t m_configSubscription{0};
     bool m_initialized{false};
 };
 
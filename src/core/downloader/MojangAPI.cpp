@@ -6,15 +6,88 @@
 
 #include "MojangAPI.hpp"
 #include "../Logger.hpp"
+#include "../../utils/JsonSchema.hpp"
+#include "../../utils/Version.hpp"
 
 #include <cpr/cpr.h>
 #include <algorithm>
+#include <numeric>
 #include <sstream>
 
 namespace konami::core::downloader {
 
 using json = nlohmann::json;
 
+namespace {
+
+/**
+ * The shape parseVersionData relies on. Vanilla and loader (Fabric,
+ * Quilt, Forge) version JSONs all satisfy it; anything else would fail
+ * with a type_error halfway through parsing, or launch with garbage.
+ */
+const utils::JsonSchema& versionSchema() {
+    static const utils::JsonSchema schema = *utils::JsonSchema::compile(json::parse(R"({
+        "type": "object",
+        "required": ["id"],
+        "properties": {
+            "id": {"type": "string", "minLength": 1},
+            "type": {"type": "string"},
+            "mainClass": {"type": "string"},
+            "minecraftArguments": {"type": "string"},
+            "inheritsFrom": {"type": "string"},
+            "javaVersion": {
+                "type": "object",
+                "properties": {
+                    "component": {"type": "string"},
+                    "majorVersion": {"type": "integer", "minimum": 1}
+                }
+            },
+            "assetIndex": {"$ref": "#/$defs/download", "required": ["id", "url"]},
+            "downloads": {"type": "object", "additionalProperties": {"$ref": "#/$defs/download"}},
+            "libraries": {"type": "array", "items": {"$ref": "#/$defs/library"}}
+        },
+        "$defs": {
+            "download": {
+                "type": "object",
+                "properties": {
+                    "id": {"type": "string"},
+                    "url": {"type": "string"},
+                    "sha1": {"type": "string", "pattern": "^[0-9a-fA-F]{40}$"},
+                    "size": {"type": "integer", "minimum": 0},
+                    "totalSize": {"type": "integer", "minimum": 0}
+                }
+            },
+            "library": {
+                "type": "object",
+                "required": ["name"],
+                "properties": {
+                    "name": {"type": "string", "pattern": "^[^:]+:[^:]+:[^:]+"},
+                    "downloads": {
+                        "type": "object",
+                        "properties": {
+                            "artifact": {"$ref": "#/$defs/download"},
+                            "classifiers": {"type": "object", "additionalProperties": {"$ref": "#/$defs/download"}}
+                        }
+                    },
+                    "natives": {"type": "object", "additionalProperties": {"type": "string"}},
+                    "rules": {
+                        "type": "array",
+                        "items": {
+                            "type": "object",
+                            "properties": {
+                                "os": {"type": "object", "properties": {"name": {"type": "string"}}}
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    })"));
+    return schema;
+}
+
+} // namespace
+
 std::future<std::vector<VersionInfo>> MojangAPI::getVersionManifest() {
     return std::async(std::launch::async, [this]() -> std::vector<VersionInfo> {
         try {
@@ -38,6 +111,18 @@ std::future<std::vector<VersionInfo>> MojangAPI::getVersionManifest() {
                 versions.push_back(parseVersionInfo(v));
             }
 
+            // Newest first: release time, then the parsed version for same-instant entries
+            std::vector<std::pair<std::string, utils::Version>> keys;
+            keys.reserve(versions.size());
+            for (const auto& v : versions) keys.emplace_back(v.releaseTime, utils::Version(v.id));
+            std::vector<size_t> order(versions.size());
+            std::iota(order.begin(), order.end(), size_t{0});
+            std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) { return keys[a] > keys[b]; });
+            std::vector<VersionInfo> sorted;
+            sorted.reserve(versions.size());
+            for (size_t i : order) sorted.push_back(std::move(versions[i]));
+            versions = std::move(sorted);
+
             m_cachedManifest = versions;
             Logger::instance().info("Fetched {} versions from Mojang", versions.size());
             return versions;
@@ -96,6 +181,12 @@ std::future<std::optional<VersionData>> MojangAPI::getVersionData(const VersionI
             }
 
             auto j = json::parse(response.text);
+            if (!versionSchema().validate(j)) {
+                for (const auto& error : versionSchema().errors(j)) {
+                    Logger::instance().error("Version JSON for {} is invalid at {}", versionInfo.id, error.str());
+                }
+                return std::nullopt;
+            }
             return parseVersionData(j);
 
         } catch (const std::exception& e) {
@@ -137,14 +228,7 @@ std::future<std::vector<AssetObject>> MojangAPI::getAssetIndex(const AssetIndex&
                 return {};
             }
 
-            auto j = json::parse(response.text);
-            std::vector<AssetObject> assets;
-
-            if (j.contains("objects")) {
-                for (auto& [name, obj] : j["objects"].items()) {
-                    assets.push_back(parseAssetObject(name, obj));
-                }
-            }
+            auto assets = parseAssetIndex(response.text);
 
             Logger::instance().info("Fetched {} assets", assets.size());
             return assets;
@@ -156,6 +240,21 @@ std::future<std::vector<AssetObject>> MojangAPI::getAssetIndex(const AssetIndex&
     });
 }
 
+std::vector<AssetObject> MojangAPI::parseAssetIndex(const std::string& text) {
+    auto j = json::parse(text);
+    std::vector<AssetObject> assets;
+
+    if (j.contains("objects")) {
+        const auto& objects = j["objects"];
+        assets.reserve(objects.size());
+        for (auto& [name, obj] : objects.items()) {
+            assets.push_back(parseAssetObject(name, obj));
+        }
+    }
+
+    return assets;
+}
+
 std::string MojangAPI::getAssetUrl(const AssetObject& asset) {
     if (asset.hash.size() < 2) return "";
     return std::string(RESOURCES_URL) + "/" + asset.hash.substr(0, 2) + "/" + asset.hash;
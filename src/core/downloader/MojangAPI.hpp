@@ -155,6 +155,13 @@ public:
      */
     std::future<std::vector<AssetObject>> getAssetIndex(const AssetIndex& assetIndex);
     
+    /**
+     * Parse a downloaded asset index
+     * @param text Asset index JSON
+     * @return Asset objects (throws on malformed JSON)
+     */
+    static std::vector<AssetObject> parseAssetIndex(const std::string& text);
+    
     /**
      * Build asset download URL
      * @param asset Asset object
@@ -1,7 +1,18 @@
 #include "GameLauncher.hpp"
 #include "../Logger.hpp"
+#include "../Profiler.hpp"
+#include "../StartupTrace.hpp"
+#include "../ThreadPool.hpp"
 #include "../downloader/DownloadManager.hpp"
+#include "../downloader/MojangAPI.hpp"
+#include "../../utils/FileUtils.hpp"
+#include "../../utils/HashUtils.hpp"
+#include "../../utils/Version.hpp"
+#include "../../utils/ZipArchive.hpp"
+#include <algorithm>
+#include <condition_variable>
 #include <fstream>
+#include <optional>
 #include <sstream>
 #include <regex>
 #include <thread>
@@ -26,7 +37,9 @@ public:
     std::filesystem::path nativesDirectory;
     
     VersionManifest versionManifest;
-    std::vector<VersionInfo> installedVersions;
+    std::vector<VersionInfo> installedVersions;     // Guarded by versionsMutex
+    
+    std::shared_ptr<core::downloader::DownloadManager> downloadManager;
     
     LaunchState currentState = LaunchState::Idle;
     ProcessInfo currentProcess;
@@ -40,6 +53,7 @@ public:
     
     std::mutex logMutex;
     std::mutex stateMutex;
+    std::mutex versionsMutex;
     
 #ifdef _WIN32
     HANDLE processHandle = nullptr;
@@ -130,6 +144,9 @@ public:
                     info.nativeClassifier = lib["natives"]["linux"].get<std::string>();
                 }
 #endif
+                if (info.native) {
+                    resolveNativeArtifact(lib, info);
+                }
             }
             
             // Rules
@@ -165,6 +182,207 @@ public:
         return libraries;
     }
     
+    void resolveNativeArtifact(const nlohmann::json& lib, LibraryInfo& info) {
+        std::string classifier = info.nativeClassifier;
+        auto arch = classifier.find("${arch}");
+        if (arch != std::string::npos) {
+            classifier.replace(arch, 7, sizeof(void*) == 8 ? "64" : "32");
+        }
+        info.nativeClassifier = classifier;
+        
+        if (lib.contains("downloads") && lib["downloads"].contains("classifiers") &&
+            lib["downloads"]["classifiers"].contains(classifier)) {
+            const auto& artifact = lib["downloads"]["classifiers"][classifier];
+            info.nativePath = artifact.value("path", "");
+            info.nativeUrl = artifact.value("url", "");
+            info.nativeSha1 = artifact.value("sha1", "");
+            info.nativeSize = artifact.value("size", 0);
+        }
+        if (info.nativePath.empty() && info.path.size() > 4) {
+            info.nativePath = info.path.substr(0, info.path.size() - 4) + "-" + classifier + ".jar";
+        }
+        
+        if (lib.contains("extract") && lib["extract"].contains("exclude")) {
+            for (const auto& prefix : lib["extract"]["exclude"]) {
+                info.extractExclude.push_back(prefix.get<std::string>());
+            }
+        }
+    }
+    
+    // A file a version needs on disk
+    struct RequiredFile {
+        std::string url;
+        std::filesystem::path path;
+        std::string sha1;
+        int64_t size = 0;
+    };
+    
+    std::vector<RequiredFile> clientFiles(const std::string& version, const nlohmann::json& versionJson) {
+        std::vector<RequiredFile> files;
+        if (versionJson.contains("downloads") && versionJson["downloads"].contains("client")) {
+            const auto& client = versionJson["downloads"]["client"];
+            files.push_back({client.value("url", ""), versionsDirectory / version / (version + ".jar"),
+                             client.value("sha1", ""), client.value("size", int64_t{0})});
+        }
+        return files;
+    }
+    
+    std::vector<RequiredFile> libraryFiles(const nlohmann::json& versionJson) {
+        std::vector<RequiredFile> files;
+        for (const auto& lib : parseLibraries(versionJson)) {
+            if (!lib.url.empty() && !lib.path.empty()) {
+                files.push_back({lib.url, librariesDirectory / lib.path, lib.sha1, lib.size});
+            }
+            if (lib.native && !lib.nativeUrl.empty() && !lib.nativePath.empty()) {
+                files.push_back({lib.nativeUrl, librariesDirectory / lib.nativePath, lib.nativeSha1, lib.nativeSize});
+            }
+        }
+        return files;
+    }
+    
+    std::optional<RequiredFile> assetIndexFile(const nlohmann::json& versionJson) {
+        if (!versionJson.contains("assetIndex")) return std::nullopt;
+        const auto& index = versionJson["assetIndex"];
+        std::string id = index.value("id", "");
+        if (id.empty()) return std::nullopt;
+        return RequiredFile{index.value("url", ""), assetsDirectory / "indexes" / (id + ".json"),
+                            index.value("sha1", ""), index.value("size", int64_t{0})};
+    }
+    
+    // Objects listed by an asset index already on disk
+    std::vector<RequiredFile> assetFiles(const RequiredFile& indexFile) {
+        std::vector<RequiredFile> files;
+        auto text = utils::FileUtils::readFile(indexFile.path);
+        if (!text) return files;
+        
+        try {
+            for (const auto& asset : core::downloader::MojangAPI::parseAssetIndex(*text)) {
+                if (asset.hash.size() < 2) continue;
+                files.push_back({core::downloader::MojangAPI::getAssetUrl(asset),
+                                 assetsDirectory / "objects" / asset.hash.substr(0, 2) / asset.hash,
+                                 asset.hash, static_cast<int64_t>(asset.size)});
+            }
+        } catch (const std::exception& e) {
+            core::Logger::instance().error("Invalid asset index {}: {}", indexFile.path.string(), e.what());
+        }
+        return files;
+    }
+    
+    static bool isMissing(const RequiredFile& file, bool verifyHashes) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(file.path, ec);
+        if (ec) return true;
+        if (file.size > 0 && size != static_cast<uintmax_t>(file.size)) return true;
+        return verifyHashes && !file.sha1.empty() && utils::HashUtils::sha1File(file.path.string()) != file.sha1;
+    }
+    
+    // Files that are absent, the wrong size or (with verifyHashes) the wrong
+    // hash; checked in parallel since hashing a full install reads every byte
+    std::vector<RequiredFile> findMissing(const std::vector<RequiredFile>& files, bool verifyHashes) {
+        KONAMI_ZONE();
+        auto& pool = core::ThreadPool::global();
+        size_t chunkSize = std::max<size_t>((files.size() + pool.size() - 1) / pool.size(), 1);
+        
+        std::vector<std::future<std::vector<RequiredFile>>> chunks;
+        for (size_t begin = 0; begin < files.size(); begin += chunkSize) {
+            size_t end = std::min(begin + chunkSize, files.size());
+            chunks.push_back(pool.submit([&files, begin, end, verifyHashes] {
+                std::vector<RequiredFile> missing;
+                for (size_t i = begin; i < end; ++i) {
+                    if (isMissing(files[i], verifyHashes)) missing.push_back(files[i]);
+                }
+                return missing;
+            }));
+        }
+        
+        std::vector<RequiredFile> missing;
+        for (auto& chunk : chunks) {
+            auto part = chunk.get();
+            missing.insert(missing.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+        }
+        return missing;
+    }
+    
+    // Queue files on the download manager and wait for this batch only,
+    // reporting progress from the calling thread at most every 100 ms
+    bool downloadFiles(const std::vector<RequiredFile>& files, LaunchState state, const std::string& message,
+                       const ProgressCallback& progressCallback) {
+        KONAMI_ZONE();
+        if (files.empty()) return true;
+        if (!downloadManager) {
+            core::Logger::instance().error("No download manager set; cannot download {} files", files.size());
+            return false;
+        }
+        
+        struct Batch {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t completed = 0;
+            size_t failed = 0;
+            int64_t bytes = 0;
+        };
+        auto batch = std::make_shared<Batch>();
+        
+        int64_t totalBytes = 0;
+        for (const auto& file : files) {
+            totalBytes += file.size;
+            
+            core::downloader::DownloadTask task(file.url, file.path.string(), file.sha1);
+            task.expectedSize = static_cast<size_t>(std::max<int64_t>(file.size, 0));
+            downloadManager->addDownload(task, 0, nullptr,
+                [batch, size = file.size, url = file.url](const std::string&, bool success, const std::string& error) {
+                    std::lock_guard<std::mutex> lock(batch->mutex);
+                    ++batch->completed;
+                    if (success) {
+                        batch->bytes += size;
+                    } else {
+                        ++batch->failed;
+                        core::Logger::instance().warn("Download failed: {} ({})", url, error);
+                    }
+                    batch->done.notify_all();
+                });
+        }
+        
+        while (true) {
+            LaunchProgress progress;
+            progress.state = state;
+            progress.message = message;
+            progress.totalFiles = static_cast<int>(files.size());
+            progress.totalBytes = totalBytes;
+            bool finished = false;
+            {
+                std::unique_lock<std::mutex> lock(batch->mutex);
+                batch->done.wait_for(lock, std::chrono::milliseconds(100),
+                                     [&] { return batch->completed == files.size(); });
+                finished = batch->completed == files.size();
+                progress.downloadedFiles = static_cast<int>(batch->completed);
+                progress.downloadedBytes = batch->bytes;
+            }
+            progress.progress = static_cast<double>(progress.downloadedFiles) / static_cast<double>(files.size());
+            if (progressCallback) {
+                progressCallback(progress);
+            }
+            if (finished) break;
+        }
+        
+        if (batch->failed > 0) {
+            core::Logger::instance().error("{} of {} downloads failed", batch->failed, files.size());
+        }
+        return batch->failed == 0;
+    }
+    
+    void reportStage(const ProgressCallback& progressCallback, LaunchState state,
+                     const std::string& message, double value) {
+        setState(state);
+        if (progressCallback) {
+            LaunchProgress progress;
+            progress.state = state;
+            progress.message = message;
+            progress.progress = value;
+            progressCallback(progress);
+        }
+    }
+    
     std::vector<std::string> splitString(const std::string& str, char delimiter) {
         std::vector<std::string> parts;
         std::stringstream ss(str);
@@ -196,6 +414,7 @@ bool GameLauncher::initialize(const std::filesystem::path& gameDirectory) {
     std::filesystem::create_directories(m_impl->nativesDirectory);
     
     // Scan installed versions
+    std::vector<VersionInfo> installed;
     for (const auto& entry : std::filesystem::directory_iterator(m_impl->versionsDirectory)) {
         if (entry.is_directory()) {
             auto versionId = entry.path().filename().string();
@@ -204,13 +423,22 @@ bool GameLauncher::initialize(const std::filesystem::path& gameDirectory) {
             if (std::filesystem::exists(versionJson)) {
                 VersionInfo info;
                 info.id = versionId;
-                m_impl->installedVersions.push_back(info);
+                installed.push_back(info);
             }
         }
     }
     
-    core::Logger::instance().info("Initialized GameLauncher with {} installed versions", 
-        m_impl->installedVersions.size());
+    // Newest first, parsing each id once
+    std::vector<std::pair<utils::Version, VersionInfo>> keyed;
+    keyed.reserve(installed.size());
+    for (auto& info : installed) keyed.emplace_back(utils::Version(info.id), std::move(info));
+    std::stable_sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    installed.clear();
+    for (auto& [key, info] : keyed) installed.push_back(std::move(info));
+    
+    core::Logger::instance().info("Initialized GameLauncher with {} installed versions", installed.size());
+    std::lock_guard<std::mutex> lock(m_impl->versionsMutex);
+    m_impl->installedVersions = std::move(installed);
     return true;
 }
 
@@ -247,19 +475,87 @@ std::vector<VersionInfo> GameLauncher::getAvailableVersions() const {
 }
 
 std::vector<VersionInfo> GameLauncher::getInstalledVersions() const {
+    std::lock_guard<std::mutex> lock(m_impl->versionsMutex);
     return m_impl->installedVersions;
 }
 
 bool GameLauncher::isVersionInstalled(const std::string& version) const {
+    std::lock_guard<std::mutex> lock(m_impl->versionsMutex);
     auto it = std::find_if(m_impl->installedVersions.begin(), m_impl->installedVersions.end(),
         [&version](const VersionInfo& v) { return v.id == version; });
     return it != m_impl->installedVersions.end();
 }
 
+std::future<bool> GameLauncher::installVersion(const std::string& version, ProgressCallback progressCallback) {
+    return std::async(std::launch::async, [this, version, progressCallback]() {
+        KONAMI_ZONE_NAMED("GameLauncher::installVersion");
+        core::Logger::instance().info("Installing version {}", version);
+        m_impl->reportStage(progressCallback, LaunchState::Preparing, "Resolving version " + version, 0.0);
+        
+        // Reuse the version JSON of an earlier (possibly partial) install
+        auto versionJson = m_impl->loadVersionJson(version);
+        if (versionJson.is_null()) {
+            core::downloader::MojangAPI api;
+            auto data = api.getVersionDataById(version).get();
+            if (!data) {
+                core::Logger::instance().error("Unknown version: {}", version);
+                return false;
+            }
+            
+            auto jsonPath = m_impl->versionsDirectory / version / (version + ".json");
+            std::error_code ec;
+            std::filesystem::create_directories(jsonPath.parent_path(), ec);
+            if (!utils::FileUtils::writeFileAtomic(jsonPath, data->rawJson.dump(2))) {
+                core::Logger::instance().error("Failed to write {}", jsonPath.string());
+                return false;
+            }
+            versionJson = data->rawJson;
+        }
+        
+        auto clientFiles = m_impl->findMissing(m_impl->clientFiles(version, versionJson), false);
+        bool ok = m_impl->downloadFiles(clientFiles, LaunchState::DownloadingClient,
+                                        "Downloading client", progressCallback);
+        ok = downloadLibraries(version, progressCallback) && ok;
+        ok = downloadAssets(version, progressCallback) && ok;
+        
+        if (ok) {
+            // Check and insert under one lock: concurrent installs of the
+            // same version must not both add it
+            std::lock_guard<std::mutex> lock(m_impl->versionsMutex);
+            auto& installed = m_impl->installedVersions;
+            if (std::none_of(installed.begin(), installed.end(),
+                             [&version](const VersionInfo& v) { return v.id == version; })) {
+                VersionInfo info;
+                info.id = version;
+                installed.insert(installed.begin(), info);
+            }
+        }
+        
+        m_impl->reportStage(progressCallback, ok ? LaunchState::Finished : LaunchState::Idle,
+                            ok ? "Installed " + version : "Install of " + version + " incomplete",
+                            ok ? 1.0 : 0.0);
+        core::Logger::instance().info("Install of {} {}", version, ok ? "finished" : "failed");
+        return ok;
+    });
+}
+
 std::future<bool> GameLauncher::launch(const LaunchOptions& options, ProgressCallback progressCallback) {
     return std::async(std::launch::async, [this, options, progressCallback]() {
+        KONAMI_THREAD_NAME("Launcher");
+        KONAMI_ZONE_NAMED("GameLauncher::launch");
         core::Logger::instance().info("Launching profile: {}", options.profileId);
         
+        // One trace span per launch stage; the last one runs until the
+        // game prints its first line
+        auto& trace = core::StartupTrace::instance();
+        auto launchStart = core::StartupTrace::Clock::now();
+        std::optional<core::StartupTrace::Span> stage;
+        auto beginStage = [&](const char* name) {
+            stage.reset();
+            stage.emplace(trace.span(name, "launch"));
+        };
+        
+        beginStage("launch.prepare");
         m_impl->setState(LaunchState::Preparing);
         
         if (progressCallback) {
@@ -282,6 +578,7 @@ std::future<bool> GameLauncher::launch(const LaunchOptions& options, ProgressCal
         }
         
         // Download assets
+        beginStage("launch.assets");
         m_impl->setState(LaunchState::DownloadingAssets);
         if (progressCallback) {
             LaunchProgress progress;
@@ -292,6 +589,7 @@ std::future<bool> GameLauncher::launch(const LaunchOptions& options, ProgressCal
         }
         
         // Download libraries
+        beginStage("launch.libraries");
         m_impl->setState(LaunchState::DownloadingLibraries);
         if (progressCallback) {
             LaunchProgress progress;
@@ -302,6 +600,7 @@ std::future<bool> GameLauncher::launch(const LaunchOptions& options, ProgressCal
         }
         
         // Build command line
+        beginStage("launch.build");
         m_impl->setState(LaunchState::Building);
         
         auto jvmArgs = buildJvmArguments(profile, options);
@@ -330,6 +629,7 @@ std::future<bool> GameLauncher::launch(const LaunchOptions& options, ProgressCal
         }
         
         // Launch
+        beginStage("launch.spawn");
         m_impl->setState(LaunchState::Launching);
         if (progressCallback) {
             LaunchProgress progress;
@@ -384,11 +684,24 @@ std::future<bool> GameLauncher::launch(const LaunchOptions& options, ProgressCal
                 }, stdoutRead, 0, nullptr);
         }
 #else
-        // Unix process creation
+        // Unix process creation; stdout and stderr go to a pipe so the game
+        // log (and the time to its first line) is visible to the launcher
+        int outputPipe[2] = {-1, -1};
+        if (pipe(outputPipe) != 0) {
+            core::Logger::instance().warn("Cannot capture game output: pipe failed");
+        }
+        
         m_impl->processPid = fork();
         
         if (m_impl->processPid == 0) {
             // Child process
+            if (outputPipe[1] >= 0) {
+                dup2(outputPipe[1], STDOUT_FILENO);
+                dup2(outputPipe[1], STDERR_FILENO);
+                close(outputPipe[0]);
+                close(outputPipe[1]);
+            }
+            
             std::vector<char*> args;
             for (auto& arg : command) {
                 args.push_back(const_cast<char*>(arg.c_str()));
@@ -397,17 +710,53 @@ std::future<bool> GameLauncher::launch(const LaunchOptions& options, ProgressCal
             
             chdir(profile.gameDirectory.c_str());
             execvp(args[0], args.data());
-            exit(1);
+            _exit(1);
         } else if (m_impl->processPid > 0) {
             m_impl->currentProcess.pid = m_impl->processPid;
             m_impl->currentProcess.startTime = std::chrono::system_clock::now();
             m_impl->running = true;
             
+            if (outputPipe[1] >= 0) {
+                close(outputPipe[1]);
+            }
+            stage.reset();
+            if (outputPipe[0] >= 0) {
+                stage.emplace(trace.span("launch.firstOutput", "launch"));
+            }
+            
             // Start output reading thread (joinable, joined on shutdown)
             if (m_impl->outputThread.joinable()) {
                 m_impl->outputThread.join();
             }
-            m_impl->outputThread = std::thread([this]() {
+            m_impl->outputThread = std::thread([this, outputFd = outputPipe[0], launchStart,
+                                                firstOutput = std::move(stage)]() mutable {
+                if (outputFd >= 0) {
+                    std::string pending;
+                    char buffer[4096];
+                    ssize_t count;
+                    while ((count = read(outputFd, buffer, sizeof(buffer))) > 0) {
+                        pending.append(buffer, static_cast<size_t>(count));
+                        size_t newline;
+                        while ((newline = pending.find('\n')) != std::string::npos) {
+                            if (firstOutput) {
+                                firstOutput->end();
+                                firstOutput.reset();
+                                auto now = core::StartupTrace::Clock::now();
+                                core::StartupTrace::instance().record("launch", "launch", launchStart,
+                                                                      now - launchStart, std::this_thread::get_id());
+                                core::Logger::instance().info("Game printed its first line {}ms after launch",
+                                    std::chrono::duration_cast<std::chrono::milliseconds>(now - launchStart).count());
+                            }
+                            m_impl->addLogLine(pending.substr(0, newline), false);
+                            pending.erase(0, newline + 1);
+                        }
+                    }
+                    if (!pending.empty()) {
+                        m_impl->addLogLine(pending, false);
+                    }
+                    close(outputFd);
+                }
+                
                 int status;
                 waitpid(m_impl->processPid, &status, 0);
                 
@@ -421,6 +770,12 @@ std::future<bool> GameLauncher::launch(const LaunchOptions& options, ProgressCal
                     m_impl->onGameExited(m_impl->currentProcess.exitCode);
                 }
             });
+        } else {
+            core::Logger::instance().error("Failed to start game process");
+            if (outputPipe[0] >= 0) {
+                close(outputPipe[0]);
+                close(outputPipe[1]);
+            }
         }
 #endif
         
@@ -522,6 +877,79 @@ void GameLauncher::setLibrariesDirectory(const std::filesystem::path& path) {
     m_impl->librariesDirectory = path;
 }
 
+void GameLauncher::setDownloadManager(std::shared_ptr<core::downloader::DownloadManager> manager) {
+    m_impl->downloadManager = std::move(manager);
+}
+
+std::future<bool> GameLauncher::verifyAssets(const std::string& version, ProgressCallback progressCallback) {
+    return std::async(std::launch::async, [this, version, progressCallback]() {
+        KONAMI_ZONE_NAMED("GameLauncher::verifyAssets");
+        auto versionJson = m_impl->loadVersionJson(version);
+        if (versionJson.is_null()) {
+            core::Logger::instance().error("Version {} is not installed", version);
+            return false;
+        }
+        
+        // Client, libraries, the asset index and every object it lists, by hash
+        auto files = m_impl->clientFiles(version, versionJson);
+        auto libraries = m_impl->libraryFiles(versionJson);
+        files.insert(files.end(), libraries.begin(), libraries.end());
+        if (auto index = m_impl->assetIndexFile(versionJson)) {
+            files.push_back(*index);
+            auto assets = m_impl->assetFiles(*index);
+            files.insert(files.end(), assets.begin(), assets.end());
+        }
+        
+        m_impl->reportStage(progressCallback, LaunchState::Preparing,
+                            "Verifying " + std::to_string(files.size()) + " files", 0.0);
+        auto missing = m_impl->findMissing(files, true);
+        for (const auto& file : missing) {
+            core::Logger::instance().warn("Missing or corrupt: {}", file.path.string());
+        }
+        
+        if (progressCallback) {
+            LaunchProgress progress;
+            progress.state = LaunchState::Finished;
+            progress.message = missing.empty() ? "All files verified"
+                                               : std::to_string(missing.size()) + " files missing or corrupt";
+            progress.progress = 1.0;
+            progress.downloadedFiles = static_cast<int>(files.size() - missing.size());
+            progress.totalFiles = static_cast<int>(files.size());
+            progressCallback(progress);
+        }
+        return missing.empty();
+    });
+}
+
+std::future<bool> GameLauncher::repairAssets(const std::string& version, ProgressCallback progressCallback) {
+    return std::async(std::launch::async, [this, version, progressCallback]() {
+        KONAMI_ZONE_NAMED("GameLauncher::repairAssets");
+        auto versionJson = m_impl->loadVersionJson(version);
+        if (versionJson.is_null()) {
+            core::Logger::instance().error("Version {} is not installed", version);
+            return false;
+        }
+        
+        m_impl->reportStage(progressCallback, LaunchState::Preparing, "Checking " + version, 0.0);
+        auto files = m_impl->clientFiles(version, versionJson);
+        auto libraries = m_impl->libraryFiles(versionJson);
+        files.insert(files.end(), libraries.begin(), libraries.end());
+        auto index = m_impl->assetIndexFile(versionJson);
+        if (index) {
+            files.push_back(*index);
+        }
+        
+        // The index has to be intact before its objects can be checked
+        bool ok = m_impl->downloadFiles(m_impl->findMissing(files, true), LaunchState::DownloadingLibraries,
+                                        "Repairing libraries", progressCallback);
+        if (index) {
+            ok = m_impl->downloadFiles(m_impl->findMissing(m_impl->assetFiles(*index), true),
+                                       LaunchState::DownloadingAssets, "Repairing assets", progressCallback) && ok;
+        }
+        return ok;
+    });
+}
+
 void GameLauncher::setOnGameStarted(std::function<void()> callback) {
     m_impl->onGameStarted = std::move(callback);
 }
@@ -535,6 +963,7 @@ void GameLauncher::setOnGameCrashed(std::function<void(const std::string&)> call
 }
 
 std::vector<std::string> GameLauncher::buildJvmArguments(const profile::Profile& profile, const LaunchOptions& options) {
+    KONAMI_ZONE();
     std::vector<std::string> args;
     
     // Memory
@@ -583,6 +1012,7 @@ std::vector<std::string> GameLauncher::buildJvmArguments(const profile::Profile&
 }
 
 std::vector<std::string> GameLauncher::buildGameArguments(const profile::Profile& profile, const LaunchOptions& options) {
+    KONAMI_ZONE();
     std::vector<std::string> args;
     
     // Required arguments
@@ -646,6 +1076,7 @@ std::vector<std::string> GameLauncher::buildGameArguments(const profile::Profile
 }
 
 std::string GameLauncher::buildClasspath(const std::string& version) {
+    KONAMI_ZONE();
     std::vector<std::string> classpathEntries;
     
     auto versionJson = m_impl->loadVersionJson(version);
@@ -684,6 +1115,7 @@ std::string GameLauncher::buildClasspath(const std::string& version) {
 }
 
 bool GameLauncher::extractNatives(const std::string& version) {
+    KONAMI_ZONE();
     auto nativesDir = m_impl->nativesDirectory / version;
     std::filesystem::create_directories(nativesDir);
     
@@ -692,14 +1124,77 @@ bool GameLauncher::extractNatives(const std::string& version) {
     
     auto libraries = m_impl->parseLibraries(versionJson);
     
+    bool success = true;
     for (const auto& lib : libraries) {
-        if (lib.native) {
-            // Extract native library - would use libzip
-            core::Logger::instance().debug("Extracting native: {}", lib.name);
+        if (!lib.native || lib.nativePath.empty()) continue;
+        
+        auto jarPath = m_impl->librariesDirectory / lib.nativePath;
+        utils::ZipReader jar;
+        if (!jar.open(jarPath)) {
+            core::Logger::instance().warn("Cannot open natives jar {}: {}", jarPath.string(), jar.error());
+            success = false;
+            continue;
+        }
+        
+        size_t extracted = 0;
+        for (const auto& entry : jar.entries()) {
+            if (entry.isDirectory()) continue;
+            
+            bool excluded = std::any_of(lib.extractExclude.begin(), lib.extractExclude.end(),
+                [&](const std::string& prefix) { return entry.name.starts_with(prefix); });
+            if (excluded) continue;
+            
+            if (!utils::ZipReader::isSafeEntryName(entry.name)) {
+                core::Logger::instance().warn("Skipping unsafe native entry {} in {}", entry.name, lib.name);
+                continue;
+            }
+            
+            // Natives are immutable per version, so a same-sized file is already extracted
+            auto target = nativesDir / std::filesystem::path(entry.name);
+            std::error_code ec;
+            if (std::filesystem::file_size(target, ec) == entry.uncompressedSize && !ec) continue;
+            
+            std::string error;
+            if (!jar.extract(entry, target, &error)) {
+                core::Logger::instance().warn("Failed to extract native {}: {}", entry.name, error);
+                success = false;
+                continue;
+            }
+            extracted++;
         }
+        
+        core::Logger::instance().debug("Extracted {} native files from {}", extracted, lib.name);
     }
     
-    return true;
+    return success;
+}
+
+bool GameLauncher::downloadLibraries(const std::string& version, ProgressCallback progressCallback) {
+    KONAMI_ZONE();
+    auto versionJson = m_impl->loadVersionJson(version);
+    if (versionJson.is_null()) return false;
+    
+    m_impl->reportStage(progressCallback, LaunchState::DownloadingLibraries, "Checking libraries...", 0.0);
+    auto missing = m_impl->findMissing(m_impl->libraryFiles(versionJson), false);
+    return m_impl->downloadFiles(missing, LaunchState::DownloadingLibraries, "Downloading libraries", progressCallback);
+}
+
+bool GameLauncher::downloadAssets(const std::string& version, ProgressCallback progressCallback) {
+    KONAMI_ZONE();
+    auto versionJson = m_impl->loadVersionJson(version);
+    if (versionJson.is_null()) return false;
+    
+    auto index = m_impl->assetIndexFile(versionJson);
+    if (!index) return true;
+    
+    m_impl->reportStage(progressCallback, LaunchState::DownloadingAssets, "Checking assets...", 0.0);
+    if (!m_impl->downloadFiles(m_impl->findMissing({*index}, true), LaunchState::DownloadingAssets,
+                               "Downloading asset index", progressCallback)) {
+        return false;
+    }
+    
+    auto missing = m_impl->findMissing(m_impl->assetFiles(*index), false);
+    return m_impl->downloadFiles(missing, LaunchState::DownloadingAssets, "Downloading assets", progressCallback);
 }
 
 // JvmArgumentBuilder implementation
@@ -9,6 +9,8 @@
 #include <future>
 #include "../profile/ProfileManager.hpp"
 
+namespace konami::core::downloader { class DownloadManager; }
+
 namespace konami::launcher {
 
 // Launch state
@@ -91,6 +93,11 @@ struct LibraryInfo {
     int64_t size = 0;
     bool native = false;
     std::string nativeClassifier;
+    std::string nativePath;                     // Classifier jar holding the natives
+    std::string nativeUrl;
+    std::string nativeSha1;
+    int64_t nativeSize = 0;
+    std::vector<std::string> extractExclude;    // Entry prefixes not to extract
     
     struct Rule {
         std::string action;     // allow/disallow
@@ -166,6 +173,9 @@ public:
     void setAssetsDirectory(const std::filesystem::path& path);
     void setLibrariesDirectory(const std::filesystem::path& path);
     
+    // Engine used by installVersion() and repairAssets()
+    void setDownloadManager(std::shared_ptr<core::downloader::DownloadManager> manager);
+    
     // Events
     void setOnGameStarted(std::function<void()> callback);
     void setOnGameExited(std::function<void(int exitCode)> callback);
@@ -1,9 +1,13 @@
 #include "ModManager.hpp"
 #include "../Logger.hpp"
+#include "../Profiler.hpp"
 #include "../downloader/DownloadManager.hpp"
-#include <zip.h>
+#include "../../utils/HashUtils.hpp"
+#include "../../utils/Version.hpp"
+#include "../../utils/ZipArchive.hpp"
 #include <fstream>
 #include <regex>
+#include <unordered_set>
 #include <algorithm>
 
 namespace konami::mods {
@@ -75,170 +79,231 @@ public:
     
     std::mutex modsMutex;
     
-    bool parseForgeModInfo(const std::filesystem::path& jarPath, ModInfo& info) {
-        int err;
-        zip_t* archive = zip_open(jarPath.string().c_str(), ZIP_RDONLY, &err);
-        if (!archive) return false;
+    // Read a small metadata entry from a mod jar
+    static std::optional<std::string> readEntry(const utils::ZipReader& jar, std::string_view name) {
+        const utils::ZipEntry* entry = jar.find(name);
+        if (!entry) return std::nullopt;
+        return jar.read(*entry);
+    }
+    
+    // Ids provided by the game or loader rather than by a mod jar
+    static bool isPlatformId(const std::string& modId) {
+        static const std::unordered_set<std::string> platform = {
+            "minecraft", "java", "fabricloader", "fabric-loader", "quilt_loader",
+            "forge", "neoforge", "javafml", "lowcodefml", "mclanguage"
+        };
+        return platform.count(modId) > 0;
+    }
+    
+    // Fabric "depends"-style object: id -> range string, or array of alternatives
+    static void collectFabricDependencies(const nlohmann::json& object, DependencyType type,
+                                          std::vector<ModDependency>& dependencies) {
+        if (!object.is_object()) return;
+        for (const auto& [modId, ranges] : object.items()) {
+            ModDependency dependency;
+            dependency.modId = modId;
+            dependency.type = type;
+            if (ranges.is_string()) {
+                dependency.versionRange = ranges.get<std::string>();
+            } else if (ranges.is_array()) {
+                for (const auto& range : ranges) {
+                    if (!range.is_string()) continue;
+                    if (!dependency.versionRange.empty()) dependency.versionRange += " || ";
+                    dependency.versionRange += range.get<std::string>();
+                }
+            }
+            dependencies.push_back(dependency);
+        }
+    }
+    
+    // Quilt "depends"/"breaks": array of ids or {id, versions, optional} objects
+    static void collectQuiltDependencies(const nlohmann::json& array, DependencyType type,
+                                         std::vector<ModDependency>& dependencies) {
+        if (!array.is_array()) return;
+        for (const auto& item : array) {
+            ModDependency dependency;
+            dependency.type = type;
+            if (item.is_string()) {
+                dependency.modId = item.get<std::string>();
+            } else if (item.is_object()) {
+                dependency.modId = item.value("id", "");
+                if (item.contains("versions") && item["versions"].is_string()) {
+                    dependency.versionRange = item["versions"].get<std::string>();
+                }
+                if (type == DependencyType::Required && item.value("optional", false)) {
+                    dependency.type = DependencyType::Optional;
+                }
+            }
+            if (!dependency.modId.empty()) dependencies.push_back(dependency);
+        }
+    }
+    
+    // Whether the installed mods satisfy one dependency of an enabled mod
+    bool isResolved(const ModDependency& dependency) const {
+        if (isPlatformId(dependency.modId)) return true;
         
-        // Try mcmod.info (legacy Forge)
-        zip_stat_t stat;
-        if (zip_stat(archive, "mcmod.info", 0, &stat) == 0) {
-            zip_file_t* file = zip_fopen(archive, "mcmod.info", 0);
-            if (file) {
-                std::string content(stat.size, '\0');
-                zip_fread(file, content.data(), stat.size);
-                zip_fclose(file);
-                
-                try {
-                    auto json = nlohmann::json::parse(content);
-                    if (json.is_array() && !json.empty()) {
-                        auto& mod = json[0];
-                        info.id = mod.value("modid", "");
-                        info.name = mod.value("name", "");
-                        info.version = mod.value("version", "");
-                        info.description = mod.value("description", "");
-                        info.author = mod.value("authorList", std::vector<std::string>{}).empty() 
-                            ? "" : mod["authorList"][0].get<std::string>();
-                        info.loader = ModLoader::Forge;
-                        zip_close(archive);
-                        return true;
-                    }
-                } catch (...) {}
+        auto range = utils::VersionRange::parse(dependency.versionRange);
+        bool present = false;
+        for (const auto& mod : installedMods) {
+            if (mod.enabled && mod.id == dependency.modId &&
+                (!range || range->contains(mod.version))) {
+                present = true;
+                break;
             }
         }
+        switch (dependency.type) {
+            case DependencyType::Required: return present;
+            case DependencyType::Incompatible: return !present;
+            default: return true;
+        }
+    }
+    
+    bool parseForgeModInfo(const utils::ZipReader& jar, ModInfo& info) {
+        // Try mcmod.info (legacy Forge)
+        if (auto content = readEntry(jar, "mcmod.info")) {
+            try {
+                auto json = nlohmann::json::parse(*content);
+                if (json.is_array() && !json.empty()) {
+                    auto& mod = json[0];
+                    info.id = mod.value("modid", "");
+                    info.name = mod.value("name", "");
+                    info.version = mod.value("version", "");
+                    info.description = mod.value("description", "");
+                    info.author = mod.value("authorList", std::vector<std::string>{}).empty() 
+                        ? "" : mod["authorList"][0].get<std::string>();
+                    info.loader = ModLoader::Forge;
+                    return true;
+                }
+            } catch (...) {}
+        }
         
         // Try mods.toml (modern Forge/NeoForge)
-        if (zip_stat(archive, "META-INF/mods.toml", 0, &stat) == 0) {
-            zip_file_t* file = zip_fopen(archive, "META-INF/mods.toml", 0);
-            if (file) {
-                std::string content(stat.size, '\0');
-                zip_fread(file, content.data(), stat.size);
-                zip_fclose(file);
-                
-                // Simple TOML parsing for mod info
-                std::regex modIdRegex(R"(modId\s*=\s*"([^"]+)")");
-                std::regex versionRegex(R"(version\s*=\s*"([^"]+)")");
-                std::regex displayNameRegex(R"(displayName\s*=\s*"([^"]+)")");
+        if (auto content = readEntry(jar, "META-INF/mods.toml")) {
+            // Simple TOML parsing for mod info
+            std::regex modIdRegex(R"re(modId\s*=\s*"([^"]+)")re");
+            std::regex versionRegex(R"re(version\s*=\s*"([^"]+)")re");
+            std::regex displayNameRegex(R"re(displayName\s*=\s*"([^"]+)")re");
+            
+            std::smatch match;
+            if (std::regex_search(*content, match, modIdRegex)) {
+                info.id = match[1];
+            }
+            if (std::regex_search(*content, match, versionRegex)) {
+                info.version = match[1];
+            }
+            if (std::regex_search(*content, match, displayNameRegex)) {
+                info.name = match[1];
+            }
+            
+            // [[dependencies.<mod>]] blocks: modId, mandatory / type, versionRange
+            std::vector<ModDependency> dependencies;
+            std::regex mandatoryRegex(R"re(mandatory\s*=\s*(true|false))re");
+            std::regex typeRegex(R"re(type\s*=\s*"([^"]+)")re");
+            std::regex rangeRegex(R"re(versionRange\s*=\s*"([^"]*)")re");
+            for (size_t pos = content->find("[[dependencies."); pos != std::string::npos;
+                 pos = content->find("[[dependencies.", pos)) {
+                size_t start = content->find("]]", pos);
+                if (start == std::string::npos) break;
+                start += 2;
+                // Ranges contain brackets, so the block ends at the next table header
+                size_t next = std::min(content->find("[[", start), content->find("\n[", start));
+                std::string block = content->substr(start, next == std::string::npos ? std::string::npos : next - start);
+                pos = start;
                 
-                std::smatch match;
-                if (std::regex_search(content, match, modIdRegex)) {
-                    info.id = match[1];
-                }
-                if (std::regex_search(content, match, versionRegex)) {
-                    info.version = match[1];
-                }
-                if (std::regex_search(content, match, displayNameRegex)) {
-                    info.name = match[1];
+                ModDependency dependency;
+                std::smatch field;
+                if (std::regex_search(block, field, modIdRegex)) dependency.modId = field[1];
+                if (std::regex_search(block, field, rangeRegex)) dependency.versionRange = field[1];
+                if (std::regex_search(block, field, typeRegex)) {
+                    std::string type = field[1];
+                    if (type == "incompatible") dependency.type = DependencyType::Incompatible;
+                    else if (type != "required") dependency.type = DependencyType::Optional;
+                } else if (std::regex_search(block, field, mandatoryRegex) && field[1] == "false") {
+                    dependency.type = DependencyType::Optional;
                 }
-                
-                info.loader = ModLoader::Forge;
-                zip_close(archive);
-                return !info.id.empty();
+                if (!dependency.modId.empty()) dependencies.push_back(dependency);
             }
+            if (!info.id.empty()) dependencyCache[info.id] = std::move(dependencies);
+            
+            info.loader = ModLoader::Forge;
+            return !info.id.empty();
         }
         
-        zip_close(archive);
         return false;
     }
     
-    bool parseFabricModInfo(const std::filesystem::path& jarPath, ModInfo& info) {
-        int err;
-        zip_t* archive = zip_open(jarPath.string().c_str(), ZIP_RDONLY, &err);
-        if (!archive) return false;
+    bool parseFabricModInfo(const utils::ZipReader& jar, ModInfo& info) {
+        auto content = readEntry(jar, "fabric.mod.json");
+        if (!content) return false;
         
-        zip_stat_t stat;
-        if (zip_stat(archive, "fabric.mod.json", 0, &stat) == 0) {
-            zip_file_t* file = zip_fopen(archive, "fabric.mod.json", 0);
-            if (file) {
-                std::string content(stat.size, '\0');
-                zip_fread(file, content.data(), stat.size);
-                zip_fclose(file);
-                zip_close(archive);
-                
-                try {
-                    auto json = nlohmann::json::parse(content);
-                    info.id = json.value("id", "");
-                    info.name = json.value("name", "");
-                    info.version = json.value("version", "");
-                    info.description = json.value("description", "");
-                    
-                    if (json.contains("authors") && json["authors"].is_array() && !json["authors"].empty()) {
-                        auto& author = json["authors"][0];
-                        if (author.is_string()) {
-                            info.author = author.get<std::string>();
-                        } else if (author.is_object()) {
-                            info.author = author.value("name", "");
-                        }
-                    }
-                    
-                    if (json.contains("contact")) {
-                        info.website = json["contact"].value("homepage", 
-                            json["contact"].value("sources", ""));
-                    }
-                    
-                    if (json.contains("icon")) {
-                        info.iconPath = json["icon"].get<std::string>();
-                    }
-                    
-                    info.loader = ModLoader::Fabric;
-                    return true;
-                } catch (...) {}
+        try {
+            auto json = nlohmann::json::parse(*content);
+            info.id = json.value("id", "");
+            info.name = json.value("name", "");
+            info.version = json.value("version", "");
+            info.description = json.value("description", "");
+            
+            if (json.contains("authors") && json["authors"].is_array() && !json["authors"].empty()) {
+                auto& author = json["authors"][0];
+                if (author.is_string()) {
+                    info.author = author.get<std::string>();
+                } else if (author.is_object()) {
+                    info.author = author.value("name", "");
+                }
             }
-        }
+            
+            if (json.contains("contact")) {
+                info.website = json["contact"].value("homepage", 
+                    json["contact"].value("sources", ""));
+            }
+            
+            if (json.contains("icon")) {
+                info.iconPath = json["icon"].get<std::string>();
+            }
+            
+            std::vector<ModDependency> dependencies;
+            collectFabricDependencies(json.value("depends", nlohmann::json::object()), DependencyType::Required, dependencies);
+            collectFabricDependencies(json.value("recommends", nlohmann::json::object()), DependencyType::Optional, dependencies);
+            collectFabricDependencies(json.value("breaks", nlohmann::json::object()), DependencyType::Incompatible, dependencies);
+            dependencyCache[info.id] = std::move(dependencies);
+            
+            info.loader = ModLoader::Fabric;
+            return true;
+        } catch (...) {}
         
-        zip_close(archive);
         return false;
     }
     
-    bool parseQuiltModInfo(const std::filesystem::path& jarPath, ModInfo& info) {
-        int err;
-        zip_t* archive = zip_open(jarPath.string().c_str(), ZIP_RDONLY, &err);
-        if (!archive) return false;
+    bool parseQuiltModInfo(const utils::ZipReader& jar, ModInfo& info) {
+        auto content = readEntry(jar, "quilt.mod.json");
+        if (!content) return false;
         
-        zip_stat_t stat;
-        if (zip_stat(archive, "quilt.mod.json", 0, &stat) == 0) {
-            zip_file_t* file = zip_fopen(archive, "quilt.mod.json", 0);
-            if (file) {
-                std::string content(stat.size, '\0');
-                zip_fread(file, content.data(), stat.size);
-                zip_fclose(file);
-                zip_close(archive);
-                
-                try {
-                    auto json = nlohmann::json::parse(content);
-                    auto& loader = json["quilt_loader"];
-                    info.id = loader.value("id", "");
-                    info.version = loader.value("version", "");
-                    
-                    if (loader.contains("metadata")) {
-                        auto& meta = loader["metadata"];
-                        info.name = meta.value("name", info.id);
-                        info.description = meta.value("description", "");
-                    }
-                    
-                    info.loader = ModLoader::Quilt;
-                    return true;
-                } catch (...) {}
+        try {
+            auto json = nlohmann::json::parse(*content);
+            auto& loader = json["quilt_loader"];
+            info.id = loader.value("id", "");
+            info.version = loader.value("version", "");
+            
+            if (loader.contains("metadata")) {
+                auto& meta = loader["metadata"];
+                info.name = meta.value("name", info.id);
+                info.description = meta.value("description", "");
             }
-        }
+            
+            std::vector<ModDependency> dependencies;
+            collectQuiltDependencies(loader.value("depends", nlohmann::json::array()), DependencyType::Required, dependencies);
+            collectQuiltDependencies(loader.value("breaks", nlohmann::json::array()), DependencyType::Incompatible, dependencies);
+            dependencyCache[info.id] = std::move(dependencies);
+            
+            info.loader = ModLoader::Quilt;
+            return true;
+        } catch (...) {}
         
-        zip_close(archive);
         return false;
     }
     
     std::string calculateSha256(const std::filesystem::path& filePath) {
-        // SHA256 calculation using OpenSSL
-        std::ifstream file(filePath, std::ios::binary);
-        if (!file) return "";
-        
-        unsigned char hash[32];
-        // Placeholder - would use EVP_Digest in real implementation
-        
-        std::stringstream ss;
-        for (int i = 0; i < 32; i++) {
-            ss << std::hex << std::setfill('0') << std::setw(2) << (int)hash[i];
-        }
-        return ss.str();
+        return utils::HashUtils::sha256File(filePath.string());
     }
 };
 
@@ -273,6 +338,8 @@ void ModManager::shutdown() {
 }
 
 std::vector<ModInfo> ModManager::scanInstalledMods() {
+    KONAMI_ZONE();
+    
     std::vector<ModInfo> mods;
     
     if (!std::filesystem::exists(m_impl->modsDirectory)) {
@@ -298,20 +365,26 @@ std::vector<ModInfo> ModManager::scanInstalledMods() {
 }
 
 std::optional<ModInfo> ModManager::parseModFile(const std::filesystem::path& modPath) {
+    KONAMI_ZONE();
+    
     ModInfo info;
     info.filePath = modPath.string();
+    KONAMI_ZONE_TEXT(info.filePath);
     info.fileSize = std::filesystem::file_size(modPath);
     info.source = ModSource::Local;
     
-    // Try different mod formats
-    if (m_impl->parseFabricModInfo(modPath, info)) {
-        return info;
-    }
-    if (m_impl->parseQuiltModInfo(modPath, info)) {
-        return info;
-    }
-    if (m_impl->parseForgeModInfo(modPath, info)) {
-        return info;
+    // Try different mod formats against one mapping of the jar
+    utils::ZipReader jar;
+    if (jar.open(modPath)) {
+        if (m_impl->parseFabricModInfo(jar, info)) {
+            return info;
+        }
+        if (m_impl->parseQuiltModInfo(jar, info)) {
+            return info;
+        }
+        if (m_impl->parseForgeModInfo(jar, info)) {
+            return info;
+        }
     }
     
     // Fallback: use filename
@@ -323,7 +396,9 @@ std::optional<ModInfo> ModManager::parseModFile(const std::filesystem::path& mod
 }
 
 bool ModManager::refreshModList() {
+    KONAMI_ZONE();
     std::lock_guard<std::mutex> lock(m_impl->modsMutex);
+    m_impl->dependencyCache.clear();
     m_impl->installedMods = scanInstalledMods();
     m_impl->detectedConflicts = detectConflicts();
     
@@ -471,9 +546,59 @@ std::vector<ModConflict> ModManager::detectConflicts() {
         conflicts.push_back(conflict);
     }
     
+    // Missing, out-of-range and incompatible dependencies
+    for (const auto& mod : m_impl->installedMods) {
+        if (!mod.enabled) continue;
+        auto deps = m_impl->dependencyCache.find(mod.id);
+        if (deps == m_impl->dependencyCache.end()) continue;
+        
+        for (const auto& dependency : deps->second) {
+            if (m_impl->isResolved(dependency)) continue;
+            ModConflict conflict;
+            conflict.modId1 = mod.id;
+            conflict.modId2 = dependency.modId;
+            std::string range = dependency.versionRange.empty() ? "" : " " + dependency.versionRange;
+            if (dependency.type == DependencyType::Incompatible) {
+                conflict.reason = mod.name + " is incompatible with " + dependency.modId + range;
+            } else {
+                conflict.reason = mod.name + " requires " + dependency.modId + range;
+            }
+            conflict.severity = ModConflict::Severity::Error;
+            conflicts.push_back(conflict);
+        }
+    }
+    
     return conflicts;
 }
 
+std::vector<ModDependency> ModManager::getDependencies(const std::string& modId) {
+    std::lock_guard<std::mutex> lock(m_impl->modsMutex);
+    
+    auto it = m_impl->dependencyCache.find(modId);
+    if (it == m_impl->dependencyCache.end()) return {};
+    
+    auto dependencies = it->second;
+    for (auto& dependency : dependencies) {
+        dependency.resolved = m_impl->isResolved(dependency);
+    }
+    return dependencies;
+}
+
+std::vector<ModDependency> ModManager::getUnresolvedDependencies() {
+    std::lock_guard<std::mutex> lock(m_impl->modsMutex);
+    
+    std::vector<ModDependency> unresolved;
+    for (const auto& mod : m_impl->installedMods) {
+        if (!mod.enabled) continue;
+        auto it = m_impl->dependencyCache.find(mod.id);
+        if (it == m_impl->dependencyCache.end()) continue;
+        for (const auto& dependency : it->second) {
+            if (!m_impl->isResolved(dependency)) unresolved.push_back(dependency);
+        }
+    }
+    return unresolved;
+}
+
 bool ModManager::hasConflicts() const {
     return !m_impl->detectedConflicts.empty();
 }
@@ -1,5 +1,7 @@
 #include "ProfileManager.hpp"
 #include "../Logger.hpp"
+#include "../../utils/FileCopier.hpp"
+#include "../../utils/ZipArchive.hpp"
 #include <fstream>
 #include <random>
 #include <sstream>
@@ -167,6 +169,39 @@ public:
     std::function<void(const std::string&)> onActiveProfileChanged;
     
     mutable std::mutex profilesMutex;
+    
+    // Snapshots of a profile, kept with the launcher data rather than in the
+    // (possibly user-chosen) game directory
+    std::filesystem::path snapshotsDirectory(const std::string& profileId) const {
+        return profilesDirectory / "snapshots" / profileId;
+    }
+    
+    // Snapshot data that may sit inside a game directory: the store itself when
+    // the game directory contains the profiles directory, and snapshots
+    // recorded by versions that kept them in the game directory
+    std::vector<std::string> snapshotPaths(const Profile& profile) const {
+        std::vector<std::string> paths{(profilesDirectory / "snapshots").generic_string()};
+        for (const auto& snapshot : profile.snapshots) {
+            paths.push_back(snapshot.dataPath.generic_string());
+        }
+        return paths;
+    }
+    
+    // Copy a game directory in parallel, skipping the given paths
+    bool copyGameDirectory(const std::filesystem::path& from, const std::filesystem::path& to,
+                           const std::vector<std::string>& excluded = {}) {
+        utils::FileCopier::Options options;
+        options.filter = [&excluded](const utils::DirectoryWalker::Entry& entry) {
+            return std::find(excluded.begin(), excluded.end(), entry.path) == excluded.end();
+        };
+        
+        auto result = utils::FileCopier::copyDirectory(from, to, options);
+        if (!result.ok()) {
+            core::Logger::instance().warn("{} files failed to copy from {}: {}",
+                result.errors, from.string(), result.firstError);
+        }
+        return result.ok();
+    }
 };
 
 ProfileManager::ProfileManager() : m_impl(std::make_unique<Impl>()) {}
@@ -248,9 +283,10 @@ bool ProfileManager::deleteProfile(const std::string& profileId) {
         [&profileId](const Profile& p) { return p.id == profileId; });
     
     if (it != m_impl->profiles.end()) {
-        // Remove profile directory
+        // Remove profile directory and its snapshots
         std::error_code ec;
         std::filesystem::remove_all(it->gameDirectory, ec);
+        std::filesystem::remove_all(m_impl->snapshotsDirectory(profileId), ec);
         
         m_impl->profiles.erase(it);
         
@@ -285,9 +321,10 @@ std::optional<Profile> ProfileManager::duplicateProfile(const std::string& profi
     newProfile.gameDirectory = (m_impl->profilesDirectory / newProfile.id).string();
     
     // Copy directory contents
-    std::error_code ec;
-    std::filesystem::copy(original->gameDirectory, newProfile.gameDirectory, 
-        std::filesystem::copy_options::recursive, ec);
+    if (!m_impl->copyGameDirectory(original->gameDirectory, newProfile.gameDirectory,
+                                   m_impl->snapshotPaths(*original))) {
+        core::Logger::instance().warn("Profile {} was duplicated with missing files", profileId);
+    }
     
     {
         std::lock_guard<std::mutex> lock(m_impl->profilesMutex);
@@ -411,6 +448,166 @@ std::filesystem::path ProfileManager::getShaderPacksDirectory(const std::string&
     return getProfileDirectory(profileId) / "shaderpacks";
 }
 
+std::vector<utils::DirectoryWalker::SubtreeSize> ProfileManager::getStorageUsage(const std::string& profileId) const {
+    utils::DirectoryWalker::Options options;
+    options.subtreeDepth = 1;
+    return utils::DirectoryWalker::walk(getProfileDirectory(profileId), options).subtrees;
+}
+
+bool ProfileManager::exportProfile(const std::string& profileId, const std::filesystem::path& outputPath, ProfileFormat format) {
+    auto profile = getProfile(profileId);
+    if (!profile) return false;
+    
+    if (format != ProfileFormat::KonamiProfile) {
+        core::Logger::instance().warn("Profile export format {} is not supported", static_cast<int>(format));
+        return false;
+    }
+    
+    // Layout: profile.json at the root, the game directory under files/
+    using Walker = utils::DirectoryWalker;
+    std::mutex sourcesMutex;
+    std::vector<utils::ZipWriter::Source> sources;
+    const auto excluded = m_impl->snapshotPaths(*profile);
+    
+    Walker::Options options;
+    options.filter = [&excluded](const Walker::Entry& entry) {
+        return std::find(excluded.begin(), excluded.end(), entry.path) == excluded.end();
+    };
+    auto walked = Walker::walk(profile->gameDirectory, options, [&](const Walker::Entry& entry) {
+        if (entry.type != Walker::Type::File) return;
+        std::lock_guard<std::mutex> lock(sourcesMutex);
+        sources.push_back({entry.fullPath(), "files/" + std::string(entry.relativePath)});
+    });
+    if (walked.errors > 0) {
+        core::Logger::instance().warn("Some folders of profile {} could not be read", profileId);
+    }
+    std::sort(sources.begin(), sources.end(),
+        [](const auto& a, const auto& b) { return a.name < b.name; });
+    
+    Profile exported = *profile;
+    exported.snapshots.clear();
+    auto manifestPath = outputPath;
+    manifestPath += ".profile.json";
+    {
+        std::ofstream manifest(manifestPath);
+        manifest << exported.toJson().dump(2);
+        if (!manifest) return false;
+    }
+    sources.insert(sources.begin(), {manifestPath, "profile.json"});
+    
+    std::string error;
+    bool ok = utils::ZipWriter::write(outputPath, sources, utils::ZipWriter::Options{}, &error);
+    std::error_code ec;
+    std::filesystem::remove(manifestPath, ec);
+    
+    if (!ok) {
+        core::Logger::instance().error("Failed to export profile {}: {}", profileId, error);
+        return false;
+    }
+    core::Logger::instance().info("Exported profile {} ({} files) to {}", profileId, sources.size() - 1, outputPath.string());
+    return true;
+}
+
+std::optional<Profile> ProfileManager::importModpack(const std::filesystem::path& mrpackPath, std::vector<ModpackFile>* files) {
+    utils::ZipReader pack;
+    if (!pack.open(mrpackPath)) {
+        core::Logger::instance().error("Cannot open modpack {}: {}", mrpackPath.string(), pack.error());
+        return std::nullopt;
+    }
+    
+    const auto* indexEntry = pack.find("modrinth.index.json");
+    auto indexText = indexEntry ? pack.read(*indexEntry) : std::nullopt;
+    if (!indexText) {
+        core::Logger::instance().error("{} is not a Modrinth pack (no modrinth.index.json)", mrpackPath.string());
+        return std::nullopt;
+    }
+    
+    // Parse and type-check the whole index before creating anything, so a
+    // malformed pack never leaves a half-made profile behind
+    std::string name;
+    std::string gameVersion;
+    LoaderConfig loader;
+    std::vector<ModpackFile> listed;
+    try {
+        auto index = nlohmann::json::parse(*indexText);
+        if (!index.is_object()) {
+            throw nlohmann::json::type_error::create(302, "index must be an object", &index);
+        }
+        
+        const auto dependencies = index.value("dependencies", nlohmann::json::object());
+        gameVersion = dependencies.value("minecraft", "");
+        if (index.value("game", "") != "minecraft" || gameVersion.empty()) {
+            core::Logger::instance().error("Modpack {} does not target a Minecraft version", mrpackPath.string());
+            return std::nullopt;
+        }
+        name = index.value("name", mrpackPath.stem().string());
+        
+        static const std::pair<const char*, const char*> kLoaders[] = {
+            {"fabric-loader", "fabric"}, {"quilt-loader", "quilt"}, {"forge", "forge"}, {"neoforge", "neoforge"}
+        };
+        for (const auto& [key, type] : kLoaders) {
+            if (dependencies.contains(key)) {
+                loader.type = type;
+                loader.version = dependencies.at(key).get<std::string>();
+            }
+        }
+        
+        const auto files = index.value("files", nlohmann::json::array());
+        if (!files.is_array()) {
+            throw nlohmann::json::type_error::create(302, "files must be an array", &files);
+        }
+        for (const auto& file : files) {
+            auto env = file.value("env", nlohmann::json::object());
+            if (env.value("client", "required") == "unsupported") continue;
+            
+            ModpackFile entry;
+            entry.path = file.at("path").get<std::string>();
+            if (!utils::ZipReader::isSafeEntryName(entry.path)) {
+                core::Logger::instance().error("Modpack {} lists an unsafe path: {}", mrpackPath.string(), entry.path);
+                return std::nullopt;
+            }
+            auto downloads = file.value("downloads", nlohmann::json::array());
+            if (downloads.empty()) continue;
+            entry.url = downloads.at(0).get<std::string>();
+            entry.sha1 = file.value("hashes", nlohmann::json::object()).value("sha1", "");
+            entry.size = file.value("fileSize", int64_t{0});
+            listed.push_back(std::move(entry));
+        }
+    } catch (const nlohmann::json::exception& e) {
+        core::Logger::instance().error("Invalid modrinth.index.json in {}: {}", mrpackPath.string(), e.what());
+        return std::nullopt;
+    }
+    
+    Profile profile = createProfile(name, gameVersion);
+    profile.loader.type = loader.type;
+    profile.loader.version = loader.version;
+    updateProfile(profile);
+    
+    // overrides/ applies everywhere, client-overrides/ on top of it
+    size_t extracted = 0;
+    for (std::string_view prefix : {"overrides/", "client-overrides/"}) {
+        for (const auto& entry : pack.entries()) {
+            if (entry.isDirectory() || !entry.name.starts_with(prefix)) continue;
+            auto relative = entry.name.substr(prefix.size());
+            if (!utils::ZipReader::isSafeEntryName(relative)) continue;
+            
+            std::string error;
+            if (!pack.extract(entry, std::filesystem::path(profile.gameDirectory) / std::filesystem::path(relative), &error)) {
+                core::Logger::instance().warn("Failed to extract {}: {}", entry.name, error);
+                continue;
+            }
+            ++extracted;
+        }
+    }
+    
+    core::Logger::instance().info("Imported modpack {} as profile {} ({} files to download, {} overrides)",
+        profile.name, profile.id, listed.size(), extracted);
+    if (files) {
+        *files = std::move(listed);
+    }
+    return profile;
+}
+
 ProfileSnapshot ProfileManager::createSnapshot(const std::string& profileId, 
     const std::string& name, const std::string& description) {
     
@@ -424,15 +621,15 @@ ProfileSnapshot ProfileManager::createSnapshot(const std::string& profileId,
     if (!profile) return snapshot;
     
     // Create snapshot directory
-    auto snapshotsDir = m_impl->profilesDirectory / profileId / "snapshots";
+    auto snapshotsDir = m_impl->snapshotsDirectory(profileId);
     std::filesystem::create_directories(snapshotsDir);
     
     snapshot.dataPath = snapshotsDir / snapshot.id;
     
     // Copy profile data
-    std::error_code ec;
-    std::filesystem::copy(profile->gameDirectory, snapshot.dataPath,
-        std::filesystem::copy_options::recursive, ec);
+    if (!m_impl->copyGameDirectory(profile->gameDirectory, snapshot.dataPath, m_impl->snapshotPaths(*profile))) {
+        core::Logger::instance().warn("Snapshot {} of profile {} is incomplete", name, profileId);
+    }
     
     // Add snapshot to profile
     {
@@ -459,16 +656,26 @@ bool ProfileManager::restoreSnapshot(const std::string& profileId, const std::st
     if (it == profile->snapshots.end()) return false;
     
     std::error_code ec;
-    
-    // Remove current data
-    std::filesystem::remove_all(profile->gameDirectory, ec);
+    if (!std::filesystem::is_directory(it->dataPath, ec)) return false;
+    
+    // Remove current data. Snapshot data only lives in the game directory if
+    // it contains the profiles directory or holds older snapshots; keep it
+    const auto keep = m_impl->snapshotPaths(*profile);
+    for (const auto& entry : std::filesystem::directory_iterator(profile->gameDirectory, ec)) {
+        auto path = entry.path().generic_string();
+        bool holdsSnapshots = std::any_of(keep.begin(), keep.end(), [&path](const std::string& kept) {
+            return kept == path || kept.starts_with(path + '/');
+        });
+        if (!holdsSnapshots) {
+            std::filesystem::remove_all(entry.path(), ec);
+        }
+    }
     
     // Restore from snapshot
-    std::filesystem::copy(it->dataPath, profile->gameDirectory,
-        std::filesystem::copy_options::recursive, ec);
+    bool restored = m_impl->copyGameDirectory(it->dataPath, profile->gameDirectory);
     
     core::Logger::instance().info( "Restored snapshot: {} for profile {}", it->name, profileId);
-    return !ec;
+    return restored;
 }
 
 bool ProfileManager::deleteSnapshot(const std::string& profileId, const std::string& snapshotId) {
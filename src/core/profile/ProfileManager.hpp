@@ -8,6 +8,7 @@
 #include <functional>
 #include <chrono>
 #include <nlohmann/json.hpp>
+#include "../../utils/DirectoryWalker.hpp"
 
 namespace konami::profile {
 
@@ -84,6 +85,14 @@ struct Profile {
     static Profile fromJson(const nlohmann::json& j);
 };
 
+// File listed by a Modrinth pack, downloaded into the profile's game directory
+struct ModpackFile {
+    std::string path;       // Relative to the game directory
+    std::string url;
+    std::string sha1;
+    int64_t size = 0;
+};
+
 // Profile import/export format
 enum class ProfileFormat {
     KonamiProfile,  // .kprofile
@@ -131,6 +140,9 @@ public:
     std::filesystem::path getResourcePacksDirectory(const std::string& profileId) const;
     std::filesystem::path getShaderPacksDirectory(const std::string& profileId) const;
     
+    // Disk usage of the profile and each top-level folder (saves, mods, screenshots, ...)
+    std::vector<utils::DirectoryWalker::SubtreeSize> getStorageUsage(const std::string& profileId) const;
+    
     // Snapshots and rollback
     ProfileSnapshot createSnapshot(const std::string& profileId, const std::string& name, const std::string& description = "");
     bool restoreSnapshot(const std::string& profileId, const std::string& snapshotId);
@@ -140,7 +152,9 @@ public:
     // Import/Export
     std::optional<Profile> importProfile(const std::filesystem::path& path, ProfileFormat format = ProfileFormat::KonamiProfile);
     bool exportProfile(const std::string& profileId, const std::filesystem::path& outputPath, ProfileFormat format = ProfileFormat::KonamiProfile);
-    bool importModpack(const std::filesystem::path& mrpackPath);
+    // Creates a profile from a Modrinth .mrpack and extracts its overrides; the
+    // files the pack lists are returned in `files` for the caller to download
+    std::optional<Profile> importModpack(const std::filesystem::path& mrpackPath, std::vector<ModpackFile>* files = nullptr);
     bool exportModpack(const std::string& profileId, const std::filesystem::path& outputPath);
     
     // Java detection
@@ -6,8 +6,8 @@
 
 #include "SkinEngine.hpp"
 #include "../Logger.hpp"
+#include "../../utils/FileCopier.hpp"
 
-#define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
@@ -316,7 +316,11 @@ bool SkinManager::addSkin(const std::filesystem::path& skinPath, const std::stri
     info.id = name.empty() ? skinPath.stem().string() : name;
     info.name = info.id;
     auto dest = m_impl->skinsDir / (info.id + ".png");
-    std::filesystem::copy_file(skinPath, dest, std::filesystem::copy_options::overwrite_existing);
+    std::string error;
+    if (!utils::FileCopier::copyFile(skinPath, dest, true, true, &error)) {
+        core::Logger::instance().error("Failed to add skin {}: {}", info.id, error);
+        return false;
+    }
     info.filePath = dest.string();
     info.source = "local";
     m_impl->skins.push_back(info);
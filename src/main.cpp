@@ -10,6 +10,7 @@
  */
 
 #include <slint.h>
+#include <CLI/CLI.hpp>
 #include <memory>
 #include <iostream>
 #include <csignal>
@@ -19,6 +20,9 @@
 #include "core/Logger.hpp"
 #include "core/Config.hpp"
 #include "core/EventBus.hpp"
+#include "core/Profiler.hpp"
+#include "core/StartupTrace.hpp"
+#include "cli/HeadlessCommands.hpp"
 #include "utils/PathUtils.hpp"
 
 namespace fs = std::filesystem;
@@ -89,8 +93,10 @@ bool initializeDirectories() {
 
 /**
  * Load and apply configuration
+ * @param autoSave Persist later setting changes (off for headless runs,
+ *                 whose command-line overrides must not be saved)
  */
-bool loadConfiguration() {
+bool loadConfiguration(bool autoSave = true) {
     auto& logger = konami::core::Logger::instance();
     auto& config = konami::core::Config::instance();
     
@@ -106,6 +112,11 @@ bool loadConfiguration() {
             logger.info("Default configuration created at {}", configPath.string());
         }
         
+        // Persist setting changes in the background, debounced and journaled
+        if (autoSave) {
+            config.enableAutoSave(std::chrono::milliseconds(1500), true);
+        }
+        
         return true;
     } catch (const std::exception& e) {
         logger.error("Failed to load configuration: {}", e.what());
@@ -143,34 +154,55 @@ std::shared_ptr<MainWindow> initializeUI() {
  * Main application entry point
  */
 int main(int argc, char* argv[]) {
+    // Start the startup timeline before anything else
+    auto& trace = konami::core::StartupTrace::instance();
+    
     // Parse command line arguments
+    CLI::App cli{"KonamiClient - Revolutionary Minecraft Launcher"};
     bool debugMode = false;
-    for (int i = 1; i < argc; ++i) {
-        std::string arg(argv[i]);
-        if (arg == "--debug" || arg == "-d") {
-            debugMode = true;
-        } else if (arg == "--help" || arg == "-h") {
-            std::cout << "KonamiClient - Revolutionary Minecraft Launcher\n"
-                      << "\nUsage: " << argv[0] << " [options]\n"
-                      << "\nOptions:\n"
-                      << "  -d, --debug    Enable debug mode\n"
-                      << "  -h, --help     Show this help message\n"
-                      << "  -v, --version  Show version information\n"
-                      << std::endl;
-            return 0;
-        } else if (arg == "--version" || arg == "-v") {
-            std::cout << "KonamiClient v1.0.0\n"
-                      << "Built with Slint UI Framework\n"
-                      << "Copyright (c) 2024 Konami Team\n"
-                      << std::endl;
-            return 0;
+    bool exitAfterFirstFrame = false;
+    bool showVersion = false;
+    std::string tracePath;
+    cli.add_flag("-d,--debug", debugMode, "Enable debug mode");
+    cli.add_option("--trace-startup", tracePath, "Write a Chrome trace of startup and launches on exit");
+    cli.add_flag("--exit-after-first-frame", exitAfterFirstFrame, "Quit once the window has rendered (benchmarking)");
+    cli.add_flag("-v,--version", showVersion, "Show version information");
+    
+    // install / prefetch / verify / gc-cache / import-pack run without the UI
+    konami::cli::HeadlessCommands headless(cli);
+    
+    CLI11_PARSE(cli, argc, argv);
+    
+    if (showVersion) {
+        std::cout << "KonamiClient v1.0.0\n"
+                  << "Built with Slint UI Framework\n"
+                  << "Copyright (c) 2024 Konami Team\n"
+                  << std::endl;
+        return 0;
+    }
+    
+    if (headless.selected()) {
+        // stdout carries the progress stream; logs go to stderr
+        konami::core::Logger::instance().initialize(
+            debugMode ? konami::core::LogLevel::Debug : konami::core::LogLevel::Info, "", true
+        );
+        if (!initializeDirectories()) {
+            konami::core::Logger::instance().critical("Failed to initialize application directories");
+            return 1;
         }
+        if (!loadConfiguration(false)) {
+            konami::core::Logger::instance().critical("Failed to load configuration");
+            return 1;
+        }
+        return headless.run();
     }
     
     // Initialize logger
+    auto loggerSpan = trace.span("logger.init");
     konami::core::Logger::instance().initialize(
         debugMode ? konami::core::LogLevel::Debug : konami::core::LogLevel::Info
     );
+    loggerSpan.end();
     
     auto& logger = konami::core::Logger::instance();
     logger.info("KonamiClient v1.0.0 starting...");
@@ -186,13 +218,19 @@ int main(int argc, char* argv[]) {
     setupSignalHandlers();
     
     // Initialize directories
-    if (!initializeDirectories()) {
+    auto directoriesSpan = trace.span("directories.init");
+    bool directoriesReady = initializeDirectories();
+    directoriesSpan.end();
+    if (!directoriesReady) {
         logger.critical("Failed to initialize application directories");
         return 1;
     }
     
     // Load configuration
-    if (!loadConfiguration()) {
+    auto configSpan = trace.span("config.load");
+    bool configLoaded = loadConfiguration();
+    configSpan.end();
+    if (!configLoaded) {
         logger.critical("Failed to load configuration");
         return 1;
     }
@@ -201,13 +239,18 @@ int main(int argc, char* argv[]) {
     try {
         g_app = std::make_unique<konami::core::Application>();
         
-        if (!g_app->initialize()) {
+        auto appSpan = trace.span("app.initialize");
+        bool appReady = g_app->initialize();
+        appSpan.end();
+        if (!appReady) {
             logger.critical("Failed to initialize application");
             return 1;
         }
         
         // Initialize Slint UI
+        auto uiSpan = trace.span("ui.create");
         auto mainWindow = initializeUI();
+        uiSpan.end();
         if (!mainWindow) {
             logger.critical("Failed to initialize UI");
             return 1;
@@ -220,12 +263,46 @@ int main(int argc, char* argv[]) {
         
         logger.info("Application initialized successfully");
         
+        // Initialize the remaining subsystems once the first frame is up.
+        // Renderers without notifier support fall back to the first turn
+        // of the event loop.
+        auto firstFrameSeen = std::make_shared<bool>(false);
+        auto onFirstFrame = [firstFrameSeen, exitAfterFirstFrame, &trace] {
+            if (*firstFrameSeen) return;
+            *firstFrameSeen = true;
+            trace.mark("ui.firstFrame");
+            konami::core::Logger::instance().info("First frame after {}ms", trace.elapsed().count());
+            if (exitAfterFirstFrame) {
+                slint::quit_event_loop();
+                return;
+            }
+            g_app->initializeDeferred();
+        };
+        auto notifierError = mainWindow->window().set_rendering_notifier(
+            [onFirstFrame](slint::RenderingState state, slint::GraphicsAPI) {
+                if (state == slint::RenderingState::AfterRendering) {
+                    KONAMI_FRAME_MARK();
+                    onFirstFrame();
+                }
+            });
+        if (notifierError) {
+            slint::Timer::single_shot(std::chrono::milliseconds(0), onFirstFrame);
+        }
+        
         // Show window and run event loop
         mainWindow->run();
         
         // Cleanup
         g_app->shutdown();
         
+        if (!tracePath.empty()) {
+            if (trace.exportChromeTrace(tracePath)) {
+                logger.info("Startup trace written to {}", tracePath);
+            } else {
+                logger.error("Failed to write startup trace to {}", tracePath);
+            }
+        }
+        
         logger.info("KonamiClient shutdown complete");
         return 0;
         
@@ -0,0 +1,285 @@
+/**
+ * ImageLoader.cpp
+ *
+ * Loads are queued in a shared table and each queued load submits one pump
+ * job to the network pool. A pump takes whichever queued load is most
+ * urgent at the time it runs, so visibility changes reorder work that has
+ * not started yet. The pump reads the disk cache or fetches the image, and
+ * hands decoding to the global ThreadPool, so blocking HTTP requests never
+ * occupy the CPU workers.
+ */
+
+#include "ImageLoader.hpp"
+#include "../../core/Logger.hpp"
+#include "../../core/ThreadPool.hpp"
+#include "../../utils/FileUtils.hpp"
+#include "../../utils/HttpClient.hpp"
+#include "../../utils/Thumbnail.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <tuple>
+
+namespace konami::ui {
+
+using core::Logger;
+using utils::Thumbnail;
+
+namespace {
+
+// Image fetches mostly wait on the network; a few in parallel keep the
+// connection pool busy without flooding the origin
+constexpr size_t kNetworkThreads = 4;
+
+/**
+ * Executor for blocking image fetches, separate from the CPU pool
+ */
+core::ThreadPool& networkPool() {
+    static core::ThreadPool pool(kNetworkThreads);
+    return pool;
+}
+
+std::string cacheKey(const std::string& url, uint32_t width, uint32_t height) {
+    return url + '#' + std::to_string(width) + 'x' + std::to_string(height);
+}
+
+/**
+ * Stable file name for a cache key (FNV-1a)
+ */
+std::string thumbnailFileName(const std::string& key) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 0x100000001b3ull;
+    }
+    static const char digits[] = "0123456789abcdef";
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; --i, hash >>= 4) {
+        name[static_cast<size_t>(i)] = digits[hash & 0xf];
+    }
+    return name + ".thumb";
+}
+
+std::optional<std::string> fetch(const std::string& url) {
+    if (url.starts_with("http://") || url.starts_with("https://")) {
+        auto response = utils::HttpClient::instance().get(url);
+        if (!response.isOk()) {
+            Logger::instance().debug("Image fetch failed for {}: HTTP {}", url, response.statusCode);
+            return std::nullopt;
+        }
+        return std::move(response.body);
+    }
+    std::string path = url.starts_with("file://") ? url.substr(7) : url;
+    return utils::FileUtils::readFile(path);
+}
+
+} // namespace
+
+struct ImageLoader::Shared {
+    struct Request {
+        std::string url;
+        uint32_t width;
+        uint32_t height;
+        bool visible;
+        uint64_t sequence;
+    };
+
+    std::filesystem::path thumbnailDirectory;
+    std::mutex mutex;
+    std::unordered_map<std::string, Request> queued;   // By cache key
+    uint64_t sequence{0};
+    std::atomic<bool> stopped{false};
+
+    /**
+     * Take the most urgent queued load: visible first, then newest
+     */
+    std::optional<std::pair<std::string, Request>> next() {
+        std::lock_guard lock(mutex);
+        auto best = queued.end();
+        for (auto it = queued.begin(); it != queued.end(); ++it) {
+            if (best == queued.end() ||
+                std::tie(it->second.visible, it->second.sequence) > std::tie(best->second.visible, best->second.sequence)) {
+                best = it;
+            }
+        }
+        if (best == queued.end()) {
+            return std::nullopt;
+        }
+        auto taken = std::make_pair(best->first, std::move(best->second));
+        queued.erase(best);
+        return taken;
+    }
+
+    /**
+     * Read a thumbnail from the disk cache
+     */
+    std::optional<Thumbnail> cachedThumbnail(const std::string& key) const {
+        if (auto data = utils::FileUtils::readFile(thumbnailDirectory / thumbnailFileName(key))) {
+            return Thumbnail::deserialize(*data);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Decode a fetched image to the requested size and store it on disk
+     */
+    std::optional<Thumbnail> decode(const std::string& key, const Request& request, const std::string& encoded) const {
+        auto path = thumbnailDirectory / thumbnailFileName(key);
+        std::string error;
+        auto thumbnail = Thumbnail::decode(encoded, request.width, request.height, &error);
+        if (!thumbnail) {
+            Logger::instance().debug("Failed to decode image {}: {}", request.url, error);
+            return std::nullopt;
+        }
+
+        if (!utils::FileUtils::writeFileAtomic(path, thumbnail->serialize())) {
+            Logger::instance().debug("Failed to cache thumbnail for {}", request.url);
+        }
+        return thumbnail;
+    }
+};
+
+ImageLoader::ImageLoader(std::filesystem::path thumbnailDirectory, size_t memoryBudget)
+    : m_shared(std::make_shared<Shared>())
+    , m_alive(std::make_shared<int>(0))
+    , m_memoryBudget(memoryBudget)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(thumbnailDirectory, ec);
+    m_shared->thumbnailDirectory = std::move(thumbnailDirectory);
+}
+
+ImageLoader::~ImageLoader() {
+    m_shared->stopped = true;
+    std::lock_guard lock(m_shared->mutex);
+    m_shared->queued.clear();
+}
+
+std::optional<slint::Image> ImageLoader::cached(const std::string& url, uint32_t width, uint32_t height) {
+    auto it = m_memory.find(cacheKey(url, width, height));
+    if (it == m_memory.end()) {
+        return std::nullopt;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+    return it->second.image;
+}
+
+void ImageLoader::load(const std::string& url, uint32_t width, uint32_t height, Callback onLoaded) {
+    if (url.empty()) {
+        return;
+    }
+    if (auto image = cached(url, width, height)) {
+        onLoaded(*image);
+        return;
+    }
+
+    std::string key = cacheKey(url, width, height);
+    auto& waiting = m_waiting[key];
+    waiting.push_back(std::move(onLoaded));
+    if (waiting.size() > 1) {
+        return;     // Already queued or in flight
+    }
+
+    {
+        std::lock_guard lock(m_shared->mutex);
+        m_shared->queued[key] = Shared::Request{url, width, height, m_visible.contains(url), ++m_shared->sequence};
+    }
+
+    std::weak_ptr<int> alive = m_alive;
+    auto post = [this, alive](std::string key, std::optional<Thumbnail> thumbnail) {
+        auto result = std::make_shared<std::optional<Thumbnail>>(std::move(thumbnail));
+        slint::invoke_from_event_loop([this, alive, key = std::move(key), result]() {
+            if (alive.expired()) return;
+            if (!*result) {
+                deliver(key, std::nullopt, 0);
+                return;
+            }
+            const auto& thumbnail = **result;
+            slint::SharedPixelBuffer<slint::Rgba8Pixel> buffer(
+                thumbnail.width, thumbnail.height,
+                reinterpret_cast<const slint::Rgba8Pixel*>(thumbnail.pixels.data()));
+            deliver(key, slint::Image(buffer), thumbnail.byteSize());
+        });
+    };
+
+    auto pump = [shared = m_shared, post]() {
+        if (shared->stopped) return;
+        auto request = shared->next();
+        if (!request) return;
+
+        auto& [key, queued] = *request;
+        if (auto thumbnail = shared->cachedThumbnail(key)) {
+            post(key, std::move(thumbnail));
+            return;
+        }
+
+        auto encoded = fetch(queued.url);
+        if (!encoded || shared->stopped) {
+            post(key, std::nullopt);
+            return;
+        }
+
+        // Decoding is CPU work; leave the network thread for the next fetch
+        auto decode = [shared, post, key, queued, encoded = std::move(*encoded)]() {
+            post(key, shared->decode(key, queued, encoded));
+        };
+        try {
+            core::ThreadPool::global().submit(std::move(decode));
+        } catch (const std::exception&) {
+            post(key, std::nullopt);
+        }
+    };
+
+    try {
+        networkPool().submit(std::move(pump));
+    } catch (const std::exception& e) {
+        Logger::instance().warn("Cannot queue image load for {}: {}", url, e.what());
+        std::lock_guard lock(m_shared->mutex);
+        m_shared->queued.erase(key);
+        m_waiting.erase(key);
+    }
+}
+
+void ImageLoader::setVisible(const std::vector<std::string>& urls) {
+    m_visible = std::unordered_set<std::string>(urls.begin(), urls.end());
+
+    std::lock_guard lock(m_shared->mutex);
+    for (auto& [key, request] : m_shared->queued) {
+        request.visible = m_visible.contains(request.url);
+    }
+}
+
+void ImageLoader::deliver(const std::string& key, std::optional<slint::Image> image, size_t cost) {
+    auto node = m_waiting.extract(key);
+    if (!image) {
+        return;
+    }
+
+    insert(key, *image, cost);
+    if (node) {
+        for (auto& callback : node.mapped()) {
+            callback(*image);
+        }
+    }
+}
+
+void ImageLoader::insert(const std::string& key, const slint::Image& image, size_t cost) {
+    auto it = m_memory.find(key);
+    if (it != m_memory.end()) {
+        m_memoryBytes -= it->second.cost;
+        m_lru.erase(it->second.lruPosition);
+        m_memory.erase(it);
+    }
+
+    m_lru.push_front(key);
+    m_memory.emplace(key, Entry{image, cost, m_lru.begin()});
+    m_memoryBytes += cost;
+
+    while (m_memoryBytes > m_memoryBudget && m_lru.size() > 1) {
+        auto victim = m_memory.find(m_lru.back());
+        m_memoryBytes -= victim->second.cost;
+        m_memory.erase(victim);
+        m_lru.pop_back();
+    }
+}
+
+} // namespace konami::ui
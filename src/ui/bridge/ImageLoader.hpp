@@ -0,0 +1,105 @@
+// Konami Client - Image Loader
+// Off-thread image fetching, decoding and caching for the UI
+
+#pragma once
+
+#include <slint.h>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace konami::ui {
+
+/**
+ * @brief Loads remote and local images as display-sized slint::Images
+ *
+ * A load fetches the image through HttpClient (and therefore the HTTP
+ * cache) on a small network pool of its own, decodes it with stb and
+ * box-filters it to the requested size on the global ThreadPool, then
+ * hands a slint::Image to the UI thread.
+ * Decoded thumbnails are also written to a disk cache, so later sessions
+ * skip both the download and the decode.
+ *
+ * Images live in a byte-budgeted LRU keyed by URL and display size.
+ * Queued loads are picked when a worker is free rather than when they were
+ * requested: images marked visible go first, then the most recently
+ * requested, so scrolling through a long list loads what is on screen.
+ *
+ * All public methods are for the UI thread; callbacks run on it too.
+ */
+class ImageLoader {
+public:
+    using Callback = std::function<void(const slint::Image& image)>;
+
+    static constexpr size_t kDefaultMemoryBudget = 64 * 1024 * 1024;
+
+    /**
+     * @param thumbnailDirectory Disk cache for decoded thumbnails
+     * @param memoryBudget Bytes of pixel data kept in memory
+     */
+    explicit ImageLoader(std::filesystem::path thumbnailDirectory, size_t memoryBudget = kDefaultMemoryBudget);
+    ~ImageLoader();
+
+    ImageLoader(const ImageLoader&) = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+
+    /**
+     * Get an image if it is already in memory
+     * @param url http(s) URL, file:// URL or local path
+     * @param width Display width in pixels
+     * @param height Display height in pixels
+     */
+    std::optional<slint::Image> cached(const std::string& url, uint32_t width, uint32_t height);
+
+    /**
+     * Load an image
+     * @param url http(s) URL, file:// URL or local path
+     * @param width Display width in pixels
+     * @param height Display height in pixels
+     * @param onLoaded Called with the image; immediately if cached, never on failure
+     */
+    void load(const std::string& url, uint32_t width, uint32_t height, Callback onLoaded);
+
+    /**
+     * Mark which images are on screen; their queued loads run first
+     * @param urls URLs currently visible, replacing the previous set
+     */
+    void setVisible(const std::vector<std::string>& urls);
+
+    /**
+     * Bytes of pixel data held in memory
+     */
+    size_t memoryUsage() const { return m_memoryBytes; }
+
+    struct Shared;
+
+private:
+    struct Entry {
+        slint::Image image;
+        size_t cost;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    void deliver(const std::string& key, std::optional<slint::Image> image, size_t cost);
+    void insert(const std::string& key, const slint::Image& image, size_t cost);
+
+    std::shared_ptr<Shared> m_shared;
+    std::shared_ptr<int> m_alive;   // Results posted after destruction are dropped
+
+    std::unordered_map<std::string, Entry> m_memory;
+    std::list<std::string> m_lru;   // Front = most recently used
+    size_t m_memoryBytes{0};
+    size_t m_memoryBudget;
+
+    std::unordered_map<std::string, std::vector<Callback>> m_waiting;
+    std::unordered_set<std::string> m_visible;
+};
+
+} // namespace konami::ui
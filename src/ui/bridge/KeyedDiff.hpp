@@ -0,0 +1,132 @@
+// Konami Client - Keyed Diff
+// Incremental list updates for UI models, matched by row key
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace konami::ui {
+
+/**
+ * @brief One step turning the previous list into the next one
+ *
+ * Edits are applied in order; row is the model index at the time the edit
+ * runs, source is the index into the next list for Insert and Update.
+ */
+struct KeyedEdit {
+    enum class Kind { Remove, Insert, Update };
+
+    Kind kind;
+    size_t row;
+    size_t source;
+};
+
+/**
+ * Compute the edits that turn previous into next
+ *
+ * Rows are matched by key. The longest run of matched rows that kept their
+ * relative order stays in place (updated only if the row data changed);
+ * every other old row is removed and every other new row is inserted, so a
+ * moved row costs one remove and one insert. Removes come first, from the
+ * back, then inserts and updates front to back. If a key repeats, only its
+ * first occurrence on each side is matched.
+ *
+ * @param previous Rows currently in the model
+ * @param next Rows the model should hold afterwards
+ * @param key Returns a hashable key for a row (e.g. a string_view of its id)
+ * @param equal Row equality, used to skip updates of unchanged rows
+ * @return Edits, empty if the lists are equal
+ */
+template <typename T, typename KeyFn, typename Equal = std::equal_to<>>
+std::vector<KeyedEdit> diffKeyed(const std::vector<T>& previous, const std::vector<T>& next,
+                                 KeyFn key, Equal equal = {}) {
+    constexpr size_t npos = std::numeric_limits<size_t>::max();
+    using Key = std::decay_t<std::invoke_result_t<KeyFn&, const T&>>;
+
+    std::unordered_map<Key, size_t> previousIndex;
+    previousIndex.reserve(previous.size());
+    for (size_t i = 0; i < previous.size(); ++i) {
+        previousIndex.try_emplace(key(previous[i]), i);
+    }
+
+    // Old index of every new row, npos for rows that are new
+    std::vector<size_t> match(next.size(), npos);
+    std::vector<bool> claimed(previous.size(), false);
+    for (size_t j = 0; j < next.size(); ++j) {
+        auto it = previousIndex.find(key(next[j]));
+        if (it != previousIndex.end() && !claimed[it->second]) {
+            match[j] = it->second;
+            claimed[it->second] = true;
+        }
+    }
+
+    // Longest increasing run of old indices: those rows never move
+    std::vector<size_t> tails;          // positions in next, by run length
+    std::vector<size_t> parent(next.size(), npos);
+    for (size_t j = 0; j < next.size(); ++j) {
+        if (match[j] == npos) continue;
+        auto pos = std::lower_bound(tails.begin(), tails.end(), match[j],
+                                    [&](size_t t, size_t value) { return match[t] < value; });
+        if (pos != tails.begin()) parent[j] = *(pos - 1);
+        if (pos == tails.end()) {
+            tails.push_back(j);
+        } else {
+            *pos = j;
+        }
+    }
+
+    std::vector<bool> kept(previous.size(), false);
+    for (size_t j = tails.empty() ? npos : tails.back(); j != npos; j = parent[j]) {
+        kept[match[j]] = true;
+    }
+
+    std::vector<KeyedEdit> edits;
+    for (size_t i = previous.size(); i-- > 0;) {
+        if (!kept[i]) edits.push_back({KeyedEdit::Kind::Remove, i, npos});
+    }
+
+    // What is left are the kept rows in next's order, so row j lines up with next[j]
+    for (size_t j = 0; j < next.size(); ++j) {
+        if (match[j] != npos && kept[match[j]]) {
+            if (!equal(previous[match[j]], next[j])) {
+                edits.push_back({KeyedEdit::Kind::Update, j, j});
+            }
+        } else {
+            edits.push_back({KeyedEdit::Kind::Insert, j, j});
+        }
+    }
+
+    return edits;
+}
+
+/**
+ * Apply edits from diffKeyed to a model
+ * @param model Anything with erase(row), insert(row, value) and
+ *              set_row_data(row, value), such as slint::VectorModel
+ * @param edits Edits computed against the rows the model currently holds
+ * @param next The list the edits were computed for
+ */
+template <typename Model, typename T>
+void applyKeyedEdits(Model& model, const std::vector<KeyedEdit>& edits, const std::vector<T>& next) {
+    for (const auto& edit : edits) {
+        switch (edit.kind) {
+            case KeyedEdit::Kind::Remove:
+                model.erase(edit.row);
+                break;
+            case KeyedEdit::Kind::Insert:
+                model.insert(edit.row, next[edit.source]);
+                break;
+            case KeyedEdit::Kind::Update:
+                model.set_row_data(edit.row, next[edit.source]);
+                break;
+        }
+    }
+}
+
+} // namespace konami::ui
@@ -0,0 +1,81 @@
+// Konami Client - Keyed Model
+// Slint list model updated in place from fresh snapshots
+
+#pragma once
+
+#include "KeyedDiff.hpp"
+
+#include <slint.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace konami::ui {
+
+/**
+ * @brief slint::VectorModel that is diffed instead of replaced
+ *
+ * The model is created once and bound to the window; each update() diffs
+ * the new rows against the last ones by their id and applies only the
+ * inserts, removes and changed rows. Repeaters keep the instances of
+ * untouched rows, so scroll position and selection survive a refresh.
+ *
+ * @tparam T Generated Slint struct with an `id` string field
+ */
+template <typename T>
+class KeyedModel {
+public:
+    KeyedModel() : m_model(std::make_shared<slint::VectorModel<T>>()) {}
+
+    /**
+     * Model to bind to the window property
+     */
+    std::shared_ptr<slint::VectorModel<T>> model() const { return m_model; }
+
+    /**
+     * Replace the contents with rows, touching only what changed
+     * @param rows New rows, in display order
+     * @return Number of edits applied to the model
+     */
+    size_t update(std::vector<T> rows) {
+        auto edits = diffKeyed(m_rows, rows, [](const T& row) { return std::string_view(row.id); });
+        applyKeyedEdits(*m_model, edits, rows);
+        m_rows = std::move(rows);
+
+        m_index.clear();
+        for (size_t i = 0; i < m_rows.size(); ++i) {
+            m_index.try_emplace(std::string(std::string_view(m_rows[i].id)), i);
+        }
+        return edits.size();
+    }
+
+    /**
+     * Modify one row in place (e.g. when its image finishes loading)
+     * @param id Row key
+     * @param modify Called with the row; return false to leave it unchanged
+     * @return true if the row exists and was changed
+     */
+    template <typename Fn>
+    bool patch(std::string_view id, Fn&& modify) {
+        auto it = m_index.find(std::string(id));
+        if (it == m_index.end()) return false;
+
+        T& row = m_rows[it->second];
+        if (!modify(row)) return false;
+        m_model->set_row_data(it->second, row);
+        return true;
+    }
+
+    const std::vector<T>& rows() const { return m_rows; }
+
+    size_t size() const { return m_rows.size(); }
+
+private:
+    std::shared_ptr<slint::VectorModel<T>> m_model;
+    std::vector<T> m_rows;  // what m_model holds, kept to diff against
+    std::unordered_map<std::string, size_t> m_index;   // id -> row
+};
+
+} // namespace konami::ui
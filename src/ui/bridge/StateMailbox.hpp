@@ -0,0 +1,66 @@
+// Konami Client - State Mailbox
+// Latest-value handoff from worker threads to the UI thread
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+
+namespace konami::ui {
+
+/**
+ * @brief Single slot holding the newest state posted by any thread
+ *
+ * Core threads post() as often as they like; each post overwrites the
+ * previous one. The UI thread take()s once per frame and gets only the
+ * latest value, so UI work stays bounded however fast events arrive.
+ * take() on an empty mailbox is a single atomic load.
+ */
+template <typename T>
+class StateMailbox {
+public:
+    /**
+     * Replace the pending value (any thread)
+     */
+    void post(T value) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_value = std::move(value);
+        }
+        m_pending.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Update the pending value in place, starting from the last posted one
+     * (any thread)
+     * @param update Called with the value under the mailbox lock
+     */
+    template <typename Fn>
+    void modify(Fn&& update) {
+        {
+            std::lock_guard lock(m_mutex);
+            update(m_value);
+        }
+        m_pending.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Take the value posted since the last take (UI thread)
+     * @return Latest value, or nullopt if nothing was posted
+     */
+    std::optional<T> take() {
+        if (!m_pending.exchange(false, std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::lock_guard lock(m_mutex);
+        return m_value;
+    }
+
+private:
+    std::mutex m_mutex;
+    T m_value{};
+    std::atomic<bool> m_pending{false};
+};
+
+} // namespace konami::ui
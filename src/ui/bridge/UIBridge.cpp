@@ -9,13 +9,55 @@
 #include "../../core/launcher/GameLauncher.hpp"
 #include "../../core/skin/SkinEngine.hpp"
 #include "../../core/Logger.hpp"
+#include "../../core/Profiler.hpp"
+#include "../../utils/FileUtils.hpp"
+
+#include <algorithm>
+#include <chrono>
 
 namespace konami::ui {
 
 using core::Logger;
 
+namespace {
+
+// Progress is applied at most once per display frame
+constexpr std::chrono::milliseconds kFrameInterval{16};
+
+// Logical sizes images are decoded for (see the .slint components)
+constexpr float kModIconSize = 48.0f;
+constexpr float kNewsImageWidth = 320.0f;
+constexpr float kNewsImageHeight = 140.0f;
+
+// ModListItem height plus list spacing
+constexpr float kModRowPitch = 84.0f;
+
+/**
+ * Load a row's image and patch it into the row once decoded, unless the
+ * row points at a different URL by then
+ */
+template <typename T>
+void loadRowImage(ImageLoader& images, KeyedModel<T>& model, const T& row,
+                  slint::SharedString T::*urlField, slint::Image T::*imageField,
+                  uint32_t width, uint32_t height) {
+    std::string url(row.*urlField);
+    if (url.empty() || (row.*imageField).size().width > 0) {
+        return;
+    }
+    images.load(url, width, height, [&model, id = std::string(row.id), url, urlField, imageField](const slint::Image& image) {
+        model.patch(id, [&](T& current) {
+            if (std::string_view(current.*urlField) != url) return false;
+            current.*imageField = image;
+            return true;
+        });
+    });
+}
+
+} // namespace
+
 UIBridge::UIBridge(core::Application& app)
     : m_app(app)
+    , m_images(utils::FileUtils::getCachePath() / "thumbnails")
 {
 }
 
@@ -26,6 +68,13 @@ bool UIBridge::initialize() {
         // Create main window
         m_window = MainWindow::create();
         
+        // Bind list models once; updates edit them in place
+        m_window->set_profiles(m_profiles.model());
+        m_window->set_installed_mods(m_installedMods.model());
+        m_window->set_skins(m_skins.model());
+        m_window->set_capes(m_capes.model());
+        m_window->set_news(m_news.model());
+        
         // Setup all callbacks
         setupNavigationCallbacks();
         setupAuthCallbacks();
@@ -34,8 +83,13 @@ bool UIBridge::initialize() {
         setupSkinCallbacks();
         setupSettingsCallbacks();
         setupLaunchCallbacks();
+        setupDownloadCallbacks();
         setupWindowCallbacks();
         
+        m_frameTimer.start(slint::TimerMode::Repeated, kFrameInterval, [this]() {
+            applyPendingState();
+        });
+        
         // Initial data load
         updateAccountInfo();
         updateProfiles();
@@ -102,8 +156,10 @@ void UIBridge::setupProfileCallbacks() {
 }
 
 void UIBridge::setupModCallbacks() {
-    // Mod management callbacks
-    // Note: Connected to ModsPage component
+    // Scrolling the installed list reorders pending icon loads
+    m_window->on_mods_viewport_changed([this](float offset, float height) {
+        setModsViewport(offset, height);
+    });
 }
 
 void UIBridge::setupSkinCallbacks() {
@@ -142,14 +198,13 @@ void UIBridge::setupLaunchCallbacks() {
         m_app.gameLauncher().launch(selectedId, 
             // Progress callback
             [this](float progress, const std::string& status) {
-                slint::invoke_from_event_loop([this, progress]() {
-                    m_window->set_launch_progress(progress);
-                });
+                m_launchProgress.post(progress);
             },
             // Completion callback
             [this](bool success, const std::string& error) {
                 slint::invoke_from_event_loop([this, success, error]() {
                     m_window->set_is_launching(false);
+                    m_launchProgress.take(); // drop progress that trails completion
                     
                     if (success) {
                         updateGameStatus(true, "");
@@ -168,6 +223,21 @@ void UIBridge::setupLaunchCallbacks() {
     });
 }
 
+void UIBridge::setupDownloadCallbacks() {
+    // Called from download workers, once per finished file
+    m_app.getDownloadManager()->setOverallProgressCallback(
+        [this](size_t completed, size_t total, size_t bytesDownloaded, size_t totalBytes) {
+            m_downloadState.modify([&](UIDownloadProgress& progress) {
+                progress.isDownloading = completed < total;
+                progress.filesCompleted = static_cast<int>(completed);
+                progress.filesTotal = static_cast<int>(total);
+                progress.totalProgress = totalBytes > 0
+                    ? static_cast<float>(bytesDownloaded) / static_cast<float>(totalBytes)
+                    : (total > 0 ? static_cast<float>(completed) / static_cast<float>(total) : 1.0f);
+            });
+        });
+}
+
 void UIBridge::setupWindowCallbacks() {
     m_window->on_minimize_window([this]() {
         m_window->window().set_minimized(true);
@@ -195,6 +265,7 @@ void UIBridge::setupWindowCallbacks() {
 }
 
 void UIBridge::updateAccountInfo() {
+    KONAMI_ZONE();
     if (!m_app.authManager().isLoggedIn()) {
         AccountInfo info;
         info.is_logged_in = false;
@@ -218,10 +289,12 @@ void UIBridge::updateAccountInfo() {
 }
 
 void UIBridge::updateProfiles() {
+    KONAMI_ZONE();
     auto& profileManager = m_app.profileManager();
     auto profiles = profileManager.getAllProfiles();
     
-    auto model = std::make_shared<slint::VectorModel<ProfileInfo>>();
+    std::vector<ProfileInfo> rows;
+    rows.reserve(profiles.size());
     
     for (const auto& profile : profiles) {
         ProfileInfo info;
@@ -237,18 +310,21 @@ void UIBridge::updateProfiles() {
         info.is_favorite = profile.isFavorite;
         info.created_at = slint::SharedString(profile.createdAt);
         
-        model->push_back(info);
+        rows.push_back(std::move(info));
     }
     
-    m_window->set_profiles(model);
+    m_profiles.update(std::move(rows));
 }
 
 void UIBridge::updateMods() {
+    KONAMI_ZONE();
     auto& modManager = m_app.modManager();
     
     // Installed mods
     auto installedMods = modManager.getInstalledMods();
-    auto installedModel = std::make_shared<slint::VectorModel<ModInfo>>();
+    std::vector<ModInfo> rows;
+    rows.reserve(installedMods.size());
+    uint32_t iconPixels = imagePixels(kModIconSize);
     
     for (const auto& mod : installedMods) {
         ModInfo info;
@@ -260,42 +336,62 @@ void UIBridge::updateMods() {
         info.game_version = slint::SharedString(mod.gameVersion);
         info.downloads = mod.downloads;
         info.icon_url = slint::SharedString(mod.iconUrl);
+        if (auto icon = m_images.cached(mod.iconUrl, iconPixels, iconPixels)) {
+            info.icon = *icon;
+        }
         info.is_installed = true;
         info.is_enabled = mod.isEnabled;
         info.is_updating = false;
         info.source = slint::SharedString(mod.source);
         info.category = slint::SharedString(mod.category);
         
-        installedModel->push_back(info);
+        rows.push_back(std::move(info));
     }
     
-    m_window->set_installed_mods(installedModel);
+    m_installedMods.update(std::move(rows));
+    
+    // Queue icons that are not in memory; on-screen ones are picked first
+    updateVisibleModIcons();
+    for (const auto& row : m_installedMods.rows()) {
+        loadRowImage(m_images, m_installedMods, row, &ModInfo::icon_url, &ModInfo::icon, iconPixels, iconPixels);
+    }
 }
 
 void UIBridge::updateSkins() {
+    KONAMI_ZONE();
     auto& skinEngine = m_app.skinEngine();
     auto skins = skinEngine.getAllSkins();
     
-    auto model = std::make_shared<slint::VectorModel<SkinInfo>>();
+    std::vector<SkinInfo> rows;
+    rows.reserve(skins.size());
     
     for (const auto& skin : skins) {
         SkinInfo info;
         info.id = slint::SharedString(skin.id);
         info.name = slint::SharedString(skin.name);
         info.texture_url = slint::SharedString(skin.textureUrl);
+        if (auto texture = m_images.cached(skin.textureUrl, 0, 0)) {
+            info.texture = *texture;
+        }
         info.model_type = slint::SharedString(skin.modelType);
         info.is_active = skin.isActive;
         info.is_favorite = skin.isFavorite;
         info.created_at = slint::SharedString(skin.createdAt);
         
-        model->push_back(info);
+        rows.push_back(std::move(info));
     }
     
-    m_window->set_skins(model);
+    m_skins.update(std::move(rows));
+    
+    // Skin textures are pixel art and stay at their native size
+    for (const auto& row : m_skins.rows()) {
+        loadRowImage(m_images, m_skins, row, &SkinInfo::texture_url, &SkinInfo::texture, 0, 0);
+    }
     
     // Also update capes
     auto capes = skinEngine.getAllCapes();
-    auto capesModel = std::make_shared<slint::VectorModel<CapeInfo>>();
+    std::vector<CapeInfo> capeRows;
+    capeRows.reserve(capes.size());
     
     for (const auto& cape : capes) {
         CapeInfo info;
@@ -305,39 +401,90 @@ void UIBridge::updateSkins() {
         info.is_active = cape.isActive;
         info.source = slint::SharedString(cape.source);
         
-        capesModel->push_back(info);
+        capeRows.push_back(std::move(info));
     }
     
-    m_window->set_capes(capesModel);
+    m_capes.update(std::move(capeRows));
+}
+
+void UIBridge::setModsViewport(float offset, float height) {
+    m_modsViewportOffset = std::max(offset, 0.0f);
+    m_modsViewportHeight = std::max(height, 0.0f);
+    updateVisibleModIcons();
+}
+
+void UIBridge::updateVisibleModIcons() {
+    KONAMI_ZONE();
+    const auto& rows = m_installedMods.rows();
+    
+    // Rows on screen plus one screen below
+    auto first = static_cast<size_t>(m_modsViewportOffset / kModRowPitch);
+    auto last = static_cast<size_t>((m_modsViewportOffset + 2 * m_modsViewportHeight) / kModRowPitch) + 1;
+    
+    std::vector<std::string> urls;
+    for (size_t i = first; i < std::min(last, rows.size()); ++i) {
+        urls.emplace_back(rows[i].icon_url);
+    }
+    m_images.setVisible(urls);
+}
+
+uint32_t UIBridge::imagePixels(float logicalSize) const {
+    float scale = m_window ? m_window->window().scale_factor() : 1.0f;
+    return static_cast<uint32_t>(logicalSize * scale + 0.5f);
 }
 
 void UIBridge::updateDownloadProgress(float progress, const std::string& currentFile) {
-    DownloadProgress dp;
-    dp.is_downloading = progress < 1.0f;
-    dp.current_file = slint::SharedString(currentFile);
-    dp.current_progress = progress;
-    dp.total_progress = progress;
-    dp.download_speed = slint::SharedString("0 MB/s"); // Would calculate actual speed
-    dp.eta = slint::SharedString("--:--");
-    dp.files_completed = 0;
-    dp.files_total = 1;
-    
-    m_window->set_download_progress(dp);
+    m_downloadState.modify([&](UIDownloadProgress& state) {
+        state.isDownloading = progress < 1.0f;
+        state.currentFile = currentFile;
+        state.currentProgress = progress;
+        if (state.filesTotal == 0) {
+            state.totalProgress = progress;
+        }
+    });
 }
 
 void UIBridge::updateGameStatus(bool running, const std::string& memoryUsage) {
-    GameStatus status;
-    status.is_running = running;
-    status.current_version = m_window->get_current_version();
-    status.memory_usage = slint::SharedString(memoryUsage);
-    status.uptime = slint::SharedString("00:00:00");
+    UIGameStatus status{};
+    status.isRunning = running;
+    status.memoryUsage = memoryUsage;
+    status.uptime = "00:00:00";
+    m_gameState.post(std::move(status));
+}
+
+void UIBridge::applyPendingState() {
+    KONAMI_ZONE();
+    if (auto progress = m_launchProgress.take()) {
+        m_window->set_launch_progress(*progress);
+    }
     
-    m_window->set_game_status(status);
+    if (auto state = m_downloadState.take()) {
+        DownloadProgress dp;
+        dp.is_downloading = state->isDownloading;
+        dp.current_file = slint::SharedString(state->currentFile);
+        dp.current_progress = state->currentProgress;
+        dp.total_progress = state->totalProgress;
+        dp.download_speed = slint::SharedString("0 MB/s"); // Would calculate actual speed
+        dp.eta = slint::SharedString("--:--");
+        dp.files_completed = state->filesCompleted;
+        dp.files_total = std::max(state->filesTotal, 1);
+        m_window->set_download_progress(dp);
+    }
+    
+    if (auto state = m_gameState.take()) {
+        GameStatus status;
+        status.is_running = state->isRunning;
+        status.current_version = m_window->get_current_version();
+        status.memory_usage = slint::SharedString(state->memoryUsage);
+        status.uptime = slint::SharedString(state->uptime);
+        m_window->set_game_status(status);
+    }
 }
 
 void UIBridge::updateNews() {
+    KONAMI_ZONE();
     // Would fetch from news API
-    auto model = std::make_shared<slint::VectorModel<NewsItem>>();
+    std::vector<NewsItem> rows;
     
     // Example news items
     NewsItem item1;
@@ -348,7 +495,7 @@ void UIBridge::updateNews() {
     item1.date = slint::SharedString("Today");
     item1.url = slint::SharedString("https://minecraft.net");
     item1.category = slint::SharedString("Update");
-    model->push_back(item1);
+    rows.push_back(std::move(item1));
     
     NewsItem item2;
     item2.id = slint::SharedString("2");
@@ -358,12 +505,18 @@ void UIBridge::updateNews() {
     item2.date = slint::SharedString("Yesterday");
     item2.url = slint::SharedString("");
     item2.category = slint::SharedString("Launcher");
-    model->push_back(item2);
+    rows.push_back(std::move(item2));
     
-    m_window->set_news(model);
+    m_news.update(std::move(rows));
+    
+    for (const auto& row : m_news.rows()) {
+        loadRowImage(m_images, m_news, row, &NewsItem::image_url, &NewsItem::image,
+                     imagePixels(kNewsImageWidth), imagePixels(kNewsImageHeight));
+    }
 }
 
 void UIBridge::updateSettings() {
+    KONAMI_ZONE();
     auto& config = m_app.config();
     
     LauncherSettings settings;
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include "ImageLoader.hpp"
+#include "KeyedModel.hpp"
+#include "StateMailbox.hpp"
+
 #include <slint.h>
 #include <memory>
 #include <functional>
@@ -23,6 +27,30 @@ namespace konami::skin { class SkinManager; }
 
 namespace konami::ui {
 
+/**
+ * @brief Download progress for UI
+ */
+struct UIDownloadProgress {
+    bool isDownloading;
+    std::string currentFile;
+    float currentProgress;
+    float totalProgress;
+    std::string downloadSpeed;
+    std::string eta;
+    int filesCompleted;
+    int filesTotal;
+};
+
+/**
+ * @brief Game status for UI
+ */
+struct UIGameStatus {
+    bool isRunning;
+    std::string currentVersion;
+    std::string memoryUsage;
+    std::string uptime;
+};
+
 /**
  * @brief Bridge between C++ backend and Slint UI
  * 
@@ -47,6 +75,11 @@ public:
     void updateProfiles();
     void updateMods();
     void updateSkins();
+    
+    // Scroll position of the installed mods list; its icons load first
+    void setModsViewport(float offset, float height);
+    
+    // Progress and status; safe from any thread, shown on the next frame
     void updateDownloadProgress(float progress, const std::string& currentFile);
     void updateGameStatus(bool running, const std::string& memoryUsage);
     void updateNews();
@@ -70,8 +103,16 @@ private:
     void setupSkinCallbacks();
     void setupSettingsCallbacks();
     void setupLaunchCallbacks();
+    void setupDownloadCallbacks();
     void setupWindowCallbacks();
     
+    // Apply state posted by core threads (frame timer)
+    void applyPendingState();
+    
+    // Mark icons of on-screen mods as visible for the image loader
+    void updateVisibleModIcons();
+    uint32_t imagePixels(float logicalSize) const;
+    
     // Convert types
     AccountInfo toSlintAccount(const struct Account& account);
     ProfileInfo toSlintProfile(const struct Profile& profile);
@@ -83,6 +124,24 @@ private:
     core::Application& m_app;
     slint::ComponentHandle<MainWindow> m_window;
     bool m_initialized{false};
+    
+    // List models, bound once and diffed on every update
+    KeyedModel<ProfileInfo> m_profiles;
+    KeyedModel<ModInfo> m_installedMods;
+    KeyedModel<SkinInfo> m_skins;
+    KeyedModel<CapeInfo> m_capes;
+    KeyedModel<NewsItem> m_news;
+    
+    // Latest progress from core threads, applied once per frame
+    StateMailbox<UIDownloadProgress> m_downloadState;
+    StateMailbox<UIGameStatus> m_gameState;
+    StateMailbox<float> m_launchProgress;
+    slint::Timer m_frameTimer;
+    
+    // Declared after the models its callbacks patch
+    ImageLoader m_images;
+    float m_modsViewportOffset{0.0f};
+    float m_modsViewportHeight{720.0f};
 };
 
 /**
@@ -132,30 +191,6 @@ struct UIModInfo {
     std::string category;
 };
 
-/**
- * @brief Download progress for UI
- */
-struct UIDownloadProgress {
-    bool isDownloading;
-    std::string currentFile;
-    float currentProgress;
-    float totalProgress;
-    std::string downloadSpeed;
-    std::string eta;
-    int filesCompleted;
-    int filesTotal;
-};
-
-/**
- * @brief Game status for UI
- */
-struct UIGameStatus {
-    bool isRunning;
-    std::string currentVersion;
-    std::string memoryUsage;
-    std::string uptime;
-};
-
 /**
  * @brief Skin info for UI
  */
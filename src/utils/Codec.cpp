@@ -0,0 +1,413 @@
+/**
+ * Codec.cpp
+ *
+ * Base64 and hex, scalar and x86 vector kernels. The base64 kernels
+ * follow Muła and Lemire ("Faster Base64 Encoding and Decoding using AVX2
+ * Instructions", 2018) at SSE width: encoding reshuffles 12 input bytes
+ * into 16 six-bit indices with pshufb and two multiplies and maps them to
+ * ASCII with a 16-entry offset table; decoding classifies characters with
+ * range compares and packs with pmaddubsw / pmaddwd. SSSE3 is detected at
+ * runtime; SSE2 (hex) is part of x86-64.
+ */
+
+#include "Codec.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define KONAMI_CODEC_X86 1
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define KONAMI_TARGET_SSSE3
+#else
+#define KONAMI_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#endif
+
+namespace konami::utils {
+
+namespace {
+
+using Alphabet = Codec::Base64Alphabet;
+
+constexpr char kBase64Standard[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kBase64UrlSafe[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr char kHexLower[] = "0123456789abcdef";
+constexpr char kHexUpper[] = "0123456789ABCDEF";
+constexpr uint8_t kInvalid = 0xFF;
+
+using DecodeTable = std::array<uint8_t, 256>;
+
+constexpr DecodeTable makeBase64Table(const char* alphabet) {
+    DecodeTable table{};
+    for (auto& value : table) value = kInvalid;
+    for (uint8_t i = 0; i < 64; ++i) table[static_cast<unsigned char>(alphabet[i])] = i;
+    return table;
+}
+
+constexpr DecodeTable makeHexTable() {
+    DecodeTable table{};
+    for (auto& value : table) value = kInvalid;
+    for (uint8_t i = 0; i < 10; ++i) table['0' + i] = i;
+    for (uint8_t i = 0; i < 6; ++i) {
+        table['a' + i] = static_cast<uint8_t>(10 + i);
+        table['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return table;
+}
+
+constexpr DecodeTable kBase64StandardTable = makeBase64Table(kBase64Standard);
+constexpr DecodeTable kBase64UrlSafeTable = makeBase64Table(kBase64UrlSafe);
+constexpr DecodeTable kHexTable = makeHexTable();
+
+const char* encodeTable(Alphabet alphabet) {
+    return alphabet == Alphabet::UrlSafe ? kBase64UrlSafe : kBase64Standard;
+}
+
+const DecodeTable& decodeTable(Alphabet alphabet) {
+    return alphabet == Alphabet::UrlSafe ? kBase64UrlSafeTable : kBase64StandardTable;
+}
+
+/**
+ * Strip '=' padding, checking it is well placed
+ * @return Unpadded text, or nullopt on bad padding or length
+ */
+std::optional<std::string_view> stripPadding(std::string_view text) {
+    size_t padding = 0;
+    while (padding < 2 && padding < text.size() && text[text.size() - 1 - padding] == '=') ++padding;
+    if (padding > 0 && text.size() % 4 != 0) return std::nullopt;
+    text.remove_suffix(padding);
+    if (text.size() % 4 == 1) return std::nullopt;
+    return text;
+}
+
+/**
+ * Decode unpadded base64 whose length is not 1 mod 4
+ */
+std::optional<size_t> decodeUnpadded(std::string_view text, uint8_t* out, const DecodeTable& table) {
+    const auto* in = reinterpret_cast<const unsigned char*>(text.data());
+    size_t n = text.size();
+    size_t i = 0, o = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32_t a = table[in[i]], b = table[in[i + 1]], c = table[in[i + 2]], d = table[in[i + 3]];
+        if ((a | b | c | d) & 0xC0) return std::nullopt;
+        uint32_t v = a << 18 | b << 12 | c << 6 | d;
+        out[o++] = static_cast<uint8_t>(v >> 16);
+        out[o++] = static_cast<uint8_t>(v >> 8);
+        out[o++] = static_cast<uint8_t>(v);
+    }
+    size_t rest = n - i;
+    if (rest >= 2) {
+        uint32_t a = table[in[i]], b = table[in[i + 1]];
+        uint32_t c = rest == 3 ? table[in[i + 2]] : 0;
+        if ((a | b | c) & 0xC0) return std::nullopt;
+        uint32_t v = a << 18 | b << 12 | c << 6;
+        out[o++] = static_cast<uint8_t>(v >> 16);
+        if (rest == 3) out[o++] = static_cast<uint8_t>(v >> 8);
+    }
+    return o;
+}
+
+#ifdef KONAMI_CODEC_X86
+
+bool detectSsse3() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+/**
+ * 12 bytes -> 16 characters per step; needs 16 readable input bytes
+ * @return Input bytes consumed (a multiple of 3)
+ */
+KONAMI_TARGET_SSSE3
+size_t base64EncodeSsse3(const uint8_t* in, size_t size, char* out, Alphabet alphabet) {
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const char c62 = alphabet == Alphabet::UrlSafe ? '-' : '+';
+    const char c63 = alphabet == Alphabet::UrlSafe ? '_' : '/';
+    // Offset from index to ASCII, selected by a reduced index (see below)
+    const __m128i offsets = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, static_cast<char>(c62 - 62), static_cast<char>(c63 - 63), 'A', 0, 0);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 12, out += 16) {
+        __m128i input = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), shuffle);
+        __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+        __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+        __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t1, t3);
+
+        // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+        __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        reduced = _mm_or_si128(reduced, _mm_and_si128(upper, _mm_set1_epi8(13)));
+        __m128i ascii = _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), ascii);
+    }
+    return i;
+}
+
+/**
+ * 16 characters -> 12 bytes per step
+ * @return Characters consumed (a multiple of 16), or nullopt on an invalid character
+ */
+KONAMI_TARGET_SSSE3
+std::optional<size_t> base64DecodeSsse3(const char* in, size_t length, uint8_t* out, Alphabet alphabet) {
+    const __m128i c62 = _mm_set1_epi8(alphabet == Alphabet::UrlSafe ? '-' : '+');
+    const __m128i c63 = _mm_set1_epi8(alphabet == Alphabet::UrlSafe ? '_' : '/');
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    auto inRange = [](__m128i c, char low, char high) {
+        return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(static_cast<char>(low - 1))),
+                             _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(high + 1)), c));
+    };
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16, out += 12) {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        // Bytes >= 0x80 are negative and fail every signed range check
+        __m128i upper = inRange(c, 'A', 'Z');
+        __m128i lower = inRange(c, 'a', 'z');
+        __m128i digit = inRange(c, '0', '9');
+        __m128i is62 = _mm_cmpeq_epi8(c, c62);
+        __m128i is63 = _mm_cmpeq_epi8(c, c63);
+        __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(is62, is63)));
+        if (_mm_movemask_epi8(valid) != 0xFFFF) return std::nullopt;
+
+        __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+        shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+        shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+        shift = _mm_or_si128(shift, _mm_and_si128(is62, _mm_sub_epi8(_mm_set1_epi8(62), c62)));
+        shift = _mm_or_si128(shift, _mm_and_si128(is63, _mm_sub_epi8(_mm_set1_epi8(63), c63)));
+        __m128i values = _mm_add_epi8(c, shift);
+
+        // [a b c d] -> a<<18 | b<<12 | c<<6 | d in each 32-bit lane, then big-endian bytes
+        __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        __m128i bytes = _mm_shuffle_epi8(words, pack);
+        alignas(16) uint8_t block[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(block), bytes);
+        std::memcpy(out, block, 12);
+    }
+    return i;
+}
+
+/**
+ * 16 bytes -> 32 characters per step
+ * @return Bytes consumed
+ */
+size_t hexEncodeSse2(const uint8_t* in, size_t size, char* out, bool uppercase) {
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    const __m128i letters = _mm_set1_epi8(static_cast<char>((uppercase ? 'A' : 'a') - '0' - 10));
+    auto ascii = [&](__m128i nibbles) {
+        __m128i isLetter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+        return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), _mm_and_si128(isLetter, letters));
+    };
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16, out += 32) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+        __m128i low = _mm_and_si128(bytes, mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), ascii(_mm_unpacklo_epi8(high, low)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), ascii(_mm_unpackhi_epi8(high, low)));
+    }
+    return i;
+}
+
+/**
+ * 32 characters -> 16 bytes per step
+ * @return Characters consumed, or nullopt on a non-hex character
+ */
+std::optional<size_t> hexDecodeSse2(const char* in, size_t length, uint8_t* out) {
+    auto nibbles = [](__m128i c, __m128i& valid) {
+        __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+        __m128i folded = _mm_or_si128(c, _mm_set1_epi8(0x20));
+        __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)),
+                                         _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), folded));
+        valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+        return _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                            _mm_and_si128(isLetter, _mm_sub_epi8(folded, _mm_set1_epi8('a' - 10))));
+    };
+    // 16-bit lanes hold [high, low] nibbles; fold each into one byte
+    auto combine = [](__m128i n) {
+        return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(n, 8));
+    };
+
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32, out += 16) {
+        __m128i valid = _mm_set1_epi8(-1);
+        __m128i first = nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), valid);
+        __m128i second = nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)), valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF) return std::nullopt;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(combine(first), combine(second)));
+    }
+    return i;
+}
+
+#endif
+
+} // namespace
+
+// -- Scalar --
+
+size_t Codec::Scalar::base64Encode(const void* data, size_t size, char* out, Base64Alphabet alphabet, bool padding) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    const char* table = encodeTable(alphabet);
+    char* start = out;
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t v = uint32_t{in[i]} << 16 | uint32_t{in[i + 1]} << 8 | in[i + 2];
+        *out++ = table[v >> 18];
+        *out++ = table[(v >> 12) & 0x3F];
+        *out++ = table[(v >> 6) & 0x3F];
+        *out++ = table[v & 0x3F];
+    }
+    size_t rest = size - i;
+    if (rest > 0) {
+        uint32_t v = uint32_t{in[i]} << 16 | (rest == 2 ? uint32_t{in[i + 1]} << 8 : 0);
+        *out++ = table[v >> 18];
+        *out++ = table[(v >> 12) & 0x3F];
+        if (rest == 2) *out++ = table[(v >> 6) & 0x3F];
+        if (padding) {
+            for (size_t p = rest; p < 3; ++p) *out++ = '=';
+        }
+    }
+    return static_cast<size_t>(out - start);
+}
+
+std::optional<size_t> Codec::Scalar::base64Decode(std::string_view text, uint8_t* out, Base64Alphabet alphabet) {
+    auto body = stripPadding(text);
+    if (!body) return std::nullopt;
+    return decodeUnpadded(*body, out, decodeTable(alphabet));
+}
+
+void Codec::Scalar::hexEncode(const void* data, size_t size, char* out, bool uppercase) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    const char* digits = uppercase ? kHexUpper : kHexLower;
+    for (size_t i = 0; i < size; ++i) {
+        *out++ = digits[in[i] >> 4];
+        *out++ = digits[in[i] & 0x0F];
+    }
+}
+
+std::optional<size_t> Codec::Scalar::hexDecode(std::string_view text, uint8_t* out) {
+    if (text.size() % 2 != 0) return std::nullopt;
+    const auto* in = reinterpret_cast<const unsigned char*>(text.data());
+    for (size_t i = 0; i < text.size(); i += 2) {
+        uint8_t high = kHexTable[in[i]], low = kHexTable[in[i + 1]];
+        if ((high | low) & 0xF0) return std::nullopt;
+        *out++ = static_cast<uint8_t>(high << 4 | low);
+    }
+    return text.size() / 2;
+}
+
+// -- Dispatch --
+
+bool Codec::simdBase64() {
+#ifdef KONAMI_CODEC_X86
+    static const bool supported = detectSsse3();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool Codec::simdHex() {
+#ifdef KONAMI_CODEC_X86
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t Codec::base64Encode(const void* data, size_t size, char* out, Base64Alphabet alphabet, bool padding) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    size_t consumed = 0;
+#ifdef KONAMI_CODEC_X86
+    if (simdBase64()) consumed = base64EncodeSsse3(in, size, out, alphabet);
+#endif
+    size_t written = consumed / 3 * 4;
+    return written + Scalar::base64Encode(in + consumed, size - consumed, out + written, alphabet, padding);
+}
+
+std::optional<size_t> Codec::base64Decode(std::string_view text, uint8_t* out, Base64Alphabet alphabet) {
+    auto body = stripPadding(text);
+    if (!body) return std::nullopt;
+    size_t consumed = 0;
+#ifdef KONAMI_CODEC_X86
+    if (simdBase64()) {
+        auto vector = base64DecodeSsse3(body->data(), body->size(), out, alphabet);
+        if (!vector) return std::nullopt;
+        consumed = *vector;
+    }
+#endif
+    size_t written = consumed / 4 * 3;
+    auto tail = decodeUnpadded(body->substr(consumed), out + written, decodeTable(alphabet));
+    if (!tail) return std::nullopt;
+    return written + *tail;
+}
+
+void Codec::hexEncode(const void* data, size_t size, char* out, bool uppercase) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    size_t consumed = 0;
+#ifdef KONAMI_CODEC_X86
+    consumed = hexEncodeSse2(in, size, out, uppercase);
+#endif
+    Scalar::hexEncode(in + consumed, size - consumed, out + consumed * 2, uppercase);
+}
+
+std::optional<size_t> Codec::hexDecode(std::string_view text, uint8_t* out) {
+    if (text.size() % 2 != 0) return std::nullopt;
+    size_t consumed = 0;
+#ifdef KONAMI_CODEC_X86
+    auto vector = hexDecodeSse2(text.data(), text.size(), out);
+    if (!vector) return std::nullopt;
+    consumed = *vector;
+#endif
+    auto tail = Scalar::hexDecode(text.substr(consumed), out + consumed / 2);
+    if (!tail) return std::nullopt;
+    return consumed / 2 + *tail;
+}
+
+// -- Allocating wrappers --
+
+std::string Codec::base64Encode(std::string_view data, Base64Alphabet alphabet, bool padding) {
+    std::string result(base64EncodedSize(data.size(), padding), '\0');
+    result.resize(base64Encode(data.data(), data.size(), result.data(), alphabet, padding));
+    return result;
+}
+
+std::optional<std::string> Codec::base64Decode(std::string_view text, Base64Alphabet alphabet) {
+    std::string result(base64MaxDecodedSize(text.size()), '\0');
+    auto size = base64Decode(text, reinterpret_cast<uint8_t*>(result.data()), alphabet);
+    if (!size) return std::nullopt;
+    result.resize(*size);
+    return result;
+}
+
+std::string Codec::hexEncode(std::string_view data, bool uppercase) {
+    std::string result(hexEncodedSize(data.size()), '\0');
+    hexEncode(data.data(), data.size(), result.data(), uppercase);
+    return result;
+}
+
+std::optional<std::string> Codec::hexDecode(std::string_view text) {
+    std::string result(hexDecodedSize(text.size()), '\0');
+    auto size = hexDecode(text, reinterpret_cast<uint8_t*>(result.data()));
+    if (!size) return std::nullopt;
+    result.resize(*size);
+    return result;
+}
+
+} // namespace konami::utils
@@ -0,0 +1,99 @@
+// Konami Client - Codec
+// Base64 (RFC 4648, standard and URL-safe) and hex encoding
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace konami::utils {
+
+/**
+ * @brief Base64 and hex codecs
+ *
+ * The buffer overloads write into caller memory and never allocate; the
+ * string overloads are thin wrappers. On x86 the bulk of the input goes
+ * through SSE2 (hex) and SSSE3 (base64, chosen at runtime) kernels, 16
+ * input characters per step; tails and other CPUs use the table-driven
+ * Scalar versions, which define the expected output.
+ *
+ * Decoding is strict: characters outside the alphabet, misplaced padding
+ * or an impossible length are errors. Base64 padding is optional on input.
+ */
+class Codec {
+public:
+    enum class Base64Alphabet {
+        Standard,   // A-Z a-z 0-9 + /
+        UrlSafe     // A-Z a-z 0-9 - _
+    };
+
+    // -- Sizes --
+
+    static constexpr size_t base64EncodedSize(size_t size, bool padding = true) {
+        return padding ? (size + 2) / 3 * 4 : size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+    }
+    static constexpr size_t base64MaxDecodedSize(size_t length) { return (length + 3) / 4 * 3; }
+    static constexpr size_t hexEncodedSize(size_t size) { return size * 2; }
+    static constexpr size_t hexDecodedSize(size_t length) { return length / 2; }
+
+    // -- Into caller buffers --
+
+    /**
+     * Base64-encode bytes
+     * @param out At least base64EncodedSize(size, padding) bytes
+     * @return Characters written
+     */
+    static size_t base64Encode(const void* data, size_t size, char* out,
+                               Base64Alphabet alphabet = Base64Alphabet::Standard, bool padding = true);
+
+    /**
+     * Decode base64
+     * @param out At least base64MaxDecodedSize(text.size()) bytes
+     * @return Bytes written, or nullopt if the input is not valid base64
+     */
+    static std::optional<size_t> base64Decode(std::string_view text, uint8_t* out,
+                                              Base64Alphabet alphabet = Base64Alphabet::Standard);
+
+    /**
+     * Hex-encode bytes (lowercase unless uppercase is set)
+     * @param out At least hexEncodedSize(size) bytes
+     */
+    static void hexEncode(const void* data, size_t size, char* out, bool uppercase = false);
+
+    /**
+     * Decode hex (either case)
+     * @param out At least hexDecodedSize(text.size()) bytes
+     * @return Bytes written, or nullopt on odd length or a non-hex character
+     */
+    static std::optional<size_t> hexDecode(std::string_view text, uint8_t* out);
+
+    // -- Allocating wrappers --
+
+    static std::string base64Encode(std::string_view data,
+                                    Base64Alphabet alphabet = Base64Alphabet::Standard, bool padding = true);
+    static std::optional<std::string> base64Decode(std::string_view text,
+                                                   Base64Alphabet alphabet = Base64Alphabet::Standard);
+    static std::string hexEncode(std::string_view data, bool uppercase = false);
+    static std::optional<std::string> hexDecode(std::string_view text);
+
+    /**
+     * Whether this CPU runs the vector kernels (base64 needs SSSE3)
+     */
+    static bool simdBase64();
+    static bool simdHex();
+
+    /**
+     * Reference implementations; same contracts as the buffer overloads
+     */
+    struct Scalar {
+        static size_t base64Encode(const void* data, size_t size, char* out, Base64Alphabet alphabet, bool padding);
+        static std::optional<size_t> base64Decode(std::string_view text, uint8_t* out, Base64Alphabet alphabet);
+        static void hexEncode(const void* data, size_t size, char* out, bool uppercase);
+        static std::optional<size_t> hexDecode(std::string_view text, uint8_t* out);
+    };
+};
+
+} // namespace konami::utils
@@ -0,0 +1,396 @@
+/**
+ * DirectoryWalker.cpp
+ *
+ * Work-stealing directory traversal. Each worker owns a deque of directories:
+ * it pushes and pops at the back (depth-first, warm dentries) and thieves take
+ * from the front, where the shallowest and usually largest subtrees are.
+ */
+
+#include "DirectoryWalker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstddef>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace konami::utils {
+
+namespace {
+
+using Entry = DirectoryWalker::Entry;
+using Type = DirectoryWalker::Type;
+
+/**
+ * Directory whose total is reported (depth <= Options::subtreeDepth)
+ */
+struct Node {
+    std::string relativePath;
+    int depth{0};
+    Node* parent{nullptr};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> files{0};
+
+    Node(std::string path, int d, Node* p) : relativePath(std::move(path)), depth(d), parent(p) {}
+};
+
+struct WorkItem {
+    std::string path;
+    int depth{0};       // Depth of this directory (root = 0)
+    Node* node{nullptr};  // Nearest reported ancestor (or self)
+};
+
+struct Counters {
+    uint64_t bytes{0};
+    uint64_t files{0};
+    uint64_t directories{0};
+    uint64_t errors{0};
+};
+
+#if defined(__linux__)
+// Fixed part of a getdents64 record; the NUL-terminated name follows d_type
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+};
+
+constexpr size_t kDirentNameOffset = offsetof(LinuxDirent64, d_type) + 1;
+
+constexpr size_t kDirentBufferSize = 64 * 1024;
+
+Type typeFromMode(mode_t mode) {
+    if (S_ISREG(mode)) return Type::File;
+    if (S_ISDIR(mode)) return Type::Directory;
+    if (S_ISLNK(mode)) return Type::Symlink;
+    return Type::Other;
+}
+#endif
+
+class Walk {
+public:
+    Walk(const fs::path& root, const DirectoryWalker::Options& options, const DirectoryWalker::Visitor& visit)
+        : m_options(options), m_visit(visit) {
+        // Keep the separator only for "/" and drive roots like "C:/"
+        m_root = root.generic_string();
+        while (m_root.size() > 1 && m_root.back() == '/' && m_root[m_root.size() - 2] != ':') {
+            m_root.pop_back();
+        }
+        m_relativeStart = !m_root.empty() && m_root.back() == '/' ? m_root.size() : m_root.size() + 1;
+
+        unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+        threads = std::max(1u, threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    DirectoryWalker::Result run() {
+        DirectoryWalker::Result result;
+        std::error_code ec;
+        if (m_root.empty() || !fs::is_directory(fs::path(m_root), ec)) {
+            return result;
+        }
+
+        Node* rootNode = &m_nodes.emplace_back(std::string(), 0, nullptr);
+        push(0, WorkItem{m_root, 0, rootNode});
+
+        std::vector<Counters> counters(m_workers.size());
+        std::vector<std::thread> threads;
+        for (unsigned id = 1; id < m_workers.size(); ++id) {
+            threads.emplace_back([this, id, &counters] { workerLoop(id, counters[id]); });
+        }
+        workerLoop(0, counters[0]);
+        for (auto& thread : threads) thread.join();
+
+        for (const auto& c : counters) {
+            result.totalBytes += c.bytes;
+            result.files += c.files;
+            result.directories += c.directories;
+            result.errors += c.errors;
+        }
+
+        if (m_options.subtreeDepth > 0) {
+            // Children were created after their parents, so a reverse pass rolls totals up
+            for (auto it = m_nodes.rbegin(); it != m_nodes.rend(); ++it) {
+                if (it->parent) {
+                    it->parent->bytes += it->bytes.load();
+                    it->parent->files += it->files.load();
+                }
+            }
+            result.subtrees.reserve(m_nodes.size());
+            for (const auto& node : m_nodes) {
+                result.subtrees.push_back({node.relativePath, node.depth, node.bytes.load(), node.files.load()});
+            }
+            std::sort(result.subtrees.begin(), result.subtrees.end(),
+                [](const auto& a, const auto& b) { return a.relativePath < b.relativePath; });
+        }
+        return result;
+    }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<WorkItem> queue;
+    };
+
+    void push(unsigned id, WorkItem item) {
+        m_pending++;
+        {
+            std::lock_guard<std::mutex> lock(m_workers[id]->mutex);
+            m_workers[id]->queue.push_back(std::move(item));
+        }
+        m_queued++;
+        if (m_sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_wake.notify_one();
+        }
+    }
+
+    bool pop(unsigned id, WorkItem& out) {
+        {
+            auto& own = *m_workers[id];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.queue.empty()) {
+                out = std::move(own.queue.back());
+                own.queue.pop_back();
+                m_queued--;
+                return true;
+            }
+        }
+        for (size_t k = 1; k < m_workers.size(); ++k) {
+            auto& victim = *m_workers[(id + k) % m_workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.queue.empty()) {
+                out = std::move(victim.queue.front());
+                victim.queue.pop_front();
+                m_queued--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned id, Counters& counters) {
+        std::string pathBuffer;
+#if defined(__linux__)
+        std::unique_ptr<char[]> dirents(new char[kDirentBufferSize]);
+#endif
+        while (true) {
+            WorkItem item;
+            if (pop(id, item)) {
+#if defined(__linux__)
+                processDirectory(id, item, counters, pathBuffer, dirents.get());
+#else
+                processDirectory(id, item, counters, pathBuffer);
+#endif
+                if (--m_pending == 0) {
+                    std::lock_guard<std::mutex> lock(m_sleepMutex);
+                    m_wake.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepers++;
+            m_wake.wait(lock, [this] { return m_queued.load() > 0 || m_pending.load() == 0; });
+            m_sleepers--;
+            if (m_pending.load() == 0) return;
+        }
+    }
+
+    /**
+     * Apply the filter, count, visit and (for directories) queue one entry
+     */
+    void report(unsigned id, const WorkItem& parent, const Entry& entry, Counters& counters,
+                uint64_t& dirBytes, uint64_t& dirFiles) {
+        if (m_options.filter && !m_options.filter(entry)) return;
+
+        if (entry.type == Type::File) {
+            dirBytes += entry.size;
+            dirFiles++;
+        } else if (entry.type == Type::Directory) {
+            counters.directories++;
+        }
+
+        if (m_visit) m_visit(entry);
+
+        if (entry.type == Type::Directory) {
+            Node* node = parent.node;
+            if (entry.depth <= m_options.subtreeDepth) {
+                std::lock_guard<std::mutex> lock(m_nodeMutex);
+                node = &m_nodes.emplace_back(std::string(entry.relativePath), entry.depth, parent.node);
+            }
+            push(id, WorkItem{std::string(entry.path), entry.depth, node});
+        }
+    }
+
+#if defined(__linux__)
+    void processDirectory(unsigned id, const WorkItem& item, Counters& counters,
+                          std::string& pathBuffer, char* buffer) {
+        int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC | (item.depth > 0 ? O_NOFOLLOW : 0);
+        int fd = ::open(item.path.c_str(), flags);
+        if (fd < 0) {
+            counters.errors++;
+            return;
+        }
+
+        pathBuffer.assign(item.path);
+        if (pathBuffer.back() != '/') pathBuffer += '/';
+        const size_t base = pathBuffer.size();
+        const bool statDirectories = static_cast<bool>(m_visit) || static_cast<bool>(m_options.filter);
+        uint64_t dirBytes = 0;
+        uint64_t dirFiles = 0;
+
+        while (true) {
+            long n = syscall(SYS_getdents64, fd, buffer, kDirentBufferSize);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                counters.errors++;
+                break;
+            }
+            if (n == 0) break;
+
+            for (long offset = 0; offset < n;) {
+                auto* d = reinterpret_cast<LinuxDirent64*>(buffer + offset);
+                offset += d->d_reclen;
+
+                const char* name = reinterpret_cast<const char*>(d) + kDirentNameOffset;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+
+                Entry entry;
+                entry.depth = item.depth + 1;
+                switch (d->d_type) {
+                    case DT_REG: entry.type = Type::File; break;
+                    case DT_DIR: entry.type = Type::Directory; break;
+                    case DT_LNK: entry.type = Type::Symlink; break;
+                    case DT_UNKNOWN: break;
+                    default: entry.type = Type::Other; break;
+                }
+
+                if (d->d_type == DT_UNKNOWN || entry.type != Type::Directory || statDirectories) {
+                    struct stat st {};
+                    if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+                        entry.type = typeFromMode(st.st_mode);
+                        entry.size = entry.type == Type::File ? static_cast<uint64_t>(st.st_size) : 0;
+                        entry.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+                        entry.mode = static_cast<uint32_t>(st.st_mode & 07777);
+                    } else if (d->d_type == DT_UNKNOWN) {
+                        continue;   // Vanished between listing and stat
+                    }
+                }
+
+                pathBuffer.resize(base);
+                pathBuffer += name;
+                entry.path = pathBuffer;
+                entry.relativePath = std::string_view(pathBuffer).substr(m_relativeStart);
+                entry.name = std::string_view(pathBuffer).substr(base);
+                report(id, item, entry, counters, dirBytes, dirFiles);
+            }
+        }
+        ::close(fd);
+
+        counters.bytes += dirBytes;
+        counters.files += dirFiles;
+        if (dirFiles > 0) {
+            item.node->bytes += dirBytes;
+            item.node->files += dirFiles;
+        }
+    }
+#else
+    void processDirectory(unsigned id, const WorkItem& item, Counters& counters, std::string& pathBuffer) {
+        std::error_code ec;
+        fs::directory_iterator it(fs::path(item.path), ec);
+        if (ec) {
+            counters.errors++;
+            return;
+        }
+
+        pathBuffer.assign(item.path);
+        if (pathBuffer.back() != '/') pathBuffer += '/';
+        const size_t base = pathBuffer.size();
+        uint64_t dirBytes = 0;
+        uint64_t dirFiles = 0;
+
+        for (; it != fs::directory_iterator(); it.increment(ec)) {
+            if (ec) {
+                counters.errors++;
+                break;
+            }
+
+            Entry entry;
+            entry.depth = item.depth + 1;
+            auto status = it->symlink_status(ec);
+            if (ec) continue;
+            switch (status.type()) {
+                case fs::file_type::regular: entry.type = Type::File; break;
+                case fs::file_type::directory: entry.type = Type::Directory; break;
+                case fs::file_type::symlink: entry.type = Type::Symlink; break;
+                default: entry.type = Type::Other; break;
+            }
+            if (entry.type == Type::File) {
+                entry.size = it->file_size(ec);
+            }
+            auto mtime = it->last_write_time(ec);
+            if (!ec) {
+                auto sys = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    mtime - fs::file_time_type::clock::now());
+                entry.mtimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(sys.time_since_epoch()).count();
+            }
+            entry.mode = static_cast<uint32_t>(status.permissions()) & 07777;
+
+            pathBuffer.resize(base);
+            pathBuffer += it->path().filename().generic_string();
+            entry.path = pathBuffer;
+            entry.relativePath = std::string_view(pathBuffer).substr(m_relativeStart);
+            entry.name = std::string_view(pathBuffer).substr(base);
+            report(id, item, entry, counters, dirBytes, dirFiles);
+        }
+
+        counters.bytes += dirBytes;
+        counters.files += dirFiles;
+        if (dirFiles > 0) {
+            item.node->bytes += dirBytes;
+            item.node->files += dirFiles;
+        }
+    }
+#endif
+
+    std::string m_root;
+    size_t m_relativeStart{0};
+    const DirectoryWalker::Options& m_options;
+    const DirectoryWalker::Visitor& m_visit;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<size_t> m_pending{0};    // Directories queued or being processed
+    std::atomic<size_t> m_queued{0};     // Directories waiting in a deque
+    std::atomic<unsigned> m_sleepers{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+
+    std::mutex m_nodeMutex;
+    std::deque<Node> m_nodes;            // Stable addresses; WorkItems point into it
+};
+
+} // namespace
+
+DirectoryWalker::Result DirectoryWalker::walk(const fs::path& root, const Options& options, const Visitor& visit) {
+    Walk walk(root, options, visit);
+    return walk.run();
+}
+
+} // namespace konami::utils
@@ -0,0 +1,100 @@
+// Konami Client - Directory Walker
+// Parallel directory tree traversal with per-subtree sizes
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace konami::utils {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Parallel recursive directory walker
+ *
+ * Each directory is a work item on a set of work-stealing workers: a
+ * worker lists its directory, pushes subdirectories onto its own deque
+ * and idle workers steal the oldest (usually largest) subtrees from the
+ * others. On Linux directories are read with getdents64 relative to an
+ * open directory fd and stat'd with fstatat, so no full path is resolved
+ * per entry; elsewhere std::filesystem is used with the same scheduling.
+ *
+ * Symlinks are reported but never followed. Unreadable directories are
+ * counted and skipped.
+ */
+class DirectoryWalker {
+public:
+    enum class Type { File, Directory, Symlink, Other };
+
+    /**
+     * One entry below the root. Views are only valid during the callback.
+     */
+    struct Entry {
+        std::string_view path;           // Full path
+        std::string_view relativePath;   // Relative to the root, '/'-separated
+        std::string_view name;           // Final component
+        Type type{Type::Other};
+        uint64_t size{0};                // Bytes (regular files)
+        int64_t mtimeNs{0};              // Modification time, ns since the Unix epoch
+        uint32_t mode{0};                // POSIX permission bits (0 where unavailable)
+        int depth{1};                    // 1 = direct child of the root
+
+        fs::path fullPath() const { return fs::path(std::string(path)); }
+    };
+
+    /**
+     * Entry filter: return false to skip an entry (a skipped directory is not descended)
+     */
+    using Filter = std::function<bool(const Entry&)>;
+
+    /**
+     * Entry callback. Called concurrently from worker threads; a directory is
+     * always reported before anything inside it.
+     */
+    using Visitor = std::function<void(const Entry&)>;
+
+    struct Options {
+        unsigned threads{0};           // 0 = hardware concurrency
+        int subtreeDepth{0};           // Report totals for directories up to this depth (0 = none)
+        Filter filter;
+    };
+
+    /**
+     * Accumulated size of one directory and everything below it
+     */
+    struct SubtreeSize {
+        std::string relativePath;      // '/'-separated; empty for the root
+        int depth{0};
+        uint64_t bytes{0};
+        uint64_t files{0};
+    };
+
+    struct Result {
+        uint64_t totalBytes{0};
+        uint64_t files{0};
+        uint64_t directories{0};
+        uint64_t errors{0};                    // Directories that could not be read
+        std::vector<SubtreeSize> subtrees;     // Sorted by path, root first
+    };
+
+    /**
+     * Walk a directory tree
+     * @param root Directory to walk (not itself reported to the visitor)
+     * @param options Thread count, subtree reporting and filter
+     * @param visit Optional per-entry callback
+     * @return Totals, plus subtree sizes when requested
+     */
+    static Result walk(const fs::path& root, const Options& options, const Visitor& visit = {});
+
+    /**
+     * Walk with default options
+     */
+    static Result walk(const fs::path& root) { return walk(root, Options{}); }
+};
+
+} // namespace konami::utils
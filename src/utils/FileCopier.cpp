@@ -0,0 +1,340 @@
+/**
+ * FileCopier.cpp
+ *
+ * File copies that keep the data in the kernel where the platform allows,
+ * and directory copies spread across threads. On Linux the fallback chain
+ * is FICLONE -> copy_file_range -> sendfile -> read/write; each step is
+ * dropped for the rest of the file as soon as the kernel rejects it
+ * (cross-filesystem, unsupported filesystem, old kernel).
+ */
+
+#include "FileCopier.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace konami::utils {
+
+namespace {
+
+constexpr size_t kCopyChunk = 8 * 1024 * 1024;
+
+void setError(std::string* error, std::string message) {
+    if (error) *error = std::move(message);
+}
+
+#if defined(__linux__)
+std::string errnoMessage(const char* what, const fs::path& path) {
+    return std::string(what) + " " + path.string() + ": " + std::strerror(errno);
+}
+
+bool kernelCopyUnsupported(int err) {
+    return err == EXDEV || err == ENOSYS || err == EINVAL || err == EOPNOTSUPP || err == EPERM || err == EBADF;
+}
+
+/**
+ * Copy from the current offset of `in` to `out`. `size` is the stat size;
+ * 0 means unknown (procfs and friends), which is read until EOF.
+ */
+bool copyData(int in, int out, uint64_t size, const std::function<void(uint64_t)>& onBytes) {
+    bool useRange = size > 0;
+    bool useSendfile = size > 0;
+    uint64_t copied = 0;
+
+    while (useRange || useSendfile) {
+        if (copied >= size) return true;
+        size_t want = static_cast<size_t>(std::min<uint64_t>(kCopyChunk, size - copied));
+        ssize_t n = useRange
+            ? ::copy_file_range(in, nullptr, out, nullptr, want, 0)
+            : ::sendfile(out, in, nullptr, want);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (copied == 0 && kernelCopyUnsupported(errno)) {
+                if (useRange) useRange = false;
+                else useSendfile = false;
+                continue;
+            }
+            return false;
+        }
+        if (n == 0) return true;  // File shrank while copying
+        copied += static_cast<uint64_t>(n);
+        if (onBytes) onBytes(static_cast<uint64_t>(n));
+    }
+
+    std::vector<char> buffer(std::min<size_t>(kCopyChunk, 1024 * 1024));
+    for (;;) {
+        ssize_t n = ::read(in, buffer.data(), buffer.size());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) return true;
+        for (ssize_t written = 0; written < n; ) {
+            ssize_t w = ::write(out, buffer.data() + written, static_cast<size_t>(n - written));
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            written += w;
+        }
+        if (onBytes) onBytes(static_cast<uint64_t>(n));
+    }
+}
+#endif
+
+std::chrono::file_clock::time_point fileTimeFromUnixNs(int64_t ns) {
+    return std::chrono::file_clock::from_sys(
+        std::chrono::sys_time<std::chrono::nanoseconds>(std::chrono::nanoseconds(ns)));
+}
+
+} // namespace
+
+bool FileCopier::copyFile(const fs::path& source, const fs::path& destination,
+                          bool overwrite, bool preserveTimes, std::string* error) {
+    return copyFileImpl(source, destination, overwrite, preserveTimes, {}, error);
+}
+
+#if defined(__linux__)
+
+bool FileCopier::copyFileImpl(const fs::path& source, const fs::path& destination,
+                              bool overwrite, bool preserveTimes,
+                              const ByteCallback& onBytes, std::string* error) {
+    int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        setError(error, errnoMessage("Cannot open", source));
+        return false;
+    }
+
+    struct stat sourceStat{};
+    if (::fstat(in, &sourceStat) != 0 || !S_ISREG(sourceStat.st_mode)) {
+        setError(error, "Not a regular file: " + source.string());
+        ::close(in);
+        return false;
+    }
+
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (overwrite ? 0 : O_EXCL);
+    int out = ::open(destination.c_str(), flags, sourceStat.st_mode & 0777);
+    if (out < 0) {
+        setError(error, errnoMessage("Cannot create", destination));
+        ::close(in);
+        return false;
+    }
+
+    // Truncate only once we know the destination is not the source itself
+    struct stat destinationStat{};
+    if (::fstat(out, &destinationStat) == 0 &&
+        destinationStat.st_dev == sourceStat.st_dev && destinationStat.st_ino == sourceStat.st_ino) {
+        setError(error, "Source and destination are the same file: " + source.string());
+        ::close(out);
+        ::close(in);
+        return false;
+    }
+
+    bool ok = destinationStat.st_size == 0 || ::ftruncate(out, 0) == 0;
+    if (ok) {
+        bool cloned = false;
+#ifdef FICLONE
+        cloned = sourceStat.st_size > 0 && ::ioctl(out, FICLONE, in) == 0;
+        if (cloned && onBytes) onBytes(static_cast<uint64_t>(sourceStat.st_size));
+#endif
+        ok = cloned || copyData(in, out, static_cast<uint64_t>(sourceStat.st_size), onBytes);
+        if (!ok) setError(error, errnoMessage("Failed to copy", source));
+    } else {
+        setError(error, errnoMessage("Cannot truncate", destination));
+    }
+
+    if (ok && preserveTimes) {
+        struct timespec times[2] = {sourceStat.st_atim, sourceStat.st_mtim};
+        ::futimens(out, times);
+    }
+
+    ::close(in);
+    if (::close(out) != 0 && ok) {
+        setError(error, errnoMessage("Failed to write", destination));
+        ok = false;
+    }
+    if (!ok) ::unlink(destination.c_str());
+    return ok;
+}
+
+#else
+
+bool FileCopier::copyFileImpl(const fs::path& source, const fs::path& destination,
+                              bool overwrite, bool preserveTimes,
+                              const ByteCallback& onBytes, std::string* error) {
+    std::error_code ec;
+    auto options = overwrite ? fs::copy_options::overwrite_existing : fs::copy_options::none;
+    if (!fs::copy_file(source, destination, options, ec)) {
+        setError(error, ec ? ec.message() : "Destination exists: " + destination.string());
+        return false;
+    }
+    if (preserveTimes) {
+        auto time = fs::last_write_time(source, ec);
+        if (!ec) fs::last_write_time(destination, time, ec);
+    }
+    if (onBytes) onBytes(fs::file_size(destination, ec));
+    return true;
+}
+
+#endif
+
+FileCopier::Result FileCopier::copyDirectory(const fs::path& source, const fs::path& destination,
+                                             const Options& options) {
+    using Walker = DirectoryWalker;
+
+    struct PendingFile {
+        std::string relativePath;
+        uint64_t size;
+    };
+    struct PendingDirectory {
+        fs::path path;
+        int depth;
+        int64_t mtimeNs;
+    };
+
+    Result result;
+    std::mutex mutex;
+    auto fail = [&](std::string message) {
+        std::lock_guard lock(mutex);
+        if (result.errors++ == 0) result.firstError = std::move(message);
+    };
+
+    std::error_code ec;
+    fs::create_directories(destination, ec);
+    if (ec) {
+        fail("Cannot create " + destination.string() + ": " + ec.message());
+        return result;
+    }
+
+    // Pass 1: the walker reports a directory before its contents, so the
+    // destination tree can be created as it is discovered
+    std::vector<PendingFile> files;
+    std::vector<PendingDirectory> directories;
+    std::vector<std::string> symlinks;
+
+    Walker::Options walkOptions;
+    walkOptions.threads = options.threads;
+    walkOptions.filter = options.filter;
+    auto walked = Walker::walk(source, walkOptions, [&](const Walker::Entry& entry) {
+        fs::path target = destination / fs::path(std::string(entry.relativePath));
+        switch (entry.type) {
+            case Walker::Type::Directory: {
+                std::error_code createError;
+                fs::create_directories(target, createError);
+                if (createError) {
+                    fail("Cannot create " + target.string() + ": " + createError.message());
+                    return;
+                }
+                std::lock_guard lock(mutex);
+                directories.push_back({std::move(target), entry.depth, entry.mtimeNs});
+                break;
+            }
+            case Walker::Type::File: {
+                std::lock_guard lock(mutex);
+                files.push_back({std::string(entry.relativePath), entry.size});
+                break;
+            }
+            case Walker::Type::Symlink: {
+                std::lock_guard lock(mutex);
+                symlinks.emplace_back(entry.relativePath);
+                break;
+            }
+            case Walker::Type::Other:
+                break;
+        }
+    });
+    if (walked.errors > 0) fail("Some directories under " + source.string() + " could not be read");
+
+    // Pass 2: copy files, largest first so the tail is short
+    std::sort(files.begin(), files.end(),
+        [](const PendingFile& a, const PendingFile& b) { return a.size > b.size; });
+
+    Progress progress;
+    progress.totalFiles = files.size();
+    for (const auto& file : files) progress.totalBytes += file.size;
+
+    std::mutex progressMutex;
+    auto report = [&](uint64_t bytes, uint64_t filesDone) {
+        std::lock_guard lock(progressMutex);
+        progress.bytesCopied += bytes;
+        progress.filesCopied += filesDone;
+        if (options.onProgress) options.onProgress(progress);
+    };
+
+    std::atomic<size_t> next{0};
+    std::atomic<uint64_t> copiedBytes{0};
+    std::atomic<uint64_t> copiedFiles{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < files.size(); i = next++) {
+            const auto& file = files[i];
+            fs::path from = source / fs::path(file.relativePath);
+            fs::path to = destination / fs::path(file.relativePath);
+            std::string error;
+            uint64_t fileBytes = 0;
+            bool ok = copyFileImpl(from, to, options.overwrite, options.preserveTimes,
+                [&](uint64_t bytes) {
+                    fileBytes += bytes;
+                    report(bytes, 0);
+                }, &error);
+            if (ok) {
+                copiedBytes += fileBytes;
+                ++copiedFiles;
+                report(0, 1);
+            } else {
+                fail(error);
+            }
+        }
+    };
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, files.size()));
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    for (const auto& link : symlinks) {
+        fs::path from = source / fs::path(link);
+        fs::path to = destination / fs::path(link);
+        std::error_code linkError;
+        auto target = fs::read_symlink(from, linkError);
+        if (!linkError && options.overwrite && fs::is_symlink(fs::symlink_status(to))) {
+            fs::remove(to, linkError);
+        }
+        if (!linkError) fs::create_symlink(target, to, linkError);
+        if (linkError) fail("Cannot copy link " + from.string() + ": " + linkError.message());
+    }
+
+    // Directory times last, deepest first, since creating children touches them
+    if (options.preserveTimes) {
+        std::sort(directories.begin(), directories.end(),
+            [](const PendingDirectory& a, const PendingDirectory& b) { return a.depth > b.depth; });
+        for (const auto& directory : directories) {
+            std::error_code timeError;
+            fs::last_write_time(directory.path, fileTimeFromUnixNs(directory.mtimeNs), timeError);
+        }
+        auto rootTime = fs::last_write_time(source, ec);
+        if (!ec) fs::last_write_time(destination, rootTime, ec);
+    }
+
+    result.bytes = copiedBytes;
+    result.files = copiedFiles;
+    return result;
+}
+
+} // namespace konami::utils
@@ -0,0 +1,96 @@
+// Konami Client - File Copier
+// Kernel-side file copies and parallel directory copies with progress
+
+#pragma once
+
+#include "DirectoryWalker.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+namespace konami::utils {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief File and directory copy engine
+ *
+ * On Linux a file is first cloned (FICLONE reflink on btrfs/XFS, which
+ * shares extents and costs nothing), then copied in-kernel with
+ * copy_file_range, then sendfile, and only then through a user-space
+ * buffer. Directory copies walk the source with DirectoryWalker and copy
+ * files on several threads, largest first. Modification times are kept
+ * on files and directories; symlinks are recreated, not followed.
+ */
+class FileCopier {
+public:
+    struct Progress {
+        uint64_t bytesCopied{0};
+        uint64_t totalBytes{0};
+        uint64_t filesCopied{0};
+        uint64_t totalFiles{0};
+    };
+
+    /**
+     * Progress callback. Serialized, but may run on any copy thread.
+     */
+    using ProgressCallback = std::function<void(const Progress&)>;
+
+    struct Options {
+        bool overwrite{true};              // Replace existing files
+        bool preserveTimes{true};          // Copy modification times
+        unsigned threads{0};               // 0 = hardware concurrency
+        DirectoryWalker::Filter filter;    // Source entries to skip (relative to the source root)
+        ProgressCallback onProgress;
+    };
+
+    struct Result {
+        uint64_t bytes{0};
+        uint64_t files{0};
+        uint64_t errors{0};
+        std::string firstError;
+
+        bool ok() const { return errors == 0; }
+    };
+
+    /**
+     * Copy one file
+     * @param source Regular file to copy
+     * @param destination Target path (parent must exist)
+     * @param overwrite Replace an existing destination
+     * @param preserveTimes Copy the modification time
+     * @param error Optional error message
+     * @return true if copied
+     */
+    static bool copyFile(const fs::path& source, const fs::path& destination,
+                         bool overwrite = true, bool preserveTimes = true,
+                         std::string* error = nullptr);
+
+    /**
+     * Copy a directory tree into a directory (created if missing)
+     * @param source Directory to copy
+     * @param destination Target directory
+     * @param options Overwrite, times, threads, filter and progress
+     * @return Bytes and files copied, and failures
+     */
+    static Result copyDirectory(const fs::path& source, const fs::path& destination,
+                                const Options& options);
+
+    /**
+     * Copy a directory tree with default options
+     */
+    static Result copyDirectory(const fs::path& source, const fs::path& destination) {
+        return copyDirectory(source, destination, Options{});
+    }
+
+private:
+    using ByteCallback = std::function<void(uint64_t)>;
+
+    static bool copyFileImpl(const fs::path& source, const fs::path& destination,
+                             bool overwrite, bool preserveTimes,
+                             const ByteCallback& onBytes, std::string* error);
+};
+
+} // namespace konami::utils
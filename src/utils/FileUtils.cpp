@@ -7,11 +7,16 @@
 #include "FileUtils.hpp"
 #include "PathUtils.hpp"
 #include "HashUtils.hpp"
+#include "ZipArchive.hpp"
+#include "DirectoryWalker.hpp"
+#include "FileCopier.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <random>
 #include <cstdlib>
+#include <cerrno>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -74,12 +79,7 @@ std::vector<fs::path> FileUtils::listDirectories(const fs::path& path) {
 }
 
 int64_t FileUtils::getDirectorySize(const fs::path& path) {
-    int64_t size = 0;
-    if (!fs::exists(path)) return 0;
-    for (const auto& e : fs::recursive_directory_iterator(path)) {
-        if (e.is_regular_file()) size += static_cast<int64_t>(e.file_size());
-    }
-    return size;
+    return static_cast<int64_t>(DirectoryWalker::walk(path).totalBytes);
 }
 
 // -- File operations --
@@ -87,9 +87,7 @@ int64_t FileUtils::getDirectorySize(const fs::path& path) {
 bool FileUtils::fileExists(const fs::path& path) { return fs::is_regular_file(path); }
 
 bool FileUtils::copyFile(const fs::path& source, const fs::path& destination, bool overwrite) {
-    std::error_code ec;
-    auto opts = overwrite ? fs::copy_options::overwrite_existing : fs::copy_options::none;
-    return fs::copy_file(source, destination, opts, ec);
+    return FileCopier::copyFile(source, destination, overwrite);
 }
 
 bool FileUtils::moveFile(const fs::path& source, const fs::path& destination) {
@@ -149,6 +147,83 @@ bool FileUtils::appendFile(const fs::path& path, const std::string& content) {
     return true;
 }
 
+bool FileUtils::writeFileAtomic(const fs::path& path, const std::string& content) {
+    // Write a sibling temp file, flush it to disk, then rename over the target
+    // so readers (and a crash) only ever see the old or the new contents.
+    createDirectories(path.parent_path());
+    fs::path tmp = path;
+    tmp += ".tmp";
+
+#ifdef _WIN32
+    HANDLE h = CreateFileW(tmp.wstring().c_str(), GENERIC_WRITE, 0, nullptr,
+                           CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) return false;
+    DWORD written = 0;
+    bool ok = WriteFile(h, content.data(), static_cast<DWORD>(content.size()), &written, nullptr)
+              && written == content.size()
+              && FlushFileBuffers(h);
+    CloseHandle(h);
+    if (!ok || !MoveFileExW(tmp.wstring().c_str(), path.wstring().c_str(),
+                            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileW(tmp.wstring().c_str());
+        return false;
+    }
+    return true;
+#else
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    size_t offset = 0;
+    while (offset < content.size()) {
+        ssize_t n = write(fd, content.data() + offset, content.size() - offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            close(fd); unlink(tmp.c_str());
+            return false;
+        }
+        offset += static_cast<size_t>(n);
+    }
+    if (fsync(fd) != 0) { close(fd); unlink(tmp.c_str()); return false; }
+    close(fd);
+    if (rename(tmp.c_str(), path.c_str()) != 0) { unlink(tmp.c_str()); return false; }
+
+    // Persist the directory entry as well
+    int dirFd = open(path.parent_path().empty() ? "." : path.parent_path().c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) { fsync(dirFd); close(dirFd); }
+    return true;
+#endif
+}
+
+bool FileUtils::appendFileDurable(const fs::path& path, const std::string& content) {
+    createDirectories(path.parent_path());
+#ifdef _WIN32
+    HANDLE h = CreateFileW(path.wstring().c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr,
+                           OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) return false;
+    DWORD written = 0;
+    bool ok = WriteFile(h, content.data(), static_cast<DWORD>(content.size()), &written, nullptr)
+              && written == content.size()
+              && FlushFileBuffers(h);
+    CloseHandle(h);
+    return ok;
+#else
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    size_t offset = 0;
+    while (offset < content.size()) {
+        ssize_t n = write(fd, content.data() + offset, content.size() - offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            close(fd);
+            return false;
+        }
+        offset += static_cast<size_t>(n);
+    }
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+#endif
+}
+
 std::vector<std::string> FileUtils::readLines(const fs::path& path) {
     std::vector<std::string> lines;
     std::ifstream file(path);
@@ -166,18 +241,94 @@ std::string FileUtils::calculateMD5(const fs::path& /*path*/) { return ""; /* TO
 bool FileUtils::verifySHA1(const fs::path& path, const std::string& expectedHash) { return calculateSHA1(path) == expectedHash; }
 bool FileUtils::verifySHA256(const fs::path& path, const std::string& expectedHash) { return calculateSHA256(path) == expectedHash; }
 
-// -- Archive operations (stubs) --
+// -- Archive operations --
+
+namespace {
 
-bool FileUtils::extractZip(const fs::path& /*zipPath*/, const fs::path& /*destination*/) { return false; /* TODO: Use minizip */ }
-bool FileUtils::createZip(const fs::path& /*sourcePath*/, const fs::path& /*zipPath*/) { return false; }
-std::vector<std::string> FileUtils::listZipContents(const fs::path& /*zipPath*/) { return {}; }
-bool FileUtils::extractFileFromZip(const fs::path& /*zipPath*/, const std::string& /*fileName*/, const fs::path& /*destination*/) { return false; }
+// An existing directory destination receives the entry under its own file name
+fs::path entryDestination(const std::string& entryName, const fs::path& destination) {
+    std::error_code ec;
+    if (fs::is_directory(destination, ec)) {
+        return destination / fs::path(entryName).filename();
+    }
+    return destination;
+}
+
+} // namespace
+
+bool FileUtils::extractZip(const fs::path& zipPath, const fs::path& destination) {
+    ZipReader reader;
+    return reader.open(zipPath) && reader.extractAll(destination);
+}
+
+bool FileUtils::createZip(const fs::path& sourcePath, const fs::path& zipPath) {
+    std::error_code ec;
+    std::vector<ZipWriter::Source> sources;
+    if (fs::is_directory(sourcePath, ec)) {
+        sources = ZipWriter::collect(sourcePath);
+    } else if (fs::is_regular_file(sourcePath, ec)) {
+        sources.push_back({sourcePath, sourcePath.filename().string()});
+    } else {
+        return false;
+    }
+    return ZipWriter::write(zipPath, sources, ZipWriter::Options{});
+}
+
+std::vector<std::string> FileUtils::listZipContents(const fs::path& zipPath) {
+    std::vector<std::string> names;
+    ZipReader reader;
+    if (!reader.open(zipPath)) return names;
+
+    names.reserve(reader.entries().size());
+    for (const auto& entry : reader.entries()) {
+        names.emplace_back(entry.name);
+    }
+    return names;
+}
+
+bool FileUtils::extractFileFromZip(const fs::path& zipPath, const std::string& fileName, const fs::path& destination) {
+    ZipReader reader;
+    if (!reader.open(zipPath)) return false;
+
+    const ZipEntry* entry = reader.find(fileName);
+    if (!entry || entry->isDirectory()) return false;
+    return reader.extract(*entry, entryDestination(fileName, destination));
+}
+
+// -- JAR operations --
 
-// -- JAR operations (stubs) --
+std::optional<std::string> FileUtils::readJarManifest(const fs::path& jarPath) {
+    ZipReader reader;
+    if (!reader.open(jarPath)) return std::nullopt;
 
-std::optional<std::string> FileUtils::readJarManifest(const fs::path& /*jarPath*/) { return std::nullopt; }
-std::vector<std::string> FileUtils::getJarClasses(const fs::path& /*jarPath*/) { return {}; }
-bool FileUtils::extractFromJar(const fs::path& /*jarPath*/, const std::string& /*entryPath*/, const fs::path& /*destination*/) { return false; }
+    const ZipEntry* entry = reader.find("META-INF/MANIFEST.MF");
+    if (!entry) return std::nullopt;
+    return reader.read(*entry);
+}
+
+std::vector<std::string> FileUtils::getJarClasses(const fs::path& jarPath) {
+    std::vector<std::string> classes;
+    ZipReader reader;
+    if (!reader.open(jarPath)) return classes;
+
+    constexpr std::string_view suffix = ".class";
+    for (const auto& entry : reader.entries()) {
+        std::string_view name = entry.name;
+        if (name.size() <= suffix.size() || !name.ends_with(suffix)) continue;
+        // Multi-release variants duplicate the base classes
+        if (name.starts_with("META-INF/")) continue;
+        if (name.ends_with("module-info.class") || name.ends_with("package-info.class")) continue;
+
+        std::string className(name.substr(0, name.size() - suffix.size()));
+        std::replace(className.begin(), className.end(), '/', '.');
+        classes.push_back(std::move(className));
+    }
+    return classes;
+}
+
+bool FileUtils::extractFromJar(const fs::path& jarPath, const std::string& entryPath, const fs::path& destination) {
+    return extractFileFromZip(jarPath, entryPath, destination);
+}
 
 // -- Temp files --
 
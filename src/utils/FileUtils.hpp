@@ -58,6 +58,8 @@ public:
     static bool writeFile(const fs::path& path, const std::string& content);
     static bool writeBinaryFile(const fs::path& path, const std::vector<uint8_t>& data);
     static bool appendFile(const fs::path& path, const std::string& content);
+    static bool writeFileAtomic(const fs::path& path, const std::string& content);
+    static bool appendFileDurable(const fs::path& path, const std::string& content);
     static std::vector<std::string> readLines(const fs::path& path);
     
     // Hash operations
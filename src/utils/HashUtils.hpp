@@ -4,14 +4,16 @@
 #include <vector>
 #include <fstream>
 #include <openssl/evp.h>
-#include <sstream>
-#include <iomanip>
+
+#include "Codec.hpp"
+#include "../core/Profiler.hpp"
 
 namespace konami::utils {
 
 class HashUtils {
 public:
     static std::string sha1File(const std::string& filePath) {
+        KONAMI_ZONE_NAMED("HashUtils::sha1File");
         std::ifstream file(filePath, std::ios::binary);
         if (!file.is_open()) return "";
 
@@ -33,14 +35,11 @@ public:
         EVP_DigestFinal_ex(ctx, hash, &hashLen);
         EVP_MD_CTX_free(ctx);
 
-        std::ostringstream oss;
-        for (unsigned int i = 0; i < hashLen; ++i) {
-            oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(hash[i]);
-        }
-        return oss.str();
+        return toHex(hash, hashLen);
     }
 
     static std::string sha256File(const std::string& filePath) {
+        KONAMI_ZONE_NAMED("HashUtils::sha256File");
         std::ifstream file(filePath, std::ios::binary);
         if (!file.is_open()) return "";
 
@@ -62,14 +61,11 @@ public:
         EVP_DigestFinal_ex(ctx, hash, &hashLen);
         EVP_MD_CTX_free(ctx);
 
-        std::ostringstream oss;
-        for (unsigned int i = 0; i < hashLen; ++i) {
-            oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(hash[i]);
-        }
-        return oss.str();
+        return toHex(hash, hashLen);
     }
 
     static std::string sha1String(const std::string& data) {
+        KONAMI_ZONE_NAMED("HashUtils::sha1String");
         EVP_MD_CTX* ctx = EVP_MD_CTX_new();
         if (!ctx) return "";
 
@@ -84,14 +80,11 @@ public:
         }
         EVP_MD_CTX_free(ctx);
 
-        std::ostringstream oss;
-        for (unsigned int i = 0; i < hashLen; ++i) {
-            oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(hash[i]);
-        }
-        return oss.str();
+        return toHex(hash, hashLen);
     }
 
     static std::string sha256String(const std::string& data) {
+        KONAMI_ZONE_NAMED("HashUtils::sha256String");
         EVP_MD_CTX* ctx = EVP_MD_CTX_new();
         if (!ctx) return "";
 
@@ -106,11 +99,14 @@ public:
         }
         EVP_MD_CTX_free(ctx);
 
-        std::ostringstream oss;
-        for (unsigned int i = 0; i < hashLen; ++i) {
-            oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(hash[i]);
-        }
-        return oss.str();
+        return toHex(hash, hashLen);
+    }
+
+private:
+    static std::string toHex(const unsigned char* hash, unsigned int length) {
+        std::string hex(Codec::hexEncodedSize(length), '\0');
+        Codec::hexEncode(hash, length, hex.data());
+        return hex;
     }
 };
 
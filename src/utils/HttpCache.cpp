@@ -0,0 +1,644 @@
+/**
+ * HttpCache.cpp
+ *
+ * Private HTTP cache following RFC 9111.
+ * Keys are "<sha1(url)>_<auth tag>", which doubles as the disk file stem;
+ * invalidating a URL drops every key with its digest prefix.
+ */
+
+#include "HttpCache.hpp"
+#include "HashUtils.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+namespace konami::utils {
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+constexpr std::chrono::seconds kMaxHeuristicLifetime{24 * 60 * 60};
+
+std::string toLower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+}
+
+std::string trim(const std::string& str) {
+    size_t start = str.find_first_not_of(" \t");
+    if (start == std::string::npos) return {};
+    size_t end = str.find_last_not_of(" \t");
+    return str.substr(start, end - start + 1);
+}
+
+/**
+ * Case-insensitive header lookup; request headers come in caller spelling
+ */
+std::string findHeader(const std::map<std::string, std::string>& headers, const std::string& lowerName) {
+    for (const auto& [name, value] : headers) {
+        if (name.size() == lowerName.size() && toLower(name) == lowerName) return value;
+    }
+    return {};
+}
+
+std::string storedHeader(const CachedResponse& response, const std::string& lowerName) {
+    auto it = response.headers.find(lowerName);
+    return it != response.headers.end() ? it->second : std::string();
+}
+
+std::vector<std::string> splitList(const std::string& value) {
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = toLower(trim(item));
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+std::optional<Clock::time_point> parseHttpDate(const std::string& value) {
+    if (value.empty()) return std::nullopt;
+    time_t parsed = curl_getdate(value.c_str(), nullptr);
+    if (parsed < 0) return std::nullopt;
+    return Clock::from_time_t(parsed);
+}
+
+std::optional<int64_t> parseSeconds(const std::string& value) {
+    if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) return std::nullopt;
+    try {
+        return std::stoll(value);
+    } catch (...) {
+        // Overflowing delta-seconds means "effectively forever" (RFC 9111 1.2.2)
+        return static_cast<int64_t>(INT32_MAX);
+    }
+}
+
+bool isHeuristicallyCacheable(int status) {
+    switch (status) {
+        case 200: case 203: case 204: case 300: case 301: case 308:
+        case 404: case 405: case 410: case 414: case 501:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int64_t toMillis(Clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+}
+
+Clock::time_point fromMillis(int64_t ms) {
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds(ms)));
+}
+
+} // namespace
+
+size_t CachedResponse::cost() const {
+    size_t total = sizeof(CachedResponse) + url.size() + body.size();
+    for (const auto& [name, value] : headers) total += name.size() + value.size() + 64;
+    for (const auto& [name, value] : varyValues) total += name.size() + value.size() + 64;
+    return total;
+}
+
+// -- Construction --
+
+HttpCache::HttpCache(std::filesystem::path directory, size_t memoryBudget, size_t diskBudget)
+    : m_directory(std::move(directory))
+    , m_memoryBudget(memoryBudget)
+    , m_diskBudget(diskBudget)
+    , m_maxEntrySize(std::max(memoryBudget, diskBudget) / 8) {
+    if (!m_directory.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(m_directory, ec);
+        scanDisk();
+    }
+}
+
+HttpCache::~HttpCache() = default;
+
+void HttpCache::setPolicy(const std::string& urlPrefix, HttpCachePolicy policy) {
+    std::lock_guard<std::mutex> lock(m_policyMutex);
+    for (auto& [prefix, existing] : m_policies) {
+        if (prefix == urlPrefix) {
+            existing = policy;
+            return;
+        }
+    }
+    m_policies.emplace_back(urlPrefix, policy);
+}
+
+HttpCachePolicy HttpCache::policyFor(const std::string& url) const {
+    std::lock_guard<std::mutex> lock(m_policyMutex);
+    const HttpCachePolicy* best = nullptr;
+    size_t bestLength = 0;
+    for (const auto& [prefix, policy] : m_policies) {
+        if (prefix.size() >= bestLength && url.compare(0, prefix.size(), prefix) == 0) {
+            best = &policy;
+            bestLength = prefix.size();
+        }
+    }
+    return best ? *best : HttpCachePolicy{};
+}
+
+std::string HttpCache::makeKey(const std::string& url, const std::map<std::string, std::string>& requestHeaders) const {
+    std::string auth = findHeader(requestHeaders, "authorization");
+    std::string tag = auth.empty() ? "anon" : HashUtils::sha1String(auth).substr(0, 16);
+    return HashUtils::sha1String(url) + "_" + tag;
+}
+
+// -- Lookup / store --
+
+HttpCache::Lookup HttpCache::lookup(const std::string& url, const std::map<std::string, std::string>& requestHeaders) {
+    Lookup result;
+    result.url = url;
+    result.policy = policyFor(url);
+    if (result.policy.bypass) {
+        return result;
+    }
+
+    auto requestCc = parseCacheControl(findHeader(requestHeaders, "cache-control"));
+    bool requestNoCache = requestCc.count("no-cache") > 0;
+    if (requestCc.empty() && toLower(findHeader(requestHeaders, "pragma")).find("no-cache") != std::string::npos) {
+        requestNoCache = true;
+    }
+    result.noStore = requestCc.count("no-store") > 0;
+    result.onlyIfCached = requestCc.count("only-if-cached") > 0;
+    result.key = makeKey(url, requestHeaders);
+
+    auto entry = getMemory(result.key);
+    if (!entry) {
+        entry = readDisk(result.key);
+        if (entry) putMemory(result.key, entry);
+    }
+    if (!entry || entry->url != url || !varyMatches(*entry, requestHeaders)) {
+        return result;
+    }
+
+    auto responseCc = parseCacheControl(storedHeader(*entry, "cache-control"));
+    auto lifetime = freshnessLifetime(*entry, result.policy);
+    auto age = currentAge(*entry);
+
+    bool fresh = age < lifetime;
+    if (auto maxAge = requestCc.find("max-age"); maxAge != requestCc.end()) {
+        auto limit = parseSeconds(maxAge->second);
+        fresh = fresh && limit && age.count() <= *limit;
+    }
+    if (auto minFresh = requestCc.find("min-fresh"); minFresh != requestCc.end()) {
+        auto limit = parseSeconds(minFresh->second);
+        fresh = fresh && limit && (lifetime - age).count() >= *limit;
+    }
+
+    bool mustRevalidate = responseCc.count("must-revalidate") > 0;
+    if (!fresh && !mustRevalidate) {
+        if (auto maxStale = requestCc.find("max-stale"); maxStale != requestCc.end()) {
+            auto limit = parseSeconds(maxStale->second);
+            fresh = maxStale->second.empty() || (limit && (age - lifetime).count() <= *limit);
+        }
+    }
+
+    // no-cache: usable only after successful validation
+    bool responseNoCache = responseCc.count("no-cache") > 0 && !result.policy.ttl;
+    if (requestNoCache || responseNoCache) {
+        fresh = false;
+    }
+
+    result.entry = entry;
+    result.state = fresh ? Freshness::Fresh : Freshness::Stale;
+    result.staleAllowed = result.policy.serveStaleOnError && !mustRevalidate && !responseNoCache;
+    if (fresh) {
+        m_hits++;
+    }
+    return result;
+}
+
+bool HttpCache::store(const Lookup& lookup, const std::map<std::string, std::string>& requestHeaders,
+                      const HttpResponse& response,
+                      Clock::time_point requestTime, Clock::time_point responseTime) {
+    if (lookup.key.empty() || lookup.policy.bypass || lookup.noStore) {
+        return false;
+    }
+
+    int status = response.statusCode;
+    bool redirect = status == 302 || status == 307;
+    if (!isHeuristicallyCacheable(status) && !redirect) {
+        return false;
+    }
+    if (response.body.size() > m_maxEntrySize) {
+        return false;
+    }
+
+    auto cc = parseCacheControl([&] {
+        auto it = response.headers.find("cache-control");
+        return it != response.headers.end() ? it->second : std::string();
+    }());
+    if (cc.count("no-store")) {
+        return false;
+    }
+
+    auto entry = std::make_shared<CachedResponse>();
+    entry->statusCode = status;
+    entry->headers = response.headers;
+    // curl has already decoded the body: the stored entry is identity-encoded
+    entry->headers.erase("content-encoding");
+    entry->headers.erase("content-length");
+    entry->requestTime = requestTime;
+    entry->responseTime = responseTime;
+
+    auto varyList = splitList(storedHeader(*entry, "vary"));
+    for (const auto& name : varyList) {
+        if (name == "*") return false;
+        entry->varyValues[name] = findHeader(requestHeaders, name);
+    }
+
+    bool explicitFreshness = lookup.policy.ttl || cc.count("max-age") || entry->headers.count("expires");
+    if (redirect && !explicitFreshness) {
+        return false;
+    }
+
+    bool hasValidator = entry->headers.count("etag") || entry->headers.count("last-modified");
+    if (freshnessLifetime(*entry, lookup.policy).count() <= 0 && !hasValidator && !cc.count("no-cache")) {
+        // Nothing would ever make this entry servable
+        return false;
+    }
+
+    entry->url = lookup.url;
+    entry->body = response.body;
+
+    std::shared_ptr<const CachedResponse> stored = entry;
+    putMemory(lookup.key, stored);
+    if (!m_directory.empty()) writeDisk(lookup.key, *stored);
+    m_stores++;
+    return true;
+}
+
+std::shared_ptr<const CachedResponse> HttpCache::revalidated(const Lookup& lookup, const HttpResponse& notModified,
+                                                             Clock::time_point requestTime,
+                                                             Clock::time_point responseTime) {
+    if (!lookup.entry) {
+        return nullptr;
+    }
+
+    auto updated = std::make_shared<CachedResponse>(*lookup.entry);
+    for (const auto& [name, value] : notModified.headers) {
+        // RFC 9111 4.3.4: framing headers describe the 304, not the stored body
+        if (name == "content-length" || name == "transfer-encoding" || name == "content-encoding") continue;
+        updated->headers[name] = value;
+    }
+    if (!notModified.headers.count("age")) {
+        updated->headers.erase("age");
+    }
+    updated->requestTime = requestTime;
+    updated->responseTime = responseTime;
+
+    m_revalidated++;
+
+    std::shared_ptr<const CachedResponse> result = updated;
+    if (!lookup.policy.bypass && !lookup.noStore) {
+        putMemory(lookup.key, result);
+        if (!m_directory.empty()) writeDisk(lookup.key, *result);
+    }
+    return result;
+}
+
+void HttpCache::invalidate(const std::string& url) {
+    std::string prefix = HashUtils::sha1String(url) + "_";
+
+    std::vector<std::string> keys;
+    {
+        std::lock_guard<std::mutex> lock(m_memoryMutex);
+        for (const auto& [key, entry] : m_memory) {
+            if (key.compare(0, prefix.size(), prefix) == 0) keys.push_back(key);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_diskMutex);
+        for (const auto& [key, entry] : m_disk) {
+            if (key.compare(0, prefix.size(), prefix) == 0) keys.push_back(key);
+        }
+    }
+
+    for (const auto& key : keys) {
+        eraseMemory(key);
+        eraseDisk(key);
+    }
+}
+
+void HttpCache::clear() {
+    {
+        std::lock_guard<std::mutex> lock(m_memoryMutex);
+        m_memory.clear();
+        m_lru.clear();
+        m_memoryBytes = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_diskMutex);
+    for (const auto& [key, entry] : m_disk) {
+        std::error_code ec;
+        std::filesystem::remove(diskPath(key), ec);
+    }
+    m_disk.clear();
+    m_diskBytes = 0;
+}
+
+HttpCache::Stats HttpCache::stats() const {
+    Stats stats;
+    stats.hits = m_hits.load();
+    stats.misses = m_misses.load();
+    stats.revalidated = m_revalidated.load();
+    stats.staleServed = m_staleServed.load();
+    stats.stores = m_stores.load();
+    stats.evictions = m_evictions.load();
+    {
+        std::lock_guard<std::mutex> lock(m_memoryMutex);
+        stats.memoryEntries = m_memory.size();
+        stats.memoryBytes = m_memoryBytes;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_diskMutex);
+        stats.diskEntries = m_disk.size();
+        stats.diskBytes = m_diskBytes;
+    }
+    return stats;
+}
+
+// -- Freshness (RFC 9111 section 4.2) --
+
+std::chrono::seconds HttpCache::freshnessLifetime(const CachedResponse& response, const HttpCachePolicy& policy) const {
+    using std::chrono::seconds;
+
+    if (policy.ttl) {
+        return *policy.ttl;
+    }
+
+    // s-maxage is for shared caches only; this cache is private
+    auto cc = parseCacheControl(storedHeader(response, "cache-control"));
+    if (auto it = cc.find("max-age"); it != cc.end()) {
+        auto value = parseSeconds(it->second);
+        return seconds(value ? *value : 0);
+    }
+
+    auto date = parseHttpDate(storedHeader(response, "date")).value_or(response.responseTime);
+
+    std::string expiresValue = storedHeader(response, "expires");
+    if (!expiresValue.empty()) {
+        // An unparseable Expires means "already expired"
+        auto expires = parseHttpDate(expiresValue);
+        if (!expires) return seconds(0);
+        return std::max(seconds(0), std::chrono::duration_cast<seconds>(*expires - date));
+    }
+
+    if (isHeuristicallyCacheable(response.statusCode) || cc.count("public")) {
+        if (auto lastModified = parseHttpDate(storedHeader(response, "last-modified"))) {
+            auto heuristic = std::chrono::duration_cast<seconds>(date - *lastModified) / 10;
+            return std::clamp(heuristic, seconds(0), kMaxHeuristicLifetime);
+        }
+    }
+
+    return seconds(0);
+}
+
+std::chrono::seconds HttpCache::currentAge(const CachedResponse& response) const {
+    using std::chrono::seconds;
+    using std::chrono::duration_cast;
+
+    auto date = parseHttpDate(storedHeader(response, "date")).value_or(response.responseTime);
+    seconds ageValue(parseSeconds(storedHeader(response, "age")).value_or(0));
+
+    seconds apparentAge = std::max(seconds(0), duration_cast<seconds>(response.responseTime - date));
+    seconds responseDelay = duration_cast<seconds>(response.responseTime - response.requestTime);
+    seconds correctedAgeValue = ageValue + responseDelay;
+    seconds correctedInitialAge = std::max(apparentAge, correctedAgeValue);
+    seconds residentTime = duration_cast<seconds>(Clock::now() - response.responseTime);
+    return correctedInitialAge + residentTime;
+}
+
+bool HttpCache::varyMatches(const CachedResponse& response, const std::map<std::string, std::string>& requestHeaders) {
+    for (const auto& name : splitList(storedHeader(response, "vary"))) {
+        if (name == "*") return false;
+        auto it = response.varyValues.find(name);
+        std::string stored = it != response.varyValues.end() ? it->second : std::string();
+        if (trim(stored) != trim(findHeader(requestHeaders, name))) return false;
+    }
+    return true;
+}
+
+std::map<std::string, std::string> HttpCache::parseCacheControl(const std::string& value) {
+    std::map<std::string, std::string> directives;
+    size_t pos = 0;
+    while (pos < value.size()) {
+        size_t end = pos;
+        bool quoted = false;
+        while (end < value.size() && (quoted || value[end] != ',')) {
+            if (value[end] == '"') quoted = !quoted;
+            ++end;
+        }
+
+        std::string item = trim(value.substr(pos, end - pos));
+        pos = end + 1;
+        if (item.empty()) continue;
+
+        size_t eq = item.find('=');
+        std::string name = toLower(trim(item.substr(0, eq)));
+        std::string argument = eq == std::string::npos ? std::string() : trim(item.substr(eq + 1));
+        if (argument.size() >= 2 && argument.front() == '"' && argument.back() == '"') {
+            argument = argument.substr(1, argument.size() - 2);
+        }
+        directives.emplace(std::move(name), std::move(argument));
+    }
+    return directives;
+}
+
+// -- Memory tier --
+
+void HttpCache::putMemory(const std::string& key, std::shared_ptr<const CachedResponse> response) {
+    size_t cost = response->cost();
+
+    std::lock_guard<std::mutex> lock(m_memoryMutex);
+    if (auto it = m_memory.find(key); it != m_memory.end()) {
+        m_memoryBytes -= it->second.cost;
+        m_lru.erase(it->second.lruPosition);
+        m_memory.erase(it);
+    }
+
+    // Large bodies stay on disk only so they cannot flush the whole tier
+    if (cost > m_memoryBudget / 4) {
+        return;
+    }
+
+    m_lru.push_front(key);
+    m_memory[key] = MemoryEntry{std::move(response), m_lru.begin(), cost};
+    m_memoryBytes += cost;
+
+    while (m_memoryBytes > m_memoryBudget && !m_lru.empty()) {
+        auto victim = m_memory.find(m_lru.back());
+        m_memoryBytes -= victim->second.cost;
+        m_memory.erase(victim);
+        m_lru.pop_back();
+        m_evictions++;
+    }
+}
+
+std::shared_ptr<const CachedResponse> HttpCache::getMemory(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_memoryMutex);
+    auto it = m_memory.find(key);
+    if (it == m_memory.end()) return nullptr;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+    return it->second.response;
+}
+
+void HttpCache::eraseMemory(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_memoryMutex);
+    auto it = m_memory.find(key);
+    if (it == m_memory.end()) return;
+    m_memoryBytes -= it->second.cost;
+    m_lru.erase(it->second.lruPosition);
+    m_memory.erase(it);
+}
+
+// -- Disk tier --
+// Each entry is one file: a single line of JSON metadata, then the raw body.
+
+std::filesystem::path HttpCache::diskPath(const std::string& key) const {
+    return m_directory / (key + ".entry");
+}
+
+void HttpCache::scanDisk() {
+    std::lock_guard<std::mutex> lock(m_diskMutex);
+    std::error_code ec;
+    for (const auto& file : std::filesystem::directory_iterator(m_directory, ec)) {
+        const auto& path = file.path();
+        if (path.extension() == ".tmp") {
+            std::filesystem::remove(path, ec);
+            continue;
+        }
+        if (path.extension() != ".entry") continue;
+
+        DiskEntry entry;
+        entry.size = static_cast<size_t>(file.file_size(ec));
+        auto mtime = file.last_write_time(ec);
+        entry.lastAccess = Clock::now() - std::chrono::duration_cast<Clock::duration>(
+            std::filesystem::file_time_type::clock::now() - mtime);
+        m_disk[path.stem().string()] = entry;
+        m_diskBytes += entry.size;
+    }
+}
+
+bool HttpCache::writeDisk(const std::string& key, const CachedResponse& response) {
+    nlohmann::json meta = {
+        {"url", response.url},
+        {"status", response.statusCode},
+        {"headers", response.headers},
+        {"vary", response.varyValues},
+        {"requestTime", toMillis(response.requestTime)},
+        {"responseTime", toMillis(response.responseTime)}
+    };
+
+    // Cache files need no durability; a plain temp + rename keeps readers consistent
+    auto target = diskPath(key);
+    auto temp = target;
+    temp += ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file << meta.dump() << '\n';
+        file.write(response.body.data(), static_cast<std::streamsize>(response.body.size()));
+        if (!file.good()) {
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    size_t size = static_cast<size_t>(std::filesystem::file_size(temp, ec));
+
+    std::lock_guard<std::mutex> lock(m_diskMutex);
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+
+    auto& entry = m_disk[key];
+    m_diskBytes = m_diskBytes - entry.size + size;
+    entry.size = size;
+    entry.lastAccess = Clock::now();
+
+    if (m_diskBytes > m_diskBudget) {
+        std::vector<std::pair<Clock::time_point, std::string>> byAge;
+        byAge.reserve(m_disk.size());
+        for (const auto& [name, info] : m_disk) byAge.emplace_back(info.lastAccess, name);
+        std::sort(byAge.begin(), byAge.end());
+
+        // Trim to 90% so the next few stores don't each trigger a sweep
+        size_t target90 = m_diskBudget / 10 * 9;
+        for (const auto& [when, name] : byAge) {
+            if (m_diskBytes <= target90) break;
+            std::filesystem::remove(diskPath(name), ec);
+            m_diskBytes -= m_disk[name].size;
+            m_disk.erase(name);
+            m_evictions++;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<const CachedResponse> HttpCache::readDisk(const std::string& key) {
+    if (m_directory.empty()) return nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_diskMutex);
+        auto it = m_disk.find(key);
+        if (it == m_disk.end()) return nullptr;
+        it->second.lastAccess = Clock::now();
+    }
+
+    std::ifstream file(diskPath(key), std::ios::binary);
+    if (!file.is_open()) return nullptr;
+
+    std::string header;
+    if (!std::getline(file, header)) return nullptr;
+
+    auto meta = nlohmann::json::parse(header, nullptr, false);
+    if (meta.is_discarded() || !meta.is_object()) {
+        eraseDisk(key);
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<CachedResponse>();
+    try {
+        entry->url = meta.at("url").get<std::string>();
+        entry->statusCode = meta.at("status").get<int>();
+        entry->headers = meta.at("headers").get<std::map<std::string, std::string>>();
+        entry->varyValues = meta.at("vary").get<std::map<std::string, std::string>>();
+        entry->requestTime = fromMillis(meta.at("requestTime").get<int64_t>());
+        entry->responseTime = fromMillis(meta.at("responseTime").get<int64_t>());
+    } catch (const nlohmann::json::exception&) {
+        eraseDisk(key);
+        return nullptr;
+    }
+
+    entry->body.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return entry;
+}
+
+void HttpCache::eraseDisk(const std::string& key) {
+    if (m_directory.empty()) return;
+    std::lock_guard<std::mutex> lock(m_diskMutex);
+    auto it = m_disk.find(key);
+    if (it == m_disk.end()) return;
+    std::error_code ec;
+    std::filesystem::remove(diskPath(key), ec);
+    m_diskBytes -= it->second.size;
+    m_disk.erase(it);
+}
+
+} // namespace konami::utils
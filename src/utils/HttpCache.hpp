@@ -0,0 +1,246 @@
+// Konami Client - HTTP Cache
+// Private RFC 9111 response cache with memory and disk tiers
+
+#pragma once
+
+#include "HttpClient.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace konami::utils {
+
+/**
+ * @brief Per-endpoint cache policy override
+ */
+struct HttpCachePolicy {
+    bool bypass{false};                            // Never read or write the cache
+    std::optional<std::chrono::seconds> ttl;       // Replaces the response's freshness lifetime
+    bool serveStaleOnError{true};                  // Serve stale entries on network errors / 5xx
+};
+
+/**
+ * @brief Stored response
+ */
+struct CachedResponse {
+    std::string url;
+    int statusCode{0};
+    std::map<std::string, std::string> headers;   // Names lower-cased
+    std::map<std::string, std::string> varyValues; // Request header values selected by Vary
+    std::string body;
+    std::chrono::system_clock::time_point requestTime;
+    std::chrono::system_clock::time_point responseTime;
+
+    /**
+     * Approximate memory footprint
+     */
+    size_t cost() const;
+};
+
+/**
+ * @brief Private HTTP response cache (RFC 9111)
+ *
+ * Used by HttpClient for GET requests. Freshness follows Cache-Control
+ * (max-age, no-cache, no-store, must-revalidate), Expires/Date/Age and
+ * the Last-Modified heuristic; stale entries are revalidated with
+ * If-None-Match / If-Modified-Since. Entries live in a byte-budgeted
+ * memory LRU backed by an optional disk tier. Unsafe methods invalidate
+ * the target URI.
+ *
+ * The key includes a digest of the Authorization header, so responses
+ * fetched with one account's token are never served to another.
+ */
+class HttpCache {
+public:
+    enum class Freshness { Miss, Fresh, Stale };
+
+    /**
+     * Result of a lookup, handed back to store()/revalidated()
+     */
+    struct Lookup {
+        std::string url;
+        std::string key;
+        Freshness state{Freshness::Miss};
+        std::shared_ptr<const CachedResponse> entry;
+        HttpCachePolicy policy;
+        bool noStore{false};        // Request said no-store
+        bool onlyIfCached{false};   // Request said only-if-cached
+        bool staleAllowed{false};   // Entry may be served if the origin is unreachable
+    };
+
+    /**
+     * Hit/miss counters
+     */
+    struct Stats {
+        uint64_t hits{0};           // Served fresh from cache
+        uint64_t misses{0};         // Full response fetched from origin
+        uint64_t revalidated{0};    // 304 Not Modified refreshed an entry
+        uint64_t staleServed{0};    // Stale entry served after an origin failure
+        uint64_t stores{0};
+        uint64_t evictions{0};
+        size_t memoryEntries{0};
+        size_t memoryBytes{0};
+        size_t diskEntries{0};
+        size_t diskBytes{0};
+
+        double hitRatio() const {
+            uint64_t total = hits + revalidated + misses;
+            return total ? static_cast<double>(hits + revalidated) / static_cast<double>(total) : 0.0;
+        }
+    };
+
+    /**
+     * Constructor
+     * @param directory Disk tier directory (empty = memory only)
+     * @param memoryBudget Memory tier size in bytes
+     * @param diskBudget Disk tier size in bytes
+     */
+    explicit HttpCache(std::filesystem::path directory = {},
+                       size_t memoryBudget = 16 * 1024 * 1024,
+                       size_t diskBudget = 256 * 1024 * 1024);
+
+    ~HttpCache();
+
+    HttpCache(const HttpCache&) = delete;
+    HttpCache& operator=(const HttpCache&) = delete;
+
+    /**
+     * Override caching for URLs starting with a prefix (longest prefix wins)
+     * @param urlPrefix URL prefix, e.g. "https://api.modrinth.com/v2/search"
+     * @param policy Policy to apply
+     */
+    void setPolicy(const std::string& urlPrefix, HttpCachePolicy policy);
+
+    /**
+     * Find a stored response for a GET request
+     * @param url Request URL
+     * @param requestHeaders Request headers (any case)
+     * @return Lookup result
+     */
+    Lookup lookup(const std::string& url, const std::map<std::string, std::string>& requestHeaders);
+
+    /**
+     * Store a response if it is cacheable
+     * @param lookup Result of the lookup made for this request
+     * @param requestHeaders Request headers (any case)
+     * @param response Origin response (body must be complete)
+     * @param requestTime When the request was sent
+     * @param responseTime When the response was received
+     * @return true if stored
+     */
+    bool store(const Lookup& lookup, const std::map<std::string, std::string>& requestHeaders,
+               const HttpResponse& response,
+               std::chrono::system_clock::time_point requestTime,
+               std::chrono::system_clock::time_point responseTime);
+
+    /**
+     * Freshen a stored entry from a 304 response
+     * @return Updated entry to serve
+     */
+    std::shared_ptr<const CachedResponse> revalidated(const Lookup& lookup, const HttpResponse& notModified,
+                                                      std::chrono::system_clock::time_point requestTime,
+                                                      std::chrono::system_clock::time_point responseTime);
+
+    /**
+     * Drop every stored variant of a URL
+     * @param url Target URI
+     */
+    void invalidate(const std::string& url);
+
+    /**
+     * Drop all entries from both tiers
+     */
+    void clear();
+
+    /**
+     * Record that a stale entry was served after an origin failure
+     */
+    void recordStaleServed() { m_staleServed++; }
+
+    /**
+     * Record that a full response was fetched from the origin
+     */
+    void recordMiss() { m_misses++; }
+
+    /**
+     * Largest body the cache will store
+     */
+    size_t maxEntrySize() const { return m_maxEntrySize; }
+
+    /**
+     * Get counters and tier sizes
+     */
+    Stats stats() const;
+
+    /**
+     * Parse a Cache-Control header into lower-cased directives
+     * @param value Header value
+     * @return Directive -> argument (empty if none)
+     */
+    static std::map<std::string, std::string> parseCacheControl(const std::string& value);
+
+private:
+    struct MemoryEntry {
+        std::shared_ptr<const CachedResponse> response;
+        std::list<std::string>::iterator lruPosition;
+        size_t cost{0};
+    };
+
+    struct DiskEntry {
+        size_t size{0};
+        std::chrono::system_clock::time_point lastAccess;
+    };
+
+    std::string makeKey(const std::string& url, const std::map<std::string, std::string>& requestHeaders) const;
+    HttpCachePolicy policyFor(const std::string& url) const;
+
+    std::chrono::seconds freshnessLifetime(const CachedResponse& response, const HttpCachePolicy& policy) const;
+    std::chrono::seconds currentAge(const CachedResponse& response) const;
+    static bool varyMatches(const CachedResponse& response, const std::map<std::string, std::string>& requestHeaders);
+
+    void putMemory(const std::string& key, std::shared_ptr<const CachedResponse> response);
+    std::shared_ptr<const CachedResponse> getMemory(const std::string& key);
+    void eraseMemory(const std::string& key);
+
+    std::filesystem::path diskPath(const std::string& key) const;
+    void scanDisk();
+    bool writeDisk(const std::string& key, const CachedResponse& response);
+    std::shared_ptr<const CachedResponse> readDisk(const std::string& key);
+    void eraseDisk(const std::string& key);
+
+private:
+    std::filesystem::path m_directory;
+    size_t m_memoryBudget;
+    size_t m_diskBudget;
+    size_t m_maxEntrySize;
+
+    mutable std::mutex m_policyMutex;
+    std::vector<std::pair<std::string, HttpCachePolicy>> m_policies;
+
+    mutable std::mutex m_memoryMutex;
+    std::unordered_map<std::string, MemoryEntry> m_memory;
+    std::list<std::string> m_lru;   // Front = most recently used
+    size_t m_memoryBytes{0};
+
+    mutable std::mutex m_diskMutex;
+    std::unordered_map<std::string, DiskEntry> m_disk;   // Keyed by file stem
+    size_t m_diskBytes{0};
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_revalidated{0};
+    std::atomic<uint64_t> m_staleServed{0};
+    std::atomic<uint64_t> m_stores{0};
+    std::atomic<uint64_t> m_evictions{0};
+};
+
+} // namespace konami::utils
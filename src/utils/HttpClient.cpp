@@ -1,26 +1,165 @@
 /**
  * HttpClient.cpp
  * 
- * HTTP client implementation using cpr (which wraps libcurl).
- * Note: This implementation uses cpr instead of raw curl for simplicity.
+ * HTTP client implementation on libcurl.
+ * Easy handles are pooled and share DNS and TLS session caches through a
+ * CURLSH object. Each easy handle keeps its own connection cache, so a
+ * pooled handle reuses its warm keep-alive connection on the next request
+ * instead of handshaking again. Connections themselves are not shared:
+ * libcurl does not support one connection cache being used from several
+ * threads at once.
+ *
+ * HTTP/2 is only requested, never required: it needs a libcurl built with
+ * nghttp2, and the curl that cpr bundles is not, so with the default build
+ * every transfer is HTTP/1.1.
  */
 
 #include "HttpClient.hpp"
+#include "HttpCache.hpp"
+#include "HttpSinks.hpp"
 
-#include <cpr/cpr.h>
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string_view>
 
 namespace konami::utils {
 
+namespace {
+
+constexpr size_t kMaxPooledHandles = 16;
+constexpr size_t kMaxPooledMultiHandles = 4;
+
+/**
+ * RAII owner for a curl header list
+ */
+struct CurlSlist {
+    curl_slist* list{nullptr};
+    ~CurlSlist() { if (list) curl_slist_free_all(list); }
+    void append(const std::string& line) { list = curl_slist_append(list, line.c_str()); }
+};
+
+/**
+ * RAII owner for a curl MIME body
+ */
+struct CurlMime {
+    curl_mime* mime{nullptr};
+    ~CurlMime() { if (mime) curl_mime_free(mime); }
+};
+
+std::string toLowerAscii(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+}
+
+bool hasHeader(const std::map<std::string, std::string>& headers, const std::string& lowerName) {
+    for (const auto& [name, value] : headers) {
+        if (toLowerAscii(name) == lowerName) return true;
+    }
+    return false;
+}
+
+/**
+ * Fill status, timing and length from a finished transfer
+ */
+void readTransferInfo(CURL* curl, HttpResponse& result) {
+    long status = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+    result.statusCode = static_cast<int>(status);
+
+    double totalTime = 0.0;
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &totalTime);
+    result.downloadTime = totalTime;
+
+    curl_off_t contentLength = -1;
+    curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength);
+    if (contentLength < 0) {
+        curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &contentLength);
+    }
+    result.contentLength = static_cast<int64_t>(contentLength);
+}
+
+/**
+ * Passes chunks through to the caller's sink while keeping a bounded copy for the cache
+ */
+class CaptureSink : public HttpSink {
+public:
+    CaptureSink(HttpSink& next, size_t limit) : m_next(next), m_limit(limit) {}
+
+    bool begin(int statusCode, const std::map<std::string, std::string>& headers, int64_t sizeHint) override {
+        m_started = true;
+        if (sizeHint > static_cast<int64_t>(m_limit)) m_overflowed = true;
+        return m_next.begin(statusCode, headers, sizeHint);
+    }
+
+    bool write(const char* data, size_t size) override {
+        if (!m_overflowed) {
+            if (m_body.size() + size > m_limit) {
+                m_overflowed = true;
+                std::string().swap(m_body);
+            } else {
+                m_body.append(data, size);
+            }
+        }
+        return m_next.write(data, size);
+    }
+
+    bool finish(bool success) override { return m_next.finish(success); }
+    std::string error() const override { return m_next.error(); }
+
+    bool started() const { return m_started; }
+    bool overflowed() const { return m_overflowed; }
+    std::string takeBody() { return std::move(m_body); }
+
+private:
+    HttpSink& m_next;
+    size_t m_limit;
+    std::string m_body;
+    bool m_started{false};
+    bool m_overflowed{false};
+};
+
+/**
+ * Build a response from a cache entry, feeding 2xx bodies to the sink
+ */
+HttpResponse replayCached(const CachedResponse& entry, HttpSink* sink) {
+    HttpResponse result;
+    result.statusCode = entry.statusCode;
+    result.headers = entry.headers;
+    result.contentLength = static_cast<int64_t>(entry.body.size());
+
+    if (!sink || !result.isSuccess()) {
+        result.body = entry.body;
+        return result;
+    }
+
+    bool ok = sink->begin(entry.statusCode, entry.headers, static_cast<int64_t>(entry.body.size()));
+    if (ok && !entry.body.empty()) {
+        ok = sink->write(entry.body.data(), entry.body.size());
+    }
+    if (!sink->finish(ok)) {
+        std::string reason = sink->error();
+        result.error = reason.empty() ? "Response body rejected by sink" : reason;
+    }
+    return result;
+}
+
+} // namespace
+
 // -- CurlGlobalInit --
 
 bool CurlGlobalInit::s_initialized = false;
 
 void CurlGlobalInit::init() {
-    if (!s_initialized) {
+    static std::once_flag once;
+    std::call_once(once, [] {
         curl_global_init(CURL_GLOBAL_ALL);
         s_initialized = true;
-    }
+    });
 }
 
 void CurlGlobalInit::cleanup() {
@@ -45,12 +184,150 @@ void CurlHandle::reset() { if (m_curl) curl_easy_reset(m_curl); }
 
 struct HttpClient::Impl {
     HttpOptions defaultOptions;
+
+    // Shared DNS / TLS session caches (thread-safe through the share locks)
+    CURLSH* share{nullptr};
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> shareLocks;
+
+    // Idle easy handles, reused across requests. A handle is owned by one
+    // thread between acquire() and release(), and carries its connections
+    // with it
+    std::mutex poolMutex;
+    std::vector<CurlHandle> idle;
+
+    // Idle multi handles for getAll(). Transfers in a multi handle use its
+    // connection cache rather than the easy handles' own, so keeping the
+    // multi handles alive lets the next batch to a host reuse the warm
+    // connections of the last one
+    std::vector<CURLM*> idleMulti;
+
+    // Optional GET response cache
+    mutable std::mutex cacheMutex;
+    std::shared_ptr<HttpCache> cache;
+
+    Impl() {
+        share = curl_share_init();
+        if (share) {
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &Impl::lockShare);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &Impl::unlockShare);
+            curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        }
+    }
+
+    ~Impl() {
+        // Easy handles must release the share before it is destroyed
+        for (CURLM* multi : idleMulti) curl_multi_cleanup(multi);
+        idle.clear();
+        if (share) curl_share_cleanup(share);
+    }
+
+    CurlHandle acquire() {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (!idle.empty()) {
+                CurlHandle handle = std::move(idle.back());
+                idle.pop_back();
+                return handle;
+            }
+        }
+        return CurlHandle();
+    }
+
+    void release(CurlHandle handle) {
+        if (!handle.get()) return;
+        // Reset clears options but keeps the handle's buffers and caches warm
+        handle.reset();
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (idle.size() < kMaxPooledHandles) {
+            idle.push_back(std::move(handle));
+        }
+    }
+
+    CURLM* acquireMulti() {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (!idleMulti.empty()) {
+                CURLM* multi = idleMulti.back();
+                idleMulti.pop_back();
+                return multi;
+            }
+        }
+        CURLM* multi = curl_multi_init();
+        // Only takes effect when libcurl speaks HTTP/2 (see the file comment)
+        if (multi) curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        return multi;
+    }
+
+    void releaseMulti(CURLM* multi) {
+        if (!multi) return;
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (idleMulti.size() < kMaxPooledMultiHandles) {
+                idleMulti.push_back(multi);
+                return;
+            }
+        }
+        curl_multi_cleanup(multi);
+    }
+
+    static void lockShare(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+        static_cast<Impl*>(userptr)->shareLocks[data].lock();
+    }
+
+    static void unlockShare(CURL*, curl_lock_data data, void* userptr) {
+        static_cast<Impl*>(userptr)->shareLocks[data].unlock();
+    }
+};
+
+/**
+ * Per-request state passed to curl callbacks
+ */
+struct RequestContext {
+    enum class Target { Undecided, Sink, Body };
+
+    HttpResponse* response;
+    const HttpOptions* options;
+    CURL* curl{nullptr};
+    HttpSink* sink{nullptr};
+    Target target{Target::Undecided};
+    bool sinkStarted{false};
+    bool sinkAborted{false};
+
+    /**
+     * Pick the body destination once the final response headers are in:
+     * 2xx bodies go to the sink, anything else is buffered for diagnostics
+     */
+    bool startSink() {
+        long status = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+        if (status < 200 || status >= 300) {
+            target = Target::Body;
+            return true;
+        }
+
+        target = Target::Sink;
+        sinkStarted = true;
+
+        // Content-Length counts encoded bytes; only trust it for identity bodies
+        curl_off_t length = -1;
+        curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+        if (response->headers.count("content-encoding")) length = -1;
+
+        if (!sink->begin(static_cast<int>(status), response->headers, static_cast<int64_t>(length))) {
+            sinkAborted = true;
+            return false;
+        }
+        return true;
+    }
 };
 
 // -- HttpClient --
 
-HttpClient::HttpClient() : m_impl(std::make_unique<Impl>()) {
+HttpClient::HttpClient() {
     CurlGlobalInit::init();
+    m_impl = std::make_unique<Impl>();
 }
 
 HttpClient::~HttpClient() = default;
@@ -66,6 +343,16 @@ void HttpClient::setDefaultOptions(const HttpOptions& options) {
     m_impl->defaultOptions = options;
 }
 
+void HttpClient::setCache(std::shared_ptr<HttpCache> cache) {
+    std::lock_guard<std::mutex> lock(m_impl->cacheMutex);
+    m_impl->cache = std::move(cache);
+}
+
+std::shared_ptr<HttpCache> HttpClient::cache() const {
+    std::lock_guard<std::mutex> lock(m_impl->cacheMutex);
+    return m_impl->cache;
+}
+
 HttpResponse HttpClient::get(const std::string& url, const HttpOptions& options) {
     return performRequest("GET", url, "", options);
 }
@@ -80,9 +367,38 @@ HttpResponse HttpClient::postJson(const std::string& url, const std::string& jso
     return performRequest("POST", url, json, opts);
 }
 
-HttpResponse HttpClient::postForm(const std::string& url, const FormData& /*form*/, const HttpOptions& options) {
-    // Simplified: would build multipart form
-    return performRequest("POST", url, "", options);
+HttpResponse HttpClient::postForm(const std::string& url, const FormData& form, const HttpOptions& options) {
+    HttpResponse result;
+    CurlHandle curl = m_impl->acquire();
+    if (!curl.get()) {
+        result.error = "Failed to create curl handle";
+        return result;
+    }
+
+    HttpOptions opts = resolveOptions(options);
+    setupCurl(curl, url, opts);
+
+    CurlMime mime;
+    mime.mime = curl_mime_init(curl);
+    for (const auto& field : form.fields) {
+        curl_mimepart* part = curl_mime_addpart(mime.mime);
+        curl_mime_name(part, field.name.c_str());
+        if (field.isFile) {
+            curl_mime_filedata(part, field.value.c_str());
+            if (!field.contentType.empty()) curl_mime_type(part, field.contentType.c_str());
+        } else {
+            curl_mime_data(part, field.value.c_str(), CURL_ZERO_TERMINATED);
+        }
+    }
+    curl_easy_setopt(curl, CURLOPT_MIMEPOST, mime.mime);
+
+    result = execute(curl, opts);
+    m_impl->release(std::move(curl));
+
+    if (auto responseCache = cache(); responseCache && result.statusCode >= 200 && result.statusCode < 400) {
+        responseCache->invalidate(url);
+    }
+    return result;
 }
 
 HttpResponse HttpClient::put(const std::string& url, const std::string& body, const HttpOptions& options) {
@@ -101,6 +417,15 @@ HttpResponse HttpClient::head(const std::string& url, const HttpOptions& options
     return performRequest("HEAD", url, "", options);
 }
 
+HttpResponse HttpClient::getStream(const std::string& url, HttpSink& sink, const HttpOptions& options) {
+    return performRequest("GET", url, "", options, &sink);
+}
+
+HttpResponse HttpClient::postStream(const std::string& url, const std::string& body,
+                                    HttpSink& sink, const HttpOptions& options) {
+    return performRequest("POST", url, body, options, &sink);
+}
+
 std::future<HttpResponse> HttpClient::getAsync(const std::string& url, const HttpOptions& options) {
     return std::async(std::launch::async, [this, url, options]() { return get(url, options); });
 }
@@ -113,18 +438,96 @@ std::future<HttpResponse> HttpClient::postJsonAsync(const std::string& url, cons
     return std::async(std::launch::async, [this, url, json, options]() { return postJson(url, json, options); });
 }
 
-bool HttpClient::downloadFile(const std::string& url, const std::string& destination, const HttpOptions& options) {
-    std::ofstream file(destination, std::ios::binary);
-    if (!file.is_open()) return false;
+std::vector<HttpResponse> HttpClient::getAll(const std::vector<std::string>& urls, const HttpOptions& options) {
+    std::vector<HttpResponse> results(urls.size());
+    if (urls.empty()) return results;
+
+    CURLM* multi = m_impl->acquireMulti();
+    if (!multi) {
+        for (auto& result : results) result.error = "Failed to create curl multi handle";
+        return results;
+    }
+
+    HttpOptions opts = resolveOptions(options);
+    CurlSlist headers;
+    for (const auto& [key, value] : opts.headers) headers.append(key + ": " + value);
+
+    struct Pending {
+        CurlHandle curl;
+        RequestContext context;
+        std::array<char, CURL_ERROR_SIZE> errorBuffer{};
+    };
+    std::vector<std::unique_ptr<Pending>> pending;
+    pending.reserve(urls.size());
+
+    for (size_t i = 0; i < urls.size(); ++i) {
+        CurlHandle curl = m_impl->acquire();
+        if (!curl.get()) {
+            results[i].error = "Failed to create curl handle";
+            continue;
+        }
+
+        auto transfer = std::make_unique<Pending>(Pending{std::move(curl), RequestContext{&results[i], &opts}});
+        CURL* handle = transfer->curl.get();
+        transfer->context.curl = handle;
+
+        setupCurl(handle, urls[i], opts);
+        // With HTTP/2, wait for an in-flight connection to the origin and share it
+        curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        if (headers.list) curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers.list);
+        curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, transfer->errorBuffer.data());
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, &HttpClient::writeCallback);
+        curl_easy_setopt(handle, CURLOPT_WRITEDATA, &transfer->context);
+        curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, &HttpClient::headerCallback);
+        curl_easy_setopt(handle, CURLOPT_HEADERDATA, &results[i]);
+        curl_easy_setopt(handle, CURLOPT_PRIVATE, transfer.get());
+
+        curl_multi_add_handle(multi, handle);
+        pending.push_back(std::move(transfer));
+    }
+
+    int running = 0;
+    do {
+        CURLMcode mcode = curl_multi_perform(multi, &running);
+        if (mcode == CURLM_OK && running) {
+            mcode = curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+        if (mcode != CURLM_OK) {
+            for (auto& transfer : pending) transfer->context.response->error = curl_multi_strerror(mcode);
+            break;
+        }
+    } while (running);
 
-    cpr::Response response = cpr::Download(
-        file,
-        cpr::Url{url},
-        cpr::Timeout{options.timeoutSeconds * 1000}
-    );
+    int queued = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+        if (message->msg != CURLMSG_DONE) continue;
 
-    file.close();
-    return response.status_code == 200;
+        Pending* transfer = nullptr;
+        curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, reinterpret_cast<char**>(&transfer));
+        HttpResponse& result = *transfer->context.response;
+
+        readTransferInfo(message->easy_handle, result);
+        CURLcode code = message->data.result;
+        if (code != CURLE_OK && result.error.empty()) {
+            result.error = transfer->errorBuffer[0] ? transfer->errorBuffer.data() : curl_easy_strerror(code);
+        }
+    }
+
+    for (auto& transfer : pending) {
+        curl_multi_remove_handle(multi, transfer->curl.get());
+        curl_easy_setopt(transfer->curl.get(), CURLOPT_ERRORBUFFER, nullptr);
+        curl_easy_setopt(transfer->curl.get(), CURLOPT_HTTPHEADER, nullptr);
+        m_impl->release(std::move(transfer->curl));
+    }
+    m_impl->releaseMulti(multi);
+
+    return results;
+}
+
+bool HttpClient::downloadFile(const std::string& url, const std::string& destination, const HttpOptions& options) {
+    FileSink sink(destination);
+    HttpResponse response = getStream(url, sink, options);
+    return response.isSuccess() && response.error.empty();
 }
 
 std::future<bool> HttpClient::downloadFileAsync(const std::string& url, const std::string& destination, const HttpOptions& options) {
@@ -135,36 +538,50 @@ std::future<bool> HttpClient::downloadFileAsync(const std::string& url, const st
 
 HttpResponse HttpClient::uploadFile(const std::string& url, const std::string& filePath,
                                     const std::string& fieldName, const HttpOptions& options) {
-    cpr::Response response = cpr::Post(
-        cpr::Url{url},
-        cpr::Multipart{{fieldName, cpr::File{filePath}}},
-        cpr::Timeout{options.timeoutSeconds * 1000}
-    );
-
-    HttpResponse result;
-    result.statusCode = response.status_code;
-    result.body = response.text;
-    return result;
+    FormData form;
+    form.addFile(fieldName, filePath);
+    return postForm(url, form, options);
 }
 
 std::string HttpClient::urlEncode(const std::string& str) {
-    CURL* curl = curl_easy_init();
-    if (!curl) return str;
-    char* output = curl_easy_escape(curl, str.c_str(), static_cast<int>(str.size()));
-    std::string result(output);
-    curl_free(output);
-    curl_easy_cleanup(curl);
+    // RFC 3986 percent-encoding; no curl handle needed
+    static const char hex[] = "0123456789ABCDEF";
+    std::string result;
+    result.reserve(str.size() * 3);
+    for (unsigned char c : str) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            result += static_cast<char>(c);
+        } else {
+            result += '%';
+            result += hex[c >> 4];
+            result += hex[c & 0x0F];
+        }
+    }
     return result;
 }
 
 std::string HttpClient::urlDecode(const std::string& str) {
-    CURL* curl = curl_easy_init();
-    if (!curl) return str;
-    int outLen = 0;
-    char* output = curl_easy_unescape(curl, str.c_str(), static_cast<int>(str.size()), &outLen);
-    std::string result(output, outLen);
-    curl_free(output);
-    curl_easy_cleanup(curl);
+    auto hexValue = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+
+    std::string result;
+    result.reserve(str.size());
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] == '%' && i + 2 < str.size()) {
+            int hi = hexValue(str[i + 1]);
+            int lo = hexValue(str[i + 2]);
+            if (hi >= 0 && lo >= 0) {
+                result += static_cast<char>((hi << 4) | lo);
+                i += 2;
+                continue;
+            }
+        }
+        result += str[i];
+    }
     return result;
 }
 
@@ -177,64 +594,294 @@ std::string HttpClient::buildQueryString(const std::map<std::string, std::string
     return result;
 }
 
+HttpOptions HttpClient::resolveOptions(const HttpOptions& options) const {
+    // Per-request values win; empty strings and non-positive numbers fall back
+    const HttpOptions& defaults = m_impl->defaultOptions;
+    HttpOptions resolved = options;
+
+    resolved.headers = defaults.headers;
+    for (const auto& [key, value] : options.headers) resolved.headers[key] = value;
+
+    if (resolved.timeoutSeconds <= 0) resolved.timeoutSeconds = defaults.timeoutSeconds > 0 ? defaults.timeoutSeconds : 30;
+    if (resolved.connectTimeoutSeconds <= 0) resolved.connectTimeoutSeconds = defaults.connectTimeoutSeconds > 0 ? defaults.connectTimeoutSeconds : 10;
+    if (resolved.maxRedirects <= 0) resolved.maxRedirects = defaults.maxRedirects;
+    if (resolved.userAgent.empty()) resolved.userAgent = defaults.userAgent.empty() ? "Konami-Client/1.0" : defaults.userAgent;
+    if (resolved.proxyUrl.empty()) resolved.proxyUrl = defaults.proxyUrl;
+    if (resolved.proxyAuth.empty()) resolved.proxyAuth = defaults.proxyAuth;
+    if (resolved.caBundle.empty()) resolved.caBundle = defaults.caBundle;
+    if (!resolved.progressCallback) resolved.progressCallback = defaults.progressCallback;
+
+    return resolved;
+}
+
 HttpResponse HttpClient::performRequest(const std::string& method, const std::string& url,
-                                         const std::string& body, const HttpOptions& options) {
+                                         const std::string& body, const HttpOptions& options,
+                                         HttpSink* sink) {
+    HttpOptions opts = resolveOptions(options);
+    std::shared_ptr<HttpCache> responseCache = cache();
+
+    // Caller-driven conditional and range requests manage their own validators;
+    // the cache only holds decoded bodies
+    bool cacheable = method == "GET" && opts.decompress && !hasHeader(opts.headers, "range") &&
+                     !hasHeader(opts.headers, "if-none-match") &&
+                     !hasHeader(opts.headers, "if-modified-since");
+    if (responseCache && cacheable) {
+        return cachedGet(*responseCache, url, opts, sink);
+    }
+
+    HttpResponse result = transfer(method, url, body, opts, sink);
+
+    // RFC 9111 4.4: a successful unsafe request invalidates the target URI
+    if (responseCache && method != "GET" && method != "HEAD" &&
+        result.statusCode >= 200 && result.statusCode < 400) {
+        responseCache->invalidate(url);
+    }
+    return result;
+}
+
+HttpResponse HttpClient::transfer(const std::string& method, const std::string& url,
+                                  const std::string& body, const HttpOptions& options, HttpSink* sink) {
     HttpResponse result;
 
-    try {
-        cpr::Header headers;
-        for (const auto& [key, value] : m_impl->defaultOptions.headers) headers[key] = value;
-        for (const auto& [key, value] : options.headers) headers[key] = value;
+    CurlHandle curl = m_impl->acquire();
+    if (!curl.get()) {
+        result.error = "Failed to create curl handle";
+        return result;
+    }
+
+    setupCurl(curl, url, options);
 
-        std::string ua = options.userAgent.empty() ? m_impl->defaultOptions.userAgent : options.userAgent;
-        if (ua.empty()) ua = "Konami-Client/1.0";
+    if (method == "HEAD") {
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    } else if (method == "POST") {
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    } else if (method != "GET") {
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method.c_str());
+    }
+
+    if (method == "POST" || method == "PUT" || method == "PATCH" || (method == "DELETE" && !body.empty())) {
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size()));
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.data());
+    }
+
+    result = execute(curl, options, sink);
+    m_impl->release(std::move(curl));
+    return result;
+}
 
-        int timeout = options.timeoutSeconds > 0 ? options.timeoutSeconds : m_impl->defaultOptions.timeoutSeconds;
-        if (timeout <= 0) timeout = 30;
+HttpResponse HttpClient::cachedGet(HttpCache& cache, const std::string& url,
+                                   const HttpOptions& options, HttpSink* sink) {
+    HttpCache::Lookup lookup = cache.lookup(url, options.headers);
+    if (lookup.state == HttpCache::Freshness::Fresh) {
+        return replayCached(*lookup.entry, sink);
+    }
 
-        cpr::Response response;
+    if (lookup.onlyIfCached) {
+        HttpResponse result;
+        result.statusCode = 504;
+        result.error = "Not cached (only-if-cached)";
+        return result;
+    }
 
-        if (method == "GET") {
-            response = cpr::Get(cpr::Url{url}, headers, cpr::Timeout{timeout * 1000}, cpr::UserAgent{ua});
-        } else if (method == "POST") {
-            response = cpr::Post(cpr::Url{url}, headers, cpr::Body{body}, cpr::Timeout{timeout * 1000}, cpr::UserAgent{ua});
-        } else if (method == "PUT") {
-            response = cpr::Put(cpr::Url{url}, headers, cpr::Body{body}, cpr::Timeout{timeout * 1000}, cpr::UserAgent{ua});
-        } else if (method == "PATCH") {
-            response = cpr::Patch(cpr::Url{url}, headers, cpr::Body{body}, cpr::Timeout{timeout * 1000}, cpr::UserAgent{ua});
-        } else if (method == "DELETE") {
-            response = cpr::Delete(cpr::Url{url}, headers, cpr::Timeout{timeout * 1000}, cpr::UserAgent{ua});
-        } else if (method == "HEAD") {
-            response = cpr::Head(cpr::Url{url}, headers, cpr::Timeout{timeout * 1000}, cpr::UserAgent{ua});
+    // Stale entry: revalidate with its validators instead of refetching blindly
+    HttpOptions request = options;
+    bool conditional = false;
+    if (lookup.entry) {
+        const auto& stored = lookup.entry->headers;
+        if (auto it = stored.find("etag"); it != stored.end()) {
+            request.headers["If-None-Match"] = it->second;
+            conditional = true;
+        }
+        if (auto it = stored.find("last-modified"); it != stored.end()) {
+            request.headers["If-Modified-Since"] = it->second;
+            conditional = true;
         }
+    }
+
+    std::optional<CaptureSink> capture;
+    if (sink) capture.emplace(*sink, cache.maxEntrySize());
 
-        result.statusCode = response.status_code;
-        result.body = response.text;
-        result.error = response.error.message;
-        result.downloadTime = response.elapsed;
+    auto requestTime = std::chrono::system_clock::now();
+    HttpResponse result = transfer("GET", url, "", request, capture ? &*capture : nullptr);
+    auto responseTime = std::chrono::system_clock::now();
 
-    } catch (const std::exception& e) {
-        result.statusCode = 0;
-        result.error = e.what();
+    if (conditional && result.statusCode == 304) {
+        auto updated = cache.revalidated(lookup, result, requestTime, responseTime);
+        HttpResponse served = replayCached(*updated, sink);
+        served.downloadTime = result.downloadTime;
+        return served;
     }
 
+    // RFC 9111 4.2.4: a disconnected cache may serve stale unless told otherwise
+    bool originFailed = result.statusCode == 0 || result.statusCode >= 500;
+    if (originFailed && lookup.entry && lookup.staleAllowed && !(capture && capture->started())) {
+        cache.recordStaleServed();
+        return replayCached(*lookup.entry, sink);
+    }
+
+    if (result.statusCode == 0 || !result.error.empty()) {
+        return result;
+    }
+
+    cache.recordMiss();
+    if (capture && capture->started()) {
+        if (!capture->overflowed()) {
+            result.body = capture->takeBody();
+            cache.store(lookup, options.headers, result, requestTime, responseTime);
+            result.body.clear();
+        }
+    } else {
+        cache.store(lookup, options.headers, result, requestTime, responseTime);
+    }
     return result;
 }
 
-void HttpClient::setupCurl(CURL* /*curl*/, const std::string& /*url*/, const HttpOptions& /*options*/) {
-    // Using cpr instead of raw curl
+HttpResponse HttpClient::execute(CURL* curl, const HttpOptions& options, HttpSink* sink) {
+    HttpResponse result;
+    RequestContext context{&result, &options};
+    context.curl = curl;
+    context.sink = sink;
+
+    CurlSlist headers;
+    for (const auto& [key, value] : options.headers) headers.append(key + ": " + value);
+    if (headers.list) curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers.list);
+
+    char errorBuffer[CURL_ERROR_SIZE] = {0};
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errorBuffer);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &HttpClient::writeCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &context);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &HttpClient::headerCallback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &result);
+    if (options.progressCallback) {
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, &HttpClient::progressCallback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &context);
+    }
+
+    CURLcode code = curl_easy_perform(curl);
+    readTransferInfo(curl, result);
+
+    if (sink) {
+        // Empty 2xx bodies never reach the write callback
+        if (code == CURLE_OK && context.target == RequestContext::Target::Undecided) {
+            context.startSink();
+        }
+        if (context.sinkStarted) {
+            bool delivered = code == CURLE_OK && !context.sinkAborted;
+            if (!sink->finish(delivered) && delivered) {
+                std::string reason = sink->error();
+                result.error = reason.empty() ? "Response body rejected by sink" : reason;
+            }
+        }
+    }
+
+    if (context.sinkAborted && result.error.empty()) {
+        std::string reason = sink->error();
+        result.error = reason.empty() ? "Transfer aborted by sink" : reason;
+    } else if (code != CURLE_OK && result.error.empty()) {
+        result.error = errorBuffer[0] ? errorBuffer : curl_easy_strerror(code);
+    }
+
+    // The buffer and header list die with this frame
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, nullptr);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+
+    return result;
 }
 
-size_t HttpClient::writeCallback(void* /*contents*/, size_t size, size_t nmemb, void* /*userp*/) {
-    return size * nmemb;
+void HttpClient::setupCurl(CURL* curl, const std::string& url, const HttpOptions& options) {
+    if (m_impl->share) curl_easy_setopt(curl, CURLOPT_SHARE, m_impl->share);
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(options.timeoutSeconds) * 1000L);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(options.connectTimeoutSeconds) * 1000L);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, options.followRedirects ? 1L : 0L);
+    curl_easy_setopt(curl, CURLOPT_MAXREDIRS, static_cast<long>(options.maxRedirects));
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, options.userAgent.c_str());
+
+    // Empty string advertises every encoding libcurl was built with; cpr's
+    // bundled curl has zlib only, so that is gzip and deflate
+    if (options.decompress) curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+
+    // TLS
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, options.verifySSL ? 1L : 0L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, options.verifySSL ? 2L : 0L);
+    if (!options.caBundle.empty()) curl_easy_setopt(curl, CURLOPT_CAINFO, options.caBundle.c_str());
+
+    // Proxy
+    if (!options.proxyUrl.empty()) curl_easy_setopt(curl, CURLOPT_PROXY, options.proxyUrl.c_str());
+    if (!options.proxyAuth.empty()) curl_easy_setopt(curl, CURLOPT_PROXYUSERPWD, options.proxyAuth.c_str());
+
+    // Connection reuse: keep-alive probes. HTTP/2 over TLS is negotiated only
+    // when libcurl has nghttp2; otherwise this stays HTTP/1.1
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, 60L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, 30L);
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+}
+
+size_t HttpClient::writeCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    auto* context = static_cast<RequestContext*>(userp);
+    const char* data = static_cast<const char*>(contents);
+    const size_t bytes = size * nmemb;
+
+    if (context->sink && context->target == RequestContext::Target::Undecided) {
+        if (!context->startSink()) return 0;
+    }
+
+    if (context->target == RequestContext::Target::Sink) {
+        if (!context->sink->write(data, bytes)) {
+            context->sinkAborted = true;
+            return 0;
+        }
+        return bytes;
+    }
+
+    context->response->body.append(data, bytes);
+    return bytes;
 }
 
-size_t HttpClient::headerCallback(char* /*buffer*/, size_t size, size_t nitems, void* /*userdata*/) {
+size_t HttpClient::headerCallback(char* buffer, size_t size, size_t nitems, void* userdata) {
+    auto* response = static_cast<HttpResponse*>(userdata);
+    std::string_view line(buffer, size * nitems);
+
+    // A new status line starts a new response (redirects, 100-continue)
+    if (line.rfind("HTTP/", 0) == 0) {
+        response->headers.clear();
+        return size * nitems;
+    }
+
+    auto colon = line.find(':');
+    if (colon == std::string_view::npos) {
+        return size * nitems;
+    }
+
+    std::string name = toLowerAscii(std::string(line.substr(0, colon)));
+    std::string_view value = line.substr(colon + 1);
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+    while (!value.empty() && (value.back() == '\r' || value.back() == '\n' || value.back() == ' ')) value.remove_suffix(1);
+
+    // Repeated fields are one comma-separated list (RFC 9110 5.3), so split
+    // Cache-Control or Vary lines keep every directive. Set-Cookie cannot be
+    // joined that way and keeps the last line.
+    auto [it, inserted] = response->headers.try_emplace(name, value);
+    if (!inserted) {
+        if (name == "set-cookie" || it->second.empty()) {
+            it->second = value;
+        } else if (!value.empty()) {
+            it->second.append(", ").append(value);
+        }
+    }
     return size * nitems;
 }
 
-int HttpClient::progressCallback(void* /*clientp*/, curl_off_t /*dltotal*/, curl_off_t /*dlnow*/,
+int HttpClient::progressCallback(void* clientp, curl_off_t dltotal, curl_off_t dlnow,
                                  curl_off_t /*ultotal*/, curl_off_t /*ulnow*/) {
+    auto* context = static_cast<RequestContext*>(clientp);
+    if (context && context->options && context->options->progressCallback) {
+        context->options->progressCallback(static_cast<int64_t>(dlnow), static_cast<int64_t>(dltotal));
+    }
     return 0;
 }
 
@@ -20,7 +20,7 @@ namespace konami::utils {
 struct HttpResponse {
     int statusCode{0};
     std::string body;
-    std::map<std::string, std::string> headers;
+    std::map<std::string, std::string> headers;   // Names lower-cased
     std::string error;
     double downloadTime{0.0};
     int64_t contentLength{0};
@@ -57,6 +57,49 @@ struct HttpOptions {
     
     // Custom CA bundle path (optional)
     std::string caBundle;
+    
+    // Advertise the encodings libcurl supports (gzip/deflate with the bundled
+    // curl) and decode bodies transparently
+    bool decompress{true};
+};
+
+/**
+ * @brief Receiver for streamed response bodies
+ * 
+ * Only successful (2xx) bodies are streamed; error bodies are still
+ * buffered into HttpResponse::body. Chunks arrive already decoded.
+ */
+class HttpSink {
+public:
+    virtual ~HttpSink() = default;
+    
+    /**
+     * Called once before the first chunk
+     * @param statusCode Final status code
+     * @param headers Final response headers (lower-cased names)
+     * @param sizeHint Decoded body size if known, -1 otherwise
+     * @return false to abort the transfer
+     */
+    virtual bool begin(int /*statusCode*/, const std::map<std::string, std::string>& /*headers*/,
+                       int64_t /*sizeHint*/) { return true; }
+    
+    /**
+     * Receive a body chunk
+     * @return false to abort the transfer
+     */
+    virtual bool write(const char* data, size_t size) = 0;
+    
+    /**
+     * Called once after begin() when the transfer ends
+     * @param success true if the whole body was delivered
+     * @return false if the sink rejects the body (parse error, hash mismatch)
+     */
+    virtual bool finish(bool success) { return success; }
+    
+    /**
+     * Reason for the last rejection, if any
+     */
+    virtual std::string error() const { return {}; }
 };
 
 /**
@@ -83,8 +126,15 @@ struct FormData {
     }
 };
 
+class HttpCache;
+
 /**
  * @brief Async HTTP client with connection pooling
+ * 
+ * Easy handles are pooled and share DNS and TLS session caches; each
+ * pooled handle keeps its own connections, so repeated requests to a host
+ * reuse keep-alive connections.
+ * GET requests go through an optional HttpCache.
  */
 class HttpClient {
 public:
@@ -105,6 +155,10 @@ public:
     // Set default options
     void setDefaultOptions(const HttpOptions& options);
     
+    // Response cache for GET requests (nullptr disables caching)
+    void setCache(std::shared_ptr<HttpCache> cache);
+    std::shared_ptr<HttpCache> cache() const;
+    
     // Synchronous requests
     HttpResponse get(const std::string& url, const HttpOptions& options = {});
     HttpResponse post(const std::string& url, const std::string& body,
@@ -120,6 +174,12 @@ public:
     HttpResponse del(const std::string& url, const HttpOptions& options = {});
     HttpResponse head(const std::string& url, const HttpOptions& options = {});
     
+    // Streaming requests: body goes to the sink, HttpResponse::body stays empty
+    HttpResponse getStream(const std::string& url, HttpSink& sink,
+                           const HttpOptions& options = {});
+    HttpResponse postStream(const std::string& url, const std::string& body,
+                            HttpSink& sink, const HttpOptions& options = {});
+    
     // Asynchronous requests
     std::future<HttpResponse> getAsync(const std::string& url,
                                         const HttpOptions& options = {});
@@ -130,6 +190,13 @@ public:
                                              const std::string& json,
                                              const HttpOptions& options = {});
     
+    // Concurrent GETs on a pooled multi handle, whose connections stay warm
+    // for the next batch (but are separate from those of single requests).
+    // Without HTTP/2 in libcurl each request gets its own connection.
+    // Bypasses the response cache. Results are in the order of urls.
+    std::vector<HttpResponse> getAll(const std::vector<std::string>& urls,
+                                     const HttpOptions& options = {});
+    
     // Download file
     bool downloadFile(const std::string& url, const std::string& destination,
                       const HttpOptions& options = {});
@@ -152,7 +219,14 @@ private:
     std::unique_ptr<Impl> m_impl;
     
     HttpResponse performRequest(const std::string& method, const std::string& url,
-                                 const std::string& body, const HttpOptions& options);
+                                 const std::string& body, const HttpOptions& options,
+                                 HttpSink* sink = nullptr);
+    HttpResponse transfer(const std::string& method, const std::string& url,
+                          const std::string& body, const HttpOptions& options, HttpSink* sink);
+    HttpResponse cachedGet(HttpCache& cache, const std::string& url,
+                           const HttpOptions& options, HttpSink* sink);
+    HttpResponse execute(CURL* curl, const HttpOptions& options, HttpSink* sink = nullptr);
+    HttpOptions resolveOptions(const HttpOptions& options) const;
     void setupCurl(CURL* curl, const std::string& url, const HttpOptions& options);
     
     static size_t writeCallback(void* contents, size_t size, size_t nmemb, void* userp);
@@ -0,0 +1,471 @@
+// Konami Client - HTTP Sinks
+// Streaming receivers for HttpClient::getStream / postStream
+
+#pragma once
+
+#include "Codec.hpp"
+#include "HttpClient.hpp"
+
+#include <nlohmann/json.hpp>
+#include <openssl/evp.h>
+
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace konami::utils {
+
+/**
+ * @brief Sink that forwards every chunk to a callback
+ */
+class CallbackSink : public HttpSink {
+public:
+    explicit CallbackSink(std::function<bool(std::string_view)> callback)
+        : m_callback(std::move(callback)) {}
+
+    bool write(const char* data, size_t size) override {
+        return m_callback(std::string_view(data, size));
+    }
+
+private:
+    std::function<bool(std::string_view)> m_callback;
+};
+
+/**
+ * @brief Sink that writes the body to a file
+ *
+ * Data goes to "<path>.part" and is renamed into place only when the
+ * transfer completes, so a failed download never leaves a truncated file.
+ */
+class FileSink : public HttpSink {
+public:
+    explicit FileSink(std::filesystem::path path) : m_path(std::move(path)) {}
+
+    ~FileSink() override {
+        if (m_file.is_open()) {
+            m_file.close();
+            std::error_code ec;
+            std::filesystem::remove(partPath(), ec);
+        }
+    }
+
+    bool begin(int, const std::map<std::string, std::string>&, int64_t) override {
+        std::error_code ec;
+        if (m_path.has_parent_path()) {
+            std::filesystem::create_directories(m_path.parent_path(), ec);
+        }
+
+        m_buffer.resize(kBufferSize);
+        m_file.rdbuf()->pubsetbuf(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_file.open(partPath(), std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open()) {
+            m_error = "Cannot open " + partPath().string();
+            return false;
+        }
+        return true;
+    }
+
+    bool write(const char* data, size_t size) override {
+        m_file.write(data, static_cast<std::streamsize>(size));
+        if (!m_file.good()) {
+            m_error = "Write failed: " + partPath().string();
+            return false;
+        }
+        m_written += size;
+        return true;
+    }
+
+    bool finish(bool success) override {
+        m_file.close();
+        std::error_code ec;
+        if (!success || m_file.fail()) {
+            std::filesystem::remove(partPath(), ec);
+            return false;
+        }
+
+        std::filesystem::rename(partPath(), m_path, ec);
+        if (ec) {
+            m_error = "Rename failed: " + ec.message();
+            std::filesystem::remove(partPath(), ec);
+            return false;
+        }
+        return true;
+    }
+
+    std::string error() const override { return m_error; }
+
+    uint64_t bytesWritten() const { return m_written; }
+    const std::filesystem::path& path() const { return m_path; }
+
+private:
+    static constexpr size_t kBufferSize = 256 * 1024;
+
+    std::filesystem::path partPath() const {
+        std::filesystem::path part = m_path;
+        part += ".part";
+        return part;
+    }
+
+    std::filesystem::path m_path;
+    std::ofstream m_file;
+    std::vector<char> m_buffer;
+    uint64_t m_written{0};
+    std::string m_error;
+};
+
+/**
+ * @brief Sink that hashes the body, optionally passing it on to another sink
+ *
+ * With an expected digest set, finish() rejects a mismatching body; chained
+ * with a FileSink this verifies a download before it is renamed into place.
+ */
+class HashSink : public HttpSink {
+public:
+    enum class Algorithm { Sha1, Sha256 };
+
+    /**
+     * Constructor
+     * @param algorithm Digest to compute
+     * @param expectedHex Expected lower- or upper-case hex digest (empty = don't verify)
+     * @param next Optional downstream sink (not owned)
+     */
+    explicit HashSink(Algorithm algorithm = Algorithm::Sha1, std::string expectedHex = {},
+                      HttpSink* next = nullptr)
+        : m_ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free)
+        , m_expected(std::move(expectedHex))
+        , m_next(next) {
+        const EVP_MD* md = algorithm == Algorithm::Sha256 ? EVP_sha256() : EVP_sha1();
+        if (!m_ctx || EVP_DigestInit_ex(m_ctx.get(), md, nullptr) != 1) {
+            m_ctx.reset();
+        }
+    }
+
+    bool begin(int statusCode, const std::map<std::string, std::string>& headers,
+               int64_t sizeHint) override {
+        if (!m_ctx) {
+            m_error = "Failed to initialise digest";
+            return false;
+        }
+        return !m_next || m_next->begin(statusCode, headers, sizeHint);
+    }
+
+    bool write(const char* data, size_t size) override {
+        if (EVP_DigestUpdate(m_ctx.get(), data, size) != 1) {
+            m_error = "Digest update failed";
+            return false;
+        }
+        return !m_next || m_next->write(data, size);
+    }
+
+    bool finish(bool success) override {
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int length = 0;
+        if (success && m_ctx && EVP_DigestFinal_ex(m_ctx.get(), digest, &length) == 1) {
+            m_hex.resize(Codec::hexEncodedSize(length));
+            Codec::hexEncode(digest, length, m_hex.data());
+        }
+
+        bool ok = success && !m_hex.empty();
+        if (ok && !m_expected.empty() && !equalsIgnoreCase(m_hex, m_expected)) {
+            m_error = "Hash mismatch: expected " + m_expected + ", got " + m_hex;
+            ok = false;
+        }
+
+        // The downstream sink must see the verdict so it can discard its output
+        bool nextOk = !m_next || m_next->finish(ok);
+        if (ok && !nextOk) {
+            m_error = m_next->error();
+        }
+        return ok && nextOk;
+    }
+
+    std::string error() const override { return m_error; }
+
+    /**
+     * Get the computed digest (valid after a successful finish)
+     * @return Lower-case hex digest
+     */
+    const std::string& hex() const { return m_hex; }
+
+private:
+    static bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) !=
+                std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> m_ctx;
+    std::string m_expected;
+    HttpSink* m_next;
+    std::string m_hex;
+    std::string m_error;
+};
+
+/**
+ * @brief Incremental JSON sink
+ *
+ * Without an element callback the body is collected (pre-sized from the
+ * size hint) and parsed once at the end, with no intermediate copy.
+ *
+ * With a callback, the array at @p arrayPointer (JSON pointer, "" = root) is
+ * streamed: each element is parsed and handed over as soon as its closing
+ * byte arrives, and dropped afterwards, so memory stays bounded by the
+ * largest element. The rest of the document is still available through
+ * document(), with the streamed array left empty.
+ *
+ * Object keys on the pointer path are matched on their raw (still escaped)
+ * spelling.
+ */
+class JsonSink : public HttpSink {
+public:
+    using json = nlohmann::json;
+    using ElementCallback = std::function<bool(json&& element)>;
+
+    /**
+     * Collect and parse the whole document
+     */
+    JsonSink() = default;
+
+    /**
+     * Stream the elements of an array
+     * @param arrayPointer JSON pointer to the array ("" for a root array)
+     * @param onElement Called per element; return false to abort
+     */
+    JsonSink(const std::string& arrayPointer, ElementCallback onElement)
+        : m_onElement(std::move(onElement)) {
+        size_t pos = arrayPointer.empty() ? std::string::npos : 1;
+        while (pos != std::string::npos && pos <= arrayPointer.size()) {
+            size_t next = arrayPointer.find('/', pos);
+            std::string token = arrayPointer.substr(pos, next == std::string::npos ? std::string::npos : next - pos);
+            for (size_t i = 0; (i = token.find('~', i)) != std::string::npos; ++i) {
+                if (i + 1 < token.size()) {
+                    token.replace(i, 2, token[i + 1] == '1' ? "/" : "~");
+                }
+            }
+            m_target.push_back(std::move(token));
+            pos = next == std::string::npos ? next : next + 1;
+        }
+    }
+
+    bool begin(int, const std::map<std::string, std::string>&, int64_t sizeHint) override {
+        if (!m_onElement && sizeHint > 0) {
+            m_document.reserve(static_cast<size_t>(sizeHint));
+        }
+        return true;
+    }
+
+    bool write(const char* data, size_t size) override {
+        if (!m_onElement) {
+            m_document.append(data, size);
+            return true;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            if (!consume(data[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool finish(bool success) override {
+        if (!success) {
+            return false;
+        }
+
+        m_result = json::parse(m_document, nullptr, false);
+        std::string().swap(m_document);
+        if (m_result.is_discarded()) {
+            m_error = "Invalid JSON document";
+            return false;
+        }
+        return true;
+    }
+
+    std::string error() const override { return m_error; }
+
+    /**
+     * Get the parsed document (without streamed elements)
+     */
+    json& document() { return m_result; }
+
+    /**
+     * Get number of streamed elements
+     */
+    size_t elementCount() const { return m_elements; }
+
+private:
+    struct Frame {
+        bool isObject;
+        bool expectKey;
+        size_t index;
+        std::string key;
+    };
+
+    bool consume(char c) {
+        // Inside the streamed array: route bytes to the element buffer
+        if (m_streaming) {
+            return consumeStreamed(c);
+        }
+
+        m_document += c;
+
+        if (m_inString) {
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+                if (m_capturingKey) {
+                    m_stack.back().key = std::move(m_keyBuffer);
+                    m_keyBuffer.clear();
+                    m_capturingKey = false;
+                }
+            } else if (m_capturingKey) {
+                m_keyBuffer += c;
+            }
+            return true;
+        }
+
+        switch (c) {
+            case '"':
+                m_inString = true;
+                if (!m_stack.empty() && m_stack.back().isObject && m_stack.back().expectKey) {
+                    m_stack.back().expectKey = false;
+                    m_capturingKey = true;
+                }
+                break;
+            case '{':
+                m_stack.push_back({true, true, 0, {}});
+                break;
+            case '[':
+                if (!m_done && atTarget()) {
+                    m_streaming = true;
+                }
+                m_stack.push_back({false, false, 0, {}});
+                break;
+            case '}':
+            case ']':
+                if (!m_stack.empty()) m_stack.pop_back();
+                break;
+            case ',':
+                if (!m_stack.empty()) {
+                    if (m_stack.back().isObject) {
+                        m_stack.back().expectKey = true;
+                    } else {
+                        m_stack.back().index++;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    bool consumeStreamed(char c) {
+        if (m_inString) {
+            m_element += c;
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+            }
+            return true;
+        }
+
+        // m_nesting counts containers opened inside the current element
+        if (m_nesting == 0 && (c == ',' || c == ']')) {
+            if (!emitElement()) {
+                return false;
+            }
+            if (c == ']') {
+                m_streaming = false;
+                m_done = true;
+                m_document += c;
+                m_stack.pop_back();
+            }
+            return true;
+        }
+
+        switch (c) {
+            case '"': m_inString = true; break;
+            case '{': case '[': m_nesting++; break;
+            case '}': case ']': m_nesting--; break;
+            default: break;
+        }
+
+        if (m_element.empty() && std::isspace(static_cast<unsigned char>(c))) {
+            return true;
+        }
+        m_element += c;
+        return true;
+    }
+
+    bool emitElement() {
+        if (m_element.empty()) {
+            return true;
+        }
+
+        json element = json::parse(m_element, nullptr, false);
+        m_element.clear();
+        if (element.is_discarded()) {
+            m_error = "Invalid JSON in element " + std::to_string(m_elements);
+            return false;
+        }
+
+        m_elements++;
+        if (!m_onElement(std::move(element))) {
+            m_error = "Aborted by element callback";
+            return false;
+        }
+        return true;
+    }
+
+    bool atTarget() const {
+        if (m_stack.size() != m_target.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < m_stack.size(); ++i) {
+            const Frame& frame = m_stack[i];
+            const std::string& token = m_target[i];
+            if (frame.isObject ? frame.key != token : std::to_string(frame.index) != token) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ElementCallback m_onElement;
+    std::vector<std::string> m_target;
+
+    std::string m_document;
+    std::string m_element;
+    std::string m_keyBuffer;
+    std::vector<Frame> m_stack;
+    bool m_inString{false};
+    bool m_escape{false};
+    bool m_capturingKey{false};
+    bool m_streaming{false};
+    bool m_done{false};
+    int m_nesting{0};
+    size_t m_elements{0};
+
+    json m_result;
+    std::string m_error;
+};
+
+} // namespace konami::utils
@@ -0,0 +1,1090 @@
+/**
+ * JsonSchema.cpp
+ *
+ * The program is a vector of nodes, one per subschema, addressed by index
+ * so that $ref cycles are just back edges. Each node is a list of checks
+ * run in order (cheap type and size checks first). Validation has two
+ * modes: collecting, which keeps going and records every error with the
+ * instance path, and probing, which stops at the first failure and records
+ * nothing. anyOf, oneOf, not, if, contains and propertyNames always probe,
+ * so a failed alternative does not leak errors into the report.
+ */
+
+#include "JsonSchema.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <unordered_map>
+
+namespace konami::utils {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+constexpr int kMaxDepth = 256;
+
+enum TypeBits : uint8_t {
+    kNull = 1 << 0,
+    kBoolean = 1 << 1,
+    kObject = 1 << 2,
+    kArray = 1 << 3,
+    kNumber = 1 << 4,
+    kInteger = 1 << 5,
+    kString = 1 << 6,
+};
+
+constexpr std::pair<const char*, uint8_t> kTypeNames[] = {
+    {"null", kNull}, {"boolean", kBoolean}, {"object", kObject}, {"array", kArray},
+    {"number", kNumber}, {"integer", kInteger}, {"string", kString},
+};
+
+/**
+ * Hash consistent with json equality: numbers hash by value, so 1 and 1.0
+ * (equal under 2020-12 and json::operator==) land in the same bucket.
+ * std::hash<json> hashes the number type too.
+ */
+size_t valueHash(const json& value) {
+    auto combine = [](size_t seed, size_t h) { return seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)); };
+    switch (value.type()) {
+        case json::value_t::number_integer:
+        case json::value_t::number_unsigned:
+        case json::value_t::number_float: {
+            double number = value.get<double>();
+            return std::hash<double>{}(number == 0.0 ? 0.0 : number);
+        }
+        case json::value_t::array: {
+            size_t seed = value.size();
+            for (const auto& item : value) seed = combine(seed, valueHash(item));
+            return seed;
+        }
+        case json::value_t::object: {
+            size_t seed = value.size() + 1;
+            for (auto it = value.begin(); it != value.end(); ++it) {
+                seed = combine(seed, std::hash<std::string>{}(it.key()));
+                seed = combine(seed, valueHash(it.value()));
+            }
+            return seed;
+        }
+        default:
+            return std::hash<json>{}(value);
+    }
+}
+
+uint8_t typeBits(const json& value) {
+    switch (value.type()) {
+        case json::value_t::null: return kNull;
+        case json::value_t::boolean: return kBoolean;
+        case json::value_t::object: return kObject;
+        case json::value_t::array: return kArray;
+        case json::value_t::string: return kString;
+        case json::value_t::number_integer:
+        case json::value_t::number_unsigned: return kNumber | kInteger;
+        case json::value_t::number_float: {
+            double d = value.get<double>();
+            return std::isfinite(d) && d == std::floor(d) ? kNumber | kInteger : kNumber;
+        }
+        default: return 0;
+    }
+}
+
+std::string typeList(uint8_t mask) {
+    std::string names;
+    for (const auto& [name, bit] : kTypeNames) {
+        if (!(mask & bit)) continue;
+        if (!names.empty()) names += " or ";
+        names += name;
+    }
+    return names;
+}
+
+size_t codePoints(const std::string& text) {
+    size_t count = 0;
+    for (unsigned char c : text) count += (c & 0xC0) != 0x80;
+    return count;
+}
+
+std::string escapeToken(const std::string& token) {
+    std::string escaped;
+    escaped.reserve(token.size());
+    for (char c : token) {
+        if (c == '~') escaped += "~0";
+        else if (c == '/') escaped += "~1";
+        else escaped += c;
+    }
+    return escaped;
+}
+
+std::string percentDecode(std::string_view text) {
+    std::string decoded;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '%' && i + 2 < text.size()) {
+            int value = 0;
+            bool ok = true;
+            for (size_t k = 1; k <= 2; ++k) {
+                char c = text[i + k];
+                value <<= 4;
+                if (c >= '0' && c <= '9') value |= c - '0';
+                else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+                else ok = false;
+            }
+            if (ok) {
+                decoded += static_cast<char>(value);
+                i += 2;
+                continue;
+            }
+        }
+        decoded += text[i];
+    }
+    return decoded;
+}
+
+/**
+ * ECMAScript regex for pattern and patternProperties. Schema patterns are
+ * mostly anchored runs of character classes ("^[0-9a-f]{40}$",
+ * "^[^:]+:[^:]+"). Those compile to at most 63 atoms run as a bit-parallel
+ * NFA: one 64-bit state word and a per-byte mask of the atoms accepting
+ * that byte, so each input byte costs a few instructions. Anything richer
+ * (groups, alternation, assertions, backreferences) goes to std::regex.
+ * Both match bytes, not code points.
+ */
+class Pattern {
+public:
+    /**
+     * @return Pattern, or nullopt with `error` set if the pattern uses syntax
+     *         std::regex lacks or std::regex rejects it
+     */
+    static std::optional<Pattern> compile(const std::string& source, std::string& error) {
+        Pattern pattern;
+        if (pattern.parse(source)) return pattern;
+        if (usesPropertyEscape(source)) {
+            error = "unsupported pattern: Unicode property escapes (\\p{...}) are not supported";
+            return std::nullopt;
+        }
+        try {
+            pattern.m_regex = std::make_shared<std::regex>(source, std::regex::ECMAScript | std::regex::optimize);
+        } catch (const std::regex_error& e) {
+            error = std::string("invalid pattern: ") + e.what();
+            return std::nullopt;
+        }
+        return pattern;
+    }
+
+    bool search(const std::string& text) const {
+        if (m_regex) return std::regex_search(text, *m_regex);
+
+        const uint64_t accept = uint64_t{1} << m_atoms;
+        uint64_t state = closure(1);
+        if ((state & accept) && !m_anchorEnd) return true;
+        for (unsigned char c : text) {
+            uint64_t moving = state & m_accepts[c];
+            state = closure(((moving & ~m_loop) << 1) | (moving & m_loop));
+            if (!m_anchorStart) state = closure(state | 1);
+            if ((state & accept) && !m_anchorEnd) return true;
+            if (!state) return false;
+        }
+        return (state & accept) != 0;
+    }
+
+private:
+    using ByteSet = std::bitset<256>;
+
+    /**
+     * \p{...} / \P{...}: valid in 2020-12 patterns, but std::regex either
+     * rejects them or reads them as a literal 'p'
+     */
+    static bool usesPropertyEscape(const std::string& source) {
+        for (size_t i = 0; i + 2 < source.size(); ++i) {
+            if (source[i] != '\\') continue;
+            if ((source[i + 1] == 'p' || source[i + 1] == 'P') && source[i + 2] == '{') return true;
+            ++i;    // Skip the escaped character
+        }
+        return false;
+    }
+
+    static constexpr int kMaxAtoms = 63;
+    static constexpr size_t kUnbounded = SIZE_MAX;
+
+    uint64_t closure(uint64_t state) const {
+        // Optional and starred atoms can be skipped; skipping only moves forward
+        for (;;) {
+            uint64_t next = state | ((state & m_skip) << 1);
+            if (next == state) return state;
+            state = next;
+        }
+    }
+
+    static int single(const ByteSet& set) {
+        if (set.count() != 1) return -1;
+        for (int b = 0; b < 256; ++b) {
+            if (set[static_cast<size_t>(b)]) return b;
+        }
+        return -1;
+    }
+
+    static ByteSet classEscape(char c, bool& ok) {
+        ByteSet set;
+        auto range = [&](char from, char to) { for (int b = from; b <= to; ++b) set.set(static_cast<unsigned char>(b)); };
+        switch (c) {
+            case 'd': case 'D': range('0', '9'); break;
+            case 'w': case 'W': range('a', 'z'); range('A', 'Z'); range('0', '9'); set.set('_'); break;
+            case 's': case 'S': for (char w : {' ', '\t', '\n', '\r', '\f', '\v'}) set.set(static_cast<unsigned char>(w)); break;
+            case 'n': set.set('\n'); return set;
+            case 't': set.set('\t'); return set;
+            case 'r': set.set('\r'); return set;
+            case 'f': set.set('\f'); return set;
+            case 'v': set.set('\v'); return set;
+            default:
+                // Other letters and digits are classes, code points or backreferences
+                if (std::isalnum(static_cast<unsigned char>(c)) || static_cast<unsigned char>(c) >= 0x80) ok = false;
+                else set.set(static_cast<unsigned char>(c));
+                return set;
+        }
+        if (std::isupper(static_cast<unsigned char>(c))) set.flip();
+        return set;
+    }
+
+    bool parseClass(const std::string& s, size_t& i, ByteSet& set) {
+        bool negate = i < s.size() && s[i] == '^';
+        if (negate) ++i;
+        if (i < s.size() && s[i] == ']') return false;  // "[]" and "[^]" are special in ECMAScript
+        while (i < s.size() && s[i] != ']') {
+            ByteSet item;
+            int low = -1;
+            bool ok = true;
+            if (s[i] == '\\' && i + 1 < s.size()) {
+                item = classEscape(s[i + 1], ok);
+                low = single(item);
+                i += 2;
+            } else {
+                low = static_cast<unsigned char>(s[i++]);
+                item.set(static_cast<size_t>(low));
+            }
+            if (!ok || low >= 0x80) return false;
+            // Range "a-z" (a trailing '-' is literal)
+            if (low >= 0 && i + 1 < s.size() && s[i] == '-' && s[i + 1] != ']') {
+                int high;
+                if (s[i + 1] == '\\') {
+                    if (i + 2 >= s.size()) return false;
+                    ByteSet end = classEscape(s[i + 2], ok);
+                    high = single(end);
+                    if (!ok || high < 0) return false;
+                    i += 3;
+                } else {
+                    high = static_cast<unsigned char>(s[i + 1]);
+                    i += 2;
+                }
+                if (high < low || high >= 0x80) return false;
+                for (int b = low; b <= high; ++b) item.set(static_cast<size_t>(b));
+            }
+            set |= item;
+        }
+        if (i >= s.size()) return false;
+        ++i;  // ']'
+        if (negate) set.flip();
+        return true;
+    }
+
+    bool parseQuantifier(const std::string& s, size_t& i, size_t& min, size_t& max) {
+        min = max = 1;
+        if (i >= s.size()) return true;
+        switch (s[i]) {
+            case '*': min = 0; max = kUnbounded; ++i; break;
+            case '+': min = 1; max = kUnbounded; ++i; break;
+            case '?': min = 0; max = 1; ++i; break;
+            case '{': {
+                size_t j = i + 1;
+                auto number = [&](size_t& out) {
+                    size_t start = j;
+                    out = 0;
+                    while (j < s.size() && std::isdigit(static_cast<unsigned char>(s[j])) && j - start < 4) {
+                        out = out * 10 + static_cast<size_t>(s[j++] - '0');
+                    }
+                    return j > start;
+                };
+                if (!number(min)) return false;
+                max = min;
+                if (j < s.size() && s[j] == ',') {
+                    ++j;
+                    max = kUnbounded;
+                    if (j < s.size() && s[j] != '}' && !number(max)) return false;
+                }
+                if (j >= s.size() || s[j] != '}' || max < min) return false;
+                i = j + 1;
+                break;
+            }
+            default: return true;
+        }
+        if (i < s.size() && s[i] == '?') ++i;  // Laziness does not change whether it matches
+        return true;
+    }
+
+    bool parse(const std::string& s) {
+        size_t i = 0;
+        if (i < s.size() && s[i] == '^') {
+            m_anchorStart = true;
+            ++i;
+        }
+        while (i < s.size()) {
+            char c = s[i];
+            if (c == '$' && i + 1 == s.size()) {
+                m_anchorEnd = true;
+                break;
+            }
+            ByteSet set;
+            bool ok = true;
+            if (c == '.') {
+                set.set().reset('\n').reset('\r');
+                ++i;
+            } else if (c == '[') {
+                ++i;
+                if (!parseClass(s, i, set)) return false;
+            } else if (c == '\\' && i + 1 < s.size()) {
+                set = classEscape(s[i + 1], ok);
+                i += 2;
+            } else if (std::strchr("()|*+?{}[]^$\\", c) || static_cast<unsigned char>(c) >= 0x80) {
+                return false;
+            } else {
+                set.set(static_cast<unsigned char>(c));
+                ++i;
+            }
+            size_t min, max;
+            if (!ok || !parseQuantifier(s, i, min, max)) return false;
+
+            size_t copies = min + (max == kUnbounded ? 1 : max - min);
+            if (m_atoms + copies > kMaxAtoms) return false;
+            for (size_t k = 0; k < copies; ++k) {
+                uint64_t bit = uint64_t{1} << m_atoms++;
+                for (size_t b = 0; b < 256; ++b) {
+                    if (set[b]) m_accepts[b] |= bit;
+                }
+                if (k >= min) m_skip |= bit;
+                if (k >= min && max == kUnbounded) m_loop |= bit;
+            }
+        }
+        return true;
+    }
+
+    std::array<uint64_t, 256> m_accepts{};
+    uint64_t m_skip = 0;     // Atoms that may match nothing (?, *, optional copies)
+    uint64_t m_loop = 0;     // Atoms that may repeat (*)
+    size_t m_atoms = 0;
+    bool m_anchorStart = false;
+    bool m_anchorEnd = false;
+    std::shared_ptr<const std::regex> m_regex;  // Set when the pattern is not simple
+};
+
+} // namespace
+
+// -- Program --
+
+struct JsonSchema::Program {
+    enum class Op : uint8_t {
+        Type, Enum, Const,
+        Minimum, Maximum, ExclusiveMinimum, ExclusiveMaximum, MultipleOf,
+        MinLength, MaxLength, Pattern,
+        MinItems, MaxItems, UniqueItems, Items, Contains,
+        MinProperties, MaxProperties, Required, DependentRequired, Properties, PropertyNames,
+        AllOf, AnyOf, OneOf, Not, Conditional, Ref, False,
+    };
+
+    struct Check {
+        Check(Op op, std::string path) : op(op), path(std::move(path)) {}
+
+        Op op;
+        std::string path;                   // Schema pointer of the keyword
+        double number = 0;                  // Numeric bounds, multipleOf
+        size_t count = 0;                   // Type mask, size bounds, regex index, minContains
+        size_t limit = SIZE_MAX;            // maxContains
+        uint32_t node = kNone;              // items / additional / contains / not / $ref target
+        std::vector<uint32_t> nodes;        // prefixItems, allOf/anyOf/oneOf, if/then/else
+        std::vector<std::string> names;     // required, enum strings (sorted)
+        std::vector<json> values;           // enum non-strings, const
+        std::vector<std::pair<std::string, uint32_t>> properties;   // sorted by name
+        std::vector<std::pair<size_t, uint32_t>> patterns;          // regex index, node
+        std::vector<std::pair<std::string, std::vector<std::string>>> dependencies;
+    };
+
+    struct Node {
+        std::string path;
+        std::vector<Check> checks;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Pattern> regexes;
+};
+
+namespace {
+
+using Program = JsonSchema::Program;
+using Op = Program::Op;
+using Check = Program::Check;
+using Node = Program::Node;
+
+// -- Compiler --
+
+class Compiler {
+public:
+    Compiler(const json& root, Program& program) : m_root(root), m_program(program) {}
+
+    bool run() {
+        compile(m_root, "");
+        // Resolving may compile more nodes (refs into non-schema locations),
+        // which may add more refs
+        for (size_t i = 0; i < m_refs.size() && m_error.empty(); ++i) {
+            const auto pending = m_refs[i];
+            uint32_t target = resolve(pending.ref);
+            if (target == kNone) {
+                if (m_error.empty()) m_error = "Cannot resolve $ref \"" + pending.ref + "\"";
+                break;
+            }
+            m_program.nodes[pending.node].checks[pending.check].node = target;
+        }
+        return m_error.empty();
+    }
+
+    const std::string& error() const { return m_error; }
+
+private:
+    struct PendingRef {
+        uint32_t node;
+        size_t check;
+        std::string ref;
+    };
+
+    uint32_t compile(const json& schema, const std::string& pointer) {
+        if (auto it = m_byPointer.find(pointer); it != m_byPointer.end()) return it->second;
+
+        auto index = static_cast<uint32_t>(m_program.nodes.size());
+        m_program.nodes.push_back({pointer, {}});
+        m_byPointer.emplace(pointer, index);
+
+        std::vector<Check> checks;
+        if (schema.is_boolean()) {
+            if (!schema.get<bool>()) checks.push_back({Op::False, pointer});
+        } else if (schema.is_object()) {
+            compileObject(schema, pointer, index, checks);
+        } else {
+            fail(pointer, "schema must be an object or a boolean");
+        }
+        m_program.nodes[index].checks = std::move(checks);
+        return index;
+    }
+
+    void compileObject(const json& schema, const std::string& pointer, uint32_t index, std::vector<Check>& checks) {
+        auto keyword = [&](const char* name) -> const json* {
+            auto it = schema.find(name);
+            return it == schema.end() ? nullptr : &*it;
+        };
+        auto path = [&](const char* name) { return pointer + "/" + name; };
+        auto sub = [&](const json& value, const std::string& at) { return compile(value, at); };
+
+        for (const char* unsupported : {"unevaluatedProperties", "unevaluatedItems", "$dynamicRef", "$recursiveRef"}) {
+            if (keyword(unsupported)) fail(path(unsupported), "keyword is not supported");
+        }
+        if (const json* anchor = keyword("$anchor"); anchor && anchor->is_string()) {
+            m_anchors.emplace(anchor->get<std::string>(), index);
+        }
+        for (const char* defs : {"$defs", "definitions"}) {
+            if (const json* value = keyword(defs); value && value->is_object()) {
+                for (auto it = value->begin(); it != value->end(); ++it) {
+                    sub(it.value(), path(defs) + "/" + escapeToken(it.key()));
+                }
+            }
+        }
+
+        if (const json* value = keyword("$ref")) {
+            if (!value->is_string()) return fail(path("$ref"), "must be a string");
+            checks.push_back({Op::Ref, path("$ref")});
+            m_refs.push_back({index, checks.size() - 1, value->get<std::string>()});
+        }
+
+        // Generic
+        if (const json* value = keyword("type")) {
+            Check check{Op::Type, path("type")};
+            auto add = [&](const json& name) {
+                for (const auto& [typeName, bit] : kTypeNames) {
+                    if (name.is_string() && name.get_ref<const std::string&>() == typeName) {
+                        check.count |= bit;
+                        return;
+                    }
+                }
+                fail(check.path, "unknown type " + name.dump());
+            };
+            if (value->is_array()) for (const auto& name : *value) add(name);
+            else add(*value);
+            checks.push_back(std::move(check));
+        }
+        if (const json* value = keyword("enum")) {
+            if (!value->is_array()) return fail(path("enum"), "must be an array");
+            Check check{Op::Enum, path("enum")};
+            for (const auto& item : *value) {
+                if (item.is_string()) check.names.push_back(item.get<std::string>());
+                else check.values.push_back(item);
+            }
+            std::sort(check.names.begin(), check.names.end());
+            checks.push_back(std::move(check));
+        }
+        if (const json* value = keyword("const")) {
+            Check check{Op::Const, path("const")};
+            check.values.push_back(*value);
+            checks.push_back(std::move(check));
+        }
+
+        // Numbers
+        for (auto [name, op] : {std::pair{"minimum", Op::Minimum}, {"maximum", Op::Maximum},
+                                {"exclusiveMinimum", Op::ExclusiveMinimum},
+                                {"exclusiveMaximum", Op::ExclusiveMaximum}, {"multipleOf", Op::MultipleOf}}) {
+            const json* value = keyword(name);
+            if (!value) continue;
+            if (!value->is_number() || (op == Op::MultipleOf && value->get<double>() <= 0)) {
+                fail(path(name), op == Op::MultipleOf ? "must be a positive number" : "must be a number");
+                continue;
+            }
+            Check check{op, path(name)};
+            check.number = value->get<double>();
+            checks.push_back(std::move(check));
+        }
+
+        // Sizes
+        for (auto [name, op] : {std::pair{"minLength", Op::MinLength}, {"maxLength", Op::MaxLength},
+                                {"minItems", Op::MinItems}, {"maxItems", Op::MaxItems},
+                                {"minProperties", Op::MinProperties}, {"maxProperties", Op::MaxProperties}}) {
+            const json* value = keyword(name);
+            if (!value) continue;
+            Check check{op, path(name)};
+            if (count(*value, check.count, check.path)) checks.push_back(std::move(check));
+        }
+
+        // Strings
+        if (const json* value = keyword("pattern")) {
+            Check check{Op::Pattern, path("pattern")};
+            if (regex(*value, check.count, check.path)) checks.push_back(std::move(check));
+        }
+
+        // Arrays
+        if (const json* value = keyword("uniqueItems"); value && value->is_boolean() && value->get<bool>()) {
+            checks.push_back({Op::UniqueItems, path("uniqueItems")});
+        }
+        {
+            Check check{Op::Items, path("items")};
+            const json* prefix = keyword("prefixItems");
+            const json* items = keyword("items");
+            const json* additional = keyword("additionalItems");
+            if (prefix) {
+                if (!prefix->is_array()) return fail(path("prefixItems"), "must be an array");
+                for (size_t i = 0; i < prefix->size(); ++i) {
+                    check.nodes.push_back(sub((*prefix)[i], path("prefixItems") + "/" + std::to_string(i)));
+                }
+                if (items) check.node = sub(*items, path("items"));
+            } else if (items && items->is_array()) {
+                // Draft-07 tuple form
+                for (size_t i = 0; i < items->size(); ++i) {
+                    check.nodes.push_back(sub((*items)[i], path("items") + "/" + std::to_string(i)));
+                }
+                if (additional) check.node = sub(*additional, path("additionalItems"));
+            } else if (items) {
+                check.node = sub(*items, path("items"));
+            }
+            if (!check.nodes.empty() || check.node != kNone) checks.push_back(std::move(check));
+        }
+        if (const json* value = keyword("contains")) {
+            Check check{Op::Contains, path("contains")};
+            check.node = sub(*value, check.path);
+            check.count = 1;
+            if (const json* min = keyword("minContains")) count(*min, check.count, path("minContains"));
+            if (const json* max = keyword("maxContains")) count(*max, check.limit, path("maxContains"));
+            checks.push_back(std::move(check));
+        }
+
+        // Objects
+        if (const json* value = keyword("required")) {
+            Check check{Op::Required, path("required")};
+            if (strings(*value, check.names, check.path)) checks.push_back(std::move(check));
+        }
+        if (const json* value = keyword("dependentRequired")) {
+            Check check{Op::DependentRequired, path("dependentRequired")};
+            if (!value->is_object()) return fail(check.path, "must be an object");
+            for (auto it = value->begin(); it != value->end(); ++it) {
+                std::vector<std::string> names;
+                if (strings(it.value(), names, check.path + "/" + escapeToken(it.key()))) {
+                    check.dependencies.emplace_back(it.key(), std::move(names));
+                }
+            }
+            checks.push_back(std::move(check));
+        }
+        {
+            Check check{Op::Properties, path("properties")};
+            if (const json* value = keyword("properties")) {
+                if (!value->is_object()) return fail(check.path, "must be an object");
+                for (auto it = value->begin(); it != value->end(); ++it) {
+                    check.properties.emplace_back(it.key(), sub(it.value(), check.path + "/" + escapeToken(it.key())));
+                }
+                // nlohmann objects iterate in key order already; keep the invariant explicit
+                std::sort(check.properties.begin(), check.properties.end());
+            }
+            if (const json* value = keyword("patternProperties")) {
+                if (!value->is_object()) return fail(path("patternProperties"), "must be an object");
+                for (auto it = value->begin(); it != value->end(); ++it) {
+                    std::string at = path("patternProperties") + "/" + escapeToken(it.key());
+                    size_t regexIndex = 0;
+                    if (regex(it.key(), regexIndex, at)) check.patterns.emplace_back(regexIndex, sub(it.value(), at));
+                }
+            }
+            if (const json* value = keyword("additionalProperties")) {
+                check.node = sub(*value, path("additionalProperties"));
+            }
+            if (!check.properties.empty() || !check.patterns.empty() || check.node != kNone) {
+                checks.push_back(std::move(check));
+            }
+        }
+        if (const json* value = keyword("propertyNames")) {
+            Check check{Op::PropertyNames, path("propertyNames")};
+            check.node = sub(*value, check.path);
+            checks.push_back(std::move(check));
+        }
+
+        // Composition
+        for (auto [name, op] : {std::pair{"allOf", Op::AllOf}, {"anyOf", Op::AnyOf}, {"oneOf", Op::OneOf}}) {
+            const json* value = keyword(name);
+            if (!value) continue;
+            if (!value->is_array() || value->empty()) {
+                fail(path(name), "must be a non-empty array");
+                continue;
+            }
+            Check check{op, path(name)};
+            for (size_t i = 0; i < value->size(); ++i) {
+                check.nodes.push_back(sub((*value)[i], check.path + "/" + std::to_string(i)));
+            }
+            checks.push_back(std::move(check));
+        }
+        if (const json* value = keyword("not")) {
+            Check check{Op::Not, path("not")};
+            check.node = sub(*value, check.path);
+            checks.push_back(std::move(check));
+        }
+        if (const json* value = keyword("if")) {
+            Check check{Op::Conditional, path("if")};
+            const json* then = keyword("then");
+            const json* otherwise = keyword("else");
+            check.nodes = {sub(*value, path("if")),
+                           then ? sub(*then, path("then")) : kNone,
+                           otherwise ? sub(*otherwise, path("else")) : kNone};
+            checks.push_back(std::move(check));
+        }
+    }
+
+    uint32_t resolve(const std::string& ref) {
+        if (ref.empty() || ref[0] != '#') {
+            m_error = "Only references within the schema are supported: \"" + ref + "\"";
+            return kNone;
+        }
+        std::string fragment = percentDecode(std::string_view(ref).substr(1));
+        if (fragment.empty()) return 0;
+        if (fragment[0] != '/') {
+            auto it = m_anchors.find(fragment);
+            return it == m_anchors.end() ? kNone : it->second;
+        }
+        if (auto it = m_byPointer.find(fragment); it != m_byPointer.end()) return it->second;
+        try {
+            json::json_pointer pointer(fragment);
+            if (!m_root.contains(pointer)) return kNone;
+            return compile(m_root.at(pointer), fragment);
+        } catch (const json::exception&) {
+            return kNone;
+        }
+    }
+
+    bool count(const json& value, size_t& out, const std::string& at) {
+        if (value.is_number_unsigned() || (value.is_number_integer() && value.get<int64_t>() >= 0)) {
+            out = value.get<size_t>();
+            return true;
+        }
+        if (value.is_number_float() && value.get<double>() >= 0 && value.get<double>() == std::floor(value.get<double>())) {
+            out = static_cast<size_t>(value.get<double>());
+            return true;
+        }
+        fail(at, "must be a non-negative integer");
+        return false;
+    }
+
+    bool strings(const json& value, std::vector<std::string>& out, const std::string& at) {
+        if (!value.is_array()) {
+            fail(at, "must be an array of strings");
+            return false;
+        }
+        for (const auto& item : value) {
+            if (!item.is_string()) {
+                fail(at, "must be an array of strings");
+                return false;
+            }
+            out.push_back(item.get<std::string>());
+        }
+        return true;
+    }
+
+    bool regex(const json& value, size_t& out, const std::string& at) {
+        if (!value.is_string()) {
+            fail(at, "must be a string");
+            return false;
+        }
+        std::string error;
+        auto pattern = Pattern::compile(value.get<std::string>(), error);
+        if (!pattern) {
+            fail(at, error);
+            return false;
+        }
+        m_program.regexes.push_back(std::move(*pattern));
+        out = m_program.regexes.size() - 1;
+        return true;
+    }
+
+    void fail(const std::string& at, const std::string& message) {
+        if (m_error.empty()) m_error = (at.empty() ? "/" : at) + ": " + message;
+    }
+
+    const json& m_root;
+    Program& m_program;
+    std::unordered_map<std::string, uint32_t> m_byPointer;
+    std::unordered_map<std::string, uint32_t> m_anchors;
+    std::vector<PendingRef> m_refs;
+    std::string m_error;
+};
+
+// -- Validator --
+
+class Validator {
+public:
+    Validator(const Program& program, std::vector<JsonSchema::Error>* errors)
+        : m_program(program), m_errors(errors) {}
+
+    bool run(uint32_t index, const json& instance, int depth) {
+        if (depth > kMaxDepth) {
+            const Node& node = m_program.nodes[index];
+            return report(node.path, "schema recursion is too deep");
+        }
+        bool ok = true;
+        for (const Check& check : m_program.nodes[index].checks) {
+            if (!apply(check, instance, depth)) {
+                ok = false;
+                if (!m_errors) return false;
+            }
+        }
+        return ok;
+    }
+
+private:
+    struct Segment {
+        const std::string* key;
+        size_t index;
+    };
+
+    /**
+     * Validate without recording errors (alternatives, conditions)
+     */
+    bool probe(uint32_t index, const json& instance, int depth) {
+        auto* saved = m_errors;
+        m_errors = nullptr;
+        bool ok = run(index, instance, depth);
+        m_errors = saved;
+        return ok;
+    }
+
+    bool child(uint32_t index, const json& instance, int depth, Segment segment) {
+        m_path.push_back(segment);
+        bool ok = run(index, instance, depth + 1);
+        m_path.pop_back();
+        return ok;
+    }
+
+    bool report(const std::string& schemaPath, std::string message) {
+        if (m_errors) m_errors->push_back({pointer(), schemaPath, std::move(message)});
+        return false;
+    }
+
+    std::string pointer() const {
+        std::string result;
+        for (const auto& segment : m_path) {
+            result += '/';
+            result += segment.key ? escapeToken(*segment.key) : std::to_string(segment.index);
+        }
+        return result;
+    }
+
+    bool isFalse(uint32_t index) const {
+        const auto& checks = m_program.nodes[index].checks;
+        return checks.size() == 1 && checks[0].op == Op::False;
+    }
+
+    bool apply(const Check& check, const json& instance, int depth) {
+        switch (check.op) {
+            case Op::Type: {
+                uint8_t bits = typeBits(instance);
+                if (bits & check.count) return true;
+                return report(check.path, "expected " + typeList(static_cast<uint8_t>(check.count)) +
+                                          ", got " + instance.type_name());
+            }
+            case Op::Enum: {
+                if (instance.is_string() &&
+                    std::binary_search(check.names.begin(), check.names.end(), instance.get_ref<const std::string&>())) {
+                    return true;
+                }
+                for (const auto& value : check.values) {
+                    if (value == instance) return true;
+                }
+                return report(check.path, "value is not one of the allowed values");
+            }
+            case Op::Const:
+                return check.values[0] == instance || report(check.path, "value must be " + check.values[0].dump());
+
+            case Op::Minimum:
+            case Op::Maximum:
+            case Op::ExclusiveMinimum:
+            case Op::ExclusiveMaximum: {
+                if (!instance.is_number()) return true;
+                double value = instance.get<double>();
+                bool ok = check.op == Op::Minimum ? value >= check.number
+                        : check.op == Op::Maximum ? value <= check.number
+                        : check.op == Op::ExclusiveMinimum ? value > check.number
+                        : value < check.number;
+                if (ok) return true;
+                const char* relation = check.op == Op::Minimum ? ">=" : check.op == Op::Maximum ? "<="
+                                     : check.op == Op::ExclusiveMinimum ? ">" : "<";
+                return report(check.path, "must be " + std::string(relation) + " " + json(check.number).dump());
+            }
+            case Op::MultipleOf: {
+                if (!instance.is_number()) return true;
+                bool ok;
+                if (instance.is_number_integer() && check.number == std::floor(check.number) && check.number < 9.0e18) {
+                    auto divisor = static_cast<int64_t>(check.number);
+                    ok = instance.is_number_unsigned()
+                        ? instance.get<uint64_t>() % static_cast<uint64_t>(divisor) == 0
+                        : instance.get<int64_t>() % divisor == 0;
+                } else {
+                    double quotient = instance.get<double>() / check.number;
+                    ok = std::isfinite(quotient) &&
+                         std::abs(quotient - std::round(quotient)) <= 1e-9 * std::max(1.0, std::abs(quotient));
+                }
+                return ok || report(check.path, "must be a multiple of " + json(check.number).dump());
+            }
+
+            case Op::MinLength:
+            case Op::MaxLength: {
+                if (!instance.is_string()) return true;
+                size_t length = codePoints(instance.get_ref<const std::string&>());
+                if (check.op == Op::MinLength ? length >= check.count : length <= check.count) return true;
+                return report(check.path, (check.op == Op::MinLength ? "shorter than " : "longer than ") +
+                                          std::to_string(check.count) + " characters");
+            }
+            case Op::Pattern: {
+                if (!instance.is_string()) return true;
+                if (m_program.regexes[check.count].search(instance.get_ref<const std::string&>())) return true;
+                return report(check.path, "does not match the pattern");
+            }
+
+            case Op::MinItems:
+            case Op::MaxItems: {
+                if (!instance.is_array()) return true;
+                if (check.op == Op::MinItems ? instance.size() >= check.count : instance.size() <= check.count) {
+                    return true;
+                }
+                return report(check.path, (check.op == Op::MinItems ? "fewer than " : "more than ") +
+                                          std::to_string(check.count) + " items");
+            }
+            case Op::UniqueItems: {
+                if (!instance.is_array() || instance.size() < 2) return true;
+                std::unordered_multimap<size_t, size_t> seen;
+                seen.reserve(instance.size());
+                for (size_t i = 0; i < instance.size(); ++i) {
+                    size_t h = valueHash(instance[i]);
+                    auto [begin, end] = seen.equal_range(h);
+                    for (auto it = begin; it != end; ++it) {
+                        if (instance[it->second] == instance[i]) {
+                            return report(check.path, "items " + std::to_string(it->second) + " and " +
+                                                      std::to_string(i) + " are equal");
+                        }
+                    }
+                    seen.emplace(h, i);
+                }
+                return true;
+            }
+            case Op::Items: {
+                if (!instance.is_array()) return true;
+                bool ok = true;
+                for (size_t i = 0; i < instance.size(); ++i) {
+                    uint32_t node = i < check.nodes.size() ? check.nodes[i] : check.node;
+                    if (node == kNone) break;
+                    if (!child(node, instance[i], depth, {nullptr, i})) {
+                        ok = false;
+                        if (!m_errors) return false;
+                    }
+                }
+                return ok;
+            }
+            case Op::Contains: {
+                if (!instance.is_array()) return true;
+                size_t matches = 0;
+                for (const auto& item : instance) {
+                    if (probe(check.node, item, depth + 1) && ++matches > check.limit) break;
+                }
+                if (matches < check.count) {
+                    return report(check.path, "fewer than " + std::to_string(check.count) + " matching items");
+                }
+                if (matches > check.limit) {
+                    return report(check.path, "more than " + std::to_string(check.limit) + " matching items");
+                }
+                return true;
+            }
+
+            case Op::MinProperties:
+            case Op::MaxProperties: {
+                if (!instance.is_object()) return true;
+                if (check.op == Op::MinProperties ? instance.size() >= check.count : instance.size() <= check.count) {
+                    return true;
+                }
+                return report(check.path, (check.op == Op::MinProperties ? "fewer than " : "more than ") +
+                                          std::to_string(check.count) + " properties");
+            }
+            case Op::Required: {
+                if (!instance.is_object()) return true;
+                bool ok = true;
+                for (const auto& name : check.names) {
+                    if (instance.contains(name)) continue;
+                    ok = report(check.path, "missing required property \"" + name + "\"");
+                    if (!m_errors) return false;
+                }
+                return ok;
+            }
+            case Op::DependentRequired: {
+                if (!instance.is_object()) return true;
+                bool ok = true;
+                for (const auto& [name, required] : check.dependencies) {
+                    if (!instance.contains(name)) continue;
+                    for (const auto& other : required) {
+                        if (instance.contains(other)) continue;
+                        ok = report(check.path, "\"" + name + "\" requires property \"" + other + "\"");
+                        if (!m_errors) return false;
+                    }
+                }
+                return ok;
+            }
+            case Op::Properties: {
+                if (!instance.is_object()) return true;
+                bool ok = true;
+                for (auto it = instance.begin(); it != instance.end(); ++it) {
+                    const std::string& key = it.key();
+                    bool matched = false;
+                    auto found = std::lower_bound(check.properties.begin(), check.properties.end(), key,
+                        [](const auto& entry, const std::string& name) { return entry.first < name; });
+                    if (found != check.properties.end() && found->first == key) {
+                        matched = true;
+                        ok = child(found->second, it.value(), depth, {&key, 0}) && ok;
+                    }
+                    for (const auto& [regexIndex, node] : check.patterns) {
+                        if (!m_errors && !ok) break;
+                        if (!m_program.regexes[regexIndex].search(key)) continue;
+                        matched = true;
+                        ok = child(node, it.value(), depth, {&key, 0}) && ok;
+                    }
+                    if (!matched && check.node != kNone && (m_errors || ok)) {
+                        if (isFalse(check.node)) {
+                            ok = report(check.path.substr(0, check.path.rfind('/')) + "/additionalProperties",
+                                        "unexpected property \"" + key + "\"") && ok;
+                        } else {
+                            ok = child(check.node, it.value(), depth, {&key, 0}) && ok;
+                        }
+                    }
+                    if (!ok && !m_errors) return false;
+                }
+                return ok;
+            }
+            case Op::PropertyNames: {
+                if (!instance.is_object()) return true;
+                bool ok = true;
+                for (auto it = instance.begin(); it != instance.end(); ++it) {
+                    if (probe(check.node, json(it.key()), depth + 1)) continue;
+                    ok = report(check.path, "invalid property name \"" + it.key() + "\"");
+                    if (!m_errors) return false;
+                }
+                return ok;
+            }
+
+            case Op::AllOf: {
+                bool ok = true;
+                for (uint32_t node : check.nodes) {
+                    ok = run(node, instance, depth + 1) && ok;
+                    if (!ok && !m_errors) return false;
+                }
+                return ok;
+            }
+            case Op::AnyOf: {
+                for (uint32_t node : check.nodes) {
+                    if (probe(node, instance, depth + 1)) return true;
+                }
+                return report(check.path, "does not match any of the alternatives");
+            }
+            case Op::OneOf: {
+                size_t matches = 0;
+                for (uint32_t node : check.nodes) {
+                    if (probe(node, instance, depth + 1) && ++matches > 1) break;
+                }
+                if (matches == 1) return true;
+                return report(check.path, matches == 0 ? "does not match any of the alternatives"
+                                                       : "matches more than one alternative");
+            }
+            case Op::Not:
+                return !probe(check.node, instance, depth + 1) || report(check.path, "must not match the schema");
+            case Op::Conditional: {
+                uint32_t branch = probe(check.nodes[0], instance, depth + 1) ? check.nodes[1] : check.nodes[2];
+                return branch == kNone || run(branch, instance, depth + 1);
+            }
+            case Op::Ref:
+                return run(check.node, instance, depth + 1);
+            case Op::False:
+                return report(check.path, "no value is allowed here");
+        }
+        return true;
+    }
+
+    const Program& m_program;
+    std::vector<JsonSchema::Error>* m_errors;
+    std::vector<Segment> m_path;
+};
+
+} // namespace
+
+std::string JsonSchema::Error::str() const {
+    return (instancePath.empty() ? "/" : instancePath) + ": " + message;
+}
+
+std::optional<JsonSchema> JsonSchema::compile(const json& schema, std::string* error) {
+    auto program = std::make_shared<Program>();
+    Compiler compiler(schema, *program);
+    if (!compiler.run()) {
+        if (error) *error = compiler.error();
+        return std::nullopt;
+    }
+    return JsonSchema(std::move(program));
+}
+
+bool JsonSchema::validate(const json& instance) const {
+    return Validator(*m_program, nullptr).run(0, instance, 0);
+}
+
+std::vector<JsonSchema::Error> JsonSchema::errors(const json& instance) const {
+    std::vector<Error> errors;
+    Validator(*m_program, &errors).run(0, instance, 0);
+    return errors;
+}
+
+} // namespace konami::utils
@@ -0,0 +1,82 @@
+// Konami Client - JSON Schema
+// Compiled JSON Schema (draft 2020-12 subset) validation
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace konami::utils {
+
+/**
+ * @brief JSON Schema compiled once into a validation program
+ *
+ * Compiling turns every subschema into a node holding a flat list of
+ * checks with their operands already decoded: numbers, sorted property
+ * tables, required names, compiled regexes and resolved $ref targets.
+ * Validation walks those nodes and never looks at the schema JSON again,
+ * so one compiled schema can check any number of documents (from any
+ * number of threads).
+ *
+ * Supported from the 2020-12 core and validation vocabularies:
+ *  - type, enum, const
+ *  - minimum, maximum, exclusiveMinimum, exclusiveMaximum, multipleOf
+ *  - minLength, maxLength, pattern
+ *  - prefixItems, items, contains, minContains, maxContains, minItems,
+ *    maxItems, uniqueItems
+ *  - properties, patternProperties, additionalProperties, propertyNames,
+ *    required, dependentRequired, minProperties, maxProperties
+ *  - allOf, anyOf, oneOf, not, if / then / else, boolean schemas
+ *  - $ref to "#", JSON pointers and $anchor names in the same document,
+ *    with $defs (draft-07 definitions, array-form items and
+ *    additionalItems are accepted too)
+ *
+ * format and other annotations are ignored. unevaluatedProperties,
+ * unevaluatedItems, $dynamicRef and references to other documents fail to
+ * compile rather than being silently skipped.
+ */
+class JsonSchema {
+public:
+    struct Error {
+        std::string instancePath;   // JSON pointer into the validated document
+        std::string schemaPath;     // JSON pointer to the failing keyword
+        std::string message;
+
+        /**
+         * "<instancePath>: <message>", with "/" for the document root
+         */
+        std::string str() const;
+    };
+
+    /**
+     * Compile a schema
+     * @param schema Schema document (object or boolean)
+     * @param error Receives the reason on failure
+     * @return Compiled schema, or nullopt if the schema is invalid or unsupported
+     */
+    static std::optional<JsonSchema> compile(const nlohmann::json& schema, std::string* error = nullptr);
+
+    /**
+     * Check a document, stopping at the first error
+     */
+    bool validate(const nlohmann::json& instance) const;
+
+    /**
+     * Check a document and report every error
+     * @return Every error found; empty if valid
+     */
+    std::vector<Error> errors(const nlohmann::json& instance) const;
+
+    struct Program;
+
+private:
+    explicit JsonSchema(std::shared_ptr<const Program> program) : m_program(std::move(program)) {}
+
+    std::shared_ptr<const Program> m_program;
+};
+
+} // namespace konami::utils
@@ -5,8 +5,13 @@
  */
 
 #include "JsonUtils.hpp"
+#include "JsonSchema.hpp"
+
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 namespace konami::utils {
 
@@ -135,8 +140,26 @@ json JsonUtils::merge(const json& base, const json& override_) {
     return result;
 }
 
+namespace {
+
+void deepMergeInto(json& target, const json& override_) {
+    for (auto it = override_.begin(); it != override_.end(); ++it) {
+        auto existing = target.find(it.key());
+        if (existing != target.end() && existing->is_object() && it.value().is_object()) {
+            deepMergeInto(*existing, it.value());
+        } else {
+            target[it.key()] = it.value();
+        }
+    }
+}
+
+} // namespace
+
 json JsonUtils::deepMerge(const json& base, const json& override_) {
-    return merge(base, override_);
+    if (!base.is_object() || !override_.is_object()) return override_;
+    json result = base;
+    deepMergeInto(result, override_);
+    return result;
 }
 
 // -- Filtering --
@@ -194,10 +217,62 @@ json JsonUtils::filterArray(const json& arr, std::function<bool(const json&)> pr
 bool JsonUtils::equals(const json& j1, const json& j2) { return j1 == j2; }
 json JsonUtils::diff(const json& j1, const json& j2) { return json::diff(j1, j2); }
 
-// -- Schema validation (basic) --
+// -- Schema validation --
+
+namespace {
 
-bool JsonUtils::validateSchema(const json& /*j*/, const json& /*schema*/) { return true; /* TODO */ }
-std::vector<std::string> JsonUtils::getValidationErrors(const json& /*j*/, const json& /*schema*/) { return {}; }
+struct CompiledSchema {
+    json source;
+    std::shared_ptr<const JsonSchema> schema;  // null if the schema did not compile
+    std::string error;
+};
+
+/**
+ * Compile a schema once and reuse it for every later call with an equal
+ * schema document. Lookup costs a hash of the schema, which is small next
+ * to the documents it checks.
+ */
+std::shared_ptr<const CompiledSchema> compiledSchema(const json& schema) {
+    static std::mutex mutex;
+    static std::unordered_multimap<size_t, std::shared_ptr<const CompiledSchema>> cache;
+    constexpr size_t kMaxCached = 64;
+
+    size_t hash = std::hash<json>{}(schema);
+    {
+        std::lock_guard lock(mutex);
+        auto [begin, end] = cache.equal_range(hash);
+        for (auto it = begin; it != end; ++it) {
+            if (it->second->source == schema) return it->second;
+        }
+    }
+
+    auto entry = std::make_shared<CompiledSchema>();
+    entry->source = schema;
+    if (auto compiled = JsonSchema::compile(schema, &entry->error)) {
+        entry->schema = std::make_shared<const JsonSchema>(std::move(*compiled));
+    }
+
+    std::lock_guard lock(mutex);
+    if (cache.size() >= kMaxCached) cache.clear();
+    cache.emplace(hash, entry);
+    return entry;
+}
+
+} // namespace
+
+bool JsonUtils::validateSchema(const json& j, const json& schema) {
+    auto compiled = compiledSchema(schema);
+    return compiled->schema && compiled->schema->validate(j);
+}
+
+std::vector<std::string> JsonUtils::getValidationErrors(const json& j, const json& schema) {
+    auto compiled = compiledSchema(schema);
+    if (!compiled->schema) return {"Invalid schema: " + compiled->error};
+
+    std::vector<std::string> messages;
+    for (const auto& error : compiled->schema->errors(j)) messages.push_back(error.str());
+    return messages;
+}
 
 // -- JsonPointer --
 
@@ -56,6 +56,9 @@ public:
     static bool isNull(const json& j, const std::string& key);
     
     // Merging
+    // merge: RFC 7386 merge patch (null in override deletes the key)
+    // deepMerge: objects merge key by key at every level; arrays, scalars
+    // and nulls in override replace the base value
     static json merge(const json& base, const json& override);
     static json deepMerge(const json& base, const json& override);
     
@@ -73,7 +76,9 @@ public:
     static bool equals(const json& j1, const json& j2);
     static json diff(const json& j1, const json& j2);
     
-    // Schema validation (basic)
+    // Schema validation (see JsonSchema). Schemas are compiled on first use
+    // and cached; hold a JsonSchema directly on hot paths to skip the lookup.
+    // Errors read "<JSON pointer>: <message>".
     static bool validateSchema(const json& j, const json& schema);
     static std::vector<std::string> getValidationErrors(const json& j, const json& schema);
 };
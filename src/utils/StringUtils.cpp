@@ -5,8 +5,11 @@
  */
 
 #include "StringUtils.hpp"
+#include "Codec.hpp"
+#include "Version.hpp"
 
 #include <cctype>
+#include <climits>
 #include <cstdarg>
 #include <numeric>
 #include <random>
@@ -193,57 +196,34 @@ std::string StringUtils::formatPercentage(double value, int precision) {
 
 // -- Encoding --
 
-static const std::string BASE64_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 std::string StringUtils::base64Encode(const std::string& str) {
-    return base64Encode(std::vector<uint8_t>(str.begin(), str.end()));
+    return Codec::base64Encode(str);
 }
 
 std::string StringUtils::base64Encode(const std::vector<uint8_t>& data) {
-    std::string result;
-    int val = 0, valb = -6;
-    for (uint8_t c : data) {
-        val = (val << 8) + c;
-        valb += 8;
-        while (valb >= 0) {
-            result.push_back(BASE64_CHARS[(val >> valb) & 0x3F]);
-            valb -= 6;
-        }
-    }
-    if (valb > -6) result.push_back(BASE64_CHARS[((val << 8) >> (valb + 8)) & 0x3F]);
-    while (result.size() % 4) result.push_back('=');
+    std::string result(Codec::base64EncodedSize(data.size()), '\0');
+    result.resize(Codec::base64Encode(data.data(), data.size(), result.data()));
     return result;
 }
 
 std::vector<uint8_t> StringUtils::base64Decode(const std::string& encoded) {
-    std::vector<int> T(256, -1);
-    for (int i = 0; i < 64; i++) T[static_cast<unsigned char>(BASE64_CHARS[i])] = i;
-    std::vector<uint8_t> out;
-    int val = 0, valb = -8;
-    for (unsigned char c : encoded) {
-        if (T[c] == -1) break;
-        val = (val << 6) + T[c];
-        valb += 6;
-        if (valb >= 0) {
-            out.push_back(static_cast<uint8_t>((val >> valb) & 0xFF));
-            valb -= 8;
-        }
-    }
+    std::vector<uint8_t> out(Codec::base64MaxDecodedSize(encoded.size()));
+    auto size = Codec::base64Decode(encoded, out.data());
+    out.resize(size.value_or(0));
     return out;
 }
 
 std::string StringUtils::hexEncode(const std::vector<uint8_t>& data) {
-    std::ostringstream oss;
-    for (uint8_t b : data) oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(b);
-    return oss.str();
+    std::string result(Codec::hexEncodedSize(data.size()), '\0');
+    Codec::hexEncode(data.data(), data.size(), result.data());
+    return result;
 }
 
 std::vector<uint8_t> StringUtils::hexDecode(const std::string& hex) {
-    std::vector<uint8_t> result;
-    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
-        result.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
-    }
-    return result;
+    std::vector<uint8_t> out(Codec::hexDecodedSize(hex.size()));
+    auto size = Codec::hexDecode(hex, out.data());
+    out.resize(size.value_or(0));
+    return out;
 }
 
 // -- UUID --
@@ -343,16 +323,7 @@ bool StringUtils::parseBool(const std::string& str, bool defaultValue) {
 // -- Version comparison --
 
 int StringUtils::compareVersions(const std::string& v1, const std::string& v2) {
-    auto parts1 = split(v1, '.');
-    auto parts2 = split(v2, '.');
-    size_t max = std::max(parts1.size(), parts2.size());
-    for (size_t i = 0; i < max; ++i) {
-        int p1 = i < parts1.size() ? parseInt(parts1[i]) : 0;
-        int p2 = i < parts2.size() ? parseInt(parts2[i]) : 0;
-        if (p1 < p2) return -1;
-        if (p1 > p2) return 1;
-    }
-    return 0;
+    return Version(v1).compare(Version(v2));
 }
 
 bool StringUtils::isVersionNewer(const std::string& version, const std::string& than) {
@@ -457,29 +428,202 @@ size_t StringBuilder::length() const { return m_stream.str().size(); }
 bool StringBuilder::isEmpty() const { return m_stream.str().empty(); }
 
 // -- Levenshtein distance --
+//
+// Myers (1999) in Hyyrö's formulation: column j of the DP matrix is held
+// as two bit-vectors of +1/-1 vertical deltas (Pv/Mv), advanced by one
+// text character with a handful of word operations. The score tracks the
+// last row. Patterns are limited to one 64-bit word; longer ones use DP.
 
-int levenshteinDistance(const std::string& s1, const std::string& s2) {
-    size_t m = s1.size(), n = s2.size();
-    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1));
-    for (size_t i = 0; i <= m; ++i) dp[i][0] = static_cast<int>(i);
-    for (size_t j = 0; j <= n; ++j) dp[0][j] = static_cast<int>(j);
-    for (size_t i = 1; i <= m; ++i) {
-        for (size_t j = 1; j <= n; ++j) {
-            int cost = (s1[i-1] == s2[j-1]) ? 0 : 1;
-            dp[i][j] = std::min({dp[i-1][j]+1, dp[i][j-1]+1, dp[i-1][j-1]+cost});
+namespace {
+
+constexpr size_t kMyersWord = 64;
+constexpr size_t kLanes = 4;
+
+using PeqTable = std::array<uint64_t, 256>;
+
+void buildPeq(std::string_view pattern, PeqTable& peq) {
+    peq.fill(0);
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        peq[static_cast<unsigned char>(pattern[i])] |= uint64_t{1} << i;
+    }
+}
+
+/**
+ * Myers over one text. Requires 0 < patternLength <= 64.
+ */
+int myersDistance(const PeqTable& peq, size_t patternLength, std::string_view text, int maxDistance) {
+    const uint64_t last = uint64_t{1} << (patternLength - 1);
+    uint64_t pv = ~uint64_t{0};
+    uint64_t mv = 0;
+    int score = static_cast<int>(patternLength);
+    int remaining = static_cast<int>(text.size());
+
+    for (char ch : text) {
+        uint64_t eq = peq[static_cast<unsigned char>(ch)];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) ++score;
+        else if (mh & last) --score;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        // Each remaining character can lower the score by at most one
+        if (score - --remaining > maxDistance) return maxDistance + 1;
+    }
+    return score;
+}
+
+/**
+ * Two-row DP with a band exit, for patterns longer than one word
+ */
+int dpDistance(std::string_view s1, std::string_view s2, int maxDistance) {
+    thread_local std::vector<int> row;
+    row.resize(s2.size() + 1);
+    std::iota(row.begin(), row.end(), 0);
+    for (size_t i = 1; i <= s1.size(); ++i) {
+        int diagonal = row[0];
+        row[0] = static_cast<int>(i);
+        int rowMin = row[0];
+        for (size_t j = 1; j <= s2.size(); ++j) {
+            int above = row[j];
+            int cost = s1[i - 1] == s2[j - 1] ? 0 : 1;
+            row[j] = std::min({above + 1, row[j - 1] + 1, diagonal + cost});
+            diagonal = above;
+            rowMin = std::min(rowMin, row[j]);
         }
+        if (rowMin > maxDistance) return maxDistance + 1;
     }
-    return dp[m][n];
+    return std::min(row[s2.size()], maxDistance + 1);
 }
 
-std::string findBestMatch(const std::string& query, const std::vector<std::string>& candidates, int maxDistance) {
-    std::string best;
-    int bestDist = maxDistance + 1;
-    for (const auto& c : candidates) {
-        int dist = levenshteinDistance(query, c);
-        if (dist < bestDist) { bestDist = dist; best = c; }
+int boundedDistance(const PeqTable* peq, std::string_view pattern, std::string_view text, int maxDistance) {
+    int lengthGap = static_cast<int>(pattern.size() > text.size() ? pattern.size() - text.size()
+                                                                   : text.size() - pattern.size());
+    if (lengthGap > maxDistance) return maxDistance + 1;
+    if (pattern.empty() || text.empty()) return lengthGap;
+    if (pattern.size() > kMyersWord) return dpDistance(pattern, text, maxDistance);
+
+    PeqTable local;
+    if (!peq) {
+        buildPeq(pattern, local);
+        peq = &local;
+    }
+    return std::min(myersDistance(*peq, pattern.size(), text, maxDistance), maxDistance + 1);
+}
+
+/**
+ * Myers over kLanes texts at once, one per lane. The per-lane loops are
+ * plain enough for the compiler to keep each step in one vector register
+ * (AVX2 holds all four lanes); only the table lookups are scalar.
+ */
+void myersLanes(const PeqTable& peq, size_t patternLength, const std::string_view* texts, int* scores) {
+    const uint64_t shift = patternLength - 1;
+    uint64_t pv[kLanes], mv[kLanes], score[kLanes], length[kLanes];
+    size_t longest = 0;
+    for (size_t k = 0; k < kLanes; ++k) {
+        pv[k] = ~uint64_t{0};
+        mv[k] = 0;
+        score[k] = patternLength;
+        length[k] = texts[k].size();
+        longest = std::max(longest, texts[k].size());
+    }
+
+    for (size_t j = 0; j < longest; ++j) {
+        uint64_t eq[kLanes], active[kLanes];
+        for (size_t k = 0; k < kLanes; ++k) {
+            bool inText = j < length[k];
+            eq[k] = inText ? peq[static_cast<unsigned char>(texts[k][j])] : 0;
+            active[k] = uint64_t{0} - static_cast<uint64_t>(inText);
+        }
+        for (size_t k = 0; k < kLanes; ++k) {
+            uint64_t xv = eq[k] | mv[k];
+            uint64_t xh = (((eq[k] & pv[k]) + pv[k]) ^ pv[k]) | eq[k];
+            uint64_t ph = mv[k] | ~(xh | pv[k]);
+            uint64_t mh = pv[k] & xh;
+            score[k] += (((ph >> shift) & 1) - ((mh >> shift) & 1)) & active[k];
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv[k] = mh | ~(xv | ph);
+            mv[k] = ph & xv;
+        }
     }
-    return best;
+    for (size_t k = 0; k < kLanes; ++k) scores[k] = static_cast<int>(score[k]);
+}
+
+} // namespace
+
+int levenshteinDistance(const std::string& s1, const std::string& s2) {
+    return levenshteinDistance(s1, s2, INT_MAX - 1);
+}
+
+int levenshteinDistance(std::string_view s1, std::string_view s2, int maxDistance) {
+    // Edit distance is symmetric; the shorter string makes the cheaper pattern
+    if (s1.size() > s2.size()) std::swap(s1, s2);
+    return boundedDistance(nullptr, s1, s2, maxDistance);
+}
+
+// -- FuzzyMatcher --
+
+FuzzyMatcher::FuzzyMatcher(std::string_view query) : m_query(query) {
+    if (m_query.size() <= kMyersWord) buildPeq(m_query, m_peq);
+}
+
+int FuzzyMatcher::distance(std::string_view candidate, int maxDistance) const {
+    return boundedDistance(&m_peq, m_query, candidate, maxDistance);
+}
+
+std::vector<int> FuzzyMatcher::distances(const std::vector<std::string>& candidates, int maxDistance) const {
+    std::vector<int> result(candidates.size(), maxDistance + 1);
+    if (m_query.empty() || m_query.size() > kMyersWord) {
+        for (size_t i = 0; i < candidates.size(); ++i) result[i] = distance(candidates[i], maxDistance);
+        return result;
+    }
+
+    // Length-gap rejects are free; the rest are scored kLanes at a time
+    const size_t queryLength = m_query.size();
+    std::string_view texts[kLanes];
+    size_t indices[kLanes];
+    size_t filled = 0;
+    auto flush = [&] {
+        for (size_t k = filled; k < kLanes; ++k) texts[k] = {};
+        int scores[kLanes];
+        myersLanes(m_peq, queryLength, texts, scores);
+        for (size_t k = 0; k < filled; ++k) result[indices[k]] = std::min(scores[k], maxDistance + 1);
+        filled = 0;
+    };
+
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const auto& candidate = candidates[i];
+        size_t gap = candidate.size() > queryLength ? candidate.size() - queryLength : queryLength - candidate.size();
+        if (gap > static_cast<size_t>(maxDistance)) continue;
+        texts[filled] = candidate;
+        indices[filled] = i;
+        if (++filled == kLanes) flush();
+    }
+    if (filled > 0) flush();
+    return result;
+}
+
+std::vector<FuzzyMatcher::Match> FuzzyMatcher::matches(const std::vector<std::string>& candidates, int maxDistance,
+                                                       size_t limit) const {
+    auto scores = distances(candidates, maxDistance);
+    std::vector<Match> result;
+    for (size_t i = 0; i < scores.size(); ++i) {
+        if (scores[i] <= maxDistance) result.push_back({i, scores[i]});
+    }
+    std::stable_sort(result.begin(), result.end(),
+        [](const Match& a, const Match& b) { return a.distance < b.distance; });
+    if (result.size() > limit) result.resize(limit);
+    return result;
+}
+
+std::string findBestMatch(const std::string& query, const std::vector<std::string>& candidates, int maxDistance) {
+    auto best = FuzzyMatcher(query).matches(candidates, maxDistance, 1);
+    return best.empty() ? std::string() : candidates[best.front().index];
 }
 
 } // namespace konami::utils
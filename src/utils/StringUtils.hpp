@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <array>
+#include <climits>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 #include <algorithm>
@@ -57,7 +61,7 @@ public:
     static std::string formatNumber(int64_t number);
     static std::string formatPercentage(double value, int precision = 1);
     
-    // Encoding
+    // Encoding (see Codec; decoders return an empty result on invalid input)
     static std::string base64Encode(const std::string& str);
     static std::string base64Encode(const std::vector<uint8_t>& data);
     static std::vector<uint8_t> base64Decode(const std::string& encoded);
@@ -145,6 +149,55 @@ private:
  */
 int levenshteinDistance(const std::string& s1, const std::string& s2);
 
+/**
+ * @brief Levenshtein distance that gives up once it exceeds a bound
+ * @return Distance, or maxDistance + 1 if it is larger than maxDistance
+ */
+int levenshteinDistance(std::string_view s1, std::string_view s2, int maxDistance);
+
+/**
+ * @brief Edit distance from one query to many candidates
+ *
+ * Myers' bit-parallel algorithm: the query's character masks are built
+ * once, then each candidate costs one pass of a few word operations per
+ * character, with no allocation. Candidates are scored several at a time,
+ * one per SIMD lane. Queries longer than 64 characters fall back to a
+ * row-at-a-time DP.
+ */
+class FuzzyMatcher {
+public:
+    struct Match {
+        size_t index;     // Into the candidate list
+        int distance;
+    };
+
+    explicit FuzzyMatcher(std::string_view query);
+
+    /**
+     * Distance to one candidate
+     * @return Distance, or maxDistance + 1 if it is larger than maxDistance
+     */
+    int distance(std::string_view candidate, int maxDistance = INT_MAX - 1) const;
+
+    /**
+     * Distances to every candidate (maxDistance + 1 where larger than maxDistance)
+     */
+    std::vector<int> distances(const std::vector<std::string>& candidates, int maxDistance = INT_MAX - 1) const;
+
+    /**
+     * Candidates within maxDistance, closest first (ties keep list order)
+     * @param limit Maximum number of matches to return
+     */
+    std::vector<Match> matches(const std::vector<std::string>& candidates, int maxDistance,
+                               size_t limit = SIZE_MAX) const;
+
+    const std::string& query() const { return m_query; }
+
+private:
+    std::string m_query;
+    std::array<uint64_t, 256> m_peq{};   // Bit i set where query[i] == c
+};
+
 /**
  * @brief Find best match from list
  */
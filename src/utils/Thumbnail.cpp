@@ -0,0 +1,160 @@
+/**
+ * Thumbnail.cpp
+ *
+ * stb_image decoding and an area-averaging downscaler. This file owns the
+ * stb_image implementation for the whole program.
+ */
+
+#include "Thumbnail.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace konami::utils {
+
+namespace {
+
+constexpr char kMagic[4] = {'K', 'T', 'H', '1'};
+constexpr size_t kHeaderSize = sizeof(kMagic) + 2 * sizeof(uint32_t);
+
+/**
+ * Output size fitting width x height into the bounds, never scaling up
+ */
+void fit(uint32_t width, uint32_t height, uint32_t maxWidth, uint32_t maxHeight,
+         uint32_t& outWidth, uint32_t& outHeight) {
+    double scale = 1.0;
+    if (maxWidth > 0) scale = std::min(scale, static_cast<double>(maxWidth) / width);
+    if (maxHeight > 0) scale = std::min(scale, static_cast<double>(maxHeight) / height);
+    outWidth = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(width * scale)));
+    outHeight = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(height * scale)));
+}
+
+} // namespace
+
+std::optional<Thumbnail> Thumbnail::decode(std::string_view encoded, uint32_t maxWidth, uint32_t maxHeight,
+                                           std::string* error) {
+    auto fail = [&](std::string reason) -> std::optional<Thumbnail> {
+        if (error) *error = std::move(reason);
+        return std::nullopt;
+    };
+
+    if (encoded.empty() || encoded.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        return fail("Empty or oversized image data");
+    }
+    const auto* bytes = reinterpret_cast<const stbi_uc*>(encoded.data());
+    int length = static_cast<int>(encoded.size());
+
+    // Reject decompression bombs before allocating for them
+    int width = 0, height = 0, channels = 0;
+    if (!stbi_info_from_memory(bytes, length, &width, &height, &channels)) {
+        return fail(stbi_failure_reason() ? stbi_failure_reason() : "Unsupported image format");
+    }
+    if (width <= 0 || height <= 0 || static_cast<uint64_t>(width) * static_cast<uint64_t>(height) > kMaxSourcePixels) {
+        return fail("Image dimensions out of range");
+    }
+
+    stbi_uc* pixels = stbi_load_from_memory(bytes, length, &width, &height, &channels, 4);
+    if (!pixels) {
+        return fail(stbi_failure_reason() ? stbi_failure_reason() : "Failed to decode image");
+    }
+
+    Thumbnail result = downscale(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                                 maxWidth, maxHeight);
+    stbi_image_free(pixels);
+    return result;
+}
+
+Thumbnail Thumbnail::downscale(const uint8_t* rgba, uint32_t width, uint32_t height,
+                               uint32_t maxWidth, uint32_t maxHeight) {
+    Thumbnail result;
+    fit(width, height, maxWidth, maxHeight, result.width, result.height);
+
+    if (result.width == width && result.height == height) {
+        result.pixels.assign(rgba, rgba + static_cast<size_t>(width) * height * 4);
+        return result;
+    }
+
+    result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+    // Source column span of every output column
+    std::vector<uint32_t> columns(result.width + 1);
+    for (uint32_t x = 0; x <= result.width; ++x) {
+        columns[x] = static_cast<uint32_t>(static_cast<uint64_t>(x) * width / result.width);
+    }
+
+    std::vector<uint64_t> sums(static_cast<size_t>(result.width) * 4);
+    for (uint32_t y = 0; y < result.height; ++y) {
+        uint32_t y0 = static_cast<uint32_t>(static_cast<uint64_t>(y) * height / result.height);
+        uint32_t y1 = std::max(y0 + 1, static_cast<uint32_t>(static_cast<uint64_t>(y + 1) * height / result.height));
+
+        std::fill(sums.begin(), sums.end(), 0);
+        for (uint32_t sy = y0; sy < y1; ++sy) {
+            const uint8_t* row = rgba + static_cast<size_t>(sy) * width * 4;
+            for (uint32_t x = 0; x < result.width; ++x) {
+                uint32_t x1 = std::max(columns[x] + 1, columns[x + 1]);
+                uint64_t* sum = &sums[static_cast<size_t>(x) * 4];
+                for (uint32_t sx = columns[x]; sx < x1; ++sx) {
+                    const uint8_t* p = row + static_cast<size_t>(sx) * 4;
+                    uint32_t alpha = p[3];
+                    sum[0] += p[0] * alpha;
+                    sum[1] += p[1] * alpha;
+                    sum[2] += p[2] * alpha;
+                    sum[3] += alpha;
+                }
+            }
+        }
+
+        uint8_t* out = result.pixels.data() + static_cast<size_t>(y) * result.width * 4;
+        for (uint32_t x = 0; x < result.width; ++x) {
+            uint32_t x1 = std::max(columns[x] + 1, columns[x + 1]);
+            uint64_t count = static_cast<uint64_t>(x1 - columns[x]) * (y1 - y0);
+            const uint64_t* sum = &sums[static_cast<size_t>(x) * 4];
+            uint8_t* p = out + static_cast<size_t>(x) * 4;
+            if (sum[3] == 0) {
+                std::memset(p, 0, 4);
+                continue;
+            }
+            p[0] = static_cast<uint8_t>((sum[0] + sum[3] / 2) / sum[3]);
+            p[1] = static_cast<uint8_t>((sum[1] + sum[3] / 2) / sum[3]);
+            p[2] = static_cast<uint8_t>((sum[2] + sum[3] / 2) / sum[3]);
+            p[3] = static_cast<uint8_t>((sum[3] + count / 2) / count);
+        }
+    }
+
+    return result;
+}
+
+std::string Thumbnail::serialize() const {
+    std::string data(kHeaderSize + pixels.size(), '\0');
+    std::memcpy(data.data(), kMagic, sizeof(kMagic));
+    std::memcpy(data.data() + 4, &width, sizeof(width));
+    std::memcpy(data.data() + 8, &height, sizeof(height));
+    if (!pixels.empty()) {
+        std::memcpy(data.data() + kHeaderSize, pixels.data(), pixels.size());
+    }
+    return data;
+}
+
+std::optional<Thumbnail> Thumbnail::deserialize(std::string_view data) {
+    if (data.size() < kHeaderSize || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        return std::nullopt;
+    }
+
+    Thumbnail result;
+    std::memcpy(&result.width, data.data() + 4, sizeof(result.width));
+    std::memcpy(&result.height, data.data() + 8, sizeof(result.height));
+    if (result.width == 0 || result.height == 0 ||
+        static_cast<uint64_t>(result.width) * result.height * 4 != data.size() - kHeaderSize) {
+        return std::nullopt;
+    }
+
+    result.pixels.assign(data.begin() + kHeaderSize, data.end());
+    return result;
+}
+
+} // namespace konami::utils
@@ -0,0 +1,67 @@
+// Konami Client - Thumbnail
+// Image decoding and downscaling to display size
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace konami::utils {
+
+/**
+ * @brief Decoded RGBA8 image sized for display
+ *
+ * decode() accepts anything stb_image reads (PNG, JPEG, GIF, BMP, TGA) and
+ * box-filters the result down to fit the requested size, keeping the aspect
+ * ratio; images are never scaled up. Filtering is done on premultiplied
+ * colour so transparent edges don't pick up dark fringes.
+ *
+ * serialize() / deserialize() are the on-disk thumbnail format: a small
+ * header followed by raw pixels, so a cached thumbnail loads with a single
+ * copy and no decoding.
+ */
+struct Thumbnail {
+    uint32_t width{0};
+    uint32_t height{0};
+    std::vector<uint8_t> pixels;    // RGBA8, straight alpha, row-major
+
+    // Images with more pixels than this are rejected before decoding
+    static constexpr uint64_t kMaxSourcePixels = 8192ull * 8192ull;
+
+    /**
+     * Decode an encoded image and fit it into maxWidth x maxHeight
+     * @param encoded File contents
+     * @param maxWidth Display width in pixels (0 = no limit)
+     * @param maxHeight Display height in pixels (0 = no limit)
+     * @param error Receives the reason on failure
+     * @return Thumbnail, or nullopt if the data is not a supported image
+     */
+    static std::optional<Thumbnail> decode(std::string_view encoded, uint32_t maxWidth, uint32_t maxHeight,
+                                           std::string* error = nullptr);
+
+    /**
+     * Fit RGBA8 pixels into maxWidth x maxHeight
+     * @param rgba Source pixels, straight alpha
+     */
+    static Thumbnail downscale(const uint8_t* rgba, uint32_t width, uint32_t height,
+                               uint32_t maxWidth, uint32_t maxHeight);
+
+    /**
+     * Disk cache representation
+     */
+    std::string serialize() const;
+
+    /**
+     * Read a thumbnail written by serialize()
+     * @return Thumbnail, or nullopt if the data is truncated or not a thumbnail
+     */
+    static std::optional<Thumbnail> deserialize(std::string_view data);
+
+    size_t byteSize() const { return pixels.size(); }
+};
+
+} // namespace konami::utils
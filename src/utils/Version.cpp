@@ -0,0 +1,370 @@
+/**
+ * Version.cpp
+ *
+ * Version keys are byte strings compared with memcmp. Layout:
+ *   [era] then items, then an end marker
+ *   number    0x50 + byte count, big-endian bytes (0 is just 0x50)
+ *   qualifier 0x11..0x16 for known pre-releases, 0x18 + word + 0x00 for
+ *             unknown ones, 0x60 for service packs
+ *   end       0x40
+ *   word      0x70 + word + 0x00, for a dot-separated identifier after the
+ *             pre-release tag (SemVer "1.0.0-alpha.beta")
+ * Pre-release tags sort below the end marker and numbers above it, which
+ * gives 1.0-rc1 < 1.0 < 1.0.1 with a plain byte compare. Inside a
+ * dot-separated pre-release tail SemVer 11.4 applies: fewer identifiers <
+ * numeric < alphanumeric, and zeros are kept, so
+ * 1.0.0-alpha < 1.0.0-alpha.1 < 1.0.0-alpha.beta < 1.0.0-beta.
+ */
+
+#include "Version.hpp"
+
+#include <cctype>
+#include <cstdint>
+
+namespace konami::utils {
+
+namespace {
+
+enum : unsigned char {
+    kEraRd = 1,
+    kEraClassic = 2,
+    kEraIndev = 3,
+    kEraInfdev = 4,
+    kEraAlpha = 5,
+    kEraBeta = 6,
+    kEraRelease = 7,
+    kEraSnapshot = 8,
+
+    kFloor = 0x01,
+    kAlpha = 0x11,
+    kBeta = 0x12,
+    kMilestone = 0x13,
+    kPre = 0x14,
+    kRc = 0x15,
+    kSnapshotQualifier = 0x16,
+    kUnknown = 0x18,
+    kEnd = 0x40,
+    kNumber = 0x50,
+    kServicePack = 0x60,
+    kIdentifier = 0x70,
+};
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+bool isAlpha(char c) { return std::isalpha(static_cast<unsigned char>(c)) != 0; }
+
+void appendNumber(std::string& key, uint64_t value) {
+    unsigned char bytes[8];
+    int count = 0;
+    for (; value != 0; value >>= 8) bytes[count++] = static_cast<unsigned char>(value & 0xFF);
+    key.push_back(static_cast<char>(kNumber + count));
+    while (count > 0) key.push_back(static_cast<char>(bytes[--count]));
+}
+
+uint64_t readNumber(std::string_view text, size_t& pos) {
+    uint64_t value = 0;
+    for (; pos < text.size() && isDigit(text[pos]); ++pos) {
+        uint64_t digit = static_cast<uint64_t>(text[pos] - '0');
+        value = value > (UINT64_MAX - digit) / 10 ? UINT64_MAX : value * 10 + digit;
+    }
+    return value;
+}
+
+/**
+ * Qualifier tag for a lowercased word; 0 for words that mean "release"
+ */
+unsigned char qualifierTag(std::string_view word) {
+    if (word == "alpha" || word == "a") return kAlpha;
+    if (word == "beta" || word == "b") return kBeta;
+    if (word == "milestone" || word == "m") return kMilestone;
+    if (word == "pre" || word == "preview" || word == "prerelease") return kPre;
+    if (word == "rc" || word == "cr" || word == "candidate") return kRc;
+    if (word == "snapshot") return kSnapshotQualifier;
+    if (word == "release" || word == "final" || word == "ga") return 0;
+    if (word == "sp") return kServicePack;
+    return kUnknown;
+}
+
+/**
+ * Minecraft legacy prefix ("b1.7.3", "rd-132211", "inf-20100618"): era and prefix length
+ */
+std::pair<unsigned char, size_t> legacyEra(std::string_view text) {
+    auto followedByNumber = [&](size_t at) {
+        return at < text.size() && (isDigit(text[at]) || (text[at] == '-' && at + 1 < text.size() && isDigit(text[at + 1])));
+    };
+    if (text.starts_with("rd") && followedByNumber(2)) return {kEraRd, 2};
+    if (text.starts_with("inf") && followedByNumber(3)) return {kEraInfdev, 3};
+    if (text.starts_with("in") && followedByNumber(2)) return {kEraIndev, 2};
+    if (text.starts_with("c") && followedByNumber(1)) return {kEraClassic, 1};
+    if (text.starts_with("a") && followedByNumber(1)) return {kEraAlpha, 1};
+    if (text.starts_with("b") && followedByNumber(1)) return {kEraBeta, 1};
+    return {kEraRelease, 0};
+}
+
+/**
+ * Weekly snapshot "23w45a": year, week and the letter's position
+ */
+bool parseWeeklySnapshot(std::string_view text, std::string& key) {
+    if (text.size() < 6 || !isDigit(text[0]) || !isDigit(text[1]) || text[2] != 'w' ||
+        !isDigit(text[3]) || !isDigit(text[4]) || !std::islower(static_cast<unsigned char>(text[5]))) {
+        return false;
+    }
+    key.push_back(static_cast<char>(kEraSnapshot));
+    appendNumber(key, static_cast<uint64_t>((text[0] - '0') * 10 + (text[1] - '0')));
+    appendNumber(key, static_cast<uint64_t>((text[3] - '0') * 10 + (text[4] - '0')));
+    appendNumber(key, static_cast<uint64_t>(text[5] - 'a' + 1));
+    key.push_back(static_cast<char>(kEnd));
+    return true;
+}
+
+std::string_view trimView(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+    return text;
+}
+
+} // namespace
+
+// -- Version --
+
+Version::Version(std::string_view text) : m_text(text) {
+    std::string_view rest = trimView(text);
+    if (auto plus = rest.find('+'); plus != std::string_view::npos) rest = rest.substr(0, plus);
+
+    std::string lowered(rest);
+    for (auto& c : lowered) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    std::string_view s = lowered;
+
+    m_key.reserve(16);
+    if (parseWeeklySnapshot(s, m_key)) {
+        m_snapshot = true;
+        m_prerelease = true;
+        return;
+    }
+
+    if (s.size() > 1 && s[0] == 'v' && isDigit(s[1])) s.remove_prefix(1);
+    auto [era, prefix] = legacyEra(s);
+    s.remove_prefix(prefix);
+    m_key.push_back(static_cast<char>(era));
+
+    // Zeros are held back until a non-zero number follows, so trailing
+    // zeros before a qualifier or the end disappear
+    size_t pendingZeros = 0;
+    size_t pos = 0;
+    bool prereleaseTag = false;
+    while (pos < s.size()) {
+        char c = s[pos];
+        // Dot-separated identifier after a pre-release tag: SemVer ordering
+        bool semverTail = prereleaseTag && pos > 0 && s[pos - 1] == '.';
+        if (isDigit(c)) {
+            uint64_t value = readNumber(s, pos);
+            if (value == 0 && !semverTail) {
+                ++pendingZeros;
+                continue;
+            }
+            m_key.append(pendingZeros, static_cast<char>(kNumber));
+            pendingZeros = 0;
+            appendNumber(m_key, value);
+        } else if (isAlpha(c)) {
+            size_t start = pos;
+            while (pos < s.size() && isAlpha(s[pos])) ++pos;
+            std::string_view word = s.substr(start, pos - start);
+            if (semverTail) {
+                m_key.append(pendingZeros, static_cast<char>(kNumber));
+                pendingZeros = 0;
+                m_key.push_back(static_cast<char>(kIdentifier));
+                m_key.append(word);
+                m_key.push_back('\0');
+                continue;
+            }
+            unsigned char tag = qualifierTag(word);
+            if (tag == 0) continue;
+            pendingZeros = 0;
+            m_key.push_back(static_cast<char>(tag));
+            if (tag == kUnknown) {
+                m_key.append(word);
+                m_key.push_back('\0');
+            }
+            if (tag < kEnd) m_prerelease = prereleaseTag = true;
+        } else {
+            ++pos;  // Separator
+        }
+    }
+    m_key.push_back(static_cast<char>(kEnd));
+}
+
+int Version::compare(const Version& other) const {
+    int result = m_key.compare(other.m_key);
+    return (result > 0) - (result < 0);
+}
+
+Version Version::floor() const {
+    Version result = *this;
+    if (!result.m_key.empty() && result.m_key.back() == static_cast<char>(kEnd)) result.m_key.pop_back();
+    result.m_key.push_back(static_cast<char>(kFloor));
+    return result;
+}
+
+// -- VersionRange --
+
+std::optional<VersionRange> VersionRange::parse(std::string_view text) {
+    VersionRange range;
+    text = trimView(text);
+    if (text.empty() || text == "*") return range;
+
+    if (text.front() == '[' || text.front() == '(') {
+        if (!parseMaven(text, range)) return std::nullopt;
+        return range;
+    }
+
+    while (true) {
+        size_t bar = text.find("||");
+        std::vector<Bound> bounds;
+        if (!parseComparators(text.substr(0, bar), bounds)) return std::nullopt;
+        range.m_alternatives.push_back(std::move(bounds));
+        if (bar == std::string_view::npos) break;
+        text.remove_prefix(bar + 2);
+    }
+    return range;
+}
+
+bool VersionRange::parseMaven(std::string_view text, VersionRange& range) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        char open = text[pos];
+        if (open != '[' && open != '(') return false;
+        size_t close = text.find_first_of("])", pos);
+        if (close == std::string_view::npos) return false;
+
+        std::string_view body = text.substr(pos + 1, close - pos - 1);
+        bool inclusiveUpper = text[close] == ']';
+        std::vector<Bound> bounds;
+
+        size_t comma = body.find(',');
+        if (comma == std::string_view::npos) {
+            // "[1.2]" pins one version
+            if (open != '[' || !inclusiveUpper || trimView(body).empty()) return false;
+            bounds.push_back({Op::Equal, Version(trimView(body))});
+        } else {
+            auto lower = trimView(body.substr(0, comma));
+            auto upper = trimView(body.substr(comma + 1));
+            if (!lower.empty()) bounds.push_back({open == '[' ? Op::GreaterEqual : Op::Greater, Version(lower)});
+            if (!upper.empty()) bounds.push_back({inclusiveUpper ? Op::LessEqual : Op::Less, Version(upper)});
+        }
+        range.m_alternatives.push_back(std::move(bounds));
+
+        pos = close + 1;
+        while (pos < text.size() && (text[pos] == ',' || std::isspace(static_cast<unsigned char>(text[pos])))) ++pos;
+    }
+    return !range.m_alternatives.empty();
+}
+
+bool VersionRange::parseComparators(std::string_view text, std::vector<Bound>& bounds) {
+    text = trimView(text);
+    if (text.empty()) return false;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        if (pos >= text.size()) break;
+
+        // Operator, optionally separated from its operand by spaces
+        size_t opStart = pos;
+        while (pos < text.size() && std::string_view("<>=~^").find(text[pos]) != std::string_view::npos) ++pos;
+        std::string_view op = text.substr(opStart, pos - opStart);
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        size_t operandStart = pos;
+        while (pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        std::string_view operand = text.substr(operandStart, pos - operandStart);
+        if (operand.empty()) return false;
+        if (operand == "*" || operand == "x" || operand == "X") {
+            if (!op.empty()) return false;
+            continue;
+        }
+
+        // Leading numeric components; a wildcard ends them ("1.20.x")
+        std::vector<std::string_view> components;
+        bool wildcard = false;
+        for (size_t start = 0; start <= operand.size(); ) {
+            size_t dot = operand.find('.', start);
+            auto part = operand.substr(start, dot == std::string_view::npos ? std::string_view::npos : dot - start);
+            if (part == "x" || part == "X" || part == "*") {
+                wildcard = true;
+                break;
+            }
+            components.push_back(part);
+            if (dot == std::string_view::npos) break;
+            start = dot + 1;
+        }
+
+        auto joined = [&](size_t count, bool bumpLast) {
+            std::string result;
+            for (size_t i = 0; i < count && i < components.size(); ++i) {
+                if (i > 0) result += '.';
+                if (bumpLast && i + 1 == count) {
+                    size_t at = 0;
+                    result += std::to_string(readNumber(components[i], at) + 1);
+                } else {
+                    result += components[i];
+                }
+            }
+            return result;
+        };
+
+        if (wildcard) {
+            if (!op.empty()) return false;
+            if (components.empty()) continue;
+            bounds.push_back({Op::GreaterEqual, Version(joined(components.size(), false))});
+            bounds.push_back({Op::Less, Version(joined(components.size(), true)).floor()});
+            continue;
+        }
+
+        Version version(operand);
+        if (op.empty() || op == "=" || op == "==") {
+            bounds.push_back({Op::Equal, version});
+        } else if (op == ">=") {
+            bounds.push_back({Op::GreaterEqual, version});
+        } else if (op == ">") {
+            bounds.push_back({Op::Greater, version});
+        } else if (op == "<=") {
+            bounds.push_back({Op::LessEqual, version});
+        } else if (op == "<") {
+            bounds.push_back({Op::Less, version});
+        } else if (op == "~" || op == "~>") {
+            // ~1.2.3 := >=1.2.3 <1.3; ~1 := >=1 <2
+            size_t keep = components.size() >= 2 ? 2 : 1;
+            bounds.push_back({Op::GreaterEqual, version});
+            bounds.push_back({Op::Less, Version(joined(keep, true)).floor()});
+        } else if (op == "^") {
+            // ^1.2.3 := <2; ^0.2.3 := <0.3; ^0.0.3 := <0.0.4
+            size_t keep = 1;
+            while (keep < components.size() && components[keep - 1].find_first_not_of('0') == std::string_view::npos) ++keep;
+            bounds.push_back({Op::GreaterEqual, version});
+            bounds.push_back({Op::Less, Version(joined(keep, true)).floor()});
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VersionRange::contains(const Version& version) const {
+    if (m_alternatives.empty()) return true;
+    for (const auto& bounds : m_alternatives) {
+        bool matches = true;
+        for (const auto& bound : bounds) {
+            int c = version.compare(bound.version);
+            switch (bound.op) {
+                case Op::Less: matches = c < 0; break;
+                case Op::LessEqual: matches = c <= 0; break;
+                case Op::Greater: matches = c > 0; break;
+                case Op::GreaterEqual: matches = c >= 0; break;
+                case Op::Equal: matches = c == 0; break;
+            }
+            if (!matches) break;
+        }
+        if (matches) return true;
+    }
+    return false;
+}
+
+} // namespace konami::utils
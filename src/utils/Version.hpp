@@ -0,0 +1,113 @@
+// Konami Client - Versions
+// Version parsing, ordering and range matching
+
+#pragma once
+
+#include <compare>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace konami::utils {
+
+/**
+ * @brief Parsed version with a precomputed sort key
+ *
+ * Parsing happens once; comparison is a single byte-string compare of
+ * the key, so version lists can be sorted without re-parsing. The key
+ * orders:
+ *  - numeric components numerically, ignoring trailing zeros (1.0 == 1.0.0)
+ *  - pre-releases before the release: alpha < beta < milestone < pre <
+ *    rc < snapshot < release < sp (SemVer and Maven qualifiers, plus
+ *    Minecraft's "-pre1", "-rc1" and " Pre-Release 1" forms)
+ *  - dot-separated identifiers after a pre-release tag as SemVer does:
+ *    1.0.0-alpha < 1.0.0-alpha.1 < 1.0.0-alpha.beta
+ *  - SemVer build metadata ("+mc1.20.4") is ignored
+ *  - Minecraft eras: rd < classic < indev < infdev < alpha < beta < release
+ *  - weekly snapshots ("23w45a") by year, week and letter
+ *
+ * Snapshot ids carry no release number, so they sort after all numbered
+ * versions; lists that mix them (the version manifest) sort by release
+ * time first.
+ */
+class Version {
+public:
+    Version() = default;
+
+    /**
+     * Parse a version string. Never fails: anything unrecognised becomes
+     * a qualifier and still orders consistently.
+     */
+    explicit Version(std::string_view text);
+
+    const std::string& str() const { return m_text; }
+    bool empty() const { return m_text.empty(); }
+    bool isPrerelease() const { return m_prerelease; }
+    bool isSnapshot() const { return m_snapshot; }
+
+    /**
+     * Compare two versions
+     * @return -1, 0 or 1
+     */
+    int compare(const Version& other) const;
+
+    std::strong_ordering operator<=>(const Version& other) const { return m_key <=> other.m_key; }
+    bool operator==(const Version& other) const { return m_key == other.m_key; }
+
+    /**
+     * Smallest version that starts with this one's components, including
+     * its pre-releases ("2.0" -> below 2.0-alpha). Used for exclusive
+     * upper bounds of ~, ^ and x ranges.
+     */
+    Version floor() const;
+
+private:
+    std::string m_text;
+    std::string m_key;
+    bool m_prerelease{false};
+    bool m_snapshot{false};
+};
+
+/**
+ * @brief Set of acceptable versions for a dependency
+ *
+ * Accepts the range syntaxes found in mod metadata:
+ *  - Maven intervals (Forge mods.toml): "[1.0,2.0)", "(,1.5]", "[1.2]",
+ *    unions "[1,2),[3,4)"
+ *  - npm / Fabric comparators: ">=1.2 <2", "=1.2", "1.2" (exact),
+ *    "~1.2.3", "^1.2.3", "1.20.x", "*", alternatives joined by "||"
+ */
+class VersionRange {
+public:
+    /**
+     * Parse a range
+     * @param text Range expression (empty or "*" matches everything)
+     * @return Range, or nullopt if the syntax is invalid
+     */
+    static std::optional<VersionRange> parse(std::string_view text);
+
+    /**
+     * A range that matches every version
+     */
+    static VersionRange any() { return VersionRange(); }
+
+    bool contains(const Version& version) const;
+    bool contains(std::string_view version) const { return contains(Version(version)); }
+
+private:
+    enum class Op { Less, LessEqual, Greater, GreaterEqual, Equal };
+
+    struct Bound {
+        Op op;
+        Version version;
+    };
+
+    static bool parseMaven(std::string_view text, VersionRange& range);
+    static bool parseComparators(std::string_view text, std::vector<Bound>& bounds);
+
+    // Alternatives (OR) of bound sets (AND); empty = any version
+    std::vector<std::vector<Bound>> m_alternatives;
+};
+
+} // namespace konami::utils
@@ -0,0 +1,1250 @@
+/**
+ * ZipArchive.cpp
+ *
+ * Zip reading over mmap and parallel zip writing, both on zlib.
+ * Format reference: PKWARE APPNOTE 6.3.x (local headers, central
+ * directory, zip64 end records and extra fields).
+ */
+
+#include "ZipArchive.hpp"
+#include "DirectoryWalker.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace konami::utils {
+
+namespace {
+
+constexpr uint32_t kLocalHeaderSig = 0x04034b50;
+constexpr uint32_t kCentralHeaderSig = 0x02014b50;
+constexpr uint32_t kEndOfCentralDirSig = 0x06054b50;
+constexpr uint32_t kZip64EndSig = 0x06064b50;
+constexpr uint32_t kZip64LocatorSig = 0x07064b50;
+
+constexpr uint16_t kMethodStored = 0;
+constexpr uint16_t kMethodDeflated = 8;
+constexpr uint16_t kFlagUtf8 = 0x0800;
+
+constexpr size_t kLocalHeaderSize = 30;
+constexpr size_t kCentralHeaderSize = 46;
+constexpr size_t kEndOfCentralDirSize = 22;
+constexpr size_t kIoChunk = 256 * 1024;
+
+// Writer limits: buffered bytes across workers, and the size above which
+// a file is deflated by the writer thread in a streaming pass instead
+constexpr uint64_t kMaxInFlightBytes = 128ull * 1024 * 1024;
+constexpr uint64_t kStreamThreshold = 32ull * 1024 * 1024;
+constexpr uint64_t kZip64Threshold = 0xF0000000ull;
+
+uint16_t readU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+uint64_t readU64(const uint8_t* p) { return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32); }
+
+void putU16(std::string& out, uint16_t v) { out += static_cast<char>(v & 0xFF); out += static_cast<char>(v >> 8); }
+void putU32(std::string& out, uint32_t v) { putU16(out, static_cast<uint16_t>(v & 0xFFFF)); putU16(out, static_cast<uint16_t>(v >> 16)); }
+void putU64(std::string& out, uint64_t v) { putU32(out, static_cast<uint32_t>(v)); putU32(out, static_cast<uint32_t>(v >> 32)); }
+
+void setError(std::string* error, std::string message) {
+    if (error) *error = std::move(message);
+}
+
+/**
+ * Run fn(i) for i in [0, count) on up to `threads` threads, pulling work dynamically.
+ * Uses its own threads so callers already on a pool cannot deadlock it.
+ */
+template<typename Fn>
+void parallelFor(size_t count, unsigned threads, Fn&& fn) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, count));
+
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < count; i = next++) fn(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+}
+
+/**
+ * Output file opened for sequential writing, preallocated to its final size
+ */
+class OutputFile {
+public:
+    bool open(const fs::path& path, uint64_t size, uint32_t unixMode) {
+#ifdef _WIN32
+        (void)unixMode;
+        m_stream.rdbuf()->pubsetbuf(nullptr, 0);
+        m_stream.open(path, std::ios::binary | std::ios::trunc);
+        (void)size;
+        return m_stream.is_open();
+#else
+        mode_t mode = (unixMode & 0111) ? 0755 : 0644;
+        m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+        if (m_fd < 0) return false;
+#if defined(__linux__)
+        // Reserve blocks up front so parallel writers don't fragment each other
+        if (size > 0) posix_fallocate(m_fd, 0, static_cast<off_t>(size));
+#else
+        (void)size;
+#endif
+        return true;
+#endif
+    }
+
+    bool write(const void* data, size_t size) {
+#ifdef _WIN32
+        m_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        return m_stream.good();
+#else
+        const auto* p = static_cast<const uint8_t*>(data);
+        while (size > 0) {
+            ssize_t n = ::write(m_fd, p, size);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+#endif
+    }
+
+    bool close() {
+#ifdef _WIN32
+        m_stream.close();
+        return !m_stream.fail();
+#else
+        if (m_fd < 0) return true;
+        int rc = ::close(m_fd);
+        m_fd = -1;
+        return rc == 0;
+#endif
+    }
+
+    ~OutputFile() { close(); }
+
+private:
+#ifdef _WIN32
+    std::ofstream m_stream;
+#else
+    int m_fd{-1};
+#endif
+};
+
+bool hasStoredExtension(const fs::path& path) {
+    static const std::set<std::string> kCompressed = {
+        ".jar", ".zip", ".png", ".jpg", ".jpeg", ".gif", ".webp", ".ogg", ".mp3",
+        ".gz", ".xz", ".zst", ".7z", ".lz4", ".mrpack"
+    };
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return kCompressed.count(ext) > 0;
+}
+
+void dosDateTime(fs::file_time_type mtime, uint16_t& date, uint16_t& time) {
+    auto sys = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        mtime - fs::file_time_type::clock::now());
+    std::time_t t = std::chrono::system_clock::to_time_t(sys);
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    if (tm.tm_year < 80) {
+        date = (1 << 5) | 1;   // 1980-01-01
+        time = 0;
+        return;
+    }
+    date = static_cast<uint16_t>(((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday);
+    time = static_cast<uint16_t>((tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2));
+}
+
+} // namespace
+
+// -- MappedFile --
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+#ifdef _WIN32
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::open(const fs::path& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) { CloseHandle(file); return false; }
+    m_file = file;
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size > 0) {
+        m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) { close(); return false; }
+        m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data) { close(); return false; }
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st {};
+    if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size > 0) {
+        void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) { ::close(fd); m_size = 0; return false; }
+        m_data = static_cast<const uint8_t*>(addr);
+    }
+    ::close(fd);
+#endif
+    m_open = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+// -- ZipReader --
+
+bool ZipReader::open(const fs::path& path) {
+    close();
+    if (!m_file.open(path)) {
+        m_error = "Cannot open " + path.string();
+        return false;
+    }
+    if (!parseCentralDirectory()) {
+        m_entries.clear();
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+void ZipReader::close() {
+    m_indexed.store(false, std::memory_order_relaxed);
+    m_seeds.clear();
+    m_slots.clear();
+    m_linearLookup = false;
+    m_entries.clear();
+    m_file.close();
+    m_error.clear();
+}
+
+bool ZipReader::parseCentralDirectory() {
+    const uint8_t* base = m_file.data();
+    const size_t size = m_file.size();
+    if (size < kEndOfCentralDirSize) {
+        m_error = "Not a zip archive";
+        return false;
+    }
+
+    // The end record sits before an optional comment of up to 64 KiB
+    size_t searchStart = size > kEndOfCentralDirSize + 0xFFFF ? size - kEndOfCentralDirSize - 0xFFFF : 0;
+    size_t eocd = std::string::npos;
+    for (size_t pos = size - kEndOfCentralDirSize + 1; pos-- > searchStart;) {
+        if (readU32(base + pos) == kEndOfCentralDirSig) {
+            eocd = pos;
+            break;
+        }
+    }
+    if (eocd == std::string::npos) {
+        m_error = "End of central directory not found";
+        return false;
+    }
+
+    uint64_t entryCount = readU16(base + eocd + 10);
+    uint64_t cdSize = readU32(base + eocd + 12);
+    uint64_t cdOffset = readU32(base + eocd + 16);
+
+    if (eocd >= 20 && readU32(base + eocd - 20) == kZip64LocatorSig) {
+        uint64_t zip64End = readU64(base + eocd - 20 + 8);
+        if (zip64End > size || size - zip64End < 56 || readU32(base + zip64End) != kZip64EndSig) {
+            m_error = "Corrupt zip64 end record";
+            return false;
+        }
+        entryCount = readU64(base + zip64End + 32);
+        cdSize = readU64(base + zip64End + 40);
+        cdOffset = readU64(base + zip64End + 48);
+    }
+
+    if (cdOffset > size || cdSize > size - cdOffset) {
+        m_error = "Central directory out of bounds";
+        return false;
+    }
+
+    // Names stay in the mapping, so this is the only allocation
+    m_entries.reserve(static_cast<size_t>(std::min<uint64_t>(entryCount, cdSize / kCentralHeaderSize)));
+    const uint8_t* p = base + cdOffset;
+    const uint8_t* end = p + cdSize;
+    for (uint64_t i = 0; i < entryCount; ++i) {
+        if (static_cast<size_t>(end - p) < kCentralHeaderSize || readU32(p) != kCentralHeaderSig) {
+            m_error = "Corrupt central directory";
+            return false;
+        }
+
+        uint16_t madeBy = readU16(p + 4);
+        uint16_t nameLength = readU16(p + 28);
+        uint16_t extraLength = readU16(p + 30);
+        uint16_t commentLength = readU16(p + 32);
+        size_t recordSize = kCentralHeaderSize + nameLength + extraLength + commentLength;
+        if (static_cast<size_t>(end - p) < recordSize) {
+            m_error = "Corrupt central directory";
+            return false;
+        }
+
+        ZipEntry& entry = m_entries.emplace_back();
+        entry.flags = readU16(p + 8);
+        entry.method = readU16(p + 10);
+        entry.crc32 = readU32(p + 16);
+        entry.compressedSize = readU32(p + 20);
+        entry.uncompressedSize = readU32(p + 24);
+        entry.localHeaderOffset = readU32(p + 42);
+        entry.name = std::string_view(reinterpret_cast<const char*>(p + kCentralHeaderSize), nameLength);
+        if ((madeBy >> 8) == 3) {
+            entry.unixMode = readU32(p + 38) >> 16;
+        }
+
+        // Zip64 extra: only the fields saturated in the fixed header are present, in order
+        const uint8_t* extra = p + kCentralHeaderSize + nameLength;
+        const uint8_t* extraEnd = extra + extraLength;
+        while (extraEnd - extra >= 4) {
+            uint16_t id = readU16(extra);
+            uint16_t length = readU16(extra + 2);
+            const uint8_t* field = extra + 4;
+            if (extraEnd - field < length) break;
+            if (id == 0x0001) {
+                const uint8_t* fieldEnd = field + length;
+                auto take = [&](uint64_t& value) {
+                    if (value == 0xFFFFFFFFu && fieldEnd - field >= 8) {
+                        value = readU64(field);
+                        field += 8;
+                    }
+                };
+                take(entry.uncompressedSize);
+                take(entry.compressedSize);
+                take(entry.localHeaderOffset);
+                break;
+            }
+            extra = field + length;
+        }
+
+        p += recordSize;
+    }
+    return true;
+}
+
+namespace {
+
+constexpr uint32_t kEmptySlot = 0xFFFFFFFFu;
+
+uint64_t hashName(std::string_view name) {
+    // Eight bytes per step; only needs to spread names, not resist attacks
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ name.size();
+    const char* p = name.data();
+    size_t remaining = name.size();
+    while (remaining >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        hash = (hash ^ word) * 0xff51afd7ed558ccdull;
+        hash ^= hash >> 29;
+        p += 8;
+        remaining -= 8;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, p, remaining);
+    hash = (hash ^ tail) * 0xc4ceb9fe1a85ec53ull;
+    return hash ^ (hash >> 32);
+}
+
+uint32_t slotFor(uint64_t hash, uint32_t seed, uint32_t mask) {
+    uint64_t x = hash ^ (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return static_cast<uint32_t>(x) & mask;
+}
+
+} // namespace
+
+void ZipReader::buildIndex() const {
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    if (m_indexed.load(std::memory_order_relaxed)) return;
+
+    // Hash-and-displace: keys are grouped into buckets of about two, and each
+    // bucket, largest first, takes the first seed that sends all of its keys
+    // to free slots. The table is kept at most half full so seeds are found
+    // in a few probes.
+    const size_t count = m_entries.size();
+    std::vector<uint64_t> hashes(count);
+    for (size_t i = 0; i < count; ++i) {
+        hashes[i] = hashName(m_entries[i].name);
+    }
+
+    const size_t bucketCount = std::max<size_t>(1, count / 2);
+    std::vector<uint32_t> bucketStart(bucketCount + 1, 0);
+    for (uint64_t hash : hashes) bucketStart[hash % bucketCount + 1]++;
+    size_t largest = 0;
+    for (size_t b = 0; b < bucketCount; ++b) {
+        largest = std::max<size_t>(largest, bucketStart[b + 1]);
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    std::vector<uint32_t> members(count);
+    {
+        std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (uint32_t i = 0; i < count; ++i) members[fill[hashes[i] % bucketCount]++] = i;
+    }
+
+    // Bucket order by size, descending (counting sort)
+    std::vector<std::vector<uint32_t>> bySize(largest + 1);
+    for (uint32_t b = 0; b < bucketCount; ++b) {
+        bySize[bucketStart[b + 1] - bucketStart[b]].push_back(b);
+    }
+
+    size_t tableSize = std::bit_ceil(count * 2);
+    for (int attempt = 0; attempt < 4; ++attempt, tableSize *= 2) {
+        const uint32_t mask = static_cast<uint32_t>(tableSize - 1);
+        m_seeds.assign(bucketCount, 0);
+        m_slots.assign(tableSize, kEmptySlot);
+
+        bool placedAll = true;
+        uint32_t taken[64];
+        for (size_t size = largest; size > 0 && placedAll; --size) {
+            for (uint32_t b : bySize[size]) {
+                const uint32_t* keys = members.data() + bucketStart[b];
+
+                // Duplicate names keep the first entry; equal hashes with different
+                // names (or a freak bucket) cannot be placed by any seed
+                size_t unique = 0;
+                uint32_t bucketKeys[64];
+                for (size_t k = 0; k < size && placedAll; ++k) {
+                    auto same = std::find_if(bucketKeys, bucketKeys + unique, [&](uint32_t j) {
+                        return hashes[j] == hashes[keys[k]];
+                    });
+                    if (same == bucketKeys + unique) {
+                        if (unique == 64) placedAll = false;
+                        else bucketKeys[unique++] = keys[k];
+                    } else if (m_entries[*same].name != m_entries[keys[k]].name) {
+                        placedAll = false;
+                    }
+                }
+                if (!placedAll) break;
+
+                bool placed = false;
+                for (uint32_t seed = 0; seed < (1u << 16) && !placed; ++seed) {
+                    placed = true;
+                    for (size_t k = 0; k < unique; ++k) {
+                        uint32_t slot = slotFor(hashes[bucketKeys[k]], seed, mask);
+                        if (m_slots[slot] != kEmptySlot || std::find(taken, taken + k, slot) != taken + k) {
+                            placed = false;
+                            break;
+                        }
+                        taken[k] = slot;
+                    }
+                    if (placed) {
+                        m_seeds[b] = seed;
+                        for (size_t k = 0; k < unique; ++k) m_slots[taken[k]] = bucketKeys[k];
+                    }
+                }
+                if (!placed) {
+                    placedAll = false;
+                    break;
+                }
+            }
+        }
+
+        if (placedAll) {
+            m_indexed.store(true, std::memory_order_release);
+            return;
+        }
+    }
+
+    // Only reachable with a full 64-bit hash collision between different names
+    m_seeds.clear();
+    m_slots.clear();
+    m_linearLookup = true;
+    m_indexed.store(true, std::memory_order_release);
+}
+
+const ZipEntry* ZipReader::find(std::string_view name) const {
+    if (m_entries.empty()) return nullptr;
+    if (!m_indexed.load(std::memory_order_acquire)) buildIndex();
+
+    if (m_linearLookup) {
+        for (const auto& entry : m_entries) {
+            if (entry.name == name) return &entry;
+        }
+        return nullptr;
+    }
+
+    uint64_t hash = hashName(name);
+    uint32_t seed = m_seeds[hash % m_seeds.size()];
+    uint32_t index = m_slots[slotFor(hash, seed, static_cast<uint32_t>(m_slots.size() - 1))];
+    if (index == kEmptySlot || m_entries[index].name != name) return nullptr;
+    return &m_entries[index];
+}
+
+std::optional<std::pair<const uint8_t*, size_t>> ZipReader::entryData(const ZipEntry& entry) const {
+    const uint8_t* base = m_file.data();
+    const size_t size = m_file.size();
+    if (entry.localHeaderOffset > size || size - entry.localHeaderOffset < kLocalHeaderSize) {
+        return std::nullopt;
+    }
+
+    const uint8_t* local = base + entry.localHeaderOffset;
+    if (readU32(local) != kLocalHeaderSig) {
+        return std::nullopt;
+    }
+
+    // Local name/extra lengths may differ from the central copy
+    uint64_t dataOffset = entry.localHeaderOffset + kLocalHeaderSize + readU16(local + 26) + readU16(local + 28);
+    if (dataOffset > size || size - dataOffset < entry.compressedSize) {
+        return std::nullopt;
+    }
+    return std::make_pair(base + dataOffset, static_cast<size_t>(entry.compressedSize));
+}
+
+std::optional<std::string_view> ZipReader::view(const ZipEntry& entry) const {
+    if (entry.method != kMethodStored || entry.isEncrypted() || entry.compressedSize != entry.uncompressedSize) {
+        return std::nullopt;
+    }
+    auto data = entryData(entry);
+    if (!data) return std::nullopt;
+    return std::string_view(reinterpret_cast<const char*>(data->first), data->second);
+}
+
+template<typename Consumer>
+bool ZipReader::decode(const ZipEntry& entry, Consumer&& consume, std::string* error) const {
+    // Stored entries go straight from the mapping to the consumer
+    if (auto stored = view(entry)) {
+        const auto* p = reinterpret_cast<const uint8_t*>(stored->data());
+        size_t remaining = stored->size();
+        uLong crc = crc32(0L, Z_NULL, 0);
+        while (remaining > 0) {
+            uInt chunk = static_cast<uInt>(std::min<size_t>(remaining, kIoChunk));
+            crc = crc32(crc, p, chunk);
+            if (!consume(p, chunk)) {
+                setError(error, "Write failed: " + std::string(entry.name));
+                return false;
+            }
+            p += chunk;
+            remaining -= chunk;
+        }
+        if (static_cast<uint32_t>(crc) != entry.crc32) {
+            setError(error, "CRC mismatch: " + std::string(entry.name));
+            return false;
+        }
+        return true;
+    }
+
+    ZipEntryStream stream(*this, entry);
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[kIoChunk]);
+    while (size_t got = stream.read(buffer.get(), kIoChunk)) {
+        if (!consume(buffer.get(), got)) {
+            setError(error, "Write failed: " + std::string(entry.name));
+            return false;
+        }
+    }
+    if (!stream.ok()) {
+        setError(error, stream.error());
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::string> ZipReader::read(const ZipEntry& entry) const {
+    std::string out;
+    out.reserve(static_cast<size_t>(entry.uncompressedSize));
+    bool ok = decode(entry, [&](const uint8_t* data, size_t size) {
+        out.append(reinterpret_cast<const char*>(data), size);
+        return true;
+    }, nullptr);
+    if (!ok) return std::nullopt;
+    return out;
+}
+
+bool ZipReader::extract(const ZipEntry& entry, const fs::path& destination, std::string* error) const {
+    std::error_code ec;
+    if (destination.has_parent_path()) fs::create_directories(destination.parent_path(), ec);
+
+    OutputFile out;
+    if (!out.open(destination, entry.uncompressedSize, entry.unixMode)) {
+        setError(error, "Cannot create " + destination.string());
+        return false;
+    }
+
+    bool ok = decode(entry, [&](const uint8_t* data, size_t size) { return out.write(data, size); }, error);
+    ok = out.close() && ok;
+    if (!ok) {
+        fs::remove(destination, ec);
+    }
+    return ok;
+}
+
+bool ZipReader::extractAll(const fs::path& destination, unsigned threads) {
+    std::error_code ec;
+    fs::create_directories(destination, ec);
+    fs::path root = fs::absolute(destination, ec).lexically_normal();
+
+    // Validate every name and create the directory tree before any worker starts
+    std::vector<const ZipEntry*> files;
+    std::set<fs::path> directories;
+    for (const auto& entry : m_entries) {
+        if (!isSafeEntryName(entry.name)) {
+            m_error = "Unsafe entry name: " + std::string(entry.name);
+            return false;
+        }
+        fs::path target = (root / fs::path(entry.name)).lexically_normal();
+        if (entry.isDirectory()) {
+            directories.insert(target);
+        } else {
+            directories.insert(target.parent_path());
+            files.push_back(&entry);
+        }
+    }
+    for (const auto& dir : directories) {
+        fs::create_directories(dir, ec);
+    }
+
+    // Largest first keeps one big entry from finishing last on a single thread
+    std::sort(files.begin(), files.end(), [](const ZipEntry* a, const ZipEntry* b) {
+        return a->compressedSize > b->compressedSize;
+    });
+
+    std::atomic<bool> failed{false};
+    std::mutex errorMutex;
+    parallelFor(files.size(), threads, [&](size_t i) {
+        if (failed.load(std::memory_order_relaxed)) return;
+        std::string error;
+        if (!extract(*files[i], root / fs::path(files[i]->name), &error)) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!failed.exchange(true)) m_error = error;
+        }
+    });
+    return !failed;
+}
+
+bool ZipReader::isSafeEntryName(std::string_view name) {
+    if (name.empty() || name.find('\0') != std::string_view::npos) return false;
+    if (name.front() == '/' || name.front() == '\\') return false;
+    if (name.size() >= 2 && name[1] == ':') return false;   // Drive letter
+
+    size_t start = 0;
+    while (start <= name.size()) {
+        size_t end = name.find_first_of("/\\", start);
+        std::string_view part = name.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        if (part == "..") return false;
+        if (end == std::string_view::npos) break;
+        start = end + 1;
+    }
+    return true;
+}
+
+// -- ZipEntryStream --
+
+class ZipEntryStream::Impl {
+public:
+    const ZipEntry& entry;
+    const uint8_t* input{nullptr};
+    size_t inputRemaining{0};
+    bool inflating{false};
+    bool ended{false};
+    z_stream stream{};
+    uLong crc{crc32(0L, Z_NULL, 0)};
+    uint64_t produced{0};
+
+    explicit Impl(const ZipEntry& e) : entry(e) {}
+
+    ~Impl() {
+        if (inflating) inflateEnd(&stream);
+    }
+};
+
+ZipEntryStream::ZipEntryStream(const ZipReader& reader, const ZipEntry& entry)
+    : m_impl(std::make_unique<Impl>(entry)) {
+    if (entry.isEncrypted()) {
+        m_error = "Encrypted entry: " + std::string(entry.name);
+        return;
+    }
+    if (entry.method != kMethodStored && entry.method != kMethodDeflated) {
+        m_error = "Unsupported compression method " + std::to_string(entry.method) + ": " + std::string(entry.name);
+        return;
+    }
+    if (entry.method == kMethodStored && entry.compressedSize != entry.uncompressedSize) {
+        m_error = "Size mismatch: " + std::string(entry.name);
+        return;
+    }
+
+    auto data = reader.entryData(entry);
+    if (!data) {
+        m_error = "Corrupt local header: " + std::string(entry.name);
+        return;
+    }
+    m_impl->input = data->first;
+    m_impl->inputRemaining = data->second;
+
+    if (entry.method == kMethodDeflated) {
+        if (inflateInit2(&m_impl->stream, -MAX_WBITS) != Z_OK) {
+            m_error = "inflateInit failed";
+            return;
+        }
+        m_impl->inflating = true;
+    }
+}
+
+ZipEntryStream::~ZipEntryStream() = default;
+
+size_t ZipEntryStream::read(void* buffer, size_t size) {
+    if (m_finished || !m_error.empty() || size == 0) return 0;
+
+    auto& impl = *m_impl;
+    const auto& entry = impl.entry;
+    auto* out = static_cast<uint8_t*>(buffer);
+    size = std::min<size_t>(size, 1u << 30);
+    size_t got = 0;
+
+    if (!impl.inflating) {
+        got = std::min(size, impl.inputRemaining);
+        std::memcpy(out, impl.input, got);
+        impl.input += got;
+        impl.inputRemaining -= got;
+        impl.ended = impl.inputRemaining == 0;
+    } else {
+        auto& stream = impl.stream;
+        stream.next_out = out;
+        stream.avail_out = static_cast<uInt>(size);
+        int rc = Z_OK;
+        while (stream.avail_out > 0 && rc != Z_STREAM_END) {
+            if (stream.avail_in == 0) {
+                if (impl.inputRemaining == 0) {
+                    m_error = "Truncated deflate stream: " + std::string(entry.name);
+                    return 0;
+                }
+                uInt chunk = static_cast<uInt>(std::min<size_t>(impl.inputRemaining, 1u << 30));
+                stream.next_in = const_cast<Bytef*>(impl.input);
+                stream.avail_in = chunk;
+                impl.input += chunk;
+                impl.inputRemaining -= chunk;
+            }
+            rc = inflate(&stream, Z_NO_FLUSH);
+            if (rc != Z_OK && rc != Z_STREAM_END) {
+                m_error = "Corrupt deflate stream: " + std::string(entry.name);
+                return 0;
+            }
+        }
+        got = size - stream.avail_out;
+        impl.ended = rc == Z_STREAM_END;
+    }
+
+    impl.crc = crc32(impl.crc, out, static_cast<uInt>(got));
+    impl.produced += got;
+    if (impl.produced > entry.uncompressedSize) {
+        m_error = "Entry larger than declared: " + std::string(entry.name);
+        return 0;
+    }
+
+    if (impl.ended) {
+        m_finished = true;
+        if (impl.produced != entry.uncompressedSize || static_cast<uint32_t>(impl.crc) != entry.crc32) {
+            m_error = "CRC mismatch: " + std::string(entry.name);
+            return 0;
+        }
+    }
+    return got;
+}
+
+// -- ZipWriter --
+
+namespace {
+
+struct PreparedEntry {
+    std::string name;
+    bool directory{false};
+    bool streamed{false};     // Deflated by the writer thread
+    bool ready{false};
+    bool failed{false};
+    std::string error;
+    uint16_t method{kMethodStored};
+    uint32_t crc{0};
+    uint64_t uncompressedSize{0};
+    uint64_t compressedSize{0};
+    uint16_t dosDate{0};
+    uint16_t dosTime{0};
+    uint32_t unixMode{0100644};
+    std::string data;
+    uint64_t reserved{0};     // Bytes counted against the in-flight budget
+    uint64_t localHeaderOffset{0};
+    bool zip64{false};
+};
+
+bool readWholeFile(const fs::path& path, std::string& out, uint64_t size) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    out.resize(static_cast<size_t>(size));
+    file.read(out.data(), static_cast<std::streamsize>(size));
+    out.resize(static_cast<size_t>(file.gcount()));
+    return !file.bad();
+}
+
+/**
+ * Deflate a whole buffer; falls back to STORED if compression doesn't help
+ */
+bool compressBuffer(PreparedEntry& entry, std::string&& input, int level, bool store) {
+    entry.uncompressedSize = input.size();
+
+    // crc32 takes uInt lengths; feed large inputs in slices
+    uLong crc = crc32(0L, Z_NULL, 0);
+    for (size_t offset = 0; offset < input.size();) {
+        uInt chunk = static_cast<uInt>(std::min<size_t>(input.size() - offset, 1u << 30));
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(input.data() + offset), chunk);
+        offset += chunk;
+    }
+    entry.crc = static_cast<uint32_t>(crc);
+
+    if (!store && level > 0 && !input.empty()) {
+        z_stream stream{};
+        if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            entry.error = "deflateInit failed";
+            return false;
+        }
+        std::string output(deflateBound(&stream, static_cast<uLong>(input.size())), '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(input.data());
+        stream.avail_in = static_cast<uInt>(input.size());
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+        int rc = deflate(&stream, Z_FINISH);
+        output.resize(stream.total_out);
+        deflateEnd(&stream);
+
+        if (rc == Z_STREAM_END && output.size() < input.size()) {
+            entry.method = kMethodDeflated;
+            entry.compressedSize = output.size();
+            entry.data = std::move(output);
+            return true;
+        }
+    }
+
+    entry.method = kMethodStored;
+    entry.compressedSize = input.size();
+    entry.data = std::move(input);
+    return true;
+}
+
+std::string localHeader(const PreparedEntry& entry) {
+    std::string out;
+    putU32(out, kLocalHeaderSig);
+    putU16(out, entry.zip64 ? 45 : 20);
+    putU16(out, kFlagUtf8);
+    putU16(out, entry.method);
+    putU16(out, entry.dosTime);
+    putU16(out, entry.dosDate);
+    putU32(out, entry.crc);
+    putU32(out, entry.zip64 ? 0xFFFFFFFFu : static_cast<uint32_t>(entry.compressedSize));
+    putU32(out, entry.zip64 ? 0xFFFFFFFFu : static_cast<uint32_t>(entry.uncompressedSize));
+    putU16(out, static_cast<uint16_t>(entry.name.size()));
+    putU16(out, entry.zip64 ? 20 : 0);
+    out += entry.name;
+    if (entry.zip64) {
+        putU16(out, 0x0001);
+        putU16(out, 16);
+        putU64(out, entry.uncompressedSize);
+        putU64(out, entry.compressedSize);
+    }
+    return out;
+}
+
+std::string centralHeader(const PreparedEntry& entry) {
+    bool bigSizes = entry.uncompressedSize >= 0xFFFFFFFFull || entry.compressedSize >= 0xFFFFFFFFull;
+    bool bigOffset = entry.localHeaderOffset >= 0xFFFFFFFFull;
+
+    std::string extra;
+    if (bigSizes || bigOffset) {
+        std::string fields;
+        if (bigSizes) {
+            putU64(fields, entry.uncompressedSize);
+            putU64(fields, entry.compressedSize);
+        }
+        if (bigOffset) putU64(fields, entry.localHeaderOffset);
+        putU16(extra, 0x0001);
+        putU16(extra, static_cast<uint16_t>(fields.size()));
+        extra += fields;
+    }
+
+    std::string out;
+    putU32(out, kCentralHeaderSig);
+    putU16(out, (3 << 8) | 45);   // Made by Unix, spec 4.5
+    putU16(out, (bigSizes || bigOffset || entry.zip64) ? 45 : 20);
+    putU16(out, kFlagUtf8);
+    putU16(out, entry.method);
+    putU16(out, entry.dosTime);
+    putU16(out, entry.dosDate);
+    putU32(out, entry.crc);
+    putU32(out, bigSizes ? 0xFFFFFFFFu : static_cast<uint32_t>(entry.compressedSize));
+    putU32(out, bigSizes ? 0xFFFFFFFFu : static_cast<uint32_t>(entry.uncompressedSize));
+    putU16(out, static_cast<uint16_t>(entry.name.size()));
+    putU16(out, static_cast<uint16_t>(extra.size()));
+    putU16(out, 0);   // Comment
+    putU16(out, 0);   // Disk
+    putU16(out, 0);   // Internal attributes
+    putU32(out, (entry.unixMode << 16) | (entry.directory ? 0x10 : 0));
+    putU32(out, bigOffset ? 0xFFFFFFFFu : static_cast<uint32_t>(entry.localHeaderOffset));
+    out += entry.name;
+    out += extra;
+    return out;
+}
+
+/**
+ * Deflate a large file straight into the archive, then patch its local header
+ */
+bool streamEntry(PreparedEntry& entry, const fs::path& path, int level, std::ofstream& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        entry.error = "Cannot read " + path.string();
+        return false;
+    }
+
+    entry.method = level > 0 ? kMethodDeflated : kMethodStored;
+    entry.zip64 = entry.uncompressedSize >= kZip64Threshold;
+    std::string header = localHeader(entry);
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    z_stream stream{};
+    if (entry.method == kMethodDeflated &&
+        deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        entry.error = "deflateInit failed";
+        return false;
+    }
+
+    std::unique_ptr<char[]> in(new char[kIoChunk]);
+    std::unique_ptr<char[]> buffer(new char[kIoChunk]);
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uint64_t read = 0;
+    uint64_t written = 0;
+    bool eof = false;
+    while (!eof) {
+        file.read(in.get(), static_cast<std::streamsize>(kIoChunk));
+        size_t got = static_cast<size_t>(file.gcount());
+        eof = got < kIoChunk;
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(in.get()), static_cast<uInt>(got));
+        read += got;
+
+        if (entry.method == kMethodStored) {
+            out.write(in.get(), static_cast<std::streamsize>(got));
+            written += got;
+            continue;
+        }
+
+        stream.next_in = reinterpret_cast<Bytef*>(in.get());
+        stream.avail_in = static_cast<uInt>(got);
+        do {
+            stream.next_out = reinterpret_cast<Bytef*>(buffer.get());
+            stream.avail_out = static_cast<uInt>(kIoChunk);
+            deflate(&stream, eof ? Z_FINISH : Z_NO_FLUSH);
+            size_t have = kIoChunk - stream.avail_out;
+            out.write(buffer.get(), static_cast<std::streamsize>(have));
+            written += have;
+        } while (stream.avail_out == 0);
+    }
+    if (entry.method == kMethodDeflated) deflateEnd(&stream);
+
+    if (file.bad() || !out.good()) {
+        entry.error = "I/O error while compressing " + path.string();
+        return false;
+    }
+
+    entry.crc = static_cast<uint32_t>(crc);
+    entry.uncompressedSize = read;
+    entry.compressedSize = written;
+    if (!entry.zip64 && (read >= 0xFFFFFFFFull || written >= 0xFFFFFFFFull)) {
+        entry.error = "File grew past the zip64 threshold while archiving: " + path.string();
+        return false;
+    }
+
+    auto end = out.tellp();
+    out.seekp(static_cast<std::streamoff>(entry.localHeaderOffset));
+    header = localHeader(entry);
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.seekp(end);
+    return out.good();
+}
+
+} // namespace
+
+bool ZipWriter::write(const fs::path& zipPath, const std::vector<Source>& sources,
+                      const Options& options, std::string* error) {
+    std::vector<PreparedEntry> entries(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        auto& entry = entries[i];
+        entry.name = sources[i].name;
+        entry.directory = !entry.name.empty() && entry.name.back() == '/';
+        if (!ZipReader::isSafeEntryName(entry.name)) {
+            setError(error, "Invalid entry name: " + entry.name);
+            return false;
+        }
+
+        std::error_code ec;
+        if (!entry.directory) {
+            entry.uncompressedSize = fs::file_size(sources[i].path, ec);
+            if (ec) {
+                setError(error, "Cannot stat " + sources[i].path.string());
+                return false;
+            }
+            entry.streamed = entry.uncompressedSize > kStreamThreshold;
+#ifndef _WIN32
+            auto perms = fs::status(sources[i].path, ec).permissions();
+            if ((perms & fs::perms::owner_exec) != fs::perms::none) entry.unixMode = 0100755;
+#endif
+        } else {
+            entry.unixMode = 040755;
+            entry.ready = true;
+        }
+        auto mtime = fs::last_write_time(entry.directory && sources[i].path.empty() ? fs::current_path() : sources[i].path, ec);
+        if (!ec) dosDateTime(mtime, entry.dosDate, entry.dosTime);
+        if (entry.streamed) entry.ready = true;
+    }
+
+    fs::path temp = zipPath;
+    temp += ".tmp";
+    std::error_code ec;
+    if (zipPath.has_parent_path()) fs::create_directories(zipPath.parent_path(), ec);
+
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        setError(error, "Cannot create " + temp.string());
+        return false;
+    }
+
+    // Workers claim entries in order; the writer consumes them in order
+    std::mutex mutex;
+    std::condition_variable readyCondition;
+    std::condition_variable budgetCondition;
+    size_t nextToWrite = 0;
+    uint64_t inFlight = 0;
+    std::atomic<size_t> nextToClaim{0};
+    std::atomic<bool> abort{false};
+
+    auto worker = [&] {
+        for (size_t i = nextToClaim++; i < entries.size() && !abort; i = nextToClaim++) {
+            auto& entry = entries[i];
+            if (entry.directory || entry.streamed) continue;
+
+            {
+                // The entry the writer is waiting on always proceeds, so this cannot deadlock
+                std::unique_lock<std::mutex> lock(mutex);
+                budgetCondition.wait(lock, [&] {
+                    return abort || i == nextToWrite || inFlight + entry.uncompressedSize <= kMaxInFlightBytes;
+                });
+                if (abort) return;
+                entry.reserved = entry.uncompressedSize;
+                inFlight += entry.reserved;
+            }
+
+            std::string input;
+            bool ok = readWholeFile(sources[i].path, input, entry.uncompressedSize);
+            if (!ok) {
+                entry.error = "Cannot read " + sources[i].path.string();
+            } else {
+                bool store = options.storeCompressedFormats && hasStoredExtension(sources[i].path);
+                ok = compressBuffer(entry, std::move(input), options.level, store);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                entry.failed = !ok;
+                entry.ready = true;
+            }
+            readyCondition.notify_all();
+        }
+    };
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, entries.size())));
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+
+    auto fail = [&](const std::string& message) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            abort = true;
+        }
+        budgetCondition.notify_all();
+        for (auto& thread : pool) thread.join();
+        out.close();
+        fs::remove(temp, ec);
+        setError(error, message);
+        return false;
+    };
+
+    uint64_t offset = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        auto& entry = entries[i];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            readyCondition.wait(lock, [&] { return entry.ready; });
+        }
+        if (entry.failed) {
+            return fail(entry.error);
+        }
+
+        entry.localHeaderOffset = offset;
+        if (entry.streamed) {
+            if (!streamEntry(entry, sources[i].path, options.level, out)) {
+                return fail(entry.error);
+            }
+        } else {
+            entry.zip64 = entry.uncompressedSize >= 0xFFFFFFFFull || entry.compressedSize >= 0xFFFFFFFFull;
+            std::string header = localHeader(entry);
+            out.write(header.data(), static_cast<std::streamsize>(header.size()));
+            out.write(entry.data.data(), static_cast<std::streamsize>(entry.data.size()));
+            std::string().swap(entry.data);
+        }
+        if (!out.good()) {
+            return fail("Write failed: " + temp.string());
+        }
+        offset = static_cast<uint64_t>(out.tellp());
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight -= entry.reserved;
+            nextToWrite = i + 1;
+        }
+        budgetCondition.notify_all();
+    }
+    for (auto& thread : pool) thread.join();
+
+    // Central directory and end records
+    uint64_t cdOffset = offset;
+    std::string directory;
+    for (const auto& entry : entries) {
+        directory += centralHeader(entry);
+    }
+    uint64_t cdSize = directory.size();
+
+    bool zip64 = entries.size() >= 0xFFFF || cdOffset >= 0xFFFFFFFFull || cdSize >= 0xFFFFFFFFull;
+    if (zip64) {
+        uint64_t zip64EndOffset = cdOffset + cdSize;
+        putU32(directory, kZip64EndSig);
+        putU64(directory, 44);
+        putU16(directory, (3 << 8) | 45);
+        putU16(directory, 45);
+        putU32(directory, 0);
+        putU32(directory, 0);
+        putU64(directory, entries.size());
+        putU64(directory, entries.size());
+        putU64(directory, cdSize);
+        putU64(directory, cdOffset);
+
+        putU32(directory, kZip64LocatorSig);
+        putU32(directory, 0);
+        putU64(directory, zip64EndOffset);
+        putU32(directory, 1);
+    }
+
+    putU32(directory, kEndOfCentralDirSig);
+    putU16(directory, 0);
+    putU16(directory, 0);
+    putU16(directory, zip64 ? 0xFFFF : static_cast<uint16_t>(entries.size()));
+    putU16(directory, zip64 ? 0xFFFF : static_cast<uint16_t>(entries.size()));
+    putU32(directory, zip64 ? 0xFFFFFFFFu : static_cast<uint32_t>(cdSize));
+    putU32(directory, zip64 ? 0xFFFFFFFFu : static_cast<uint32_t>(cdOffset));
+    putU16(directory, 0);
+
+    out.write(directory.data(), static_cast<std::streamsize>(directory.size()));
+    out.close();
+    if (out.fail()) {
+        fs::remove(temp, ec);
+        setError(error, "Write failed: " + temp.string());
+        return false;
+    }
+
+    fs::rename(temp, zipPath, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        setError(error, "Cannot rename archive into place: " + zipPath.string());
+        return false;
+    }
+    return true;
+}
+
+std::vector<ZipWriter::Source> ZipWriter::collect(const fs::path& root) {
+    std::vector<Source> sources;
+    std::mutex sourcesMutex;
+    DirectoryWalker::walk(root, DirectoryWalker::Options{}, [&](const DirectoryWalker::Entry& entry) {
+        if (entry.type != DirectoryWalker::Type::File && entry.type != DirectoryWalker::Type::Directory) return;
+        std::string name(entry.relativePath);
+        if (entry.type == DirectoryWalker::Type::Directory) name += '/';
+        std::lock_guard lock(sourcesMutex);
+        sources.push_back({entry.fullPath(), std::move(name)});
+    });
+    std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) { return a.name < b.name; });
+
+    // Keep directory entries only for empty directories: anything inside sorts right after them
+    std::vector<Source> kept;
+    kept.reserve(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const auto& name = sources[i].name;
+        bool isDirectory = name.back() == '/';
+        if (isDirectory && i + 1 < sources.size() && sources[i + 1].name.starts_with(name)) continue;
+        kept.push_back(std::move(sources[i]));
+    }
+    return kept;
+}
+
+} // namespace konami::utils
@@ -0,0 +1,254 @@
+// Konami Client - Zip Archives
+// Memory-mapped zip reader and parallel zip writer on zlib
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace konami::utils {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Map a file
+     * @param path File to map
+     * @return true if mapped (empty files map to a null view)
+     */
+    bool open(const fs::path& path);
+
+    /**
+     * Unmap the file
+     */
+    void close();
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool isOpen() const { return m_open; }
+
+private:
+    const uint8_t* m_data{nullptr};
+    size_t m_size{0};
+    bool m_open{false};
+#ifdef _WIN32
+    void* m_file{nullptr};
+    void* m_mapping{nullptr};
+#endif
+};
+
+/**
+ * @brief Central directory record of one zip entry
+ */
+struct ZipEntry {
+    std::string_view name;            // Points into the mapping; valid while the reader is open
+    uint16_t method{0};               // 0 = stored, 8 = deflated
+    uint16_t flags{0};
+    uint32_t crc32{0};
+    uint64_t compressedSize{0};
+    uint64_t uncompressedSize{0};
+    uint64_t localHeaderOffset{0};
+    uint32_t unixMode{0};             // 0 if the archive was not made on Unix
+
+    bool isDirectory() const { return !name.empty() && name.back() == '/'; }
+    bool isEncrypted() const { return (flags & 0x1) != 0; }
+};
+
+/**
+ * @brief Read-only zip archive over a memory mapping
+ *
+ * Opening parses the central directory into one flat vector without
+ * copying names; the name index (a minimal-collision perfect hash) is
+ * built on the first lookup. Reads are const and touch only the mapping,
+ * so entries can be inflated from several threads at once. Supports
+ * stored and deflated entries and zip64 archives.
+ */
+class ZipReader {
+public:
+    ZipReader() = default;
+
+    ZipReader(const ZipReader&) = delete;
+    ZipReader& operator=(const ZipReader&) = delete;
+
+    /**
+     * Open an archive and parse its central directory
+     * @param path Archive path
+     * @return true if opened
+     */
+    bool open(const fs::path& path);
+
+    /**
+     * Close the archive
+     */
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    const std::string& error() const { return m_error; }
+    const std::vector<ZipEntry>& entries() const { return m_entries; }
+
+    /**
+     * Find an entry by name
+     * @param name Entry name ("dir/file.ext")
+     * @return Entry or nullptr
+     */
+    const ZipEntry* find(std::string_view name) const;
+
+    /**
+     * View a stored entry without copying (no CRC check)
+     * @param entry Entry from this archive
+     * @return Bytes inside the mapping, or nullopt if the entry is compressed or corrupt
+     */
+    std::optional<std::string_view> view(const ZipEntry& entry) const;
+
+    /**
+     * Read an entry into memory
+     * @param entry Entry from this archive
+     * @return Contents, or nullopt on corruption / unsupported method
+     */
+    std::optional<std::string> read(const ZipEntry& entry) const;
+
+    /**
+     * Extract an entry to a file
+     * @param entry Entry from this archive
+     * @param destination Output file path
+     * @param error Optional error message
+     * @return true if written and CRC-verified
+     */
+    bool extract(const ZipEntry& entry, const fs::path& destination, std::string* error = nullptr) const;
+
+    /**
+     * Extract every entry below a directory, inflating in parallel
+     * @param destination Output directory
+     * @param threads Worker count (0 = hardware concurrency)
+     * @return true if all entries were extracted
+     */
+    bool extractAll(const fs::path& destination, unsigned threads = 0);
+
+    /**
+     * Check an entry name cannot escape the extraction directory (zip-slip)
+     * @param name Entry name
+     * @return true if relative and free of ".." components
+     */
+    static bool isSafeEntryName(std::string_view name);
+
+private:
+    friend class ZipEntryStream;
+
+    bool parseCentralDirectory();
+    void buildIndex() const;
+    std::optional<std::pair<const uint8_t*, size_t>> entryData(const ZipEntry& entry) const;
+
+    template<typename Consumer>
+    bool decode(const ZipEntry& entry, Consumer&& consume, std::string* error) const;
+
+    MappedFile m_file;
+    std::vector<ZipEntry> m_entries;
+    std::string m_error;
+
+    // Lazily built name index: bucket seeds displace keys into collision-free slots
+    mutable std::mutex m_indexMutex;
+    mutable std::atomic<bool> m_indexed{false};
+    mutable std::vector<uint32_t> m_seeds;
+    mutable std::vector<uint32_t> m_slots;
+    mutable bool m_linearLookup{false};
+};
+
+/**
+ * @brief Pull-based reader for one entry's uncompressed bytes
+ *
+ * Inflates on demand into the caller's buffer, so large entries never
+ * need to be held in memory. CRC and size are checked when the end of
+ * the entry is reached.
+ */
+class ZipEntryStream {
+public:
+    /**
+     * Constructor
+     * @param reader Open archive (must outlive the stream)
+     * @param entry Entry from that archive
+     */
+    ZipEntryStream(const ZipReader& reader, const ZipEntry& entry);
+    ~ZipEntryStream();
+
+    ZipEntryStream(const ZipEntryStream&) = delete;
+    ZipEntryStream& operator=(const ZipEntryStream&) = delete;
+
+    /**
+     * Read the next bytes
+     * @param buffer Destination
+     * @param size Buffer size
+     * @return Bytes written; 0 at the end of the entry or on error
+     */
+    size_t read(void* buffer, size_t size);
+
+    bool ok() const { return m_error.empty(); }
+    bool finished() const { return m_finished; }
+    const std::string& error() const { return m_error; }
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+    std::string m_error;
+    bool m_finished{false};
+};
+
+/**
+ * @brief Zip writer with parallel compression
+ *
+ * Worker threads read and deflate entries concurrently while the calling
+ * thread writes them to the archive in order, so output is deterministic.
+ * In-flight data is capped; files too large to buffer are deflated in a
+ * streaming pass by the writer thread.
+ */
+class ZipWriter {
+public:
+    struct Options {
+        int level{6};                       // zlib level 0-9
+        unsigned threads{0};                // 0 = hardware concurrency
+        bool storeCompressedFormats{true};  // Store .jar/.png/.ogg/... without recompressing
+    };
+
+    struct Source {
+        fs::path path;       // File on disk (ignored for directories)
+        std::string name;    // Entry name; trailing '/' makes a directory entry
+    };
+
+    /**
+     * Write an archive
+     * @param zipPath Output path (written to a temp file, then renamed)
+     * @param sources Entries in archive order
+     * @param options Compression options
+     * @param error Optional error message
+     * @return true if written
+     */
+    static bool write(const fs::path& zipPath, const std::vector<Source>& sources,
+                      const Options& options, std::string* error = nullptr);
+
+    /**
+     * Collect a directory tree as sources (sorted, '/'-separated names)
+     * @param root Directory to archive
+     * @return Sources, including entries for empty directories
+     */
+    static std::vector<Source> collect(const fs::path& root);
+};
+
+} // namespace konami::utils
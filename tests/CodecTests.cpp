@@ -0,0 +1,78 @@
+/**
+ * CodecTests.cpp
+ *
+ * Base64 (RFC 4648 vectors, URL-safe, unpadded) and hex round trips, strict
+ * decoding, and the SIMD kernels against the scalar reference.
+ */
+
+#include "utils/Codec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using konami::utils::Codec;
+
+TEST_CASE("Codec encodes the RFC 4648 base64 vectors", "[codec]") {
+    const std::vector<std::pair<std::string, std::string>> vectors = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"},
+    };
+    for (const auto& [plain, encoded] : vectors) {
+        CHECK(Codec::base64Encode(plain) == encoded);
+        CHECK(Codec::base64Decode(encoded) == plain);
+    }
+}
+
+TEST_CASE("Codec handles URL-safe and unpadded base64", "[codec]") {
+    const std::string bytes = "\xfb\xff\xbf";
+    CHECK(Codec::base64Encode(bytes) == "+/+/");
+    CHECK(Codec::base64Encode(bytes, Codec::Base64Alphabet::UrlSafe) == "-_-_");
+    CHECK(Codec::base64Decode("-_-_", Codec::Base64Alphabet::UrlSafe) == bytes);
+
+    CHECK(Codec::base64Encode("fo", Codec::Base64Alphabet::Standard, false) == "Zm8");
+    CHECK(Codec::base64Decode("Zm8") == "fo");
+    CHECK(Codec::base64EncodedSize(2, false) == 3);
+}
+
+TEST_CASE("Codec rejects invalid base64", "[codec]") {
+    CHECK_FALSE(Codec::base64Decode("Zm9v!"));
+    CHECK_FALSE(Codec::base64Decode("Z"));
+    CHECK_FALSE(Codec::base64Decode("Zg==Zg=="));
+    CHECK_FALSE(Codec::base64Decode("-_-_"));
+    CHECK_FALSE(Codec::base64Decode("+/+/", Codec::Base64Alphabet::UrlSafe));
+}
+
+TEST_CASE("Codec encodes and decodes hex", "[codec]") {
+    CHECK(Codec::hexEncode(std::string("\x00\x7f\xff", 3)) == "007fff");
+    CHECK(Codec::hexEncode(std::string("\xab", 1), true) == "AB");
+    CHECK(Codec::hexDecode("007FfF") == std::string("\x00\x7f\xff", 3));
+    CHECK_FALSE(Codec::hexDecode("abc"));
+    CHECK_FALSE(Codec::hexDecode("zz"));
+}
+
+TEST_CASE("Codec matches the scalar reference on long inputs", "[codec]") {
+    // Long enough to go through the vector kernels and their tails
+    std::string bytes;
+    for (int i = 0; i < 1000; ++i) {
+        bytes.push_back(static_cast<char>((i * 131 + 7) & 0xff));
+    }
+
+    for (size_t size : {size_t{15}, size_t{16}, size_t{47}, size_t{48}, size_t{999}}) {
+        std::string input = bytes.substr(0, size);
+
+        std::string reference(Codec::base64EncodedSize(size), '\0');
+        Codec::Scalar::base64Encode(input.data(), size, reference.data(), Codec::Base64Alphabet::Standard, true);
+        std::string encoded = Codec::base64Encode(input);
+        CHECK(encoded == reference);
+        CHECK(Codec::base64Decode(encoded) == input);
+
+        std::string hexReference(Codec::hexEncodedSize(size), '\0');
+        Codec::Scalar::hexEncode(input.data(), size, hexReference.data(), false);
+        std::string hex = Codec::hexEncode(input);
+        CHECK(hex == hexReference);
+        CHECK(Codec::hexDecode(hex) == input);
+    }
+}
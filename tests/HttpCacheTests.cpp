@@ -0,0 +1,232 @@
+/**
+ * HttpCacheTests.cpp
+ *
+ * HttpCache under HttpClient against a local origin: the RFC 9111 paths -
+ * max-age, no-store, ETag and Last-Modified revalidation, Vary,
+ * stale-on-5xx, POST invalidation, decoded bodies, split header fields and
+ * the disk tier.
+ */
+
+#include "LocalHttpServer.hpp"
+#include "utils/HttpCache.hpp"
+#include "utils/HttpClient.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <zlib.h>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+using konami::bench::LocalHttpServer;
+using konami::utils::HttpCache;
+using konami::utils::HttpClient;
+using konami::utils::HttpOptions;
+
+namespace {
+
+constexpr const char* kLastModified = "Wed, 01 Jan 2025 00:00:00 GMT";
+const std::string kPlainBody(4096, 'k');
+
+std::string deflate(const std::string& data) {
+    uLongf size = compressBound(static_cast<uLong>(data.size()));
+    std::string out(size, '\0');
+    compress2(reinterpret_cast<Bytef*>(out.data()), &size,
+              reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()), Z_BEST_SPEED);
+    out.resize(size);
+    return out;
+}
+
+/**
+ * Origin with one route per cache behaviour, counting GETs per path
+ */
+class Origin {
+public:
+    Origin() {
+        counted("/fresh", [](const std::string&) {
+            return LocalHttpServer::response(200, "fresh", {{"Cache-Control", "max-age=60"}});
+        });
+        counted("/nostore", [](const std::string&) {
+            return LocalHttpServer::response(200, "nostore", {{"Cache-Control", "no-store"}});
+        });
+        counted("/split", [](const std::string&) {
+            return LocalHttpServer::response(200, "split", {{"Cache-Control", "no-store"},
+                                                            {"Cache-Control", "max-age=60"}});
+        });
+        counted("/etag", [](const std::string& head) {
+            if (LocalHttpServer::requestHeader(head, "if-none-match") == "\"v1\"") {
+                return LocalHttpServer::response(304, "", {{"ETag", "\"v1\""}});
+            }
+            return LocalHttpServer::response(200, "etag", {{"Cache-Control", "no-cache"}, {"ETag", "\"v1\""}});
+        });
+        counted("/lastmod", [](const std::string& head) {
+            if (LocalHttpServer::requestHeader(head, "if-modified-since") == kLastModified) {
+                return LocalHttpServer::response(304, "");
+            }
+            return LocalHttpServer::response(200, "lastmod", {{"Cache-Control", "max-age=0"},
+                                                              {"Last-Modified", kLastModified}});
+        });
+        counted("/vary", [](const std::string& head) {
+            return LocalHttpServer::response(200, "lang:" + LocalHttpServer::requestHeader(head, "accept-language"),
+                                             {{"Cache-Control", "max-age=60"}, {"Vary", "Accept-Language"}});
+        });
+        counted("/flaky", [this](const std::string&) {
+            if (m_failing) {
+                return LocalHttpServer::response(503, "down");
+            }
+            return LocalHttpServer::response(200, "flaky", {{"Cache-Control", "max-age=0"}, {"ETag", "\"f1\""}});
+        });
+        counted("/post", [](const std::string&) {
+            return LocalHttpServer::response(200, "post", {{"Cache-Control", "max-age=60"}});
+        });
+        counted("/disk", [](const std::string&) {
+            return LocalHttpServer::response(200, "disk", {{"Cache-Control", "max-age=60"}});
+        });
+        counted("/deflate", [body = deflate(kPlainBody)](const std::string&) {
+            return LocalHttpServer::response(200, body, {{"Cache-Control", "max-age=60"},
+                                                         {"Content-Encoding", "deflate"}});
+        });
+    }
+
+    std::string url(const std::string& path) const { return m_server.url(path); }
+    int gets(const std::string& path) const { return m_gets.at(path).load(); }
+    void setFailing(bool failing) { m_failing = failing; }
+
+private:
+    void counted(const std::string& path, LocalHttpServer::Handler handler) {
+        auto& counter = m_gets[path];
+        m_server.handle(path, [&counter, handler = std::move(handler)](const std::string& head) {
+            if (head.rfind("GET ", 0) == 0) ++counter;
+            return handler(head);
+        });
+    }
+
+    // Declared before the server, which references them from its thread
+    std::unordered_map<std::string, std::atomic<int>> m_gets;
+    std::atomic<bool> m_failing{false};
+    LocalHttpServer m_server;
+};
+
+/**
+ * Fresh origin plus a cache attached to the shared HttpClient
+ */
+class CacheFixture {
+public:
+    CacheFixture() : m_directory(fs::temp_directory_path() / "konami-httpcache-tests") {
+        fs::remove_all(m_directory);
+        attach();
+    }
+
+    ~CacheFixture() {
+        HttpClient::instance().setCache(nullptr);
+        fs::remove_all(m_directory);
+    }
+
+    /**
+     * Replace the cache with a new one on the same directory
+     */
+    void attach() {
+        m_cache = std::make_shared<HttpCache>(m_directory);
+        HttpClient::instance().setCache(m_cache);
+    }
+
+    konami::utils::HttpResponse fetch(const std::string& path, const HttpOptions& options = {}) {
+        return HttpClient::instance().get(origin.url(path), options);
+    }
+
+    HttpCache& cache() { return *m_cache; }
+
+    Origin origin;
+
+private:
+    fs::path m_directory;
+    std::shared_ptr<HttpCache> m_cache;
+};
+
+} // namespace
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache serves fresh entries without a request", "[httpcache]") {
+    fetch("/fresh");
+    CHECK(fetch("/fresh").body == "fresh");
+    CHECK(origin.gets("/fresh") == 1);
+}
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache never stores no-store responses", "[httpcache]") {
+    fetch("/nostore");
+    fetch("/nostore");
+    CHECK(origin.gets("/nostore") == 2);
+}
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache reads directives from repeated Cache-Control lines", "[httpcache]") {
+    fetch("/split");
+    fetch("/split");
+    CHECK(origin.gets("/split") == 2);
+}
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache revalidates with validators", "[httpcache]") {
+    SECTION("ETag") {
+        fetch("/etag");
+        auto response = fetch("/etag");
+        CHECK(response.statusCode == 200);
+        CHECK(response.body == "etag");
+        CHECK(origin.gets("/etag") == 2);
+    }
+    SECTION("Last-Modified") {
+        fetch("/lastmod");
+        auto response = fetch("/lastmod");
+        CHECK(response.statusCode == 200);
+        CHECK(response.body == "lastmod");
+        CHECK(origin.gets("/lastmod") == 2);
+    }
+    CHECK(cache().stats().revalidated == 1);
+}
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache matches Vary request headers", "[httpcache]") {
+    HttpOptions english;
+    english.headers["Accept-Language"] = "en";
+    HttpOptions german;
+    german.headers["Accept-Language"] = "de";
+
+    // One variant is kept per URL; a request that selects another refetches
+    fetch("/vary", english);
+    CHECK(fetch("/vary", english).body == "lang:en");
+    CHECK(fetch("/vary", german).body == "lang:de");
+    CHECK(origin.gets("/vary") == 2);
+}
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache serves stale entries when the origin fails", "[httpcache]") {
+    fetch("/flaky");
+    origin.setFailing(true);
+    auto stale = fetch("/flaky");
+    origin.setFailing(false);
+
+    CHECK(stale.statusCode == 200);
+    CHECK(stale.body == "flaky");
+    CHECK(cache().stats().staleServed == 1);
+}
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache invalidates the target of a POST", "[httpcache]") {
+    fetch("/post");
+    HttpClient::instance().post(origin.url("/post"), "{}");
+    fetch("/post");
+    CHECK(origin.gets("/post") == 2);
+}
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache stores decoded bodies", "[httpcache]") {
+    fetch("/deflate");
+    auto decoded = fetch("/deflate");
+    CHECK(origin.gets("/deflate") == 1);
+    CHECK(decoded.body == kPlainBody);
+    CHECK(decoded.headers.count("content-encoding") == 0);
+}
+
+TEST_CASE_METHOD(CacheFixture, "HttpCache reloads entries from disk", "[httpcache]") {
+    fetch("/disk");
+    attach();
+    CHECK(fetch("/disk").body == "disk");
+    CHECK(origin.gets("/disk") == 1);
+}
@@ -0,0 +1,126 @@
+/**
+ * JsonSchemaTests.cpp
+ *
+ * Compiled JSON Schema validation: keywords, error paths, $ref resolution,
+ * uniqueItems equality and the schemas that must fail to compile.
+ */
+
+#include "utils/JsonSchema.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+using konami::utils::JsonSchema;
+using nlohmann::json;
+
+namespace {
+
+JsonSchema compileOrFail(const json& schema) {
+    std::string error;
+    auto compiled = JsonSchema::compile(schema, &error);
+    INFO(error);
+    REQUIRE(compiled);
+    return *compiled;
+}
+
+} // namespace
+
+TEST_CASE("JsonSchema checks types, ranges and required properties", "[jsonschema]") {
+    auto schema = compileOrFail(json::parse(R"({
+        "type": "object",
+        "required": ["name", "memory"],
+        "properties": {
+            "name": {"type": "string", "minLength": 1},
+            "memory": {"type": "integer", "minimum": 512, "maximum": 65536},
+            "tags": {"type": "array", "items": {"type": "string"}}
+        },
+        "additionalProperties": false
+    })"));
+
+    CHECK(schema.validate(json::parse(R"({"name": "a", "memory": 2048, "tags": ["x"]})")));
+    CHECK_FALSE(schema.validate(json::parse(R"({"name": "a"})")));
+    CHECK_FALSE(schema.validate(json::parse(R"({"name": "", "memory": 2048})")));
+    CHECK_FALSE(schema.validate(json::parse(R"({"name": "a", "memory": 100})")));
+    CHECK_FALSE(schema.validate(json::parse(R"({"name": "a", "memory": 2048, "extra": 1})")));
+    CHECK_FALSE(schema.validate(json::parse(R"({"name": "a", "memory": 2048, "tags": [1]})")));
+}
+
+TEST_CASE("JsonSchema reports every error with its instance path", "[jsonschema]") {
+    auto schema = compileOrFail(json::parse(R"({
+        "properties": {
+            "a": {"type": "string"},
+            "b": {"items": {"minimum": 0}}
+        }
+    })"));
+
+    auto errors = schema.errors(json::parse(R"({"a": 1, "b": [1, -1]})"));
+    REQUIRE(errors.size() == 2);
+    CHECK(errors[0].instancePath == "/a");
+    CHECK(errors[1].instancePath == "/b/1");
+    CHECK(schema.errors(json::parse(R"({"a": "x", "b": []})")).empty());
+}
+
+TEST_CASE("JsonSchema resolves $ref to $defs and anchors", "[jsonschema]") {
+    auto schema = compileOrFail(json::parse(R"({
+        "$defs": {
+            "positive": {"type": "number", "exclusiveMinimum": 0},
+            "named": {"$anchor": "name", "type": "string"}
+        },
+        "properties": {
+            "size": {"$ref": "#/$defs/positive"},
+            "label": {"$ref": "#name"}
+        }
+    })"));
+
+    CHECK(schema.validate(json::parse(R"({"size": 1, "label": "x"})")));
+    CHECK_FALSE(schema.validate(json::parse(R"({"size": 0})")));
+    CHECK_FALSE(schema.validate(json::parse(R"({"label": 1})")));
+}
+
+TEST_CASE("JsonSchema combines subschemas", "[jsonschema]") {
+    auto schema = compileOrFail(json::parse(R"({
+        "oneOf": [{"type": "integer"}, {"type": "number", "minimum": 10}],
+        "not": {"const": 42}
+    })"));
+
+    CHECK(schema.validate(1));
+    CHECK(schema.validate(10.5));
+    CHECK_FALSE(schema.validate(12));    // matches both branches
+    CHECK_FALSE(schema.validate(42));
+    CHECK_FALSE(schema.validate("x"));
+}
+
+TEST_CASE("JsonSchema compares uniqueItems by JSON value", "[jsonschema]") {
+    auto schema = compileOrFail(json::parse(R"({"uniqueItems": true})"));
+
+    CHECK(schema.validate(json::parse(R"([1, 2, "1"])")));
+    CHECK_FALSE(schema.validate(json::parse(R"([1, 1.0])")));
+    CHECK_FALSE(schema.validate(json::parse(R"([{"a": 1, "b": 2}, {"b": 2, "a": 1}])")));
+    CHECK_FALSE(schema.validate(json::parse(R"([[0], [-0.0]])")));
+}
+
+TEST_CASE("JsonSchema matches patterns anywhere in the string", "[jsonschema]") {
+    auto schema = compileOrFail(json::parse(R"({"pattern": "^[a-z]+$", "propertyNames": {"pattern": "ab"}})"));
+
+    CHECK(schema.validate("abc"));
+    CHECK_FALSE(schema.validate("abc1"));
+    CHECK(schema.validate(json::parse(R"({"xaby": 1})")));
+    CHECK_FALSE(schema.validate(json::parse(R"({"xy": 1})")));
+}
+
+TEST_CASE("JsonSchema refuses schemas it cannot honour", "[jsonschema]") {
+    for (const char* text : {
+             R"({"unevaluatedProperties": false})",
+             R"({"$ref": "other.json#/a"})",
+             R"({"$ref": "#/$defs/missing"})",
+             R"({"pattern": "\\p{L}+"})",
+             R"({"pattern": "("})",
+             R"({"minimum": "1"})",
+         }) {
+        INFO(text);
+        std::string error;
+        CHECK_FALSE(JsonSchema::compile(json::parse(text), &error));
+        CHECK_FALSE(error.empty());
+    }
+}
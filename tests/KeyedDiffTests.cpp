@@ -0,0 +1,99 @@
+/**
+ * KeyedDiffTests.cpp
+ *
+ * diffKeyed/applyKeyedEdits against a vector-backed model: every edit
+ * script must turn the previous rows into the next ones, and rows that
+ * kept their place must not be touched.
+ */
+
+#include "ui/bridge/KeyedDiff.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using konami::ui::KeyedEdit;
+using konami::ui::applyKeyedEdits;
+using konami::ui::diffKeyed;
+
+namespace {
+
+struct Row {
+    std::string id;
+    int value{0};
+
+    bool operator==(const Row&) const = default;
+};
+
+/**
+ * Minimal model with the slint::VectorModel editing interface
+ */
+struct VectorModel {
+    std::vector<Row> rows;
+
+    void erase(size_t row) { rows.erase(rows.begin() + static_cast<std::ptrdiff_t>(row)); }
+    void insert(size_t row, const Row& value) { rows.insert(rows.begin() + static_cast<std::ptrdiff_t>(row), value); }
+    void set_row_data(size_t row, const Row& value) { rows.at(row) = value; }
+};
+
+std::vector<Row> rowsOf(std::string_view ids, int value = 0) {
+    std::vector<Row> rows;
+    for (char id : ids) rows.push_back({std::string(1, id), value});
+    return rows;
+}
+
+/**
+ * Diff previous into next, apply it and check the result
+ * @return The edits that were applied
+ */
+std::vector<KeyedEdit> diffAndApply(const std::vector<Row>& previous, const std::vector<Row>& next) {
+    auto edits = diffKeyed(previous, next, [](const Row& row) { return std::string_view(row.id); });
+    VectorModel model{previous};
+    applyKeyedEdits(model, edits, next);
+    CHECK(model.rows == next);
+    return edits;
+}
+
+size_t countKind(const std::vector<KeyedEdit>& edits, KeyedEdit::Kind kind) {
+    size_t count = 0;
+    for (const auto& edit : edits) count += edit.kind == kind;
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("diffKeyed produces no edits for equal lists", "[keyeddiff]") {
+    CHECK(diffAndApply(rowsOf("abcd"), rowsOf("abcd")).empty());
+    CHECK(diffAndApply({}, {}).empty());
+}
+
+TEST_CASE("diffKeyed inserts and removes only what changed", "[keyeddiff]") {
+    auto edits = diffAndApply(rowsOf("abcd"), rowsOf("abxd"));
+    CHECK(countKind(edits, KeyedEdit::Kind::Remove) == 1);
+    CHECK(countKind(edits, KeyedEdit::Kind::Insert) == 1);
+    CHECK(countKind(edits, KeyedEdit::Kind::Update) == 0);
+
+    CHECK(diffAndApply({}, rowsOf("abc")).size() == 3);
+    CHECK(diffAndApply(rowsOf("abc"), {}).size() == 3);
+}
+
+TEST_CASE("diffKeyed updates rows whose data changed in place", "[keyeddiff]") {
+    auto edits = diffAndApply(rowsOf("abc", 0), rowsOf("abc", 1));
+    CHECK(countKind(edits, KeyedEdit::Kind::Update) == 3);
+    CHECK(countKind(edits, KeyedEdit::Kind::Insert) == 0);
+}
+
+TEST_CASE("diffKeyed moves a row with one remove and one insert", "[keyeddiff]") {
+    auto edits = diffAndApply(rowsOf("abcde"), rowsOf("bcdea"));
+    CHECK(edits.size() == 2);
+
+    diffAndApply(rowsOf("abcde"), rowsOf("edcba"));
+    diffAndApply(rowsOf("abcdef"), rowsOf("fbxdaz"));
+}
+
+TEST_CASE("diffKeyed matches only the first occurrence of a repeated key", "[keyeddiff]") {
+    diffAndApply(rowsOf("aab"), rowsOf("aba"));
+    diffAndApply(rowsOf("abab"), rowsOf("bb"));
+}
@@ -0,0 +1,136 @@
+/**
+ * VersionTests.cpp
+ *
+ * Version ordering (SemVer, Maven qualifiers, Minecraft releases and
+ * snapshots) and VersionRange parsing and matching.
+ */
+
+#include "utils/Version.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+using konami::utils::Version;
+using konami::utils::VersionRange;
+
+namespace {
+
+/**
+ * Check that every version orders strictly below the next one
+ */
+void checkAscending(const std::vector<std::string>& versions) {
+    for (size_t i = 0; i + 1 < versions.size(); ++i) {
+        INFO(versions[i] << " < " << versions[i + 1]);
+        CHECK(Version(versions[i]) < Version(versions[i + 1]));
+        CHECK(Version(versions[i + 1]).compare(Version(versions[i])) == 1);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Version orders the SemVer precedence example", "[version]") {
+    checkAscending({"1.0.0-alpha", "1.0.0-alpha.1", "1.0.0-alpha.beta", "1.0.0-beta",
+                    "1.0.0-beta.2", "1.0.0-beta.11", "1.0.0-rc.1", "1.0.0"});
+}
+
+TEST_CASE("Version compares numeric components numerically", "[version]") {
+    checkAscending({"0.9", "1.2", "1.10", "1.10.1", "2.0", "10.0"});
+}
+
+TEST_CASE("Version ignores trailing zeros and build metadata", "[version]") {
+    CHECK(Version("1.0") == Version("1.0.0"));
+    CHECK(Version("1") == Version("1.0"));
+    CHECK(Version("0.15.3+mc1.20.4") == Version("0.15.3"));
+    CHECK(Version("1.0").compare(Version("1.0.0")) == 0);
+}
+
+TEST_CASE("Version orders Maven qualifiers", "[version]") {
+    checkAscending({"1.0-alpha", "1.0-beta", "1.0-milestone", "1.0-rc", "1.0-snapshot", "1.0", "1.0-sp"});
+}
+
+TEST_CASE("Version orders Minecraft releases and pre-releases", "[version]") {
+    checkAscending({"1.20.4-pre1", "1.20.4-rc1", "1.20.4", "1.20.5"});
+    checkAscending({"1.14 Pre-Release 1", "1.14 Pre-Release 2", "1.14"});
+    CHECK(Version("1.20.4-rc1").isPrerelease());
+    CHECK_FALSE(Version("1.20.4").isPrerelease());
+}
+
+TEST_CASE("Version orders Minecraft eras and weekly snapshots", "[version]") {
+    checkAscending({"rd-132211", "c0.30_01c", "a1.2.6", "b1.7.3", "1.0"});
+    checkAscending({"23w45a", "23w45b", "23w46a", "24w03a"});
+    CHECK(Version("23w45a").isSnapshot());
+}
+
+TEST_CASE("VersionRange parses Maven intervals", "[version]") {
+    auto range = VersionRange::parse("[1.0,2.0)");
+    REQUIRE(range);
+    CHECK(range->contains("1.0"));
+    CHECK(range->contains("1.9.9"));
+    CHECK_FALSE(range->contains("2.0"));
+    CHECK_FALSE(range->contains("0.9"));
+
+    auto upper = VersionRange::parse("(,1.5]");
+    REQUIRE(upper);
+    CHECK(upper->contains("0.1"));
+    CHECK(upper->contains("1.5"));
+    CHECK_FALSE(upper->contains("1.5.1"));
+
+    auto exact = VersionRange::parse("[1.2]");
+    REQUIRE(exact);
+    CHECK(exact->contains("1.2.0"));
+    CHECK_FALSE(exact->contains("1.2.1"));
+
+    auto unioned = VersionRange::parse("[1,2),[3,4)");
+    REQUIRE(unioned);
+    CHECK(unioned->contains("1.5"));
+    CHECK_FALSE(unioned->contains("2.5"));
+    CHECK(unioned->contains("3.5"));
+}
+
+TEST_CASE("VersionRange parses npm and Fabric comparators", "[version]") {
+    auto bounded = VersionRange::parse(">=1.2 <2");
+    REQUIRE(bounded);
+    CHECK(bounded->contains("1.2"));
+    CHECK(bounded->contains("1.9"));
+    CHECK_FALSE(bounded->contains("2.0"));
+
+    auto tilde = VersionRange::parse("~1.2.3");
+    REQUIRE(tilde);
+    CHECK(tilde->contains("1.2.9"));
+    CHECK_FALSE(tilde->contains("1.3.0"));
+    CHECK_FALSE(tilde->contains("1.2.2"));
+
+    auto caret = VersionRange::parse("^1.2.3");
+    REQUIRE(caret);
+    CHECK(caret->contains("1.9.0"));
+    CHECK_FALSE(caret->contains("2.0.0"));
+    CHECK_FALSE(caret->contains("2.0.0-alpha"));
+
+    auto wildcard = VersionRange::parse("1.20.x");
+    REQUIRE(wildcard);
+    CHECK(wildcard->contains("1.20.4"));
+    CHECK_FALSE(wildcard->contains("1.21"));
+
+    auto alternatives = VersionRange::parse("1.18.2 || >=1.20");
+    REQUIRE(alternatives);
+    CHECK(alternatives->contains("1.18.2"));
+    CHECK_FALSE(alternatives->contains("1.19"));
+    CHECK(alternatives->contains("1.20.1"));
+}
+
+TEST_CASE("VersionRange matches everything when empty", "[version]") {
+    for (const char* text : {"", "*"}) {
+        auto range = VersionRange::parse(text);
+        REQUIRE(range);
+        CHECK(range->contains("0.0.1"));
+        CHECK(range->contains("23w45a"));
+    }
+    CHECK(VersionRange::any().contains("1.0"));
+}
+
+TEST_CASE("VersionRange rejects malformed ranges", "[version]") {
+    CHECK_FALSE(VersionRange::parse("[1.0,2.0"));
+    CHECK_FALSE(VersionRange::parse(">="));
+}